@@ -25,6 +25,8 @@
 #include "idlib/process/configure.h"
 #include "idlib/process/status.h"
 #include "idlib/process/mutex.h"
+#include "idlib/process/condition.h"
+#include "idlib/process/thread.h"
 
 #if IDLIB_OPERATING_SYSTEM_LINUX == IDLIB_OPERATING_SYSTEM || IDLIB_OPERATING_SYSTEM_CYGWIN == IDLIB_OPERATING_SYSTEM
 
@@ -77,6 +79,7 @@ idlib_process_relinquish
  * - IDLIB_EXISTS if an entry for the key (`p`, `n`) exists
  * @remarks 
  * This function is mt-safe.
+ * Calls to idlib_add_global and idlib_remove_global are serialized.
  */
 idlib_status
 idlib_add_global
@@ -100,6 +103,7 @@ idlib_add_global
  * - IDLIB_NOT_EXISTS if no entry for the key (`p`, `n`) was found
  * @remarks 
  * This function is mt-safe.
+ * This function does not lock: It may run concurrently with other calls to idlib_get_global and with calls to idlib_add_global or idlib_remove_global.
  */
 idlib_status
 idlib_get_global
@@ -119,6 +123,9 @@ idlib_get_global
  * In particular, this function returns
  * - IDLIB_ARGUMENT_INVALID if `process` or `p` is null
  * - IDLIB_NOT_EXISTS if no global is registered for the key `p` and `n` 
+ * @remarks 
+ * This function is mt-safe.
+ * Calls to idlib_add_global and idlib_remove_global are serialized.
  */
 idlib_status
 idlib_remove_global
@@ -52,6 +52,14 @@ idlib_mutex_lock
     idlib_mutex* mutex
   );
 
+// Lock the mutex if it is not locked.
+// Return IDLIB_SUCCESS if the mutex was locked by this call, IDLIB_LOCK_FAILED otherwise.
+idlib_status
+idlib_mutex_try_lock
+  (
+    idlib_mutex* mutex
+  );
+
 idlib_status
 idlib_mutex_unlock
   (
@@ -0,0 +1,61 @@
+/*
+  IdLib Process
+  Copyright (C) 2018-2024 Michael Heilmann. All rights reserved.
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+
+#if !defined(IDLIB_PROCESS_THREAD_H_INCLUDED)
+#define IDLIB_PROCESS_THREAD_H_INCLUDED
+
+#include "idlib/process/configure.h"
+#include "idlib/process/status.h"
+
+// The type of a thread procedure.
+typedef void (idlib_thread_procedure)(void* argument);
+
+// The type of a thread.
+typedef struct idlib_thread idlib_thread;
+
+struct idlib_thread {
+  void* pimpl;
+}; // struct idlib_thread
+
+// Create a thread executing procedure(argument).
+idlib_status
+idlib_thread_initialize
+  (
+    idlib_thread* thread,
+    idlib_thread_procedure* procedure,
+    void* argument
+  );
+
+// Wait for the thread to terminate and release its resources.
+idlib_status
+idlib_thread_uninitialize
+  (
+    idlib_thread* thread
+  );
+
+// Relinquish the remainder of the time slice of the calling thread.
+idlib_status
+idlib_thread_yield
+  (
+  );
+
+#endif // IDLIB_PROCESS_THREAD_H_INCLUDED
@@ -19,9 +19,6 @@
   3. This notice may not be removed or altered from any source distribution.
 */
 
-// TODO:
-// - Linux version not yet thread-safe.
-
 #define IDLIB_PROCESS_PRIVATE (1)
 #include "idlib/process.h"
 
@@ -57,19 +54,97 @@
 
 #endif
 
+// The globals are stored in a hash table with open addressing.
+// The table is never modified after it was published (a "snapshot"):
+// Writers are serialized by a mutex, create a new snapshot, and publish it by atomically replacing the current snapshot.
+// Readers do not lock: They atomically load the current snapshot and lookup the key in it.
+// Readers announce themselves by incrementing a reader counter for their duration.
+// The reader counters are spread over cache line sized slots selected by the stack address of the reader
+// such that readers on different threads do not contend on a single counter.
+// Replaced snapshots and removed entries are "retired" and freed if all reader counters are zero:
+// By the writer after publishing and by a reader leaving if its counter drops to zero and it acquires the writer lock without waiting.
+// Hence retired snapshots and entries are kept at most until the next write or the next reader leaving while no reader is active
+// (and at most until the process singleton is destroyed).
+
+#if (IDLIB_OPERATING_SYSTEM == IDLIB_OPERATING_SYSTEM_LINUX)  || \
+    (IDLIB_OPERATING_SYSTEM == IDLIB_OPERATING_SYSTEM_CYGWIN) || \
+    (IDLIB_OPERATING_SYSTEM == IDLIB_OPERATING_SYSTEM_MACOS)
+
+  #define load_pointer(x) __atomic_load_n((x), __ATOMIC_SEQ_CST)
+  #define store_pointer(x, v) __atomic_store_n((x), (v), __ATOMIC_SEQ_CST)
+  #define load_counter(x) __atomic_load_n((x), __ATOMIC_SEQ_CST)
+  #define store_counter(x, v) __atomic_store_n((x), (v), __ATOMIC_SEQ_CST)
+  #define increment_counter(x) __atomic_add_fetch((x), 1, __ATOMIC_SEQ_CST)
+  #define decrement_counter(x) __atomic_sub_fetch((x), 1, __ATOMIC_SEQ_CST)
+
+#elif IDLIB_OPERATING_SYSTEM_WINDOWS == IDLIB_OPERATING_SYSTEM
+
+  #define load_pointer(x) InterlockedCompareExchangePointer((PVOID volatile*)(x), NULL, NULL)
+  #define store_pointer(x, v) InterlockedExchangePointer((PVOID volatile*)(x), (v))
+  #define load_counter(x) InterlockedCompareExchange64((LONG64 volatile*)(x), 0, 0)
+  #define store_counter(x, v) InterlockedExchange64((LONG64 volatile*)(x), (v))
+  #define increment_counter(x) InterlockedIncrement64((LONG64 volatile*)(x))
+  #define decrement_counter(x) InterlockedDecrement64((LONG64 volatile*)(x))
+
+#else
+
+  #error("operating system not (yet) supported")
+
+#endif
+
+#define MINIMUM_CAPACITY (8)
+
+// The number of reader counter slots. Must be a power of two.
+#define NUMBER_OF_READER_SLOTS (16)
+
+// The size of a cache line (assumed).
+#define CACHE_LINE_SIZE (64)
+
+typedef struct _reader_slot _reader_slot;
+
+struct _reader_slot {
+  // The number of readers using this slot. Accessed atomically.
+  int64_t readers;
+  // Padding such that the counters of two slots are not in the same cache line.
+  char padding[CACHE_LINE_SIZE - sizeof(int64_t)];
+};
+
 typedef struct _entry _entry;
 
+typedef struct _snapshot _snapshot;
+
 typedef struct _entries _entries;
 
 struct _entry {
-  _entry* next;
-  void *p;
-  size_t n;
+  // The next retired entry.
+  _entry* retired;
+  size_t hash_value;
   void* v;
+  size_t n;
+  char p[];
+};
+
+struct _snapshot {
+  // The next retired snapshot.
+  _snapshot* retired;
+  size_t size;
+  // The capacity is a power of two.
+  size_t capacity;
+  // Null pointers denote free slots.
+  _entry* elements[];
 };
 
 struct _entries {
-  _entry* entries;
+  // Serializes the writers.
+  idlib_mutex lock;
+  // The current snapshot. Accessed atomically.
+  _snapshot* snapshot;
+  // The number of readers per slot.
+  _reader_slot reader_slots[NUMBER_OF_READER_SLOTS];
+  // 1 if there are retired snapshots or entries, 0 otherwise. Accessed atomically.
+  int64_t retired;
+  _snapshot* retired_snapshots;
+  _entry* retired_entries;
 };
 
 struct idlib_process {
@@ -77,14 +152,207 @@ struct idlib_process {
   _entries entries; 
 };
 
+static size_t
+hash_key
+  (
+    void const* p,
+    size_t n
+  )
+{
+  // FNV-1a.
+  uint64_t hash_value = UINT64_C(14695981039346656037);
+  for (size_t i = 0; i < n; ++i) {
+    hash_value ^= ((unsigned char const*)p)[i];
+    hash_value *= UINT64_C(1099511628211);
+  }
+  return (size_t)hash_value;
+}
+
+static _snapshot*
+create_snapshot
+  (
+    size_t capacity
+  )
+{
+  _snapshot* snapshot = malloc(sizeof(_snapshot) + sizeof(_entry*) * capacity);
+  if (!snapshot) {
+    return NULL;
+  }
+  snapshot->retired = NULL;
+  snapshot->size = 0;
+  snapshot->capacity = capacity;
+  for (size_t i = 0; i < capacity; ++i) {
+    snapshot->elements[i] = NULL;
+  }
+  return snapshot;
+}
+
+// Insert an entry into a snapshot which is not yet published. The snapshot must have a free slot.
+static void
+insert_entry
+  (
+    _snapshot* snapshot,
+    _entry* entry
+  )
+{
+  size_t i = entry->hash_value & (snapshot->capacity - 1);
+  while (snapshot->elements[i]) {
+    i = (i + 1) & (snapshot->capacity - 1);
+  }
+  snapshot->elements[i] = entry;
+  snapshot->size++;
+}
+
+static _entry*
+find_entry
+  (
+    _snapshot const* snapshot,
+    size_t hash_value,
+    void const* p,
+    size_t n
+  )
+{
+  size_t i = hash_value & (snapshot->capacity - 1);
+  _entry* entry;
+  while (NULL != (entry = snapshot->elements[i])) {
+    if (entry->hash_value == hash_value && entry->n == n && !memcmp(entry->p, p, n)) {
+      return entry;
+    }
+    i = (i + 1) & (snapshot->capacity - 1);
+  }
+  return NULL;
+}
+
+// Create a snapshot of the specified capacity with the entries of the specified snapshot except for the specified entry.
+static _snapshot*
+copy_snapshot
+  (
+    _snapshot const* source,
+    size_t capacity,
+    _entry const* except
+  )
+{
+  _snapshot* target = create_snapshot(capacity);
+  if (!target) {
+    return NULL;
+  }
+  for (size_t i = 0; i < source->capacity; ++i) {
+    _entry* entry = source->elements[i];
+    if (entry && entry != except) {
+      insert_entry(target, entry);
+    }
+  }
+  return target;
+}
+
+// Get the index of the reader slot of the calling reader.
+// Threads have disjoint stacks such that readers on different threads mostly use different slots.
+// Correctness does not depend on the slot selected.
+static inline size_t
+get_reader_slot_index
+  (
+  )
+{
+  char local;
+  uint64_t x = (uint64_t)(uintptr_t)&local >> 12;
+  return (size_t)((x * UINT64_C(0x9E3779B97F4A7C15)) >> 32) & (NUMBER_OF_READER_SLOTS - 1);
+}
+
+// Free the retired snapshots and entries if all reader counters are zero.
+// A reader incrementing its counter after the check loads the current snapshot which is not retired.
+// The writer lock must be held.
+static void
+reclaim_retired
+  (
+    _entries* entries
+  )
+{
+  for (size_t i = 0; i < NUMBER_OF_READER_SLOTS; ++i) {
+    if (0 != load_counter(&entries->reader_slots[i].readers)) {
+      return;
+    }
+  }
+  while (entries->retired_snapshots) {
+    _snapshot* retired = entries->retired_snapshots;
+    entries->retired_snapshots = retired->retired;
+    free(retired);
+  }
+  while (entries->retired_entries) {
+    _entry* retired = entries->retired_entries;
+    entries->retired_entries = retired->retired;
+    free(retired);
+  }
+  store_counter(&entries->retired, 0);
+}
+
+// Publish a snapshot and retire the previous snapshot.
+// Free the retired snapshots and entries if there are no readers.
+// The writer lock must be held.
+static void
+publish_snapshot
+  (
+    _entries* entries,
+    _snapshot* snapshot
+  )
+{
+  _snapshot* previous = entries->snapshot;
+  store_pointer(&entries->snapshot, snapshot);
+  previous->retired = entries->retired_snapshots;
+  entries->retired_snapshots = previous;
+  // Announce the retired snapshot before checking the reader counters:
+  // A reader leaving after the check observes the announcement and attempts to free the retired snapshot.
+  store_counter(&entries->retired, 1);
+  reclaim_retired(entries);
+}
+
 static idlib_status
-initialize_entries(_entries* entries) {
-  entries->entries = NULL;
+initialize_entries
+  (
+    _entries* entries
+  )
+{
+  entries->snapshot = create_snapshot(MINIMUM_CAPACITY);
+  if (!entries->snapshot) {
+    return IDLIB_ALLOCATION_FAILED;
+  }
+  if (idlib_mutex_initialize(&entries->lock)) {
+    free(entries->snapshot);
+    entries->snapshot = NULL;
+    return IDLIB_ENVIRONMENT_FAILED;
+  }
+  for (size_t i = 0; i < NUMBER_OF_READER_SLOTS; ++i) {
+    entries->reader_slots[i].readers = 0;
+  }
+  entries->retired = 0;
+  entries->retired_snapshots = NULL;
+  entries->retired_entries = NULL;
   return IDLIB_SUCCESS;
 }
 
 static idlib_status
-uninitialize_entries(_entries* entries) {
+uninitialize_entries
+  (
+    _entries* entries
+  )
+{
+  for (size_t i = 0; i < entries->snapshot->capacity; ++i) {
+    if (entries->snapshot->elements[i]) {
+      free(entries->snapshot->elements[i]);
+    }
+  }
+  free(entries->snapshot);
+  entries->snapshot = NULL;
+  while (entries->retired_snapshots) {
+    _snapshot* retired = entries->retired_snapshots;
+    entries->retired_snapshots = retired->retired;
+    free(retired);
+  }
+  while (entries->retired_entries) {
+    _entry* retired = entries->retired_entries;
+    entries->retired_entries = retired->retired;
+    free(retired);
+  }
+  idlib_mutex_uninitialize(&entries->lock);
   return IDLIB_SUCCESS;
 }
 
@@ -129,7 +397,11 @@ static idlib_process* g = NULL;
         ReleaseMutex(InterlockedCompareExchangePointer((volatile void*)&g_lock, NULL, NULL));
         return IDLIB_ALLOCATION_FAILED;
       }
-      initialize_entries(&p->entries);
+      if (initialize_entries(&p->entries)) {
+        free(p);
+        ReleaseMutex(InterlockedCompareExchangePointer((volatile void*)&g_lock, NULL, NULL));
+        return IDLIB_ENVIRONMENT_FAILED;
+      }
       p->reference_count = 0;
       g = p;
     }
@@ -197,7 +469,12 @@ idlib_process_acquire
       pthread_mutex_unlock(&g_lock);
       return IDLIB_ALLOCATION_FAILED;
     }
-    initialize_entries(&g->entries);
+    if (initialize_entries(&g->entries)) {
+      free(g);
+      g = NULL;
+      pthread_mutex_unlock(&g_lock);
+      return IDLIB_ENVIRONMENT_FAILED;
+    }
     g->reference_count = 0;
   }
   if (UINT64_MAX == g->reference_count) {
@@ -292,30 +569,48 @@ idlib_add_global
     void* v
   )
 {
-  _entry* entry = process->entries.entries;
-  while (entry) {
-    if (entry->n == n) {
-      if (!memcmp(entry->p, p, n)) {
-        return IDLIB_EXISTS;
-      }
-    }
-    entry = entry->next;
+  if (!process || !p) {
+    return IDLIB_ARGUMENT_INVALID;
+  }
+  _entries* entries = &process->entries;
+  size_t hash_value = hash_key(p, n);
+  if (idlib_mutex_lock(&entries->lock)) {
+    return IDLIB_LOCK_FAILED;
   }
-  entry = malloc(sizeof(_entry));
+  _snapshot* snapshot = entries->snapshot;
+  if (find_entry(snapshot, hash_value, p, n)) {
+    idlib_mutex_unlock(&entries->lock);
+    return IDLIB_EXISTS;
+  }
+  _entry* entry = malloc(sizeof(_entry) + n);
   if (!entry) {
+    idlib_mutex_unlock(&entries->lock);
     return IDLIB_ALLOCATION_FAILED;
   }
-  entry->p = malloc(n > 0 ? n : 1);
-  if (!entry->p) {
+  entry->retired = NULL;
+  entry->hash_value = hash_value;
+  entry->v = v;
+  entry->n = n;
+  memcpy(entry->p, p, n);
+  // Keep the load factor at or below 3/4.
+  size_t capacity = snapshot->capacity;
+  if (snapshot->size + 1 > capacity / 4 * 3) {
+    if (capacity > SIZE_MAX / 2 / sizeof(_entry*)) {
+      free(entry);
+      idlib_mutex_unlock(&entries->lock);
+      return IDLIB_OVERFLOW;
+    }
+    capacity *= 2;
+  }
+  _snapshot* new_snapshot = copy_snapshot(snapshot, capacity, NULL);
+  if (!new_snapshot) {
     free(entry);
-    entry = NULL;
+    idlib_mutex_unlock(&entries->lock);
     return IDLIB_ALLOCATION_FAILED;
   }
-  memcpy(entry->p, p, n);
-  entry->n = n;
-  entry->v = v;
-  entry->next = process->entries.entries;
-  process->entries.entries = entry;
+  insert_entry(new_snapshot, entry);
+  publish_snapshot(entries, new_snapshot);
+  idlib_mutex_unlock(&entries->lock);
   return IDLIB_SUCCESS;
 }
  
@@ -328,17 +623,29 @@ idlib_get_global
     void** v
   )
 {
-  _entry* entry = process->entries.entries;
-  while (entry) {
-    if (entry->n == n) {
-      if (!memcmp(entry->p, p, n)) {
-        *v = entry->v;
-        return IDLIB_SUCCESS;
-      }
+  if (!process || !p || !v) {
+    return IDLIB_ARGUMENT_INVALID;
+  }
+  _entries* entries = &process->entries;
+  size_t hash_value = hash_key(p, n);
+  _reader_slot* slot = &entries->reader_slots[get_reader_slot_index()];
+  increment_counter(&slot->readers);
+  _snapshot const* snapshot = load_pointer(&entries->snapshot);
+  _entry const* entry = find_entry(snapshot, hash_value, p, n);
+  void* value = entry ? entry->v : NULL;
+  idlib_status status = entry ? IDLIB_SUCCESS : IDLIB_NOT_EXISTS;
+  // If this was the last reader of its slot and there are retired snapshots or entries, attempt to free them.
+  // Do not wait for the writer lock: A writer holding it frees them itself if there are no readers.
+  if (0 == decrement_counter(&slot->readers) && 0 != load_counter(&entries->retired)) {
+    if (IDLIB_SUCCESS == idlib_mutex_try_lock(&entries->lock)) {
+      reclaim_retired(entries);
+      idlib_mutex_unlock(&entries->lock);
     }
-    entry = entry->next;
   }
-  return IDLIB_NOT_EXISTS;
+  if (IDLIB_SUCCESS == status) {
+    *v = value;
+  }
+  return status;
 }
 
 idlib_status
@@ -352,19 +659,30 @@ idlib_remove_global
   if (!process || !p) {
     return IDLIB_ARGUMENT_INVALID;
   }
-  _entry** previous = &process->entries.entries;
-  _entry* current = process->entries.entries;
-  while (current) {
-    if (current->n == n) {
-      if (!memcmp(current->p, p, n)) {
-        _entry* node = current;
-        *previous = current->next;
-        free(node);
-        return IDLIB_SUCCESS;
-      }
-    }
-    previous = &current->next;
-    current = current->next;
+  _entries* entries = &process->entries;
+  size_t hash_value = hash_key(p, n);
+  if (idlib_mutex_lock(&entries->lock)) {
+    return IDLIB_LOCK_FAILED;
+  }
+  _snapshot* snapshot = entries->snapshot;
+  _entry* entry = find_entry(snapshot, hash_value, p, n);
+  if (!entry) {
+    idlib_mutex_unlock(&entries->lock);
+    return IDLIB_NOT_EXISTS;
   }
-  return IDLIB_NOT_EXISTS;
+  // Shrink if the load factor falls below 1/8.
+  size_t capacity = snapshot->capacity;
+  if (capacity > MINIMUM_CAPACITY && snapshot->size - 1 < capacity / 8) {
+    capacity /= 2;
+  }
+  _snapshot* new_snapshot = copy_snapshot(snapshot, capacity, entry);
+  if (!new_snapshot) {
+    idlib_mutex_unlock(&entries->lock);
+    return IDLIB_ALLOCATION_FAILED;
+  }
+  entry->retired = entries->retired_entries;
+  entries->retired_entries = entry;
+  publish_snapshot(entries, new_snapshot);
+  idlib_mutex_unlock(&entries->lock);
+  return IDLIB_SUCCESS;
 }
@@ -23,6 +23,10 @@
 
 #include "idlib/process/condition_impl.h"
 
+#include "idlib/process/mutex.h"
+
+#include "idlib/process/mutex_impl.h"
+
 // malloc, free
 #include <malloc.h>
 
@@ -49,6 +53,7 @@ idlib_condition_intialize
   }
 #elif (IDLIB_OPERATING_SYSTEM == IDLIB_OPERATING_SYSTEM_WINDOWS)
   InitializeConditionVariable(&pimpl->condition_variable);
+  InitializeCriticalSection(&pimpl->critical_section);
 #else
   #error("operating system not (yet) supported")
 #endif
@@ -72,7 +77,7 @@ idlib_condition_uninitialize
     (IDLIB_OPERATING_SYSTEM == IDLIB_OPERATING_SYSTEM_MACOS)
   pthread_cond_destroy(&pimpl->condition);
 #elif (IDLIB_OPERATING_SYSTEM == IDLIB_OPERATING_SYSTEM_WINDOWS)
-  /* Intentionally empty. */
+  DeleteCriticalSection(&pimpl->critical_section);
 #else
   #error("operating system not (yet) supported")
 #endif
@@ -86,16 +91,84 @@ idlib_condition_wait
   (
     idlib_condition* condition,
     idlib_mutex* mutex
-  );
+  )
+{
+  if (!condition || !mutex) {
+    return IDLIB_ARGUMENT_INVALID;
+  }
+  idlib_condition_impl* pimpl = (idlib_condition_impl*)condition->pimpl;
+  idlib_mutex_impl* mutex_pimpl = (idlib_mutex_impl*)mutex->pimpl;
+#if (IDLIB_OPERATING_SYSTEM == IDLIB_OPERATING_SYSTEM_LINUX)  || \
+    (IDLIB_OPERATING_SYSTEM == IDLIB_OPERATING_SYSTEM_CYGWIN) || \
+    (IDLIB_OPERATING_SYSTEM == IDLIB_OPERATING_SYSTEM_MACOS)
+  if (pthread_cond_wait(&pimpl->condition, &mutex_pimpl->mtx)) {
+    return IDLIB_ENVIRONMENT_FAILED;
+  }
+#elif (IDLIB_OPERATING_SYSTEM == IDLIB_OPERATING_SYSTEM_WINDOWS)
+  // The mutex is a kernel mutex and cannot be used with a condition variable directly.
+  // The critical section is entered before the mutex is released and is released atomically when sleeping.
+  // As signalling enters the critical section, a signal cannot be lost between releasing the mutex and sleeping.
+  EnterCriticalSection(&pimpl->critical_section);
+  ReleaseMutex(mutex_pimpl->mtx);
+  SleepConditionVariableCS(&pimpl->condition_variable, &pimpl->critical_section, INFINITE);
+  LeaveCriticalSection(&pimpl->critical_section);
+  if (WAIT_OBJECT_0 != WaitForSingleObject(mutex_pimpl->mtx, INFINITE)) {
+    return IDLIB_LOCK_FAILED;
+  }
+#else
+  #error("operating system not (yet) supported")
+#endif
+  return IDLIB_SUCCESS;
+}
 
 idlib_status
 idlib_condition_signal_one
   (
     idlib_condition* condition
-  );
+  )
+{
+  if (!condition) {
+    return IDLIB_ARGUMENT_INVALID;
+  }
+  idlib_condition_impl* pimpl = (idlib_condition_impl*)condition->pimpl;
+#if (IDLIB_OPERATING_SYSTEM == IDLIB_OPERATING_SYSTEM_LINUX)  || \
+    (IDLIB_OPERATING_SYSTEM == IDLIB_OPERATING_SYSTEM_CYGWIN) || \
+    (IDLIB_OPERATING_SYSTEM == IDLIB_OPERATING_SYSTEM_MACOS)
+  if (pthread_cond_signal(&pimpl->condition)) {
+    return IDLIB_ENVIRONMENT_FAILED;
+  }
+#elif (IDLIB_OPERATING_SYSTEM == IDLIB_OPERATING_SYSTEM_WINDOWS)
+  EnterCriticalSection(&pimpl->critical_section);
+  WakeConditionVariable(&pimpl->condition_variable);
+  LeaveCriticalSection(&pimpl->critical_section);
+#else
+  #error("operating system not (yet) supported")
+#endif
+  return IDLIB_SUCCESS;
+}
 
 idlib_status
 idlib_condition_signal_all
   (
     idlib_condition* condition
-  );
+  )
+{
+  if (!condition) {
+    return IDLIB_ARGUMENT_INVALID;
+  }
+  idlib_condition_impl* pimpl = (idlib_condition_impl*)condition->pimpl;
+#if (IDLIB_OPERATING_SYSTEM == IDLIB_OPERATING_SYSTEM_LINUX)  || \
+    (IDLIB_OPERATING_SYSTEM == IDLIB_OPERATING_SYSTEM_CYGWIN) || \
+    (IDLIB_OPERATING_SYSTEM == IDLIB_OPERATING_SYSTEM_MACOS)
+  if (pthread_cond_broadcast(&pimpl->condition)) {
+    return IDLIB_ENVIRONMENT_FAILED;
+  }
+#elif (IDLIB_OPERATING_SYSTEM == IDLIB_OPERATING_SYSTEM_WINDOWS)
+  EnterCriticalSection(&pimpl->critical_section);
+  WakeAllConditionVariable(&pimpl->condition_variable);
+  LeaveCriticalSection(&pimpl->critical_section);
+#else
+  #error("operating system not (yet) supported")
+#endif
+  return IDLIB_SUCCESS;
+}
@@ -184,6 +184,32 @@ idlib_mutex_lock
   return IDLIB_SUCCESS;
 }
 
+idlib_status
+idlib_mutex_try_lock
+  (
+    idlib_mutex* mutex
+  )
+{
+  if (!mutex) {
+    return IDLIB_ARGUMENT_INVALID;
+  }
+  idlib_mutex_impl* pimpl = (idlib_mutex_impl*)mutex->pimpl;
+#if (IDLIB_OPERATING_SYSTEM == IDLIB_OPERATING_SYSTEM_LINUX)  || \
+    (IDLIB_OPERATING_SYSTEM == IDLIB_OPERATING_SYSTEM_CYGWIN) || \
+    (IDLIB_OPERATING_SYSTEM == IDLIB_OPERATING_SYSTEM_MACOS)
+  if (pthread_mutex_trylock(&pimpl->mtx)) {
+    return IDLIB_LOCK_FAILED;
+  }
+#elif (IDLIB_OPERATING_SYSTEM == IDLIB_OPERATING_SYSTEM_WINDOWS)
+  if (WAIT_OBJECT_0 != WaitForSingleObject(pimpl->mtx, 0)) {
+    return IDLIB_LOCK_FAILED;
+  }
+#else
+  #error("operating system not (yet) supported")
+#endif
+  return IDLIB_SUCCESS;
+}
+
 idlib_status
 idlib_mutex_unlock
   (
@@ -0,0 +1,150 @@
+/*
+  IdLib Process
+  Copyright (C) 2018-2024 Michael Heilmann. All rights reserved.
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+
+#include "idlib/process/thread.h"
+
+#include "idlib/process/thread_impl.h"
+
+// malloc, free
+#include <malloc.h>
+
+#if (IDLIB_OPERATING_SYSTEM == IDLIB_OPERATING_SYSTEM_LINUX)  || \
+    (IDLIB_OPERATING_SYSTEM == IDLIB_OPERATING_SYSTEM_CYGWIN) || \
+    (IDLIB_OPERATING_SYSTEM == IDLIB_OPERATING_SYSTEM_MACOS)
+  // sched_yield
+  #include <sched.h>
+#endif
+
+#if (IDLIB_OPERATING_SYSTEM == IDLIB_OPERATING_SYSTEM_LINUX)  || \
+    (IDLIB_OPERATING_SYSTEM == IDLIB_OPERATING_SYSTEM_CYGWIN) || \
+    (IDLIB_OPERATING_SYSTEM == IDLIB_OPERATING_SYSTEM_MACOS)
+
+static void*
+idlib_thread_start
+  (
+    void* argument
+  )
+{
+  idlib_thread_impl* pimpl = (idlib_thread_impl*)argument;
+  pimpl->procedure(pimpl->argument);
+  return NULL;
+}
+
+#elif (IDLIB_OPERATING_SYSTEM == IDLIB_OPERATING_SYSTEM_WINDOWS)
+
+static DWORD WINAPI
+idlib_thread_start
+  (
+    LPVOID argument
+  )
+{
+  idlib_thread_impl* pimpl = (idlib_thread_impl*)argument;
+  pimpl->procedure(pimpl->argument);
+  return 0;
+}
+
+#else
+  #error("operating system not (yet) supported")
+#endif
+
+idlib_status
+idlib_thread_initialize
+  (
+    idlib_thread* thread,
+    idlib_thread_procedure* procedure,
+    void* argument
+  )
+{
+  if (!thread || !procedure) {
+    return IDLIB_ARGUMENT_INVALID;
+  }
+  idlib_thread_impl* pimpl = malloc(sizeof(idlib_thread_impl));
+  if (!pimpl) {
+    return IDLIB_ALLOCATION_FAILED;
+  }
+  pimpl->procedure = procedure;
+  pimpl->argument = argument;
+#if (IDLIB_OPERATING_SYSTEM == IDLIB_OPERATING_SYSTEM_LINUX)  || \
+    (IDLIB_OPERATING_SYSTEM == IDLIB_OPERATING_SYSTEM_CYGWIN) || \
+    (IDLIB_OPERATING_SYSTEM == IDLIB_OPERATING_SYSTEM_MACOS)
+  if (pthread_create(&pimpl->thread, NULL, &idlib_thread_start, pimpl)) {
+    free(pimpl);
+    pimpl = NULL;
+    return IDLIB_ENVIRONMENT_FAILED;
+  }
+#elif (IDLIB_OPERATING_SYSTEM == IDLIB_OPERATING_SYSTEM_WINDOWS)
+  pimpl->thread = CreateThread(NULL, 0, &idlib_thread_start, pimpl, 0, NULL);
+  if (!pimpl->thread) {
+    free(pimpl);
+    pimpl = NULL;
+    return IDLIB_ENVIRONMENT_FAILED;
+  }
+#else
+  #error("operating system not (yet) supported")
+#endif
+  thread->pimpl = pimpl;
+  return IDLIB_SUCCESS;
+}
+
+idlib_status
+idlib_thread_uninitialize
+  (
+    idlib_thread* thread
+  )
+{
+  if (!thread) {
+    return IDLIB_ARGUMENT_INVALID;
+  }
+  idlib_thread_impl* pimpl = (idlib_thread_impl*)thread->pimpl;
+  thread->pimpl = NULL;
+#if (IDLIB_OPERATING_SYSTEM == IDLIB_OPERATING_SYSTEM_LINUX)  || \
+    (IDLIB_OPERATING_SYSTEM == IDLIB_OPERATING_SYSTEM_CYGWIN) || \
+    (IDLIB_OPERATING_SYSTEM == IDLIB_OPERATING_SYSTEM_MACOS)
+  pthread_join(pimpl->thread, NULL);
+#elif (IDLIB_OPERATING_SYSTEM == IDLIB_OPERATING_SYSTEM_WINDOWS)
+  WaitForSingleObject(pimpl->thread, INFINITE);
+  CloseHandle(pimpl->thread);
+  pimpl->thread = NULL;
+#else
+  #error("operating system not (yet) supported")
+#endif
+  free(pimpl);
+  pimpl = NULL;
+  return IDLIB_SUCCESS;
+}
+
+idlib_status
+idlib_thread_yield
+  (
+  )
+{
+#if (IDLIB_OPERATING_SYSTEM == IDLIB_OPERATING_SYSTEM_LINUX)  || \
+    (IDLIB_OPERATING_SYSTEM == IDLIB_OPERATING_SYSTEM_CYGWIN) || \
+    (IDLIB_OPERATING_SYSTEM == IDLIB_OPERATING_SYSTEM_MACOS)
+  sched_yield();
+#elif (IDLIB_OPERATING_SYSTEM == IDLIB_OPERATING_SYSTEM_WINDOWS)
+  SwitchToThread();
+#else
+  #error("operating system not (yet) supported")
+#endif
+  return IDLIB_SUCCESS;
+}
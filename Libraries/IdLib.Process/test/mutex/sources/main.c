@@ -56,6 +56,18 @@ test1
     idlib_mutex_uninitialize(&mutex);
     return status;
   }
+  status = idlib_mutex_try_lock(&mutex);
+  if (status) {
+    fprintf(stderr, "%s:%d: test failed\n", __FILE__, __LINE__);
+    idlib_mutex_uninitialize(&mutex);
+    return status;
+  }
+  status = idlib_mutex_unlock(&mutex);
+  if (status) {
+    fprintf(stderr, "%s:%d: test failed\n", __FILE__, __LINE__);
+    idlib_mutex_uninitialize(&mutex);
+    return status;
+  }
   status = idlib_mutex_uninitialize(&mutex);
   if (status) {
     fprintf(stderr, "%s:%d: test failed\n", __FILE__, __LINE__);
@@ -23,6 +23,8 @@
 
 #include <stdlib.h>
 
+#include <stdio.h>
+
 static int
 test1
   (
@@ -45,6 +47,194 @@ test1
   return IDLIB_SUCCESS;
 }
 
+// Add, get, and remove many globals.
+static int
+test2
+  (
+  )
+{
+  idlib_status status;
+  idlib_process* process = NULL;
+  status = idlib_process_acquire(&process);
+  if (status) {
+    return status;
+  }
+  for (size_t i = 0; i < 256; ++i) {
+    char key[32];
+    int n = snprintf(key, sizeof(key), "test2.%zu", i);
+    status = idlib_add_global(process, key, n, (void*)(i + 1));
+    if (status) {
+      fprintf(stderr, "%s:%d: test failed\n", __FILE__, __LINE__);
+      idlib_process_relinquish(process);
+      return status;
+    }
+  }
+  if (IDLIB_EXISTS != idlib_add_global(process, "test2.0", sizeof("test2.0") - 1, NULL)) {
+    fprintf(stderr, "%s:%d: test failed\n", __FILE__, __LINE__);
+    idlib_process_relinquish(process);
+    return IDLIB_ENVIRONMENT_FAILED;
+  }
+  for (size_t i = 0; i < 256; i += 2) {
+    char key[32];
+    int n = snprintf(key, sizeof(key), "test2.%zu", i);
+    status = idlib_remove_global(process, key, n);
+    if (status) {
+      fprintf(stderr, "%s:%d: test failed\n", __FILE__, __LINE__);
+      idlib_process_relinquish(process);
+      return status;
+    }
+  }
+  for (size_t i = 0; i < 256; ++i) {
+    char key[32];
+    int n = snprintf(key, sizeof(key), "test2.%zu", i);
+    void* v = NULL;
+    status = idlib_get_global(process, key, n, &v);
+    if (i % 2 == 0 ? IDLIB_NOT_EXISTS != status : (IDLIB_SUCCESS != status || (void*)(i + 1) != v)) {
+      fprintf(stderr, "%s:%d: test failed\n", __FILE__, __LINE__);
+      idlib_process_relinquish(process);
+      return IDLIB_ENVIRONMENT_FAILED;
+    }
+  }
+  for (size_t i = 1; i < 256; i += 2) {
+    char key[32];
+    int n = snprintf(key, sizeof(key), "test2.%zu", i);
+    status = idlib_remove_global(process, key, n);
+    if (status) {
+      fprintf(stderr, "%s:%d: test failed\n", __FILE__, __LINE__);
+      idlib_process_relinquish(process);
+      return status;
+    }
+  }
+  status = idlib_process_relinquish(process);
+  if (status) {
+    return status;
+  }
+  return IDLIB_SUCCESS;
+}
+
+typedef struct test3_context {
+  idlib_process* process;
+  // Guards stop and failed.
+  idlib_mutex mutex;
+  int stop;
+  int failed;
+} test3_context;
+
+static int
+test3_get
+  (
+    test3_context* context,
+    int* flag
+  )
+{
+  idlib_mutex_lock(&context->mutex);
+  int value = *flag;
+  idlib_mutex_unlock(&context->mutex);
+  return value;
+}
+
+static void
+test3_set
+  (
+    test3_context* context,
+    int* flag
+  )
+{
+  idlib_mutex_lock(&context->mutex);
+  *flag = 1;
+  idlib_mutex_unlock(&context->mutex);
+}
+
+static void
+test3_reader
+  (
+    void* argument
+  )
+{
+  test3_context* context = (test3_context*)argument;
+  while (!test3_get(context, &context->stop)) {
+    for (size_t i = 0; i < 64; ++i) {
+      void* v = NULL;
+      if (IDLIB_SUCCESS != idlib_get_global(context->process, "test3.fixed", sizeof("test3.fixed") - 1, &v) || (void*)1 != v) {
+        test3_set(context, &context->failed);
+      }
+    }
+  }
+}
+
+// Get a global while other globals are added and removed by another thread.
+static int
+test3
+  (
+  )
+{
+  idlib_status status;
+  test3_context context;
+  idlib_thread threads[4];
+  context.process = NULL;
+  context.stop = 0;
+  context.failed = 0;
+  status = idlib_mutex_initialize(&context.mutex);
+  if (status) {
+    return status;
+  }
+  status = idlib_process_acquire(&context.process);
+  if (status) {
+    idlib_mutex_uninitialize(&context.mutex);
+    return status;
+  }
+  status = idlib_add_global(context.process, "test3.fixed", sizeof("test3.fixed") - 1, (void*)1);
+  if (status) {
+    idlib_process_relinquish(context.process);
+    idlib_mutex_uninitialize(&context.mutex);
+    return status;
+  }
+  size_t numberOfThreads = 0;
+  for (; numberOfThreads < 4; ++numberOfThreads) {
+    if (idlib_thread_initialize(&threads[numberOfThreads], &test3_reader, &context)) {
+      fprintf(stderr, "%s:%d: test failed\n", __FILE__, __LINE__);
+      test3_set(&context, &context.failed);
+      break;
+    }
+  }
+  for (size_t i = 0; i < 1024 && !test3_get(&context, &context.failed); ++i) {
+    char key[32];
+    int n = snprintf(key, sizeof(key), "test3.%zu", i % 64);
+    if (i < 64) {
+      status = idlib_add_global(context.process, key, n, NULL);
+    } else {
+      status = idlib_remove_global(context.process, key, n);
+      if (!status) {
+        status = idlib_add_global(context.process, key, n, NULL);
+      }
+    }
+    if (status) {
+      fprintf(stderr, "%s:%d: test failed\n", __FILE__, __LINE__);
+      test3_set(&context, &context.failed);
+    }
+  }
+  test3_set(&context, &context.stop);
+  while (numberOfThreads > 0) {
+    idlib_thread_uninitialize(&threads[--numberOfThreads]);
+  }
+  for (size_t i = 0; i < 64; ++i) {
+    char key[32];
+    int n = snprintf(key, sizeof(key), "test3.%zu", i);
+    idlib_remove_global(context.process, key, n);
+  }
+  idlib_remove_global(context.process, "test3.fixed", sizeof("test3.fixed") - 1);
+  idlib_mutex_uninitialize(&context.mutex);
+  status = idlib_process_relinquish(context.process);
+  if (status) {
+    return status;
+  }
+  if (context.failed) {
+    fprintf(stderr, "%s:%d: test failed\n", __FILE__, __LINE__);
+    return IDLIB_ENVIRONMENT_FAILED;
+  }
+  return IDLIB_SUCCESS;
+}
+
 int
 main
   (
@@ -55,6 +245,12 @@ main
   if (test1()) {
     return EXIT_FAILURE;
   }
+  if (test2()) {
+    return EXIT_FAILURE;
+  }
+  if (test3()) {
+    return EXIT_FAILURE;
+  }
   return EXIT_SUCCESS;
 }
 
@@ -0,0 +1,116 @@
+/*
+  IdLib Process
+  Copyright (C) 2023-2024 Michael Heilmann. All rights reserved.
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+#include "idlib/process.h"
+
+#include <stdlib.h>
+
+#include <stdio.h>
+
+typedef struct context {
+  idlib_mutex mutex;
+  idlib_condition condition;
+  int counter;
+} context;
+
+static void
+procedure
+  (
+    void* argument
+  )
+{
+  context* context1 = (context*)argument;
+  idlib_mutex_lock(&context1->mutex);
+  context1->counter++;
+  idlib_condition_signal_all(&context1->condition);
+  idlib_mutex_unlock(&context1->mutex);
+}
+
+static int
+test1
+  (
+  )
+{
+  idlib_status status;
+  idlib_thread threads[4];
+  context context1;
+
+  status = idlib_thread_initialize(NULL, &procedure, NULL);
+  if (IDLIB_ARGUMENT_INVALID != status) {
+    fprintf(stderr, "%s:%d: test failed\n", __FILE__, __LINE__);
+    return IDLIB_ENVIRONMENT_FAILED;
+  }
+
+  context1.counter = 0;
+  status = idlib_mutex_initialize(&context1.mutex);
+  if (status) {
+    fprintf(stderr, "%s:%d: test failed\n", __FILE__, __LINE__);
+    return status;
+  }
+  status = idlib_condition_intialize(&context1.condition);
+  if (status) {
+    fprintf(stderr, "%s:%d: test failed\n", __FILE__, __LINE__);
+    idlib_mutex_uninitialize(&context1.mutex);
+    return status;
+  }
+  for (size_t i = 0; i < 4; ++i) {
+    status = idlib_thread_initialize(&threads[i], &procedure, &context1);
+    if (status) {
+      fprintf(stderr, "%s:%d: test failed\n", __FILE__, __LINE__);
+      while (i > 0) {
+        idlib_thread_uninitialize(&threads[--i]);
+      }
+      idlib_condition_uninitialize(&context1.condition);
+      idlib_mutex_uninitialize(&context1.mutex);
+      return status;
+    }
+  }
+  // Wait until all threads have incremented the counter.
+  idlib_mutex_lock(&context1.mutex);
+  while (context1.counter < 4) {
+    idlib_condition_wait(&context1.condition, &context1.mutex);
+  }
+  idlib_mutex_unlock(&context1.mutex);
+  for (size_t i = 0; i < 4; ++i) {
+    idlib_thread_uninitialize(&threads[i]);
+  }
+  idlib_condition_uninitialize(&context1.condition);
+  idlib_mutex_uninitialize(&context1.mutex);
+  if (4 != context1.counter) {
+    fprintf(stderr, "%s:%d: test failed\n", __FILE__, __LINE__);
+    return IDLIB_ENVIRONMENT_FAILED;
+  }
+  fprintf(stderr, "%s:%d: test success\n", __FILE__, __LINE__);
+  return IDLIB_SUCCESS;
+}
+
+int
+main
+  (
+    int argc,
+    char** argv
+  )
+{
+  if (test1()) {
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
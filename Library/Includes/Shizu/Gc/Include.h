@@ -19,6 +19,10 @@ typedef int32_t Shizu_Gcx_Status;
 #define Shizu_Gcx_Status_PlsExists (9)
 #define Shizu_Gcx_Status_PlsNotExists (10)
 
+#define Shizu_Gcx_Status_OperationInvalid (11)
+
+#define Shizu_Gcx_Status_EnvironmentFailed (12)
+
 typedef void (Shizu_Gcx_VisitCallback)(void *visitContext, void *object);
 typedef void (Shizu_Gcx_FinalizeCallback)(void *finalizeContext, void* object);
 
@@ -66,6 +70,13 @@ Shizu_Gcx_relinquishType
     Shizu_Gcx_Type* type
   );
 
+// Allocate an object of the specified type.
+// The common path neither takes the lock of the GC nor performs atomic read-modify-write operations:
+// Each thread allocates small objects from its thread-local allocation buffers and adds objects to its object list.
+// The lock is taken for the first allocation of a thread, to refill a thread-local allocation buffer, and during the sweep phase.
+// Shizu_Gcx_Status_ArgumentInvalid
+// Shizu_Gcx_Status_NotInitialized
+// Shizu_Gcx_Status_AllocationFailed
 Shizu_Gcx_Status
 Shizu_Gcx_allocate
   (
@@ -74,6 +85,130 @@ Shizu_Gcx_allocate
     void** object
   );
 
+// The kind of a collection.
+typedef int32_t Shizu_Gcx_Collection;
+// A major collection marks and sweeps all objects.
+#define Shizu_Gcx_Collection_Major (0)
+// A minor collection only marks and sweeps young objects.
+// Old objects are considered live, old objects in the remembered set are visited.
+// The surviving young objects are promoted to the old generation.
+#define Shizu_Gcx_Collection_Minor (1)
+
+// The phase of a collection.
+typedef int32_t Shizu_Gcx_Phase;
+// No collection is in progress.
+#define Shizu_Gcx_Phase_None (0)
+// A collection is in progress and objects are being marked.
+#define Shizu_Gcx_Phase_Mark (1)
+// A collection is in progress and objects are being swept.
+#define Shizu_Gcx_Phase_Sweep (2)
+
+// Begin a collection of the specified kind.
+// Subsequent calls to Shizu_Gcx_visit (to visit the roots), Shizu_Gcx_mark, Shizu_Gcx_beginSweep, and Shizu_Gcx_sweep
+// or Shizu_Gcx_run (to complete the collection) belong to this collection.
+// The phase changes from Shizu_Gcx_Phase_None to Shizu_Gcx_Phase_Mark.
+// The object lists of all threads are merged into the lists of the GC such that the objects allocated before this call are collected by this collection.
+// Consequently, no other thread may invoke Shizu_Gcx_allocate concurrently with this function (or with the last Shizu_Gcx_shutdown).
+// Shizu_Gcx_Status_ArgumentInvalid
+// Shizu_Gcx_Status_NotInitialized
+// Shizu_Gcx_Status_OperationInvalid if a collection was already begun
+Shizu_Gcx_Status
+Shizu_Gcx_begin
+  (
+    Shizu_Gcx_Collection collection
+  );
+
+// Get the phase of the collection in progress or Shizu_Gcx_Phase_None if no collection is in progress.
+// Shizu_Gcx_Status_ArgumentInvalid
+// Shizu_Gcx_Status_NotInitialized
+Shizu_Gcx_Status
+Shizu_Gcx_getPhase
+  (
+    Shizu_Gcx_Phase* phase
+  );
+
+// Start threads to mark in parallel.
+// Marking without a budget (Shizu_Gcx_mark with SIZE_MAX, Shizu_Gcx_run) is then performed by the calling thread and @a numberOfMarkThreads - 1 additional threads.
+// If @a numberOfMarkThreads is 1 or parallel marking is disabled (Shizu_Configuration_WithGcParallelMark), marking is performed by the calling thread only.
+// The visit callbacks of the types must be safe to invoke concurrently for different objects.
+// Shizu_Gcx_Status_ArgumentInvalid if @a numberOfMarkThreads is 0
+// Shizu_Gcx_Status_NotInitialized
+// Shizu_Gcx_Status_OperationInvalid if mark threads were already started
+// Shizu_Gcx_Status_EnvironmentFailed if a thread could not be started
+Shizu_Gcx_Status
+Shizu_Gcx_startupMarkThreads
+  (
+    size_t numberOfMarkThreads
+  );
+
+// Stop the threads started by Shizu_Gcx_startupMarkThreads (if any).
+// Shizu_Gcx_Status_NotInitialized
+Shizu_Gcx_Status
+Shizu_Gcx_shutdownMarkThreads
+  (
+  );
+
+// Mark at most @a budget gray objects.
+// @a marked receives the number of objects marked.
+// @a done receives true if there are no gray objects left.
+// Further objects may become gray by subsequent calls to Shizu_Gcx_visit or Shizu_Gcx_writeBarrier.
+// Shizu_Gcx_Status_ArgumentInvalid
+// Shizu_Gcx_Status_OperationInvalid if the phase is not Shizu_Gcx_Phase_Mark
+Shizu_Gcx_Status
+Shizu_Gcx_mark
+  (
+    size_t budget,
+    size_t* marked,
+    bool* done
+  );
+
+// End marking and begin sweeping.
+// The phase changes from Shizu_Gcx_Phase_Mark to Shizu_Gcx_Phase_Sweep.
+// Objects allocated after this call are not swept by this collection.
+// Shizu_Gcx_Status_OperationInvalid if the phase is not Shizu_Gcx_Phase_Mark or there are gray objects left
+Shizu_Gcx_Status
+Shizu_Gcx_beginSweep
+  (
+  );
+
+// Sweep at most @a budget objects.
+// @a dead and @a live receive the number of objects reclaimed and retained, respectively.
+// These numbers include the objects swept lazily by Shizu_Gcx_allocate since the last call to this function:
+// During the sweep phase, Shizu_Gcx_allocate sweeps a bounded number of objects of a type before allocating an object of that type.
+// Dead objects of a type with a finalize callback are not deallocated but added to the finalization queue (see Shizu_Gcx_finalize).
+// @a done receives true if all objects were swept. The phase changes from Shizu_Gcx_Phase_Sweep to Shizu_Gcx_Phase_None.
+// Shizu_Gcx_Status_ArgumentInvalid
+// Shizu_Gcx_Status_OperationInvalid if the phase is not Shizu_Gcx_Phase_Sweep
+// Shizu_Gcx_Status_AllocationFailed if the compact header is enabled (Shizu_Configuration_WithGcCompactHeader) and a dead object could not be added to the finalization queue.
+// The sweep can be resumed by calling this function again.
+Shizu_Gcx_Status
+Shizu_Gcx_sweep
+  (
+    size_t budget,
+    size_t* dead,
+    size_t* live,
+    bool* done
+  );
+
+// Invoke the finalize callbacks of at most @a budget objects in the finalization queue and deallocate these objects.
+// The finalize callbacks are invoked without holding the lock of the GC such that they may invoke Gcx functions.
+// The finalization queue may be drained in any phase.
+// @a finalized receives the number of objects finalized.
+// @a done receives true if the finalization queue is empty.
+// Dead objects remaining in the finalization queue when the GC is shut down are deallocated without invoking their finalize callbacks.
+// Shizu_Gcx_Status_ArgumentInvalid
+// Shizu_Gcx_Status_NotInitialized
+Shizu_Gcx_Status
+Shizu_Gcx_finalize
+  (
+    size_t budget,
+    size_t* finalized,
+    bool* done
+  );
+
+// Complete the collection begun by Shizu_Gcx_begin.
+// Shorthand for marking, beginning the sweep, sweeping, and finalizing without a budget.
+// Shizu_Gcx_Status_OperationInvalid if the phase is not Shizu_Gcx_Phase_Mark
 Shizu_Gcx_Status
 Shizu_Gcx_run
   (
@@ -87,6 +222,116 @@ Shizu_Gcx_visit
     void* object
   );
 
+// Visit the objects of an array of objects.
+// Equivalent to invoking Shizu_Gcx_visit for each object but the headers of the objects are prefetched before they are tested
+// and the singleton is only looked up once.
+void
+Shizu_Gcx_visitObjects
+  (
+    void* const* objects,
+    size_t numberOfObjects
+  );
+
+// Write barrier.
+// Must be invoked after a reference to the object @a value was stored in the object @a object.
+// If @a value is a null pointer then the object @a object is conservatively assumed to store a reference to a white object.
+// If @a object is black and @a value is white then
+// - during the phase Shizu_Gcx_Phase_Mark @a value is colored gray (or @a object is colored gray if @a value is a null pointer) and
+// - otherwise @a object is added to the remembered set (old objects are black between collections).
+void
+Shizu_Gcx_writeBarrier
+  (
+    void* object,
+    void* value
+  );
+
+/*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+
+// The statistics of a type.
+// The sizes of objects include the headers of the GC. The size of an object in a slot of the size-class heap is the size of the slot.
+// The statistics are updated when a collection begins and when objects are swept such that they are cheap to maintain:
+// The objects allocated since the last collection began are counted when the next collection begins.
+typedef struct Shizu_Gcx_TypeStatistics {
+  // The number of objects of the type not reclaimed by a collection and their size, in Bytes.
+  // Excludes the objects allocated since the last collection began.
+  size_t liveObjects;
+  size_t liveBytes;
+  // The number of objects of the type allocated between the beginnings of the second to last and the last collection and their size, in Bytes.
+  size_t allocatedObjects;
+  size_t allocatedBytes;
+  // The number of objects of the type reclaimed since the last collection began and their size, in Bytes.
+  size_t freedObjects;
+  size_t freedBytes;
+} Shizu_Gcx_TypeStatistics;
+
+// Get the statistics of a type.
+// Shizu_Gcx_Status_ArgumentInvalid
+Shizu_Gcx_Status
+Shizu_Gcx_getTypeStatistics
+  (
+    Shizu_Gcx_Type* type,
+    Shizu_Gcx_TypeStatistics* statistics
+  );
+
+// Set or clear the record flag of an object.
+// The GC does not interpret the flag and preserves it for the lifetime of the object.
+// It allows for testing cheaply if the user of the GC stores data of the object outside of the object
+// (for example, in a table keyed by the address of the object) before looking that data up.
+// The flag is cleared when the object is allocated.
+// Must not be invoked concurrently with Shizu_Gcx_mark.
+void
+Shizu_Gcx_setRecordFlag
+  (
+    void* object,
+    bool flag
+  );
+
+// Get the record flag of an object.
+bool
+Shizu_Gcx_getRecordFlag
+  (
+    void const* object
+  );
+
+// Get if an object is colored white.
+// If marking is complete (Shizu_Gcx_mark reported that there are no gray objects left), then the white objects
+// which were allocated before the collection began are reclaimed by the sweep.
+// Must not be invoked concurrently with Shizu_Gcx_mark.
+bool
+Shizu_Gcx_isWhite
+  (
+    void const* object
+  );
+
+// Get the size, in Bytes, of an object including the header of the GC.
+// The size of an object in a slot of the size-class heap is the size of the slot.
+// Shizu_Gcx_Status_ArgumentInvalid
+Shizu_Gcx_Status
+Shizu_Gcx_getObjectSize
+  (
+    void* object,
+    size_t* size
+  );
+
+// Invoked by Shizu_Gcx_enumerateObjects for an object.
+// @a size is the size of the object as reported by Shizu_Gcx_getObjectSize.
+// @a recent is true if the object was allocated since the last collection began.
+typedef void (Shizu_Gcx_EnumerateCallback)(void* context, void* object, size_t size, bool recent);
+
+// Invoke the callback for each object of the specified type not reclaimed by a collection.
+// During the sweep phase, this includes dead objects not yet swept. Objects in the finalization queue are excluded.
+// The lock of the GC is held while the callback is invoked: The callback must not invoke Gcx functions.
+// No other thread may invoke Shizu_Gcx_allocate concurrently with this function.
+// Shizu_Gcx_Status_ArgumentInvalid
+// Shizu_Gcx_Status_NotInitialized
+Shizu_Gcx_Status
+Shizu_Gcx_enumerateObjects
+  (
+    Shizu_Gcx_Type* type,
+    void* context,
+    Shizu_Gcx_EnumerateCallback* callback
+  );
+
 /*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
 
 // Destroy process local storage.
@@ -24,6 +24,8 @@
 
 // size_t
 #include <stddef.h>
+// uint64_t
+#include <inttypes.h>
 #include "Shizu/Runtime/Value.h"
 typedef struct Shizu_Gc Shizu_Gc;
 typedef struct Shizu_State1 Shizu_State1;
@@ -55,11 +57,132 @@ Shizu_Gc_visitValue
     Shizu_Value* value
   );
 
+/// @since 1.0
+/// @brief Write barrier.
+/// Must be invoked after a reference to an object was stored in an object.
+/// @param object A pointer to the object the reference was stored in.
+/// @param value A pointer to the referenced object or the null pointer.
+/// If this is the null pointer then @a object is assumed to reference a young or unmarked object.
+/// @remarks While a collection is marking incrementally, the GC marks objects stored into already marked objects.
+/// If generational collection is enabled, the GC records old objects which reference young objects.
+/// Failing to invoke this function may cause incremental or minor collections to reclaim live objects.
+void
+Shizu_Gc_writeBarrier
+  (
+    Shizu_State1* state1,
+    Shizu_Gc* gc,
+    Shizu_Object* object,
+    Shizu_Object* value
+  );
+
+/// @since 1.0
+/// @brief Write barrier.
+/// Must be invoked after a Shizu_Value was stored in an object.
+/// @param object A pointer to the object the value was stored in.
+/// @param value A pointer to the value.
+/// @remarks This function does nothing if the value does not store an object.
+void
+Shizu_Gc_writeBarrierValue
+  (
+    Shizu_State1* state1,
+    Shizu_Gc* gc,
+    Shizu_Object* object,
+    Shizu_Value const* value
+  );
+
+/// @since 1.0
+/// @brief The phase of a collection.
+typedef enum Shizu_Gc_Phase Shizu_Gc_Phase;
+
+enum Shizu_Gc_Phase {
+  /// @brief No collection is in progress.
+  Shizu_Gc_Phase_None = 0,
+  /// @brief A collection is in progress and objects are being marked.
+  Shizu_Gc_Phase_Mark = 1,
+  /// @brief A collection is in progress and objects are being swept.
+  Shizu_Gc_Phase_Sweep = 2,
+};
+
 typedef struct Shizu_Gc_SweepInfo {
+  /// @brief The number of objects retained by the collection.
   size_t live;
+  /// @brief The number of objects reclaimed by the collection.
   size_t dead;
+  /// @brief The number of objects marked by the collection.
+  size_t marked;
+  /// @brief The number of dead objects finalized and deallocated by the call.
+  /// These objects may have been reclaimed by a previous collection.
+  size_t finalized;
+  /// @brief The phase of the collection after the call returned.
+  /// Shizu_Gc_Phase_None if the collection is complete.
+  Shizu_Gc_Phase phase;
 } Shizu_Gc_SweepInfo;
 
+/// @since 1.0
+/// @brief The statistics of the garbage collector.
+/// The durations are measured with a monotonic clock.
+/// They include the time spent by Shizu_Gc_step and Shizu_Gc_run(Minor|Major) marking (including visiting the roots) and sweeping.
+/// They do not include the time spent by the lazy sweeping of allocations and by finalizing dead objects.
+typedef struct Shizu_Gc_Statistics {
+  /// @brief The number of collections completed.
+  size_t collections;
+  /// @brief The number of minor collections completed.
+  size_t minorCollections;
+  /// @brief The time, in nanoseconds, spent marking by the last completed collection.
+  uint64_t markDuration;
+  /// @brief The time, in nanoseconds, spent sweeping by the last completed collection.
+  uint64_t sweepDuration;
+  /// @brief The time, in nanoseconds, spent marking by all completed collections.
+  uint64_t totalMarkDuration;
+  /// @brief The time, in nanoseconds, spent sweeping by all completed collections.
+  uint64_t totalSweepDuration;
+  /// @brief The number of collections run by Shizu_Gc_poll.
+  size_t pacedCollections;
+  /// @brief The size, in Bytes, of the objects retained by the last completed collection.
+  size_t liveBytes;
+  /// @brief The size, in Bytes, of the objects allocated since the last collection began.
+  size_t allocatedBytes;
+} Shizu_Gc_Statistics;
+
+/// @since 1.0
+/// @brief The pacing policy of the garbage collector.
+/// The policy decides when Shizu_Gc_poll runs a collection.
+/// The heap size is the size of the objects retained by the last completed collection (as counted by the GC, including the headers)
+/// plus the size of the objects allocated since the last collection began (as requested from Shizu_Gc_allocateObject).
+typedef struct Shizu_Gc_Pacing {
+  /// @brief A collection is triggered if the heap grew by this percentage of the size of the objects retained by the last completed collection.
+  /// This is like `GOGC`: 100 lets the heap double between collections. 0 disables triggering collections by growth.
+  size_t growthFactor;
+  /// @brief The size, in Bytes, of the objects retained by a collection is assumed to be at least this size when computing the heap size triggering the next collection.
+  /// This avoids frequent collections of small heaps.
+  size_t minimumHeapSize;
+  /// @brief If not 0, a collection is triggered if the heap size reaches this size, in Bytes, regardless of the growth factor and the minimum interval.
+  /// If the objects retained by the collections exceed this size, every call to Shizu_Gc_poll runs a collection.
+  size_t maximumHeapSize;
+  /// @brief The minimum time, in nanoseconds, between the end of a collection and a collection triggered by growth.
+  uint64_t minimumInterval;
+} Shizu_Gc_Pacing;
+
+/// @since 1.0
+/// @brief The statistics of the objects of a type.
+/// Only objects of exactly that type are counted (and not objects of types derived from that type).
+/// The sizes of objects include the headers of the GC (see Shizu_Gcx_getObjectSize).
+typedef struct Shizu_Gc_TypeStatistics {
+  /// @brief The number of objects not reclaimed by a collection.
+  /// During the sweep phase, this includes dead objects not yet swept.
+  size_t liveObjects;
+  /// @brief The size, in Bytes, of the objects not reclaimed by a collection.
+  size_t liveBytes;
+  /// @brief The number of objects allocated since the last collection began and not reclaimed.
+  size_t allocatedObjects;
+  /// @brief The size, in Bytes, of the objects allocated since the last collection began and not reclaimed.
+  size_t allocatedBytes;
+  /// @brief The number of objects finalized since the last collection began.
+  size_t freedObjects;
+  /// @brief The size, in Bytes, of the objects finalized since the last collection began.
+  size_t freedBytes;
+} Shizu_Gc_TypeStatistics;
+
 typedef void Shizu_Gc_PreMarkCallbackContext;
 typedef void (Shizu_Gc_PreMarkCallbackFunction)(Shizu_State1*, Shizu_Gc*, Shizu_Gc_PreMarkCallbackContext*);
 
@@ -92,6 +215,44 @@ Shizu_Gc_removePreMarkHook
     Shizu_Gc_PreMarkCallbackFunction* function
   );
 
+/// @since 1.0
+/// @brief Add a registration of a root range.
+/// A root range is an array of Shizu_Value objects.
+/// Whenever the roots are visited, the objects referenced by the values of the array are visited after the pre mark hooks were notified.
+/// The array is scanned in a tight loop and the objects are visited in batches such that the cost per value is small.
+/// @param values A pointer to a variable storing a pointer to the array.
+/// @param numberOfValues A pointer to a variable storing the number of values of the array.
+/// @remarks The variables are read whenever the roots are visited such that the array may be reallocated, grow, or shrink.
+/// The same @a values and @a numberOfValues pointers can be registered multiple times.
+/// @undefined @a state does not point to a Shizu_State1 object.
+/// @error @a gc is a null pointer.
+/// @error @a values is a null pointer.
+/// @error @a numberOfValues is a null pointer.
+void
+Shizu_Gc_addRootRange
+  (
+    Shizu_State1* state,
+    Shizu_Gc* gc,
+    Shizu_Value* const* values,
+    size_t const* numberOfValues
+  );
+
+/// @since 1.0
+/// @brief Remove all(!) registrations of a root range.
+/// @param values, numberOfValues The pointers of the root range.
+/// @undefined @a state does not point to a Shizu_State1 object.
+/// @error @a gc is a null pointer.
+/// @error @a values is a null pointer.
+/// @error @a numberOfValues is a null pointer.
+void
+Shizu_Gc_removeRootRange
+  (
+    Shizu_State1* state,
+    Shizu_Gc* gc,
+    Shizu_Value* const* values,
+    size_t const* numberOfValues
+  );
+
 typedef void Shizu_Gc_ObjectFinalizeCallbackContext;
 typedef void (Shizu_Gc_ObjectFinalizeCallbackFunction)(Shizu_State1*, Shizu_Gc*, Shizu_Gc_ObjectFinalizeCallbackContext*, Shizu_Object*);
 
@@ -124,6 +285,39 @@ Shizu_Gc_removeObjectFinalizeHook
     Shizu_Gc_ObjectFinalizeCallbackFunction* function
   );
 
+/// @since 1.0
+/// @brief Perform an increment of work of a collection.
+/// If no collection is in progress, a collection is begun (as selected by Shizu_Gc_run) and the roots are visited.
+/// Otherwise at most @a budget objects are marked or swept.
+/// When the last gray object was marked, the roots are visited again and marking is completed without a budget before the sweep begins.
+/// In addition, the finalizers of at most @a budget dead objects are invoked and these objects are deallocated.
+/// @param budget The maximum number of objects to mark or sweep and the maximum number of objects to finalize. Must not be @a 0.
+/// @param sweepInfo A pointer to a Shizu_Gc_SweepInfo object or the null pointer.
+/// If not the null pointer, that object receives the numbers for the collection in progress accumulated up to and including this step and the phase after this step.
+/// @remarks Between steps, the mutator may run.
+/// Stores of references into objects must invoke the write barrier (Shizu_Gc_writeBarrier, Shizu_Gc_writeBarrierValue).
+/// During the sweep phase, allocating an object sweeps a bounded number of objects such that the sweep may complete without further steps.
+/// Dead objects are not finalized by the sweep but are added to a finalization queue.
+/// That queue is drained by Shizu_Gc_step and Shizu_Gc_run(Minor|Major) as their finalizers may not be invoked during allocation.
+/// The write barrier only colors white objects gray and an object is marked at most once per collection.
+/// Hence marking completes after at most (number of reachable objects) / @a budget steps and the final marking pass.
+/// @error @a budget is @a 0.
+void
+Shizu_Gc_step
+  (
+    Shizu_State2* state,
+    Shizu_Gc* self,
+    size_t budget,
+    Shizu_Gc_SweepInfo* sweepInfo
+  );
+
+/// @since 1.0
+/// @brief Run the GC.
+/// Completes a collection in progress (see Shizu_Gc_step).
+/// The finalizers of all dead objects are invoked and these objects are deallocated before this function returns.
+/// If generational collection is enabled, this performs a minor collection.
+/// Every Shizu_Gc_MinorRunsPerMajorRun-th run performs a major collection.
+/// Otherwise this performs a major collection.
 void
 Shizu_Gc_run
   (
@@ -132,4 +326,104 @@ Shizu_Gc_run
     Shizu_Gc_SweepInfo* sweepInfo
   );
 
+/// @since 1.0
+/// @brief Run the GC and perform a minor collection.
+/// A minor collection only reclaims young objects and promotes the surviving young objects to the old generation.
+/// If generational collection is disabled, this performs a major collection.
+void
+Shizu_Gc_runMinor
+  (
+    Shizu_State2* state,
+    Shizu_Gc* self,
+    Shizu_Gc_SweepInfo* sweepInfo
+  );
+
+/// @since 1.0
+/// @brief Run the GC and perform a major collection.
+/// A major collection reclaims young and old objects.
+void
+Shizu_Gc_runMajor
+  (
+    Shizu_State2* state,
+    Shizu_Gc* self,
+    Shizu_Gc_SweepInfo* sweepInfo
+  );
+
+/// @since 1.0
+/// @brief Get the pacing policy of the garbage collector.
+/// @param pacing A pointer to a Shizu_Gc_Pacing object.
+/// @remarks The default policy is defined by the build configuration
+/// (Shizu_Configuration_GcGrowthFactor, Shizu_Configuration_GcMaximumHeapSize, Shizu_Configuration_GcMinimumInterval, and Shizu_Gc_MinimumHeapSize).
+/// @error @a pacing is a null pointer.
+void
+Shizu_Gc_getPacing
+  (
+    Shizu_State2* state,
+    Shizu_Gc* self,
+    Shizu_Gc_Pacing* pacing
+  );
+
+/// @since 1.0
+/// @brief Set the pacing policy of the garbage collector.
+/// @param pacing A pointer to a Shizu_Gc_Pacing object.
+/// @remarks The policy applies to the next call to Shizu_Gc_poll.
+/// @error @a pacing is a null pointer.
+void
+Shizu_Gc_setPacing
+  (
+    Shizu_State2* state,
+    Shizu_Gc* self,
+    Shizu_Gc_Pacing const* pacing
+  );
+
+/// @since 1.0
+/// @brief Run a collection if the pacing policy (see Shizu_Gc_Pacing) demands it.
+/// If a collection is in progress (see Shizu_Gc_step), that collection is completed.
+/// Otherwise a collection is run (see Shizu_Gc_run).
+/// @param sweepInfo A pointer to a Shizu_Gc_SweepInfo object or the null pointer.
+/// If not the null pointer and a collection was run, that object receives the numbers for that collection.
+/// @return @a true if a collection was run. @a false otherwise.
+/// @remarks Objects are allocated without triggering collections as the objects referenced only by the C stack are not roots.
+/// Embedders call this function at safe points, for example between the calls into scripts.
+/// If the policy does not demand a collection, the cost of a call is constant and small.
+bool
+Shizu_Gc_poll
+  (
+    Shizu_State2* state,
+    Shizu_Gc* self,
+    Shizu_Gc_SweepInfo* sweepInfo
+  );
+
+/// @since 1.0
+/// @brief Get the statistics of the garbage collector.
+/// @param statistics A pointer to a Shizu_Gc_Statistics object.
+/// @remarks The statistics are maintained at a constant cost per step and per collection.
+/// They are also available to scripts by the procedure `Gc.getStatistics`.
+/// @error @a statistics is a null pointer.
+void
+Shizu_Gc_getStatistics
+  (
+    Shizu_State2* state,
+    Shizu_Gc* self,
+    Shizu_Gc_Statistics* statistics
+  );
+
+/// @since 1.0
+/// @brief Get the statistics of the objects of a type.
+/// @param type A pointer to the type.
+/// @param statistics A pointer to a Shizu_Gc_TypeStatistics object.
+/// @remarks The numbers of freed objects are maintained at a constant cost per finalized object.
+/// The other numbers are computed by enumerating the objects such that the cost of a call is linear in the number of objects.
+/// They are also available to scripts by the procedure `Gc.getTypeStatistics`.
+/// @error @a type is not an object type.
+/// @error @a statistics is a null pointer.
+void
+Shizu_Gc_getTypeStatistics
+  (
+    Shizu_State2* state,
+    Shizu_Gc* self,
+    Shizu_Type* type,
+    Shizu_Gc_TypeStatistics* statistics
+  );
+
 #endif // SHIZU_RUNTIME_GC_H_INCLUDED
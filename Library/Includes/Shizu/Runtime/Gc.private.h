@@ -30,10 +30,9 @@
 
 /*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
 
-typedef struct PreMarkHookNode PreMarkHookNode;
+typedef struct PreMarkHook PreMarkHook;
 
-struct PreMarkHookNode {
-  PreMarkHookNode* next;
+struct PreMarkHook {
   bool dead;
   Shizu_Gc_PreMarkCallbackContext* context;
   Shizu_Gc_PreMarkCallbackFunction* function;
@@ -41,10 +40,40 @@ struct PreMarkHookNode {
 
 /*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
 
-typedef struct ObjectFinalizeHookNode ObjectFinalizeHookNode;
+typedef struct RootRange RootRange;
 
-struct ObjectFinalizeHookNode {
-  ObjectFinalizeHookNode* next;
+struct RootRange {
+  Shizu_Value* const* values;
+  size_t const* numberOfValues;
+};
+
+/*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+
+typedef struct Shizu_WeakReference Shizu_WeakReference;
+
+/// @since 1.0
+/// @brief The side record of an object.
+/// Stores the data of an object kept outside of the object: The lock count and the weak references of the object.
+/// An object has a side record if and only if its record flag (see Shizu_Gcx_getRecordFlag) is set
+/// such that finalizing an object without side record does not perform a lookup.
+typedef struct Shizu_ObjectRecord Shizu_ObjectRecord;
+
+struct Shizu_ObjectRecord {
+  Shizu_ObjectRecord* next;
+  Shizu_Object* object;
+  /// The hash value of the address of the object.
+  size_t hashValue;
+  /// The number of locks on the object. The object is a root if this is not zero.
+  size_t lockCount;
+  /// The list of the weak references to the object.
+  Shizu_WeakReference* weakReferences;
+};
+
+/*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+
+typedef struct ObjectFinalizeHook ObjectFinalizeHook;
+
+struct ObjectFinalizeHook {
   bool dead;
   Shizu_Gc_ObjectFinalizeCallbackContext* context;
   Shizu_Gc_ObjectFinalizeCallbackFunction* function;
@@ -52,6 +81,14 @@ struct ObjectFinalizeHookNode {
 
 /*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
 
+/// @since 1.0
+/// @brief If generational collection is enabled, Shizu_Gc_run performs a major run after this number of minor runs.
+#define Shizu_Gc_MinorRunsPerMajorRun (8)
+
+/// @since 1.0
+/// @brief The default of Shizu_Gc_Pacing.minimumHeapSize, in Bytes.
+#define Shizu_Gc_MinimumHeapSize (4 * 1024 * 1024)
+
 typedef struct Shizu_Gc Shizu_Gc;
 
 struct Shizu_Gc {
@@ -60,14 +97,62 @@ struct Shizu_Gc {
   Shizu_Gcx_Type* type;
   Shizu_Object* all;
   Shizu_Object* gray;
+  /// The number of minor runs since the last major run.
+  size_t minorRuns;
+  /// The kind of the collection in progress.
+  /// Only meaningful if the collection was begun by Shizu_Gc_step and is not yet complete.
+  Shizu_Gcx_Collection collection;
+  /// The numbers of objects marked, reclaimed, and retained by the collection in progress.
+  /// The time, in nanoseconds, spent marking and sweeping by the collection in progress.
+  struct {
+    size_t marked;
+    size_t dead;
+    size_t live;
+    uint64_t markDuration;
+    uint64_t sweepDuration;
+  } current;
+  /// The number of collections begun.
+  size_t collectionsBegun;
+  /// The statistics of the completed collections.
+  Shizu_Gc_Statistics statistics;
+  /// The pacing policy.
+  /// The heap size triggering the next collection by growth (SIZE_MAX if growth does not trigger collections)
+  /// and the point in time, in nanoseconds, when the last collection ended.
   struct {
-    PreMarkHookNode* nodes;
+    Shizu_Gc_Pacing policy;
+    size_t triggerBytes;
+    uint64_t lastCollectionEnd;
+  } pacing;
+  /// The pre mark hooks in the order of their registration.
+  struct {
+    PreMarkHook* elements;
+    size_t size;
+    size_t capacity;
     bool running;
   } preMarkHooks;
+  /// The root ranges.
+  struct {
+    RootRange* elements;
+    size_t size;
+    size_t capacity;
+  } rootRanges;
+  /// The object finalize hooks in the order of their registration.
   struct {
-    ObjectFinalizeHookNode* nodes;
+    ObjectFinalizeHook* elements;
+    size_t size;
+    size_t capacity;
     bool running;
   } objectFinalizeHooks;
+  /// The side records of the objects.
+  /// The capacity is a power of two. The table grows if the load factor exceeds 3/4 and shrinks if it falls below 1/8.
+  /// Removed side records are kept in a free list of at most capacity side records for reuse.
+  struct {
+    Shizu_ObjectRecord** buckets;
+    size_t size;
+    size_t capacity;
+    Shizu_ObjectRecord* free;
+    size_t freeSize;
+  } objectRecords;
 };
 
 /// @since 1.0
@@ -77,10 +162,14 @@ struct Shizu_Gc {
 /// Shutdown the "garbage collector" state by calling Shizu_Gc_destroy.
 /// This function may invoke Shizu_State1_(push|pop)JumpTarget, Shizu_State1_(jump|setStatus|getStatus) Shizu_State1 is required.
 /// Only one Shizu_Gc object may exist in a process.
+/// @param numberOfMarkThreads The number of threads marking in parallel (including the thread running the GC).
+/// If this is 1 or parallel marking is disabled (Shizu_Configuration_WithGcParallelMark), the thread running the GC marks alone.
+/// @error @a numberOfMarkThreads is 0.
 Shizu_Gc*
 Shizu_Gc_create
   (
-    Shizu_State2* state
+    Shizu_State2* state,
+    size_t numberOfMarkThreads
   );
 
 /// @since 1.0
@@ -94,6 +183,47 @@ Shizu_Gc_destroy
     Shizu_Gc* self
   );
 
+/// @since 1.0
+/// @brief Get the side record of an object.
+/// @param object A pointer to the object.
+/// @param create If @a true and the object has no side record, an empty side record is created.
+/// @return A pointer to the side record of the object.
+/// The null pointer if the object has no side record and @a create is @a false.
+/// @error The side record was not found and could not be created.
+Shizu_ObjectRecord*
+Shizu_Gc_getObjectRecord
+  (
+    Shizu_State1* state1,
+    Shizu_Gc* self,
+    Shizu_Object* object,
+    bool create
+  );
+
+/// @since 1.0
+/// @brief Remove the side record of an object if it is empty.
+/// A side record is empty if its object is not locked and not referenced by weak references.
+/// @param record A pointer to the side record.
+void
+Shizu_Gc_releaseObjectRecord
+  (
+    Shizu_State1* state1,
+    Shizu_Gc* self,
+    Shizu_ObjectRecord* record
+  );
+
+/// @since 1.0
+/// @brief Read barrier for weak tables.
+/// Must be invoked before a reference to an object found in a table not visited by the GC (for example, the intern table of strings) is handed out.
+/// @param object A pointer to the object.
+/// @remarks While a collection is marking, the object is colored gray if it is white such that it is not reclaimed by that collection.
+void
+Shizu_Gc_readBarrier
+  (
+    Shizu_State1* state1,
+    Shizu_Gc* self,
+    Shizu_Object* object
+  );
+
 /// @since 1.0
 /// @brief Color a Shizu_Object value black.
 /// @param object A pointer to the Shizu_Object value.
@@ -106,7 +236,7 @@ Shizu_Object_setWhite
 /// @since 1.0
 /// @brief Get if an Shizu_Object value is colored white.
 /// @param object A pointer to a Shizu_Object value.
-/// @return @a true if the object is colored gray. @a false otherwise.
+/// @return @a true if the object is colored white. @a false otherwise.
 bool
 Shizu_Object_isWhite
   (
@@ -151,4 +281,15 @@ Shizu_Object_isBlack
     Shizu_Object const* object
   );
 
+/// @since 1.0
+/// @brief Register the procedures `Gc.getStatistics` and `Gc.getTypeStatistics` in the global environment.
+/// `Gc.getStatistics()` returns a Map from the names of the fields of Shizu_Gc_Statistics to their values.
+/// `Gc.getTypeStatistics(name : String)` returns a Map from the names of the fields of Shizu_Gc_TypeStatistics to their values for the type of the specified name.
+/// Counts are Integer32 values (saturated), durations are Float32 values in milliseconds.
+void
+Shizu_Gc_registerProcedures
+  (
+    Shizu_State2* state
+  );
+
 #endif // SHIZU_RUNTIME_GC_PRIVATE_H_INCLUDED
@@ -33,6 +33,7 @@
 
 #include "Shizu/Runtime/countLeadingZeroes.h"
 #include "Shizu/Runtime/countTrailingZeroes.h"
+#include "Shizu/Runtime/getMonotonicTime.h"
 #include "Shizu/Runtime/getWorkingDirectory.h"
 #include "Shizu/Runtime/isPowerOfTwo.h"
 #include "Shizu/Runtime/powerOfTwoGreaterThan.h"
@@ -46,6 +47,7 @@
 #include "Shizu/Runtime/Objects/List.h"
 #include "Shizu/Runtime/Objects/Map.h"
 #include "Shizu/Runtime/Objects/String.h"
+#include "Shizu/Runtime/Objects/StringBuilder.h"
 #include "Shizu/Runtime/Objects/WeakReference.h"
 #undef SHIZU_RUNTIME_PRIVATE
 
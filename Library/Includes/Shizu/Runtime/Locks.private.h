@@ -38,10 +38,12 @@ typedef struct Shizu_Gc Shizu_Gc;
 /// This function may invoke Shizu_State1_(push|pop)JumpTarget, Shizu_State1_(jump|setStatus|getStatus) Shizu_State1 is required.
 /// Only one Shizu_Stack object may exist in a process.
 /// @remarks This function requires the "gc" state to be available.
+/// The lock counts are stored in the side records of the objects (see Shizu_ObjectRecord) and the "gc" state visits the locked objects.
 Shizu_Locks*
 Shizu_Locks_create
   ( 
-    Shizu_State1* state1
+    Shizu_State1* state1,
+    Shizu_Gc* gc
   );
 
 /// @since 1.0
@@ -55,6 +57,8 @@ Shizu_Locks_destroy
     Shizu_Locks* self
   );
 
+/// @since 1.0
+/// @brief Get the number of locked objects.
 size_t
 Shizu_Locks_getSize
   (
@@ -62,24 +66,4 @@ Shizu_Locks_getSize
     Shizu_Locks* self
   );
 
-/// @since 1.0
-/// @brief Invoked to notify the "locks" module to perform pre-marking.
-/// @param state1 A pointer to the Shizu_State1 object. 
-void
-Shizu_Locks_notifyPreMark
-  (
-    Shizu_State1* state1,
-    Shizu_Gc* gc,
-    Shizu_Locks* self
-  );
-
-void
-Shizu_Locks_notifyObjectFinalize
-  (
-    Shizu_State1* state1,
-    Shizu_Gc* gc,
-    Shizu_Locks* self,
-    Shizu_Object* object
-  );
-
 #endif // SHIZU_RUNTIME_LOCKS_PRIVATE_H_INCLUDED
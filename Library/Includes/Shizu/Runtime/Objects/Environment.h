@@ -264,4 +264,56 @@ Shizu_Environment_isDefined
     Shizu_String* name
   );
 
+/// @since 1.0
+/// @brief Get the slot of a variable in this environment.
+/// @param state A pointer to a Shizu_State2 value.
+/// @param self A pointer to this Shizu_Environment value.
+/// @param name The name of the variable.
+/// @return The slot of the variable.
+/// @remarks
+/// The slot of a variable does not change as variables are never removed from an environment.
+/// Repeated accesses to a variable can hence look up its slot once and use Shizu_Environment_getAt and Shizu_Environment_setAt.
+/// @error The variable is not defined in this environment.
+/// @undefined @a state does not point to a Shizu_State value.
+Shizu_Integer32
+Shizu_Environment_getSlot
+  (
+    Shizu_State2* state,
+    Shizu_Environment* self,
+    Shizu_String* name
+  );
+
+/// @since 1.0
+/// @brief Get the value of the variable of the specified slot in this environment.
+/// @param state A pointer to a Shizu_State2 value.
+/// @param self A pointer to this Shizu_Environment value.
+/// @param slot The slot of the variable as returned by Shizu_Environment_getSlot for this environment.
+/// @return The value of the variable.
+/// @error Shizu_Status_ArgumentOutOfRange @a slot is not a slot of this environment.
+/// @undefined @a state does not point to a Shizu_State value.
+Shizu_Value
+Shizu_Environment_getAt
+  (
+    Shizu_State2* state,
+    Shizu_Environment* self,
+    Shizu_Integer32 slot
+  );
+
+/// @since 1.0
+/// @brief Assign the variable of the specified slot in this environment.
+/// @param state A pointer to a Shizu_State2 value.
+/// @param self A pointer to this Shizu_Environment value.
+/// @param slot The slot of the variable as returned by Shizu_Environment_getSlot for this environment.
+/// @param value The value.
+/// @error Shizu_Status_ArgumentOutOfRange @a slot is not a slot of this environment.
+/// @undefined @a state does not point to a Shizu_State value.
+void
+Shizu_Environment_setAt
+  (
+    Shizu_State2* state,
+    Shizu_Environment* self,
+    Shizu_Integer32 slot,
+    Shizu_Value* value
+  );
+
 #endif // SHIZU_OBJECTS_ENVIRONMENT_H_INCLUDED
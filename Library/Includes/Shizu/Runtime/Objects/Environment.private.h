@@ -29,13 +29,12 @@
 
 /**
  * @since 0.1
- * @brief A node in an environment.
+ * @brief A variable in an environment.
  * @unmanaged
  */
-typedef struct Shizu_Environment_Node Shizu_Environment_Node;
+typedef struct Shizu_Environment_Variable Shizu_Environment_Variable;
 
-struct Shizu_Environment_Node {
-  Shizu_Environment_Node* next;
+struct Shizu_Environment_Variable {
   Shizu_String* name;
   Shizu_Value value;
 };
@@ -44,10 +43,25 @@ struct Shizu_Environment_Dispatch {
   Shizu_Object_Dispatch _parent;
 };
 
+/// The variables are stored in an array in the order of their definition.
+/// As variables are never removed, the index of a variable (its slot) never changes.
+/// The variables are found by an open addressing index of groups of 8 control bytes and variable indices.
+/// A control byte is either 0x80 if its slot of the index is empty or 7 bits of the hash value of the name of the variable.
+/// The control bytes of a group are compared at once, as a 64 bit word, to find the candidate slots.
 struct Shizu_Environment {
   Shizu_Object _parent;
-  Shizu_Environment_Node** buckets;
+  /// The variables.
+  Shizu_Environment_Variable* variables;
+  /// The number of variables.
   size_t size;
+  /// The capacity of the variables array.
+  size_t variablesCapacity;
+  /// The variable indices of the slots of the index (also the start of the allocation of the index).
+  uint32_t* indices;
+  /// The control bytes of the slots of the index.
+  uint8_t* controls;
+  /// The number of slots of the index. A power of two and a multiple of 8.
+  /// The number of variables does not exceed 3/4 of this.
   size_t capacity;
 };
 
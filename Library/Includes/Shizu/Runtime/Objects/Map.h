@@ -98,4 +98,67 @@ Shizu_Map_get
     Shizu_Value* key
   );
 
+/// @since 1.0
+/// @brief Remove a pair from this map.
+/// @param state A pointer to the Shizu_State2 object.
+/// @param self A pointer to this Shizu_Map object.
+/// @param key A pointer to the key value.
+/// @remarks
+/// If <code>*key</code> stores a Void value or no pair for the key was found, then this call immediatly returns.
+/// Otherwise the pair is removed from this map.
+void
+Shizu_Map_remove
+  (
+    Shizu_State2* state,
+    Shizu_Map* self,
+    Shizu_Value* key
+  );
+
+/// @since 1.0
+/// @brief Ensure this map can store a number of pairs without growing.
+/// @param state A pointer to the Shizu_State2 object.
+/// @param self A pointer to this Shizu_Map object.
+/// @param numberOfPairs The number of pairs.
+/// @error Shizu_Status_ArgumentOutOfRange @a numberOfPairs is negative.
+/// @error Shizu_Status_AllocationFailed An allocation failed.
+void
+Shizu_Map_reserve
+  (
+    Shizu_State2* state,
+    Shizu_Map* self,
+    Shizu_Integer32 numberOfPairs
+  );
+
+/// @since 1.0
+/// @brief Reduce the capacity of this map to the smallest capacity that can store its pairs.
+/// @param state A pointer to the Shizu_State2 object.
+/// @param self A pointer to this Shizu_Map object.
+/// @error Shizu_Status_AllocationFailed An allocation failed.
+void
+Shizu_Map_shrinkToFit
+  (
+    Shizu_State2* state,
+    Shizu_Map* self
+  );
+
+/// @since 1.0
+/// @brief Get the next pair of an iteration over the pairs of this map.
+/// @param state A pointer to the Shizu_State2 object.
+/// @param self A pointer to this Shizu_Map object.
+/// @param iterator A pointer to the iterator. The iterator must be 0 for the first call of an iteration.
+/// @param key A pointer to a Shizu_Value object receiving the key of the pair.
+/// @param value A pointer to a Shizu_Value object receiving the value of the pair.
+/// @return @a true if a pair was stored and the iterator was advanced. @a false if there are no more pairs.
+/// @remarks The pairs are visited in an unspecified order. This map must not be modified during an iteration.
+/// @error Shizu_Status_ArgumentOutOfRange <code>*iterator</code> is negative.
+bool
+Shizu_Map_iterate
+  (
+    Shizu_State2* state,
+    Shizu_Map* self,
+    Shizu_Integer32* iterator,
+    Shizu_Value* key,
+    Shizu_Value* value
+  );
+
 #endif // SHIZU_OBJECTS_MAP_H_INCLUDED
@@ -29,27 +29,49 @@
 
 /**
  * @since 0.1
- * @brief A node of a map.
+ * @brief The control of a slot of a map.
  * @unmanaged
  */
-typedef struct Shizu_Map_Node Shizu_Map_Node;
+typedef struct Shizu_Map_Control Shizu_Map_Control;
 
-struct Shizu_Map_Node {
-  Shizu_Map_Node* next;
+struct Shizu_Map_Control {
+  /// 0 if the slot is empty.
+  /// Otherwise one plus the distance of the slot from the home slot of its key.
+  uint32_t distance;
+  /// The hash value of the key if the slot is not empty.
+  Shizu_Integer32 hashValue;
+};
+
+/**
+ * @since 0.1
+ * @brief A slot of a map.
+ * @unmanaged
+ */
+typedef struct Shizu_Map_Slot Shizu_Map_Slot;
+
+struct Shizu_Map_Slot {
   Shizu_Value key;
   Shizu_Value value;
-  Shizu_Integer32 hashValue;
 };
 
 struct Shizu_Map_Dispatch {
   Shizu_Object_Dispatch _parent;
 };
 
+/// The map is an open addressing hash table with linear probing and Robin Hood insertion.
+/// The controls and the pairs of the slots are stored in parallel arrays in a single allocation
+/// such that probing only reads the controls and reads a pair only if the hash values are equal.
+/// The capacity is a power of two and the load factor does not exceed 3/4.
 struct Shizu_Map {
   Shizu_Object _parent;
-  Shizu_Map_Node** buckets;
+  /// The pairs of the slots (also the start of the allocation).
+  Shizu_Map_Slot* slots;
+  /// The controls of the slots.
+  Shizu_Map_Control* controls;
   size_t size;
   size_t capacity;
+  /// 32 minus the binary logarithm of the capacity.
+  uint32_t shift;
 };
 
 #endif // SHIZU_OBJECTS_MAP_PRIVATE_H_INCLUDED
@@ -53,6 +53,9 @@ Shizu_String_create
 /// @param self A pointer to this Shizu_String value.
 /// @param other A pointer to another Shizu_String value.
 /// @return The string representing the concatenation of the this Shizu_String value (the prefix) with the other Shizu_String value (the suffix).
+/// @remarks The hash value of the string is derived from the hash values of the operands.
+/// If ropes are enabled (Shizu_Configuration_WithStringRopes), the Bytes of long concatenations are not copied until they are accessed.
+/// To build a string from many parts, use Shizu_StringBuilder.
 Shizu_String*
 Shizu_String_concatenate
   (
@@ -61,6 +64,58 @@ Shizu_String_concatenate
     Shizu_String* other
   );
 
+/// @since 1.0
+/// @brief Get the interned Shizu_String value of the specified sequence of Bytes.
+/// If no interned Shizu_String value of that sequence of Bytes exists, it is created.
+/// @param state A pointer to a Shizu_State2 value.
+/// @param bytes A pointer to an array of @a numberOfBytes bytes.
+/// @param numberOfBytes The number of Bytes in the array pointed to by @a bytes.
+/// @return A pointer to the interned Shizu_String value.
+/// @undefined state does not point to a Shizu_State value.
+/// @undefined bytes does not point to an array of @a numberOfBytes Bytes.
+/// @remarks
+/// No Shizu_String value is allocated if an interned Shizu_String value of that sequence of Bytes exists.
+/// Interned Shizu_String values are equal if and only if they are identical.
+/// The intern table does not keep the interned Shizu_String values alive.
+Shizu_String*
+Shizu_String_createInterned
+  (
+    Shizu_State2* state,
+    char const* bytes,
+    size_t numberOfBytes
+  );
+
+/// @since 1.0
+/// @brief Get the interned Shizu_String value equal to this Shizu_String value.
+/// If no such interned Shizu_String value exists, then this Shizu_String value is interned.
+/// @param state A pointer to a Shizu_State2 value.
+/// @param self A pointer to this Shizu_String value.
+/// @return A pointer to the interned Shizu_String value.
+Shizu_String*
+Shizu_String_intern
+  (
+    Shizu_State2* state,
+    Shizu_String* self
+  );
+
+/// @since 1.0
+/// @brief Get if this Shizu_String value is interned.
+/// @param state A pointer to a Shizu_State2 value.
+/// @param self A pointer to this Shizu_String value.
+/// @return @a true if this Shizu_String value is interned. @a false otherwise.
+Shizu_Boolean
+Shizu_String_isInterned
+  (
+    Shizu_State2* state,
+    Shizu_String* self
+  );
+
+/// @since 1.0
+/// @brief Get the Bytes of this Shizu_String value.
+/// @param state A pointer to a Shizu_State2 value.
+/// @param self A pointer to this Shizu_String value.
+/// @return A pointer to the Bytes. The pointer is valid as long as this Shizu_String value exists.
+/// @error This Shizu_String value is a rope and its Bytes could not be copied into a single array.
 char const*
 Shizu_String_getBytes
   (
@@ -26,17 +26,103 @@
   #error("Do not include `Shizu/Runtime/Objects/String.private.h` directly. Include `Shizu/Runtime/Include.h` instead.")
 #endif
 #include "Shizu/Runtime/Objects/String.h"
+typedef struct Shizu_Gc Shizu_Gc;
+typedef struct Shizu_Strings Shizu_Strings;
 
 struct Shizu_String_Dispatch {
   Shizu_Object_Dispatch _parent;
 };
 
+/// @since 1.0
+/// @brief The maximum number of Bytes of a string stored in the object of the string.
+/// The Bytes of longer strings are stored in a separate allocation.
+/// @remarks A string of this number of Bytes and the compact header of the GC fit into 64 Bytes on 64 bit platforms.
+#define Shizu_String_MaximumInlineNumberOfBytes (15)
+
+#if 1 == Shizu_Configuration_WithStringRopes
+/// @since 1.0
+/// @brief The minimum number of Bytes of a concatenation represented as a rope by Shizu_String_concatenate.
+/// Shorter concatenations are copied immediately.
+#define Shizu_String_MinimumRopeNumberOfBytes (256)
+#endif
+
 struct Shizu_String {
   Shizu_Object _parent;
+  /// @brief A pointer to the next string in the bucket of the intern table if this string is interned.
   Shizu_String* next;
+  /// @brief The polynomial hash value of the Bytes b[0], ..., b[n-1] of this string, b[0] * 37^(n-1) + ... + b[n-1] * 37^0.
+  /// The hash value of a concatenation is derived from the hash values of its operands (see Shizu_String_concatenate).
   size_t hashValue;
   size_t numberOfBytes;
+  /// @brief A pointer to the Bytes of this string.
+  /// Points to inlineBytes if numberOfBytes is at most Shizu_String_MaximumInlineNumberOfBytes.
+  /// The null pointer if this string is a rope.
   char *bytes;
+#if 1 == Shizu_Configuration_WithStringRopes
+  /// @brief If this string is a rope, pointers to the strings it is the concatenation of. The null pointers otherwise.
+  /// A rope is flattened (its Bytes are copied into a single array and these pointers are cleared) on the first access to its Bytes.
+  Shizu_String* left;
+  Shizu_String* right;
+#endif
+  /// @brief @a true if this string is in the intern table.
+  /// Two different interned strings are not equal.
+  bool interned;
+  /// @brief The Bytes of this string if numberOfBytes is at most Shizu_String_MaximumInlineNumberOfBytes.
+  /// The object of such a string is allocated with room for exactly numberOfBytes Bytes (see Shizu_String_getObjectSize).
+  char inlineBytes[];
 };
 
+/// @since 1.0
+/// @brief Get the size, in Bytes, of the object of a string of the specified number of Bytes.
+/// @param numberOfBytes The number of Bytes of the string.
+/// @return The size, in Bytes, of the object.
+static inline size_t
+Shizu_String_getObjectSize
+  (
+    size_t numberOfBytes
+  )
+{
+  if (numberOfBytes <= Shizu_String_MaximumInlineNumberOfBytes) {
+    return offsetof(Shizu_String, inlineBytes) + numberOfBytes;
+  } else {
+    return sizeof(Shizu_String);
+  }
+}
+
+/// @since 1.0
+/// Startup the "strings" state.
+/// Called by Shizu_State2_create/Shizu_State2_destroy.
+/// Shutdown the "strings" state by calling Shizu_Strings_destroy.
+/// This function may invoke Shizu_State1_(push|pop)JumpTarget, Shizu_State1_(jump|setStatus|getStatus) Shizu_State1 is required.
+/// Only one Shizu_Strings object may exist in a process.
+/// @remarks The "strings" state stores the intern table.
+/// The intern table does not keep its strings alive: It is not visited by the GC and the strings not marked by a collection are removed from it.
+Shizu_Strings*
+Shizu_Strings_create
+  (
+    Shizu_State1* state
+  );
+
+/// @since 1.0
+/// Shutdown the "strings" state.
+/// This function may only return via regular control flow and not via jump control flow.
+void
+Shizu_Strings_destroy
+  (
+    Shizu_State1* state,
+    Shizu_Strings* self
+  );
+
+/// @since 1.0
+/// Invoked by the "gc" state if marking is complete and before the sweep begins.
+/// Removes the strings which are colored white from the intern table.
+/// @param self A pointer to the "strings" state or the null pointer if that state does not exist.
+void
+Shizu_Strings_notifyMarkComplete
+  (
+    Shizu_State1* state1,
+    Shizu_Gc* gc,
+    Shizu_Strings* self
+  );
+
 #endif // SHIZU_OBJECTS_STRING_PRIVATE_H_INCLUDED
@@ -0,0 +1,119 @@
+/*
+  Shizu
+  Copyright (C) 2024 Michael Heilmann. All rights reserved.
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+#if !defined(SHIZU_OBJECTS_STRINGBUILDER_H_INCLUDED)
+#define SHIZU_OBJECTS_STRINGBUILDER_H_INCLUDED
+
+#if !defined(SHIZU_RUNTIME_PRIVATE) && 1 != SHIZU_RUNTIME_PRIVATE
+  #error("Do not include `Shizu/Runtime/Objects/StringBuilder.h` directly. Include `Shizu/Runtime/Include.h` instead.")
+#endif
+#include "Shizu/Runtime/Objects/String.h"
+
+/// @brief
+/// The Machine Language type is
+/// @code
+/// class Shizu.StringBuilder
+/// @endcode
+/// @remarks
+/// Shizu_StringBuilder is used to build a Shizu_String value from many parts.
+/// The Bytes of the parts are appended to a buffer growing geometrically such that appending is amortized constant time per Byte.
+/// The Bytes are copied into a Shizu_String value only when Shizu_StringBuilder_toString is invoked.
+Shizu_declareObjectType(Shizu_StringBuilder);
+
+/// @since 1.0
+/// @brief Create a Shizu_StringBuilder value.
+/// @param state A pointer to a Shizu_State2 value.
+/// @return A pointer to the Shizu_StringBuilder value. The Shizu_StringBuilder value is empty.
+/// @undefined state does not point to a Shizu_State value.
+Shizu_StringBuilder*
+Shizu_StringBuilder_create
+  (
+    Shizu_State2* state
+  );
+
+/// @since 1.0
+/// @brief Append Bytes to this Shizu_StringBuilder value.
+/// @param state A pointer to a Shizu_State2 value.
+/// @param self A pointer to this Shizu_StringBuilder value.
+/// @param bytes A pointer to an array of @a numberOfBytes bytes.
+/// @param numberOfBytes The number of Bytes in the array pointed to by @a bytes.
+/// @error The buffer of this Shizu_StringBuilder value could not be grown.
+void
+Shizu_StringBuilder_appendBytes
+  (
+    Shizu_State2* state,
+    Shizu_StringBuilder* self,
+    char const* bytes,
+    size_t numberOfBytes
+  );
+
+/// @since 1.0
+/// @brief Append the Bytes of a Shizu_String value to this Shizu_StringBuilder value.
+/// @param state A pointer to a Shizu_State2 value.
+/// @param self A pointer to this Shizu_StringBuilder value.
+/// @param string A pointer to the Shizu_String value.
+/// @error The buffer of this Shizu_StringBuilder value could not be grown.
+void
+Shizu_StringBuilder_appendString
+  (
+    Shizu_State2* state,
+    Shizu_StringBuilder* self,
+    Shizu_String* string
+  );
+
+/// @since 1.0
+/// @brief Get the number of Bytes appended to this Shizu_StringBuilder value.
+/// @param state A pointer to a Shizu_State2 value.
+/// @param self A pointer to this Shizu_StringBuilder value.
+/// @return The number of Bytes.
+size_t
+Shizu_StringBuilder_getNumberOfBytes
+  (
+    Shizu_State2* state,
+    Shizu_StringBuilder* self
+  );
+
+/// @since 1.0
+/// @brief Remove all Bytes from this Shizu_StringBuilder value.
+/// The buffer of this Shizu_StringBuilder value is retained for subsequent appends.
+/// @param state A pointer to a Shizu_State2 value.
+/// @param self A pointer to this Shizu_StringBuilder value.
+void
+Shizu_StringBuilder_clear
+  (
+    Shizu_State2* state,
+    Shizu_StringBuilder* self
+  );
+
+/// @since 1.0
+/// @brief Create a Shizu_String value of the Bytes appended to this Shizu_StringBuilder value.
+/// @param state A pointer to a Shizu_State2 value.
+/// @param self A pointer to this Shizu_StringBuilder value.
+/// @return A pointer to the Shizu_String value.
+/// @remarks This Shizu_StringBuilder value is not modified.
+Shizu_String*
+Shizu_StringBuilder_toString
+  (
+    Shizu_State2* state,
+    Shizu_StringBuilder* self
+  );
+
+#endif // SHIZU_OBJECTS_STRINGBUILDER_H_INCLUDED
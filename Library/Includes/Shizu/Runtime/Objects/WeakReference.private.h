@@ -27,6 +27,7 @@
 #endif
 #include "Shizu/Runtime/Objects/WeakReference.h"
 typedef struct Shizu_Gc Shizu_Gc;
+typedef struct Shizu_ObjectRecord Shizu_ObjectRecord;
 
 /// @since 1.0
 /// Startup the "weak references" state.
@@ -51,13 +52,18 @@ Shizu_WeakReferences_destroy
     Shizu_WeakReferences* self
   );
 
+/// @since 1.0
+/// Invoked by the "gc" state if an object referenced by weak references is finalized.
+/// Sets the references of the weak references to null and removes them from the side record of the object.
+/// @param self A pointer to the "weak references" state or the null pointer if that state was shut down.
+/// @param record A pointer to the side record of the object.
 void
 Shizu_WeakReferenceState_notifyObjectFinalize
   (
     Shizu_State1* state1,
     Shizu_Gc* gc,
     Shizu_WeakReferences* self,
-    Shizu_Object* reference
+    Shizu_ObjectRecord* record
   );
 
 #endif // SHIZU_OBJECTS_WEAKREFERENCE_PRIVATE_H_INCLUDED
@@ -55,10 +55,19 @@ Shizu_Stack_destroy
   );
 
 /// @since 1.0
-/// @brief Invoked to notify the "stack" module to perform pre-marking.
-/// @param state A pointer to a Shizu_State2 value. 
+/// @brief Register the elements of the "stack" module as a root range of the "gc" module (see Shizu_Gc_addRootRange).
+void
+Shizu_Stack_addRootRange
+  (
+    Shizu_State1* state1,
+    Shizu_Gc* gc,
+    Shizu_Stack* self
+  );
+
+/// @since 1.0
+/// @brief Unregister the elements of the "stack" module as a root range of the "gc" module (see Shizu_Gc_removeRootRange).
 void
-Shizu_Stack_notifyPreMark
+Shizu_Stack_removeRootRange
   (
     Shizu_State1* state1,
     Shizu_Gc* gc,
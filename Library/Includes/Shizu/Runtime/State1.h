@@ -364,4 +364,58 @@ Shizu_State1_getNamedStorage
     void** p
   );
 
+/**
+ * @brief A handle to named memory.
+ * @details
+ * A handle is resolved once by Shizu_State1_getNamedStorageHandle (for example, by the "post create type" callback of a type).
+ * Afterwards, the named memory is accessed by Shizu_NamedStorageHandle_get which neither locks nor looks up the name.
+ * The handle must be invalidated by Shizu_NamedStorageHandle_invalidate when the named memory is deallocated.
+ */
+typedef struct Shizu_NamedStorageHandle {
+  void* p;
+} Shizu_NamedStorageHandle;
+
+/**
+ * @brief Initializer for an invalid Shizu_NamedStorageHandle value.
+ */
+#define Shizu_NamedStorageHandle_Initializer { .p = NULL }
+
+/**
+ * @brief Get a handle to named memory.
+ * @param name The name of the named memory.
+ * @param handle A pointer to a Shizu_NamedStorageHandle value.
+ * @return A zero value on success. A non-zero value on failure.
+ * @success <code>*handle</code> was assigned a handle to the storage.
+ */
+int
+Shizu_State1_getNamedStorageHandle
+  (
+    Shizu_State1* state1,
+    char const* name,
+    Shizu_NamedStorageHandle* handle
+  );
+
+/**
+ * @brief Get the named memory of a handle.
+ * @param handle A pointer to the Shizu_NamedStorageHandle value.
+ * @return A pointer to the storage. The null pointer if the handle is invalid.
+ */
+static inline void*
+Shizu_NamedStorageHandle_get
+  (
+    Shizu_NamedStorageHandle const* handle
+  )
+{ return handle->p; }
+
+/**
+ * @brief Invalidate a handle to named memory.
+ * @param handle A pointer to the Shizu_NamedStorageHandle value.
+ */
+static inline void
+Shizu_NamedStorageHandle_invalidate
+  (
+    Shizu_NamedStorageHandle* handle
+  )
+{ handle->p = NULL; }
+
 #endif // SHIZU_STATE1_H_INCLUDED
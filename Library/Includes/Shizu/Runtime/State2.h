@@ -33,6 +33,7 @@ typedef struct Shizu_Type Shizu_Type;
 typedef struct Shizu_WeakReference Shizu_WeakReference;
 
 typedef struct Shizu_WeakReferences Shizu_WeakReferences;
+typedef struct Shizu_Strings Shizu_Strings;
 typedef struct Shizu_Gc Shizu_Gc;
 typedef struct Shizu_Locks Shizu_Locks;
 typedef struct Shizu_Stack Shizu_Stack;
@@ -209,6 +210,19 @@ Shizu_State2_getWeakReferences
     Shizu_State2* self
   );
 
+/**
+ * @since 1.0
+ * @brief Get the "strings" state component.
+ * @param self A pointer to this state.
+ * @return A pointer to the "strings" state component.
+ * The null pointer if the "strings" component does not exist.
+ */
+Shizu_Strings*
+Shizu_State2_getStrings
+  (
+    Shizu_State2* self
+  );
+
 Shizu_Environment*
 Shizu_State2_getGlobalEnvironment
   (
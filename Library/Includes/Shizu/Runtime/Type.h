@@ -26,7 +26,7 @@
 #include "Shizu/Cxx/Include.h"
 #include "Shizu/Runtime/Value.h"
 
-// size_t
+// size_t, offsetof
 #include <stddef.h>
 // strlen
 #include <string.h>
@@ -98,6 +98,33 @@ typedef void (Shizu_OnDispatchInitializeCallback)(Shizu_State1* state1, void*);
 /// The type of a "onStaticUninitialize" callback function.
 typedef void (Shizu_OnDispatchUninitializeCallback)(Shizu_State1* state1, void*);
 
+/// @since 1.0
+/// @brief The kind of a reference field of type `Shizu_Object*` (or a pointer to an object of a type derived from `Shizu_Object`).
+/// The value of the field may be the null pointer.
+#define Shizu_ObjectTypeFieldKind_Object (1)
+
+/// @since 1.0
+/// @brief The kind of a reference field of type `Shizu_Value`.
+#define Shizu_ObjectTypeFieldKind_Value (2)
+
+/// @since 1.0
+/// @brief A reference field of the objects of a type.
+/// The GC visits the fields described by an object type (see Shizu_ObjectTypeDescriptor.fields) without invoking a visit callback.
+typedef struct Shizu_ObjectTypeField {
+  /// @brief The kind of the field (Shizu_ObjectTypeFieldKind_Object or Shizu_ObjectTypeFieldKind_Value).
+  uint8_t kind;
+  /// @brief The offset, in Bytes, of the field from the beginning of the object.
+  size_t offset;
+} Shizu_ObjectTypeField;
+
+/// @since 1.0
+/// @brief Initializer of a Shizu_ObjectTypeField describing the field @a FieldName of kind Shizu_ObjectTypeFieldKind_Object of the C type @a CxxName.
+#define Shizu_ObjectTypeField_Object(CxxName, FieldName) { .kind = Shizu_ObjectTypeFieldKind_Object, .offset = offsetof(CxxName, FieldName) }
+
+/// @since 1.0
+/// @brief Initializer of a Shizu_ObjectTypeField describing the field @a FieldName of kind Shizu_ObjectTypeFieldKind_Value of the C type @a CxxName.
+#define Shizu_ObjectTypeField_Value(CxxName, FieldName) { .kind = Shizu_ObjectTypeFieldKind_Value, .offset = offsetof(CxxName, FieldName) }
+
 struct Shizu_ObjectTypeDescriptor {
   Shizu_PostCreateTypeCallback* postCreateType;
   Shizu_PreDestroyTypeCallback* preDestroyType;
@@ -107,6 +134,12 @@ struct Shizu_ObjectTypeDescriptor {
   Shizu_OnConstructCallback* construct;
   Shizu_OnVisitCallback* visit;
   Shizu_OnFinalizeCallback* finalize;
+  /// A pointer to an array of @a numberOfFields Shizu_ObjectTypeField objects or the null pointer if @a numberOfFields is 0.
+  /// The reference fields of the objects of this type not including the reference fields of the objects of the parent type.
+  /// The GC visits these fields without invoking @a visit.
+  /// @a visit is only required for references not stored in such fields (for example, references stored in arrays).
+  Shizu_ObjectTypeField const* fields;
+  size_t numberOfFields;
 
   size_t dispatchSize;
   Shizu_OnDispatchInitializeCallback *dispatchInitialize;
@@ -206,6 +239,73 @@ Shizu_Types_getTypeHash
     Shizu_Type* x
   );
 
+/// @since
+/// 1.0
+/// @remarks
+/// Stable interface.
+/// @brief
+/// Get the ID of a type.
+/// @details
+/// The ID of a type is a small integer which does not change during the lifetime of the type.
+/// Types existing at the same time have different IDs, the IDs of destroyed types are reused.
+/// The IDs are less than Shizu_Types_getTypeIdBound such that they can be used as array indices.
+/// @param state
+/// A pointer to a Shizu_State1 object.
+/// @param self
+/// A pointer to the Shizu_Types object.
+/// @param x
+/// A pointer to the type.
+/// @return
+/// The ID of the type.
+size_t
+Shizu_Types_getTypeId
+  (
+    Shizu_State1* state,
+    Shizu_Types* self,
+    Shizu_Type* x
+  );
+
+/// @since
+/// 1.0
+/// @remarks
+/// Stable interface.
+/// @brief
+/// Get the bound of the IDs of the types.
+/// @param state
+/// A pointer to a Shizu_State1 object.
+/// @param self
+/// A pointer to the Shizu_Types object.
+/// @return
+/// A value greater than the IDs of all existing types.
+size_t
+Shizu_Types_getTypeIdBound
+  (
+    Shizu_State1* state,
+    Shizu_Types* self
+  );
+
+/// @since
+/// 1.0
+/// @remarks
+/// Stable interface.
+/// @brief
+/// Get a type by its ID.
+/// @param state
+/// A pointer to a Shizu_State1 object.
+/// @param self
+/// A pointer to the Shizu_Types object.
+/// @param id
+/// The ID.
+/// @return
+/// A pointer to the type of the ID if it exists. The null pointer otherwise.
+Shizu_Type*
+Shizu_Types_getTypeById
+  (
+    Shizu_State1* state,
+    Shizu_Types* self,
+    size_t id
+  );
+
 /// @since 1.0
 /// @remarks Stable interface.
 /// @brief
@@ -378,7 +478,12 @@ Shizu_Types_getDispatch
 /// The DL a type is created by must not be unloaded as long as the type exists.
 /// For a type T defined in a DL we store in T.dl a reference to the DL in the type object.
 /// If T is defined in the executable we store in T.dl the null reference.
+/// The type returned by CxxName_getType (created by it or found by its name) is cached such that subsequent calls do not look up the type by its name.
+/// The cache is cleared when the type is destroyed (by the "type destroyed" callback).
+/// Hence a type name must be defined by at most one Shizu_defineObjectType such that the callback of that definition is invoked.
 #define Shizu_defineObjectType(MlName, CxxName, ParentName) \
+  static Shizu_Type* CxxName##_cachedType = NULL; \
+  \
   static void \
   CxxName##_typeDestroyed \
     ( \
@@ -390,7 +495,7 @@ Shizu_Types_getDispatch
     ( \
       Shizu_State1* state1 \
     ) \
-  {/*Intentionally empty.*/} \
+  { CxxName##_cachedType = NULL; } \
   \
   Shizu_Type* \
   CxxName##_getType \
@@ -398,6 +503,9 @@ Shizu_Types_getDispatch
       Shizu_State2* state \
     ) \
   { \
+    if (CxxName##_cachedType) { \
+      return CxxName##_cachedType; \
+    } \
     size_t n = strlen(MlName); \
     if (n > Shizu_Integer32_Maximum) { \
       Shizu_State2_setStatus(state, Shizu_Status_ArgumentValueInvalid); \
@@ -411,6 +519,7 @@ Shizu_Types_getDispatch
         Shizu_State1_unrefDl(Shizu_State2_getState1(state), dl); \
       } \
     } \
+    CxxName##_cachedType = type; \
     return type; \
   }
 
@@ -425,7 +534,10 @@ Shizu_Types_getDispatch
 /// The DL a type is created by must not be unloaded as long as the type exists.
 /// For a type T defined in a DL we store in T.dl a reference to the DL in the type object.
 /// If T is defined in the executable we store in T.dl the null reference.
+/// The type created by Name_getType is cached as described for Shizu_defineObjectType.
 #define Shizu_definePrimitiveType(Name) \
+  static Shizu_Type* Name##_cachedType = NULL; \
+  \
   static void \
   Name##_typeDestroyed \
     ( \
@@ -437,7 +549,7 @@ Shizu_Types_getDispatch
     ( \
       Shizu_State1* state1 \
     ) \
-  {/*Intentionally empty.*/} \
+  { Name##_cachedType = NULL; } \
   \
   Shizu_Type* \
   Name##_getType \
@@ -445,6 +557,9 @@ Shizu_Types_getDispatch
       Shizu_State2* state \
     ) \
   { \
+    if (Name##_cachedType) { \
+      return Name##_cachedType; \
+    } \
     Shizu_Type* type = Shizu_Types_getTypeByName(Shizu_State2_getState1(state), Shizu_State2_getTypes(state), #Name, sizeof(#Name) - 1); \
     if (!type) { \
       Shizu_Dl* dl = Shizu_State1_getDlByAdr(Shizu_State2_getState1(state), &Name##_getType); \
@@ -453,6 +568,7 @@ Shizu_Types_getDispatch
         Shizu_State1_unrefDl(Shizu_State2_getState1(state), dl); \
       } \
     } \
+    Name##_cachedType = type; \
     return type; \
   }
 
@@ -61,6 +61,12 @@ typedef struct Shizu_PrimitiveTypeNode {
   Shizu_PrimitiveTypeDescriptor const* descriptor;
 } Shizu_PrimitiveTypeNode;
 
+// A non-null finalize callback of a type and that type.
+typedef struct Shizu_ObjectTypeFinalizer {
+  Shizu_Type* type;
+  Shizu_OnFinalizeCallback* finalize;
+} Shizu_ObjectTypeFinalizer;
+
 typedef struct Shizu_ObjectTypeNode {
   // Pointer to the type descriptor.
   Shizu_ObjectTypeDescriptor const* descriptor;
@@ -69,20 +75,56 @@ typedef struct Shizu_ObjectTypeNode {
   Shizu_Object_Dispatch* dispatch;
   // The parent type of this type (null only for the "Object" type).
   Shizu_Type* parentType;
+  // The number of ancestor types of this type (0 only for the "Object" type).
+  size_t depth;
+  // The array of depth + 1 pointers to the ancestor types of this type and this type.
+  // The element at index i is the ancestor type of depth i, the element at index depth is this type.
+  // Computed when this type is created such that a sub-type test is a single comparison.
+  Shizu_Type** ancestors;
   // The array of pointers to child types of this type.
   SmallTypeArray children;
+  // The reference fields of this type and its ancestor types.
+  // Computed when this type is created such that the GC visits these fields in a loop without invoking a callback.
+  struct {
+    Shizu_ObjectTypeField* elements;
+    size_t size;
+  } fields;
+  // The non-null visit callbacks of this type and its ancestor types in the order from this type to the "Object" type.
+  // Computed when this type is created such that the GC does not walk the parent types for each visited object.
+  // If this array and the array of fields are empty, then the objects of this type do not reference other objects and the GC does not visit fields or invoke callbacks.
+  struct {
+    Shizu_OnVisitCallback** elements;
+    size_t size;
+  } visitors;
+  // The non-null finalize callbacks of this type and its ancestor types in the order from this type to the "Object" type.
+  // Computed when this type is created such that the GC does not walk the parent types for each finalized object.
+  struct {
+    Shizu_ObjectTypeFinalizer* elements;
+    size_t size;
+  } finalizers;
+  // The number of objects of this type finalized and their size, in Bytes.
+  // Reset by the first finalization after a collection began (see Shizu_Gc_TypeStatistics).
+  struct {
+    // The number of collections begun when the numbers were reset.
+    size_t collection;
+    size_t objects;
+    size_t bytes;
+  } freed;
 } Shizu_ObjectTypeNode;
 
 struct Shizu_Type {
-  Shizu_Type* next;
   // The flags of this type.
   uint8_t flags;
+  // The ID of this type (see Shizu_Types_getTypeId).
+  size_t id;
   // The name of this type.
   struct {
-    Shizu_Integer32 hashValue;
+    // The hash value of the name (see Shizu_Types_hashName).
+    size_t hashValue;
     // The number of Bytes including the zero terminator.
     Shizu_Integer32 numberOfBytes;
     // A pointer to an array of @a numberOfBytes containing a zero-terminated C string.
+    // The array is allocated along with this type and directly follows it.
     uint8_t* bytes;
   } name;
   // A pointer to the DL from which the type originates from or the null pointer.
@@ -97,12 +139,39 @@ struct Shizu_Type {
   };
 };
 
+// A slot of the hash table of the types.
+typedef struct Shizu_TypesSlot {
+  // The hash value of the name of the type.
+  size_t hashValue;
+  // A pointer to the type or the null pointer if this slot is free.
+  Shizu_Type* type;
+} Shizu_TypesSlot;
+
 struct Shizu_Types {
-  Shizu_Type** elements;
+  // The hash table of the types by their names.
+  // Open addressing with linear probing. The capacity is a power of two and the load factor is at most 3/4.
+  Shizu_TypesSlot* elements;
   size_t size;
   size_t capacity;
+  // The types by their IDs.
+  // The element at index i is the type of the ID i or the null pointer if no type has the ID i.
+  // The element at index size - 1 is not the null pointer.
+  struct {
+    Shizu_Type** elements;
+    size_t size;
+    size_t capacity;
+  } byId;
 };
 
+// Compute the hash value of a type name.
+// This function is used by all functions computing the hash value of a type name.
+size_t
+Shizu_Types_hashName
+  (
+    uint8_t const* bytes,
+    size_t numberOfBytes
+  );
+
 Shizu_Types*
 Shizu_Types_startup
   (
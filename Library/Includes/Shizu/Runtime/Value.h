@@ -236,8 +236,7 @@ typedef int32_t Shizu_Integer32;
 
 
 
-#if 1 == Shizu_Configuration_WithInteger64
-
+// The C type Shizu_Integer64 is also used by the runtime (e.g., for the properties of Float64) if Integer64 values are disabled.
 typedef int64_t Shizu_Integer64;
 
 // This is -9223372036854775807-1.
@@ -246,8 +245,6 @@ typedef int64_t Shizu_Integer64;
 // This is +9223372036854775807+0.
 #define Shizu_Integer64_Maximum (INT64_MAX)
 
-#endif
-
 
 
 typedef uint8_t Shizu_Void;
@@ -298,6 +295,39 @@ typedef struct Shizu_Value Shizu_Value;
 
 
 
+#if 1 == Shizu_Configuration_WithNanBoxing
+
+#if 1 == Shizu_Configuration_WithInteger64
+  #error("Shizu_Configuration_WithNanBoxing requires Shizu_Configuration_WithInteger64 to be 0")
+#endif
+
+/// A NaN-boxed value is a Float64 value or a quiet NaN with the sign bit set (Shizu_Value_NanBoxPrefix)
+/// which stores the tag of the value in bits 48 to 50 and its payload in bits 0 to 47.
+/// A Float64 value is stored as is unless it is a NaN in which case Shizu_Value_NanBoxCanonicalNan is stored.
+#define Shizu_Value_NanBoxPrefix (UINT64_C(0xFFF8000000000000))
+
+#define Shizu_Value_NanBoxTagShift (48)
+
+#define Shizu_Value_NanBoxTagMask (UINT64_C(0x7))
+
+#define Shizu_Value_NanBoxPayloadMask (UINT64_C(0x0000FFFFFFFFFFFF))
+
+#define Shizu_Value_NanBoxCanonicalNan (UINT64_C(0x7FF8000000000000))
+
+static_assert(Shizu_Value_Tag_Void <= Shizu_Value_NanBoxTagMask, "tags do not fit into the NaN box");
+
+/// Box a payload with a tag.
+#define Shizu_Value_NanBox(TAG, PAYLOAD) \
+  (Shizu_Value_NanBoxPrefix | ((uint64_t)(TAG) << Shizu_Value_NanBoxTagShift) | ((uint64_t)(PAYLOAD) & Shizu_Value_NanBoxPayloadMask))
+
+struct Shizu_Value {
+  uint64_t bits;
+};
+
+static_assert(sizeof(Shizu_Value) == 8, "NaN-boxed values must be 8 Bytes");
+
+#else
+
 struct Shizu_Value {
   uint8_t tag;
   union {
@@ -317,23 +347,53 @@ struct Shizu_Value {
   };
 };
 
+#endif
 
 
-#define Shizu_Value_InitializerBoolean(VALUE) { .tag = Shizu_Value_Tag_Boolean, .booleanValue = (VALUE) }
 
-Shizu_Boolean
+/// @since 1.0
+/// @brief The storage class of the accessors of Shizu_Value (the Shizu_Value_get*, Shizu_Value_is*, and Shizu_Value_set* functions).
+/// If Shizu_Configuration_WithInlineValueAccessors is 1, the accessors are static inline functions defined in "Shizu/Runtime/Value.inline.h".
+/// Otherwise they are exported functions.
+#if 1 == Shizu_Configuration_WithInlineValueAccessors
+  #define Shizu_Value_Accessor static inline
+#else
+  #define Shizu_Value_Accessor
+#endif
+
+
+
+/// @since 1.0
+/// @brief Get the tag of a value.
+/// @param self A pointer to the value.
+/// @return The tag of the value (one of the Shizu_Value_Tag_* constants).
+Shizu_Value_Accessor uint8_t
+Shizu_Value_getTag
+  (
+    Shizu_Value const* self
+  );
+
+
+
+#if 1 == Shizu_Configuration_WithNanBoxing
+  #define Shizu_Value_InitializerBoolean(VALUE) { .bits = Shizu_Value_NanBox(Shizu_Value_Tag_Boolean, (VALUE) ? 1 : 0) }
+#else
+  #define Shizu_Value_InitializerBoolean(VALUE) { .tag = Shizu_Value_Tag_Boolean, .booleanValue = (VALUE) }
+#endif
+
+Shizu_Value_Accessor Shizu_Boolean
 Shizu_Value_getBoolean
   (
     Shizu_Value const* self
   );
 
-bool
+Shizu_Value_Accessor bool
 Shizu_Value_isBoolean
   (
     Shizu_Value const* self
   );
 
-void
+Shizu_Value_Accessor void
 Shizu_Value_setBoolean
   (
     Shizu_Value* self,
@@ -342,44 +402,53 @@ Shizu_Value_setBoolean
 
 
 
-#define Shizu_Value_InitializerCxxFunction(VALUE) { .tag = Shizu_Value_Tag_CxxFunction, .cxxFunctionValue = (VALUE) }
+#if 1 == Shizu_Configuration_WithNanBoxing
+  #define Shizu_Value_InitializerCxxFunction(VALUE) { .bits = Shizu_Value_NanBox(Shizu_Value_Tag_CxxFunction, (uintptr_t)(VALUE)) }
+#else
+  #define Shizu_Value_InitializerCxxFunction(VALUE) { .tag = Shizu_Value_Tag_CxxFunction, .cxxFunctionValue = (VALUE) }
+#endif
 
-Shizu_CxxFunction*
+Shizu_Value_Accessor Shizu_CxxFunction*
 Shizu_Value_getCxxFunction
   (
     Shizu_Value const* self
   );
 
-bool
+Shizu_Value_Accessor bool
 Shizu_Value_isCxxFunction
   (
     Shizu_Value const* self
   );
 
-void
+Shizu_Value_Accessor void
 Shizu_Value_setCxxFunction
   (
     Shizu_Value* self,
     Shizu_CxxFunction* cxxFunctionValue
   );
 
-#define Shizu_Value_InitializerFloat32(VALUE) { .tag = Shizu_Value_Tag_Float32, .float32Value = (VALUE) }
+// Not a constant expression if Shizu_Configuration_WithNanBoxing is 1.
+#if 1 == Shizu_Configuration_WithNanBoxing
+  #define Shizu_Value_InitializerFloat32(VALUE) { .bits = Shizu_Value_NanBox(Shizu_Value_Tag_Float32, ((union { Shizu_Float32 f; uint32_t u; }){ .f = (VALUE) }).u) }
+#else
+  #define Shizu_Value_InitializerFloat32(VALUE) { .tag = Shizu_Value_Tag_Float32, .float32Value = (VALUE) }
+#endif
 
 
 
-Shizu_Float32
+Shizu_Value_Accessor Shizu_Float32
 Shizu_Value_getFloat32
   (
     Shizu_Value const* self
   );
 
-bool
+Shizu_Value_Accessor bool
 Shizu_Value_isFloat32
   (
     Shizu_Value const* self
   );
 
-void
+Shizu_Value_Accessor void
 Shizu_Value_setFloat32
   (
     Shizu_Value* self,
@@ -390,46 +459,55 @@ Shizu_Value_setFloat32
 
 #if 1 == Shizu_Configuration_WithFloat64
 
-#define Shizu_Value_InitializerFloat64(VALUE) { .tag = Shizu_Value_Tag_Float64, .floa64Value = (VALUE) }
+// Not a constant expression if Shizu_Configuration_WithNanBoxing is 1.
+#if 1 == Shizu_Configuration_WithNanBoxing
+  #define Shizu_Value_InitializerFloat64(VALUE) { .bits = (VALUE) != (VALUE) ? Shizu_Value_NanBoxCanonicalNan : ((union { Shizu_Float64 f; uint64_t u; }){ .f = (VALUE) }).u }
+#else
+  #define Shizu_Value_InitializerFloat64(VALUE) { .tag = Shizu_Value_Tag_Float64, .float64Value = (VALUE) }
+#endif
 
-Shizu_Float64
+Shizu_Value_Accessor Shizu_Float64
 Shizu_Value_getFloat64
   (
     Shizu_Value const* self
   );
 
-bool
+Shizu_Value_Accessor bool
 Shizu_Value_isFloat64
-(
-  Shizu_Value const* self
-);
+  (
+    Shizu_Value const* self
+  );
 
-void
+Shizu_Value_Accessor void
 Shizu_Value_setFloat64
-(
-  Shizu_Value* self,
-  Shizu_Float64 float64Value
-);
+  (
+    Shizu_Value* self,
+    Shizu_Float64 float64Value
+  );
 
 #endif
 
 
 
-#define Shizu_Value_InitializerInteger32(VALUE) { .tag = Shizu_Value_Tag_Integer32, .integer32Value = (VALUE) }
+#if 1 == Shizu_Configuration_WithNanBoxing
+  #define Shizu_Value_InitializerInteger32(VALUE) { .bits = Shizu_Value_NanBox(Shizu_Value_Tag_Integer32, (uint32_t)(VALUE)) }
+#else
+  #define Shizu_Value_InitializerInteger32(VALUE) { .tag = Shizu_Value_Tag_Integer32, .integer32Value = (VALUE) }
+#endif
 
-Shizu_Integer32
+Shizu_Value_Accessor Shizu_Integer32
 Shizu_Value_getInteger32
   (
     Shizu_Value const* self
   );
 
-bool
+Shizu_Value_Accessor bool
 Shizu_Value_isInteger32
   (
     Shizu_Value const* self
   );
 
-void
+Shizu_Value_Accessor void
 Shizu_Value_setInteger32
   (
     Shizu_Value* self,
@@ -442,19 +520,19 @@ Shizu_Value_setInteger32
 
 #define Shizu_Value_InitializerInteger64(VALUE) { .tag = Shizu_Value_Tag_Integer64, .integer64Value = (VALUE) }
 
-Shizu_Integer64
+Shizu_Value_Accessor Shizu_Integer64
 Shizu_Value_getInteger64
   (
     Shizu_Value const* self
   );
 
-bool
+Shizu_Value_Accessor bool
 Shizu_Value_isInteger64
   (
     Shizu_Value const* self
   );
 
-void
+Shizu_Value_Accessor void
 Shizu_Value_setInteger64
   (
     Shizu_Value* self,
@@ -465,21 +543,25 @@ Shizu_Value_setInteger64
 
 
 
-#define Shizu_Value_InitializerObject(VALUE) { .tag = Shizu_Value_Tag_Object, .objectValue = (Shizu_Object*)(VALUE) }
+#if 1 == Shizu_Configuration_WithNanBoxing
+  #define Shizu_Value_InitializerObject(VALUE) { .bits = Shizu_Value_NanBox(Shizu_Value_Tag_Object, (uintptr_t)(Shizu_Object*)(VALUE)) }
+#else
+  #define Shizu_Value_InitializerObject(VALUE) { .tag = Shizu_Value_Tag_Object, .objectValue = (Shizu_Object*)(VALUE) }
+#endif
 
-Shizu_Object*
+Shizu_Value_Accessor Shizu_Object*
 Shizu_Value_getObject
   (
     Shizu_Value const* self
   );
 
-bool
+Shizu_Value_Accessor bool
 Shizu_Value_isObject
   (
     Shizu_Value const* self
   );
 
-void
+Shizu_Value_Accessor void
 Shizu_Value_setObject
   (
     Shizu_Value* self,
@@ -488,22 +570,26 @@ Shizu_Value_setObject
 
 
 
-#define Shizu_Value_InitializerType(VALUE) { .tag = Shizu_Value_Tag_Type, .typeValue = (VALUE) }
+#if 1 == Shizu_Configuration_WithNanBoxing
+  #define Shizu_Value_InitializerType(VALUE) { .bits = Shizu_Value_NanBox(Shizu_Value_Tag_Type, (uintptr_t)(VALUE)) }
+#else
+  #define Shizu_Value_InitializerType(VALUE) { .tag = Shizu_Value_Tag_Type, .typeValue = (VALUE) }
+#endif
 
-void
+Shizu_Value_Accessor void
 Shizu_Value_setType
   (
     Shizu_Value* self,
     Shizu_Type* typeValue
   );
 
-Shizu_Type*
+Shizu_Value_Accessor Shizu_Type*
 Shizu_Value_getType
   (
     Shizu_Value const* self
   );
 
-bool
+Shizu_Value_Accessor bool
 Shizu_Value_isType
   (
     Shizu_Value const* self
@@ -511,21 +597,25 @@ Shizu_Value_isType
 
 
 
-#define Shizu_Value_InitializerVoid(VALUE) { .tag = Shizu_Value_Tag_Void, .voidValue = (VALUE) }
+#if 1 == Shizu_Configuration_WithNanBoxing
+  #define Shizu_Value_InitializerVoid(VALUE) { .bits = Shizu_Value_NanBox(Shizu_Value_Tag_Void, (VALUE)) }
+#else
+  #define Shizu_Value_InitializerVoid(VALUE) { .tag = Shizu_Value_Tag_Void, .voidValue = (VALUE) }
+#endif
 
-Shizu_Void
+Shizu_Value_Accessor Shizu_Void
 Shizu_Value_getVoid
   (
     Shizu_Value const* self
   );
 
-bool
+Shizu_Value_Accessor bool
 Shizu_Value_isVoid
   (
     Shizu_Value const* self
   );
 
-void
+Shizu_Value_Accessor void
 Shizu_Value_setVoid
   (
     Shizu_Value* self,
@@ -549,4 +639,8 @@ Shizu_Value_getHashValue
     Shizu_Value const* x
   );
 
+#if 1 == Shizu_Configuration_WithInlineValueAccessors
+  #include "Shizu/Runtime/Value.inline.h"
+#endif
+
 #endif // SHIZU_RUNTIME_VALUE_H_INCLUDED
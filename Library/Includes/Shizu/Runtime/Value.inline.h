@@ -0,0 +1,622 @@
+/*
+  Shizu
+  Copyright (C) 2024 Michael Heilmann. All rights reserved.
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+#if !defined(SHIZU_RUNTIME_VALUE_INLINE_H_INCLUDED)
+#define SHIZU_RUNTIME_VALUE_INLINE_H_INCLUDED
+
+// The definitions of the accessors of Shizu_Value.
+// Included by "Shizu/Runtime/Value.h" if Shizu_Configuration_WithInlineValueAccessors is 1 and by "Value.c" otherwise.
+#include "Shizu/Runtime/Value.h"
+
+#if 1 == Shizu_Configuration_WithNanBoxing
+
+Shizu_Value_Accessor uint8_t
+Shizu_Value_getTag
+  (
+    Shizu_Value const* self
+  )
+{
+  Shizu_Cxx_Debug_assert(NULL != self);
+#if 1 == Shizu_Configuration_WithFloat64
+  if (self->bits < Shizu_Value_NanBoxPrefix) {
+    return Shizu_Value_Tag_Float64;
+  }
+#endif
+  return (uint8_t)((self->bits >> Shizu_Value_NanBoxTagShift) & Shizu_Value_NanBoxTagMask);
+}
+
+Shizu_Value_Accessor Shizu_Boolean
+Shizu_Value_getBoolean
+  (
+    Shizu_Value const* self
+  )
+{
+  Shizu_Cxx_Debug_assert(Shizu_Value_isBoolean(self));
+  return 0 != (self->bits & Shizu_Value_NanBoxPayloadMask);
+}
+
+Shizu_Value_Accessor bool
+Shizu_Value_isBoolean
+  (
+    Shizu_Value const* self
+  )
+{
+  Shizu_Cxx_Debug_assert(NULL != self);
+  return Shizu_Value_NanBox(Shizu_Value_Tag_Boolean, 0) == (self->bits & ~Shizu_Value_NanBoxPayloadMask);
+}
+
+Shizu_Value_Accessor void
+Shizu_Value_setBoolean
+  (
+    Shizu_Value* self,
+    Shizu_Boolean booleanValue
+  )
+{
+  Shizu_Cxx_Debug_assert(NULL != self);
+  self->bits = Shizu_Value_NanBox(Shizu_Value_Tag_Boolean, booleanValue ? 1 : 0);
+}
+
+Shizu_Value_Accessor Shizu_CxxFunction*
+Shizu_Value_getCxxFunction
+  (
+    Shizu_Value const* self
+  )
+{
+  Shizu_Cxx_Debug_assert(Shizu_Value_isCxxFunction(self));
+  return (Shizu_CxxFunction*)(uintptr_t)(self->bits & Shizu_Value_NanBoxPayloadMask);
+}
+
+Shizu_Value_Accessor bool
+Shizu_Value_isCxxFunction
+  (
+    Shizu_Value const* self
+  )
+{
+  Shizu_Cxx_Debug_assert(NULL != self);
+  return Shizu_Value_NanBox(Shizu_Value_Tag_CxxFunction, 0) == (self->bits & ~Shizu_Value_NanBoxPayloadMask);
+}
+
+Shizu_Value_Accessor void
+Shizu_Value_setCxxFunction
+  (
+    Shizu_Value* self,
+    Shizu_CxxFunction* cxxFunctionValue
+  )
+{
+  Shizu_Cxx_Debug_assert(NULL != self);
+  Shizu_Cxx_Debug_assert(NULL != cxxFunctionValue);
+  Shizu_Cxx_Debug_assert(0 == ((uint64_t)(uintptr_t)cxxFunctionValue & ~Shizu_Value_NanBoxPayloadMask));
+  self->bits = Shizu_Value_NanBox(Shizu_Value_Tag_CxxFunction, (uintptr_t)cxxFunctionValue);
+}
+
+Shizu_Value_Accessor Shizu_Float32
+Shizu_Value_getFloat32
+  (
+    Shizu_Value const* self
+  )
+{
+  Shizu_Cxx_Debug_assert(Shizu_Value_isFloat32(self));
+  union { uint32_t u; Shizu_Float32 f; } x = { .u = (uint32_t)self->bits };
+  return x.f;
+}
+
+Shizu_Value_Accessor bool
+Shizu_Value_isFloat32
+  (
+    Shizu_Value const* self
+  )
+{
+  Shizu_Cxx_Debug_assert(NULL != self);
+  return Shizu_Value_NanBox(Shizu_Value_Tag_Float32, 0) == (self->bits & ~Shizu_Value_NanBoxPayloadMask);
+}
+
+Shizu_Value_Accessor void
+Shizu_Value_setFloat32
+  (
+    Shizu_Value* self,
+    Shizu_Float32 float32Value
+  )
+{
+  Shizu_Cxx_Debug_assert(NULL != self);
+  union { Shizu_Float32 f; uint32_t u; } x = { .f = float32Value };
+  self->bits = Shizu_Value_NanBox(Shizu_Value_Tag_Float32, x.u);
+}
+
+#if 1 == Shizu_Configuration_WithFloat64
+
+Shizu_Value_Accessor Shizu_Float64
+Shizu_Value_getFloat64
+  (
+    Shizu_Value const* self
+  )
+{
+  Shizu_Cxx_Debug_assert(Shizu_Value_isFloat64(self));
+  union { uint64_t u; Shizu_Float64 f; } x = { .u = self->bits };
+  return x.f;
+}
+
+Shizu_Value_Accessor bool
+Shizu_Value_isFloat64
+  (
+    Shizu_Value const* self
+  )
+{
+  Shizu_Cxx_Debug_assert(NULL != self);
+  return self->bits < Shizu_Value_NanBoxPrefix;
+}
+
+Shizu_Value_Accessor void
+Shizu_Value_setFloat64
+  (
+    Shizu_Value* self,
+    Shizu_Float64 float64Value
+  )
+{
+  Shizu_Cxx_Debug_assert(NULL != self);
+  union { Shizu_Float64 f; uint64_t u; } x = { .f = float64Value };
+  // Any NaN is stored as the canonical NaN such that its bits are never mistaken for a boxed value.
+  self->bits = float64Value != float64Value ? Shizu_Value_NanBoxCanonicalNan : x.u;
+}
+
+#endif
+
+Shizu_Value_Accessor Shizu_Integer32
+Shizu_Value_getInteger32
+  (
+    Shizu_Value const* self
+  )
+{
+  Shizu_Cxx_Debug_assert(Shizu_Value_isInteger32(self));
+  return (Shizu_Integer32)(uint32_t)self->bits;
+}
+
+Shizu_Value_Accessor bool
+Shizu_Value_isInteger32
+  (
+    Shizu_Value const* self
+  )
+{
+  Shizu_Cxx_Debug_assert(NULL != self);
+  return Shizu_Value_NanBox(Shizu_Value_Tag_Integer32, 0) == (self->bits & ~Shizu_Value_NanBoxPayloadMask);
+}
+
+Shizu_Value_Accessor void
+Shizu_Value_setInteger32
+  (
+    Shizu_Value* self,
+    Shizu_Integer32 integer32Value
+  )
+{
+  Shizu_Cxx_Debug_assert(NULL != self);
+  self->bits = Shizu_Value_NanBox(Shizu_Value_Tag_Integer32, (uint32_t)integer32Value);
+}
+
+Shizu_Value_Accessor Shizu_Object*
+Shizu_Value_getObject
+  (
+    Shizu_Value const* self
+  )
+{
+  Shizu_Cxx_Debug_assert(Shizu_Value_isObject(self));
+  return (Shizu_Object*)(uintptr_t)(self->bits & Shizu_Value_NanBoxPayloadMask);
+}
+
+Shizu_Value_Accessor bool
+Shizu_Value_isObject
+  (
+    Shizu_Value const* self
+  )
+{
+  Shizu_Cxx_Debug_assert(NULL != self);
+  return Shizu_Value_NanBox(Shizu_Value_Tag_Object, 0) == (self->bits & ~Shizu_Value_NanBoxPayloadMask);
+}
+
+Shizu_Value_Accessor void
+Shizu_Value_setObject
+  (
+    Shizu_Value* self,
+    Shizu_Object* objectValue
+  )
+{
+  Shizu_Cxx_Debug_assert(NULL != self);
+  Shizu_Cxx_Debug_assert(NULL != objectValue);
+  Shizu_Cxx_Debug_assert(0 == ((uint64_t)(uintptr_t)objectValue & ~Shizu_Value_NanBoxPayloadMask));
+  self->bits = Shizu_Value_NanBox(Shizu_Value_Tag_Object, (uintptr_t)objectValue);
+}
+
+Shizu_Value_Accessor Shizu_Type*
+Shizu_Value_getType
+  (
+    Shizu_Value const* self
+  )
+{
+  Shizu_Cxx_Debug_assert(Shizu_Value_isType(self));
+  return (Shizu_Type*)(uintptr_t)(self->bits & Shizu_Value_NanBoxPayloadMask);
+}
+
+Shizu_Value_Accessor bool
+Shizu_Value_isType
+  (
+    Shizu_Value const* self
+  )
+{
+  Shizu_Cxx_Debug_assert(NULL != self);
+  return Shizu_Value_NanBox(Shizu_Value_Tag_Type, 0) == (self->bits & ~Shizu_Value_NanBoxPayloadMask);
+}
+
+Shizu_Value_Accessor void
+Shizu_Value_setType
+  (
+    Shizu_Value* self,
+    Shizu_Type* typeValue
+  )
+{
+  Shizu_Cxx_Debug_assert(NULL != self);
+  Shizu_Cxx_Debug_assert(NULL != typeValue);
+  Shizu_Cxx_Debug_assert(0 == ((uint64_t)(uintptr_t)typeValue & ~Shizu_Value_NanBoxPayloadMask));
+  self->bits = Shizu_Value_NanBox(Shizu_Value_Tag_Type, (uintptr_t)typeValue);
+}
+
+Shizu_Value_Accessor Shizu_Void
+Shizu_Value_getVoid
+  (
+    Shizu_Value const* self
+  )
+{
+  Shizu_Cxx_Debug_assert(Shizu_Value_isVoid(self));
+  return (Shizu_Void)(self->bits & Shizu_Value_NanBoxPayloadMask);
+}
+
+Shizu_Value_Accessor bool
+Shizu_Value_isVoid
+  (
+    Shizu_Value const* self
+  )
+{
+  Shizu_Cxx_Debug_assert(NULL != self);
+  return Shizu_Value_NanBox(Shizu_Value_Tag_Void, 0) == (self->bits & ~Shizu_Value_NanBoxPayloadMask);
+}
+
+Shizu_Value_Accessor void
+Shizu_Value_setVoid
+  (
+    Shizu_Value* self,
+    Shizu_Void voidValue
+  )
+{
+  Shizu_Cxx_Debug_assert(NULL != self);
+  self->bits = Shizu_Value_NanBox(Shizu_Value_Tag_Void, voidValue);
+}
+
+#else
+
+Shizu_Value_Accessor uint8_t
+Shizu_Value_getTag
+  (
+    Shizu_Value const* self
+  )
+{
+  Shizu_Cxx_Debug_assert(NULL != self);
+  return self->tag;
+}
+
+Shizu_Value_Accessor Shizu_Boolean
+Shizu_Value_getBoolean
+  (
+    Shizu_Value const* self
+  )
+{
+  Shizu_Cxx_Debug_assert(Shizu_Value_isBoolean(self));
+  return self->booleanValue;
+}
+
+Shizu_Value_Accessor bool
+Shizu_Value_isBoolean
+  (
+    Shizu_Value const* self
+  )
+{
+  Shizu_Cxx_Debug_assert(NULL != self);
+  return Shizu_Value_Tag_Boolean == self->tag;
+}
+
+Shizu_Value_Accessor void
+Shizu_Value_setBoolean
+  (
+    Shizu_Value* self,
+    Shizu_Boolean booleanValue
+  )
+{
+  Shizu_Cxx_Debug_assert(NULL != self);
+  self->booleanValue = booleanValue;
+  self->tag = Shizu_Value_Tag_Boolean;
+}
+
+Shizu_Value_Accessor Shizu_CxxFunction*
+Shizu_Value_getCxxFunction
+  (
+    Shizu_Value const* self
+  )
+{
+  Shizu_Cxx_Debug_assert(Shizu_Value_isCxxFunction(self));
+  return self->cxxFunctionValue;
+}
+
+Shizu_Value_Accessor bool
+Shizu_Value_isCxxFunction
+  (
+    Shizu_Value const* self
+  )
+{
+  Shizu_Cxx_Debug_assert(NULL != self);
+  return Shizu_Value_Tag_CxxFunction == self->tag;
+}
+
+Shizu_Value_Accessor void
+Shizu_Value_setCxxFunction
+  (
+    Shizu_Value* self,
+    Shizu_CxxFunction* cxxFunctionValue
+  )
+{
+  Shizu_Cxx_Debug_assert(NULL != self);
+  Shizu_Cxx_Debug_assert(NULL != cxxFunctionValue);
+  self->cxxFunctionValue = cxxFunctionValue;
+  self->tag = Shizu_Value_Tag_CxxFunction;
+}
+
+Shizu_Value_Accessor Shizu_Float32
+Shizu_Value_getFloat32
+  (
+    Shizu_Value const* self
+  )
+{
+  Shizu_Cxx_Debug_assert(Shizu_Value_isFloat32(self));
+  return self->float32Value;
+}
+
+Shizu_Value_Accessor bool
+Shizu_Value_isFloat32
+  (
+    Shizu_Value const* self
+  )
+{
+  Shizu_Cxx_Debug_assert(NULL != self);
+  return Shizu_Value_Tag_Float32 == self->tag;
+}
+
+Shizu_Value_Accessor void
+Shizu_Value_setFloat32
+  (
+    Shizu_Value* self,
+    Shizu_Float32 float32Value
+  )
+{
+  Shizu_Cxx_Debug_assert(NULL != self);
+  self->float32Value = float32Value;
+  self->tag = Shizu_Value_Tag_Float32;
+}
+
+#if 1 == Shizu_Configuration_WithFloat64
+
+Shizu_Value_Accessor Shizu_Float64
+Shizu_Value_getFloat64
+  (
+    Shizu_Value const* self
+  )
+{
+  Shizu_Cxx_Debug_assert(Shizu_Value_isFloat64(self));
+  return self->float64Value;
+}
+
+Shizu_Value_Accessor bool
+Shizu_Value_isFloat64
+  (
+    Shizu_Value const* self
+  )
+{
+  Shizu_Cxx_Debug_assert(NULL != self);
+  return Shizu_Value_Tag_Float64 == self->tag;
+}
+
+Shizu_Value_Accessor void
+Shizu_Value_setFloat64
+  (
+    Shizu_Value* self,
+    Shizu_Float64 float64Value
+  )
+{
+  Shizu_Cxx_Debug_assert(NULL != self);
+  self->float64Value = float64Value;
+  self->tag = Shizu_Value_Tag_Float64;
+}
+
+#endif
+
+Shizu_Value_Accessor Shizu_Integer32
+Shizu_Value_getInteger32
+  (
+    Shizu_Value const* self
+  )
+{
+  Shizu_Cxx_Debug_assert(Shizu_Value_isInteger32(self));
+  return self->integer32Value;
+}
+
+Shizu_Value_Accessor bool
+Shizu_Value_isInteger32
+  (
+    Shizu_Value const* self
+  )
+{
+  Shizu_Cxx_Debug_assert(NULL != self);
+  return Shizu_Value_Tag_Integer32 == self->tag;
+}
+
+Shizu_Value_Accessor void
+Shizu_Value_setInteger32
+  (
+    Shizu_Value* self,
+    Shizu_Integer32 integer32Value
+  )
+{
+  Shizu_Cxx_Debug_assert(NULL != self);
+  self->integer32Value = integer32Value;
+  self->tag = Shizu_Value_Tag_Integer32;
+}
+
+#if 1 == Shizu_Configuration_WithInteger64
+
+Shizu_Value_Accessor Shizu_Integer64
+Shizu_Value_getInteger64
+  (
+    Shizu_Value const* self
+  )
+{
+  Shizu_Cxx_Debug_assert(Shizu_Value_isInteger64(self));
+  return self->integer64Value;
+}
+
+Shizu_Value_Accessor bool
+Shizu_Value_isInteger64
+  (
+    Shizu_Value const* self
+  )
+{
+  Shizu_Cxx_Debug_assert(NULL != self);
+  return Shizu_Value_Tag_Integer64 == self->tag;
+}
+
+Shizu_Value_Accessor void
+Shizu_Value_setInteger64
+  (
+    Shizu_Value* self,
+    Shizu_Integer64 integer64Value
+  )
+{
+  Shizu_Cxx_Debug_assert(NULL != self);
+  self->integer64Value = integer64Value;
+  self->tag = Shizu_Value_Tag_Integer64;
+}
+
+#endif
+
+Shizu_Value_Accessor Shizu_Object*
+Shizu_Value_getObject
+  (
+    Shizu_Value const* self
+  )
+{
+  Shizu_Cxx_Debug_assert(Shizu_Value_isObject(self));
+  return self->objectValue;
+}
+
+Shizu_Value_Accessor bool
+Shizu_Value_isObject
+  (
+    Shizu_Value const* self
+  )
+{
+  Shizu_Cxx_Debug_assert(NULL != self);
+  return Shizu_Value_Tag_Object == self->tag;
+}
+
+Shizu_Value_Accessor void
+Shizu_Value_setObject
+  (
+    Shizu_Value* self,
+    Shizu_Object* objectValue
+  )
+{
+  Shizu_Cxx_Debug_assert(NULL != self);
+  Shizu_Cxx_Debug_assert(NULL != objectValue);
+  self->objectValue = objectValue;
+  self->tag = Shizu_Value_Tag_Object;
+}
+
+Shizu_Value_Accessor Shizu_Type*
+Shizu_Value_getType
+  (
+    Shizu_Value const* self
+  )
+{
+  Shizu_Cxx_Debug_assert(Shizu_Value_isType(self));
+  return self->typeValue;
+}
+
+Shizu_Value_Accessor bool
+Shizu_Value_isType
+  (
+    Shizu_Value const* self
+  )
+{
+  Shizu_Cxx_Debug_assert(NULL != self);
+  return Shizu_Value_Tag_Type == self->tag;
+}
+
+Shizu_Value_Accessor void
+Shizu_Value_setType
+  (
+    Shizu_Value* self,
+    Shizu_Type* typeValue
+  )
+{
+  Shizu_Cxx_Debug_assert(NULL != self);
+  Shizu_Cxx_Debug_assert(NULL != typeValue);
+  self->typeValue = typeValue;
+  self->tag = Shizu_Value_Tag_Type;
+}
+
+Shizu_Value_Accessor Shizu_Void
+Shizu_Value_getVoid
+  (
+    Shizu_Value const* self
+  )
+{
+  Shizu_Cxx_Debug_assert(Shizu_Value_isVoid(self));
+  return self->voidValue;
+}
+
+Shizu_Value_Accessor bool
+Shizu_Value_isVoid
+  (
+    Shizu_Value const* self
+  )
+{
+  Shizu_Cxx_Debug_assert(NULL != self);
+  return Shizu_Value_Tag_Void == self->tag;
+}
+
+Shizu_Value_Accessor void
+Shizu_Value_setVoid
+  (
+    Shizu_Value* self,
+    Shizu_Void voidValue
+  )
+{
+  Shizu_Cxx_Debug_assert(NULL != self);
+  self->voidValue = voidValue;
+  self->tag = Shizu_Value_Tag_Void;
+}
+
+#endif
+
+#endif // SHIZU_RUNTIME_VALUE_INLINE_H_INCLUDED
@@ -0,0 +1,45 @@
+/*
+  Shizu
+  Copyright (C) 2024 Michael Heilmann. All rights reserved.
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+#if !defined(SHIZU_RUNTIME_GETMONOTONICTIME_H_INCLUDED)
+#define SHIZU_RUNTIME_GETMONOTONICTIME_H_INCLUDED
+
+#if !defined(SHIZU_RUNTIME_PRIVATE) && 1 != SHIZU_RUNTIME_PRIVATE
+  #error("Do not include `Shizu/Runtime/getMonotonicTime.h` directly. Include `Shizu/Runtime/Include.h` instead.")
+#endif
+
+#include "Shizu/Runtime/Configure.h"
+#include <inttypes.h>
+typedef struct Shizu_State1 Shizu_State1;
+
+/// @since 1.0
+/// @brief Get the time, in nanoseconds, of a monotonic clock.
+/// The time is relative to an unspecified point in the past such that only differences of times are meaningful.
+/// @param state A pointer to the Shizu service level 1 state.
+/// @return The time, in nanoseconds.
+/// @error The clock could not be read.
+uint64_t
+Shizu_getMonotonicTime
+  (
+    Shizu_State1* state
+  );
+
+#endif // SHIZU_RUNTIME_GETMONOTONICTIME_H_INCLUDED
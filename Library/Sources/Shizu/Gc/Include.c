@@ -4,6 +4,20 @@
 #include <malloc.h>
 #include <stdio.h>
 
+// memcmp, memcpy
+#include <string.h>
+
+// malloc, calloc, realloc, free
+#include <stdlib.h>
+
+#if 1 == Shizu_Configuration_WithGcParallelMark
+  #include "idlib/process.h"
+#endif
+
+#if 1 == Shizu_Configuration_WithGcCompactHeader && 1 != Shizu_Configuration_WithGcSizeClassHeap
+  #error("the compact header requires the size-class heap")
+#endif
+
 /*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
 
 typedef struct PlsNode PlsNode;
@@ -20,15 +34,64 @@ typedef struct TypeManager TypeManager;
 
 /*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
 
+#if 1 == Shizu_Configuration_WithGcParallelMark
+
+typedef struct MarkThreads MarkThreads;
+
+#endif
+
+/*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+
+#if 1 == Shizu_Configuration_WithGcSizeClassHeap
+
+typedef struct Slot Slot;
+typedef struct Page Page;
+typedef struct SizeClass SizeClass;
+typedef struct Heap Heap;
+
+#endif
+
+/*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+
 #define Tag_Flags_White (1)
 
 #define Tag_Flags_Black (2)
 
 #define Tag_Flags_Gray (Tag_Flags_White | Tag_Flags_Black)
 
+// The Tag and its object are stored in a slot of a page of the size-class heap.
+// Otherwise the Tag and its object were allocated by malloc.
+#define Tag_Flags_Slot (4)
+
+// The object is in the old generation.
+// If generational collection is disabled, all objects are in the old generation.
+#define Tag_Flags_Old (8)
+
+// The object is in the remembered set.
+#define Tag_Flags_Remembered (16)
+
+// The object has a side record (see Shizu_Gcx_setRecordFlag).
+#define Tag_Flags_Record (64)
+
+#if 1 == Shizu_Configuration_WithGcCompactHeader
+
+// The object was allocated after the last collection began.
+// It is not swept by the collection in progress and is counted as allocated when the next collection begins.
+#define Tag_Flags_New (32)
+
+// The flags are stored in the low bits of the pointer to the type node.
+// Type nodes are aligned to Tag_Flags_Mask + 1 Bytes.
+#define Tag_Flags_Mask (127)
+
+struct Tag {
+  // The pointer to the type node and the flags.
+  // The null pointer if the slot does not store an object.
+  void* flags;
+};
+
+#else
+
 struct Tag {
-  // We could compress "flags" and "type" into 8 Byte.
-  // We can use the upper 2^62 Bit for the pointer and the lower 2 bit for the color.
   void* flags;
   union {
     Tag* gray;
@@ -37,6 +100,27 @@ struct Tag {
   Tag* next;
 };
 
+#endif
+
+/// @since 1.0
+/// @internal
+/// @brief Get the type node of a Tag.
+/// @param tag A pointer to the Tag.
+/// @return A pointer to the type node.
+/// @remark If the compact header is disabled, the type node of a Tag in a gray list can not be determined.
+static inline TypeNode*
+Tag_getType
+  (
+    Tag const* tag
+  )
+{
+#if 1 == Shizu_Configuration_WithGcCompactHeader
+  return (TypeNode*)(~((uintptr_t)Tag_Flags_Mask) & (uintptr_t)tag->flags);
+#else
+  return tag->type;
+#endif
+}
+
 /// @since 1.0
 /// @brief Get if an Tag is colored white.
 /// @param object A pointer to the Tag.
@@ -79,7 +163,7 @@ Tag_setGray
   (
     Tag* tag
   )
-{ tag->flags = (void*)(uintptr_t)Tag_Flags_Gray; }
+{ tag->flags = (void*)(uintptr_t)(Tag_Flags_Gray | (uintptr_t)tag->flags); }
 
 /// @since 1.0
 /// @brief Get if an Tag is colored black.
@@ -134,7 +218,16 @@ struct TypeNode {
   Shizu_Gcx_FinalizeCallback* finalizeCallback;
 
   Tag* gray; // A list only used during marking.
-  Tag* all; // All objects of this type.
+  Tag* all; // All old objects of this type.
+  Tag* young; // All young objects of this type.
+  Tag* sweepAll; // The old objects of this type not yet swept by the collection in progress.
+  Tag* sweepYoung; // The young objects of this type not yet swept by the collection in progress.
+
+  // The statistics of this type (see Shizu_Gcx_TypeStatistics).
+  // The objects allocated since the last collection began are counted when the next collection begins.
+  size_t liveObjects, liveBytes;
+  size_t allocatedObjects, allocatedBytes;
+  size_t freedObjects, freedBytes;
 };
 
 struct TypeManager {
@@ -142,11 +235,279 @@ struct TypeManager {
   size_t sz, cp;
 };
 
+// Allocate a type node.
+// If the compact header is enabled, the type node is aligned to Tag_Flags_Mask + 1 Bytes such that the flags fit into the low bits of a pointer to it.
+static TypeNode*
+TypeNode_allocate
+  (
+  )
+{
+#if 1 == Shizu_Configuration_WithGcCompactHeader
+  void* p = NULL;
+  #if (Shizu_Configuration_OperatingSystem == Shizu_Configuration_OperatingSystem_Linux)  || \
+      (Shizu_Configuration_OperatingSystem == Shizu_Configuration_OperatingSystem_Cygwin) || \
+      (Shizu_Configuration_OperatingSystem == Shizu_Configuration_OperatingSystem_Macos)
+    if (posix_memalign(&p, Tag_Flags_Mask + 1, sizeof(TypeNode))) {
+      p = NULL;
+    }
+  #elif Shizu_Configuration_OperatingSystem == Shizu_Configuration_OperatingSystem_Windows
+    p = _aligned_malloc(sizeof(TypeNode), Tag_Flags_Mask + 1);
+  #else
+    #error("operating system not (yet) supported")
+  #endif
+  return (TypeNode*)p;
+#else
+  return malloc(sizeof(TypeNode));
+#endif
+}
+
+static void
+TypeNode_deallocate
+  (
+    TypeNode* node
+  )
+{
+#if 1 == Shizu_Configuration_WithGcCompactHeader && Shizu_Configuration_OperatingSystem == Shizu_Configuration_OperatingSystem_Windows
+  _aligned_free(node);
+#else
+  free(node);
+#endif
+}
+
+/*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+
+#if 1 == Shizu_Configuration_WithGcSizeClassHeap
+
+// The size, in Bytes, of a page.
+// Pages are aligned to their size such that the page of a slot can be computed from the address of the slot.
+#define Heap_PageSize (64 * 1024)
+
+// The size, in Bytes, of a slot is a multiple of this.
+#define Heap_Granularity (16)
+
+// The maximum size, in Bytes, of a slot.
+// Tags (including their objects) greater than this are allocated by malloc.
+#define Heap_MaximumSlotSize (512)
+
+// The number of size classes.
+// The slot size of the size class of index i is (i + 1) * Heap_Granularity.
+#define Heap_NumberOfSizeClasses (Heap_MaximumSlotSize / Heap_Granularity)
+
+// The offset, in Bytes, of the first slot of a page from the start of the page.
+#define Page_SlotsOffset (((sizeof(Page) + Heap_Granularity - 1) / Heap_Granularity) * Heap_Granularity)
+
+// A free slot.
+struct Slot {
+#if 1 == Shizu_Configuration_WithGcCompactHeader
+  // The null pointer such that a free slot is distinguishable from a Tag when enumerating the slots of a page.
+  void* flags;
+#endif
+  Slot* next;
+};
+
+struct Page {
+  // The next page in the list of all pages of the size class.
+  Page* next;
+  // The next page in the list of pages with free slots of the size class.
+  Page* nextAvailable;
+  // If this page is in the list of pages with free slots of the size class.
+  bool available;
+  // The size class this page belongs to.
+  SizeClass* sizeClass;
+  // The number of slots in use.
+  size_t used;
+  // Slots in [bump, end) were never used.
+  char* bump;
+  char* end;
+  // The list of slots that were released.
+  Slot* free;
+};
+
+struct SizeClass {
+  // The size, in Bytes, of a slot of this size class.
+  size_t slotSize;
+  // The list of all pages of this size class.
+  Page* pages;
+  // The list of pages of this size class with free slots.
+  Page* available;
+};
+
+struct Heap {
+  SizeClass sizeClasses[Heap_NumberOfSizeClasses];
+};
+
+#endif
+
+/*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+
+typedef struct LargeObject LargeObject;
+
+// A Tag (including its object) not stored in a slot is allocated by malloc and preceded by this record.
+struct LargeObject {
+#if 1 == Shizu_Configuration_WithGcCompactHeader
+  // The next large object in the list of large objects of the singleton.
+  LargeObject* next;
+#endif
+  // The size, in Bytes, of the Tag and its object.
+  size_t size;
+#if 1 == Shizu_Configuration_WithGcCompactHeader
+  // The object following the Tag is aligned as if it was allocated by malloc.
+  void* padding;
+#endif
+};
+
+// Get the size, in Bytes, of a Tag and its object.
+// For an object in a slot, this is the size of the slot.
+static inline size_t
+Tag_getSize
+  (
+    Tag const* tag
+  )
+{
+#if 1 == Shizu_Configuration_WithGcSizeClassHeap
+  if (Tag_Flags_Slot & (uintptr_t)tag->flags) {
+    Page const* page = (Page const*)(((uintptr_t)tag) & ~((uintptr_t)(Heap_PageSize - 1)));
+    return page->sizeClass->slotSize;
+  }
+#endif
+  return (((LargeObject const*)tag) - 1)->size;
+}
+
+// Count an object allocated since the last collection began in the statistics of its type.
+// Invoked when the next collection begins.
+static inline void
+countAllocated
+  (
+    TypeNode* node,
+    Tag const* tag
+  )
+{
+  size_t size = Tag_getSize(tag);
+  node->allocatedObjects++;
+  node->allocatedBytes += size;
+  node->liveObjects++;
+  node->liveBytes += size;
+}
+
+// Count a dead object in the statistics of its type.
+// Must be invoked before the object is deallocated.
+static inline void
+countFreed
+  (
+    Tag const* tag
+  )
+{
+  TypeNode* node = Tag_getType(tag);
+  size_t size = Tag_getSize(tag);
+  node->liveObjects--;
+  node->liveBytes -= size;
+  node->freedObjects++;
+  node->freedBytes += size;
+}
+
+#if 1 == Shizu_Configuration_WithGcCompactHeader
+
+// A stack of Tags.
+typedef struct TagStack {
+  Tag** elements;
+  size_t size, capacity;
+} TagStack;
+
+// The position of the sweep in progress.
+// The slots of the pages of the size classes are swept in order, then the large objects are swept.
+typedef struct SweepCursor {
+  // The index of the size class.
+  size_t sizeClass;
+  // The page or the null pointer if the sweep of the size class did not start yet.
+  Page* page;
+  // The next slot of the page.
+  char* slot;
+  // The link to the next large object.
+  LargeObject** largeObject;
+} SweepCursor;
+
+// Push a Tag on the stack.
+// Return false if the stack could not grow.
+static bool
+TagStack_push
+  (
+    TagStack* self,
+    Tag* tag
+  )
+{
+  if (self->size == self->capacity) {
+    if (self->capacity > SIZE_MAX / sizeof(Tag*) / 2) {
+      return false;
+    }
+    size_t newCapacity = self->capacity ? self->capacity * 2 : 64;
+    Tag** newElements = realloc(self->elements, newCapacity * sizeof(Tag*));
+    if (!newElements) {
+      return false;
+    }
+    self->elements = newElements;
+    self->capacity = newCapacity;
+  }
+  self->elements[self->size++] = tag;
+  return true;
+}
+
+#endif
+
 /*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
 
+typedef struct RememberedSet {
+  Tag** elements;
+  size_t size, capacity;
+  // If an old object could not be added to the remembered set.
+  // The next collection must be a major collection.
+  bool overflow;
+} RememberedSet;
+
+typedef struct ThreadContext ThreadContext;
+
+// During the sweep phase, Shizu_Gcx_allocate sweeps at most this number of objects of a type before allocating an object of that type.
+#define LazySweepBudget (16)
+
 typedef struct Singleton {
   PlsManager* plsManager;
   TypeManager* typeManager;
+#if 1 == Shizu_Configuration_WithGcSizeClassHeap
+  Heap* heap;
+#endif
+  RememberedSet rememberedSet;
+#if 1 == Shizu_Configuration_WithGcParallelMark
+  // The mark threads or the null pointer if marking is performed by the calling thread only.
+  MarkThreads* markThreads;
+#endif
+  // The phase of the collection in progress or Shizu_Gcx_Phase_None.
+  Shizu_Gcx_Phase phase;
+  // The kind of the collection in progress.
+  // Only meaningful if phase is not Shizu_Gcx_Phase_None.
+  Shizu_Gcx_Collection collection;
+  // The numbers of objects reclaimed and retained by lazy sweeping in Shizu_Gcx_allocate.
+  // Reported and reset by the next call to Shizu_Gcx_sweep.
+  size_t lazyDead, lazyLive;
+#if 1 == Shizu_Configuration_WithGcCompactHeader
+  // The dead objects with a finalize callback not yet invoked.
+  TagStack finalizationQueue;
+  // The gray objects.
+  TagStack grayStack;
+  // If a gray object could not be pushed on the gray stack.
+  // The gray objects not on the gray stack are then found by enumerating the objects.
+  bool grayStackOverflow;
+  // The large objects allocated before the collection in progress (or the last collection) began.
+  LargeObject* largeObjects;
+  // The position of the sweep in progress.
+  SweepCursor sweepCursor;
+#else
+  // The dead objects with a finalize callback not yet invoked (linked by Tag.next).
+  Tag* finalizationQueue;
+#endif
+  // 1 if the phase is Shizu_Gcx_Phase_Sweep such that Shizu_Gcx_allocate must take the lock to sweep lazily, 0 otherwise.
+  // Written under the lock, read by Shizu_Gcx_allocate without the lock.
+  size_t volatile lazySweeping;
+  // The contexts of the threads which allocated objects.
+  ThreadContext* threadContexts;
   int64_t referenceCount;
 } Singleton;
 
@@ -247,88 +608,774 @@ static Singleton* g_singleton = NULL;
 
 #endif
 
-static Shizu_Gcx_Status
-hashName
-  (
-    char const* name,
-    size_t nameLength,
-    size_t* hashValue
-  );
+#if Shizu_Configuration_CompilerC_Msvc == Shizu_Configuration_CompilerC
+  #define ThreadLocal __declspec(thread)
+#else
+  #define ThreadLocal __thread
+#endif
 
-static Shizu_Gcx_Status
-startupPlsManager
+// Hint the processor to load the cache line of the specified address.
+static inline void
+prefetch
   (
-  );
+    void const* p
+  )
+{
+#if Shizu_Configuration_CompilerC_Msvc == Shizu_Configuration_CompilerC
+  PreFetchCacheLine(PF_TEMPORAL_LEVEL_1, p);
+#else
+  __builtin_prefetch(p);
+#endif
+}
 
-static Shizu_Gcx_Status
-shutdownPlsManager
+static inline void*
+Atomic_loadPointer
   (
-  );
+    void* volatile* p
+  )
+{
+#if Shizu_Configuration_CompilerC_Msvc == Shizu_Configuration_CompilerC
+  return InterlockedCompareExchangePointer(p, NULL, NULL);
+#else
+  return __atomic_load_n(p, __ATOMIC_ACQUIRE);
+#endif
+}
 
-static Shizu_Gcx_Status
-startupTypeManager
+static inline void
+Atomic_storePointer
   (
-  );
+    void* volatile* p,
+    void* v
+  )
+{
+#if Shizu_Configuration_CompilerC_Msvc == Shizu_Configuration_CompilerC
+  InterlockedExchangePointer(p, v);
+#else
+  __atomic_store_n(p, v, __ATOMIC_RELEASE);
+#endif
+}
 
-static Shizu_Gcx_Status
-shutdownTypeManager
+static inline bool
+Atomic_compareExchangePointer
   (
-  );
+    void* volatile* p,
+    void* expected,
+    void* desired
+  )
+{
+#if Shizu_Configuration_CompilerC_Msvc == Shizu_Configuration_CompilerC
+  return expected == InterlockedCompareExchangePointer(p, desired, expected);
+#else
+  return __atomic_compare_exchange_n(p, &expected, desired, false, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE);
+#endif
+}
 
-static Shizu_Gcx_Status
-getSingletonVar
+static inline size_t
+Atomic_loadSize
   (
-    Singleton*** singleton
-  );
+    size_t volatile* p
+  )
+{
+#if Shizu_Configuration_CompilerC_Msvc == Shizu_Configuration_CompilerC
+  return (size_t)(uintptr_t)InterlockedCompareExchangePointer((void* volatile*)p, NULL, NULL);
+#else
+  return __atomic_load_n(p, __ATOMIC_ACQUIRE);
+#endif
+}
 
-static Shizu_Gcx_Status
-lockMutex
-  ( 
-  );
+static inline void
+Atomic_storeSize
+  (
+    size_t volatile* p,
+    size_t v
+  )
+{
+#if Shizu_Configuration_CompilerC_Msvc == Shizu_Configuration_CompilerC
+  InterlockedExchangePointer((void* volatile*)p, (void*)(uintptr_t)v);
+#else
+  __atomic_store_n(p, v, __ATOMIC_RELEASE);
+#endif
+}
 
-static Shizu_Gcx_Status
-unlockMutex
+static inline void
+Atomic_addSize
   (
-  );
+    size_t volatile* p,
+    size_t v
+  )
+{
+#if Shizu_Configuration_CompilerC_Msvc == Shizu_Configuration_CompilerC
+  #if Shizu_Configuration_InstructionSetArchitecture_X64 == Shizu_Configuration_InstructionSetArchitecture
+    InterlockedExchangeAdd64((LONG64 volatile*)p, (LONG64)v);
+  #else
+    InterlockedExchangeAdd((LONG volatile*)p, (LONG)v);
+  #endif
+#else
+  __atomic_add_fetch(p, v, __ATOMIC_ACQ_REL);
+#endif
+}
 
-static Shizu_Gcx_Status
-hashName
+/*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+
+// The allocation context of a thread.
+// Shizu_Gcx_allocate allocates objects without taking the lock if
+// - the context of the calling thread is registered with the singleton,
+// - the collection is not in the sweep phase (see lazy sweeping), and
+// - the object is allocated from the thread-local allocation buffer or by malloc.
+// The objects are added to the object list of the context.
+// The object lists of all contexts are merged into the lists of the type nodes when a collection begins.
+// If the compact header is enabled, the objects are not added to lists but found by enumerating the pages of the heap.
+// Large objects are then always allocated under the lock.
+// A context is deallocated when its thread exits or when the singleton is shut down.
+// In the latter case, a new context is created when its thread allocates from a new singleton.
+#if 1 == Shizu_Configuration_WithGcSizeClassHeap
+
+// The maximum number of slots reserved for a thread-local allocation buffer at once.
+#define ThreadContext_SlotsPerRefill (32)
+
+#endif
+
+struct ThreadContext {
+  // The next context in the list of contexts registered with the singleton.
+  ThreadContext* next;
+  // The singleton this context is registered with or the null pointer.
+  // Written under the lock, read by the thread of this context without the lock.
+  Singleton* volatile singleton;
+#if 1 != Shizu_Configuration_WithGcCompactHeader
+  // The objects allocated by the thread of this context since the last merge.
+  Tag* objects;
+  // If the thread of this context exited during a collection.
+  // The context is deallocated when its objects are merged.
+  bool exited;
+#endif
+#if 1 == Shizu_Configuration_WithGcSizeClassHeap
+  // The thread-local allocation buffers: The lists of free slots reserved for the thread of this context, one per size class.
+  // The slots are counted as used by their pages.
+  Slot* slots[Heap_NumberOfSizeClasses];
+#endif
+};
+
+// The context of the calling thread or the null pointer.
+// The context is valid only if g_threadContextGeneration is equal to g_threadContextsGeneration.
+static ThreadLocal ThreadContext* g_threadContext = NULL;
+
+// The value of g_threadContextsGeneration when the context of the calling thread was created.
+static ThreadLocal size_t g_threadContextGeneration = 0;
+
+// Incremented under the lock whenever all contexts are deallocated.
+static size_t volatile g_threadContextsGeneration = 1;
+
+#if (Shizu_Configuration_OperatingSystem == Shizu_Configuration_OperatingSystem_Linux)  || \
+    (Shizu_Configuration_OperatingSystem == Shizu_Configuration_OperatingSystem_Cygwin) || \
+    (Shizu_Configuration_OperatingSystem == Shizu_Configuration_OperatingSystem_Macos)
+
+  // The key whose destructor deallocates the context of a thread when the thread exits.
+  // Created under the lock when the first context is created. Never deleted.
+  static pthread_key_t g_threadContextKey;
+  static bool g_threadContextKeyCreated = false;
+
+#elif Shizu_Configuration_OperatingSystem == Shizu_Configuration_OperatingSystem_Windows
+
+  // The fiber-local storage index whose callback deallocates the context of a thread when the thread exits.
+  // Allocated under the lock when the first context is created. Never freed.
+  static DWORD g_threadContextKey = FLS_OUT_OF_INDEXES;
+
+#else
+
+  #error("operating system not (yet) supported")
+
+#endif
+
+// Get the context of the calling thread.
+// Return the null pointer if the calling thread has no context or its context was deallocated.
+static inline ThreadContext*
+getThreadContext
   (
-    char const* name,
-    size_t nameLength,
-    size_t* hashValue
   )
 {
-  size_t hv = nameLength;
-  for (size_t i = 0; i < nameLength; ++i) {
-    hv = hv * 37 + (size_t)name[i];
+  if (g_threadContextGeneration != Atomic_loadSize(&g_threadContextsGeneration)) {
+    return NULL;
   }
-  *hashValue = hv;
-  return Shizu_Gcx_Status_Success;
+  return g_threadContext;
 }
 
-static Shizu_Gcx_Status
-startupPlsManager
+/*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+
+#if 1 == Shizu_Configuration_WithGcParallelMark
+
+// A stack of gray objects.
+typedef struct MarkStack {
+  Tag** elements;
+  size_t volatile size;
+  size_t capacity;
+} MarkStack;
+
+static bool
+MarkStack_reserve
   (
+    MarkStack* self,
+    size_t additional
   )
 {
-  Singleton** singleton = NULL;
-  Shizu_Gcx_Status status;
-  status = getSingletonVar(&singleton);
-  if (status) {
-    return status;
+  size_t size = Atomic_loadSize(&self->size);
+  if (self->capacity - size >= additional) {
+    return true;
   }
-  (*singleton)->plsManager = malloc(sizeof(PlsManager));
-  if (!(*singleton)->plsManager) {
-    fprintf(stdout, "%s:%d: unable to allocate %zu Bytes\n", __FILE__, __LINE__, sizeof(PlsManager));
-    return Shizu_Gcx_Status_AllocationFailed;
+  if (SIZE_MAX / sizeof(Tag*) - size < additional) {
+    return false;
   }
-  (*singleton)->plsManager->p = malloc(sizeof(PlsNode*) * 8);
-  if (!(*singleton)->plsManager->p) {
-    fprintf(stdout, "%s:%d: unable to allocate %zu Bytes\n", __FILE__, __LINE__, sizeof(PlsNode*) * 8);
-    free((*singleton)->plsManager);
-    (*singleton)->plsManager = NULL;
-    return Shizu_Gcx_Status_AllocationFailed;
+  size_t newCapacity = self->capacity ? self->capacity : 64;
+  while (newCapacity - size < additional) {
+    if (newCapacity > SIZE_MAX / sizeof(Tag*) / 2) {
+      newCapacity = SIZE_MAX / sizeof(Tag*);
+      break;
+    }
+    newCapacity *= 2;
+  }
+  Tag** newElements = realloc(self->elements, newCapacity * sizeof(Tag*));
+  if (!newElements) {
+    return false;
+  }
+  self->elements = newElements;
+  self->capacity = newCapacity;
+  return true;
+}
+
+typedef struct MarkThreads MarkThreads;
+
+// A marker owns a local stack (only accessed by the marker) and a shared stack (accessed under the mutex by the marker and by thieves).
+// A marker moves half of its local stack to its shared stack if other markers are idle.
+typedef struct Marker {
+  MarkThreads* markThreads;
+  size_t index;
+  MarkStack local;
+  idlib_mutex mutex;
+  MarkStack shared;
+  // The number of objects marked by this marker in the current mark.
+  size_t marked;
+  // The thread executing this marker. Marker 0 is executed by the thread invoking the mark.
+  idlib_thread thread;
+  uint64_t epoch;
+} Marker;
+
+struct MarkThreads {
+  Marker* markers;
+  size_t numberOfMarkers;
+  // The number of markers which have no work and are trying to steal work.
+  // The mark is complete if all markers are idle.
+  size_t volatile idle;
+  // Protects epoch, running, and shutdown. Also protects the gray lists of the type nodes (or the gray stack of the singleton).
+  idlib_mutex mutex;
+  idlib_condition condition;
+  // Incremented to start a mark.
+  uint64_t epoch;
+  // The number of marker threads which have not yet completed the current mark.
+  size_t running;
+  bool shutdown;
+#if 1 == Shizu_Configuration_WithGcCompactHeader
+  // The singleton of the mark in progress. Its gray stack is protected by the mutex while marking in parallel.
+  Singleton* singleton;
+#endif
+};
+
+// The marker of the calling thread if it is marking in parallel, the null pointer otherwise.
+static ThreadLocal Marker* g_marker = NULL;
+
+// Color the object gray and push it on the local stack of the marker.
+static void
+Marker_visit
+  (
+    Marker* self,
+    Tag* tag
+  )
+{
+  for (;;) {
+    void* flags = Atomic_loadPointer(&tag->flags);
+    if (Tag_Flags_White != (Tag_Flags_Gray & (uintptr_t)flags)) {
+      return;
+    }
+    if (Atomic_compareExchangePointer(&tag->flags, flags, (void*)(Tag_Flags_Gray | (uintptr_t)flags))) {
+      break;
+    }
+  }
+  if (MarkStack_reserve(&self->local, 1)) {
+    self->local.elements[self->local.size++] = tag;
+  } else {
+  #if 1 == Shizu_Configuration_WithGcCompactHeader
+    // Overflow to the gray stack of the singleton. These objects are marked after the parallel mark.
+    Singleton* singleton = self->markThreads->singleton;
+    idlib_mutex_lock(&self->markThreads->mutex);
+    if (!TagStack_push(&singleton->grayStack, tag)) {
+      singleton->grayStackOverflow = true;
+    }
+    idlib_mutex_unlock(&self->markThreads->mutex);
+  #else
+    // Overflow to the gray list of the type. These objects are marked after the parallel mark.
+    TypeNode* type = tag->type;
+    idlib_mutex_lock(&self->markThreads->mutex);
+    tag->gray = type->gray;
+    type->gray = tag;
+    idlib_mutex_unlock(&self->markThreads->mutex);
+  #endif
+  }
+}
+
+// Pop an object from the local stack of the marker.
+// If the local stack is empty, move the objects from the shared stack to the local stack.
+static bool
+Marker_pop
+  (
+    Marker* self,
+    Tag** tag
+  )
+{
+  if (!self->local.size) {
+    if (!Atomic_loadSize(&self->shared.size)) {
+      return false;
+    }
+    idlib_mutex_lock(&self->mutex);
+    size_t size = self->shared.size;
+    if (size) {
+      // Move as many objects as fit into the local stack.
+      size_t n = size;
+      if (!MarkStack_reserve(&self->local, n)) {
+        n = self->local.capacity;
+      }
+      if (!n) {
+        // The local stack cannot grow. Pop directly from the shared stack.
+        *tag = self->shared.elements[size - 1];
+        Atomic_storeSize(&self->shared.size, size - 1);
+        idlib_mutex_unlock(&self->mutex);
+        return true;
+      }
+      memcpy(self->local.elements, self->shared.elements + (size - n), n * sizeof(Tag*));
+      self->local.size = n;
+      Atomic_storeSize(&self->shared.size, size - n);
+    }
+    idlib_mutex_unlock(&self->mutex);
+    if (!self->local.size) {
+      return false;
+    }
+  }
+  *tag = self->local.elements[--self->local.size];
+  return true;
+}
+
+// Move the bottom half of the local stack to the shared stack.
+static void
+Marker_share
+  (
+    Marker* self
+  )
+{
+  if (Atomic_loadSize(&self->shared.size)) {
+    return;
+  }
+  size_t n = self->local.size / 2;
+  idlib_mutex_lock(&self->mutex);
+  if (MarkStack_reserve(&self->shared, n)) {
+    memcpy(self->shared.elements, self->local.elements, n * sizeof(Tag*));
+    Atomic_storeSize(&self->shared.size, n);
+    memmove(self->local.elements, self->local.elements + n, (self->local.size - n) * sizeof(Tag*));
+    self->local.size -= n;
+  }
+  idlib_mutex_unlock(&self->mutex);
+}
+
+// Steal the top half of the shared stack of the victim.
+static bool
+Marker_steal
+  (
+    Marker* self,
+    Marker* victim
+  )
+{
+  bool stolen = false;
+  idlib_mutex_lock(&victim->mutex);
+  size_t size = victim->shared.size;
+  size_t n = (size + 1) / 2;
+  if (n && !MarkStack_reserve(&self->local, n)) {
+    n = self->local.capacity - self->local.size;
+  }
+  if (n) {
+    memcpy(self->local.elements + self->local.size, victim->shared.elements + (size - n), n * sizeof(Tag*));
+    self->local.size += n;
+    Atomic_storeSize(&victim->shared.size, size - n);
+    stolen = true;
+  }
+  idlib_mutex_unlock(&victim->mutex);
+  return stolen;
+}
+
+static void
+Marker_run
+  (
+    Marker* self
+  )
+{
+  MarkThreads* markThreads = self->markThreads;
+  size_t n = markThreads->numberOfMarkers;
+  for (;;) {
+    Tag* tag;
+    while (Marker_pop(self, &tag)) {
+      // Mark the object as black.
+      Atomic_storePointer(&tag->flags, (void*)(~((uintptr_t)Tag_Flags_White) & (uintptr_t)tag->flags));
+      TypeNode* type = Tag_getType(tag);
+      if (type->visitCallback) {
+        type->visitCallback(type->visitContext, (void*)(tag + 1));
+      }
+      self->marked++;
+      if (self->local.size > 1 && Atomic_loadSize(&markThreads->idle)) {
+        Marker_share(self);
+      }
+    }
+    // This marker has no work left: Its local stack and its shared stack are empty.
+    // Only its owner pushes objects to its shared stack, hence its shared stack remains empty.
+    Atomic_addSize(&markThreads->idle, 1);
+    bool stolen = false;
+    while (!stolen) {
+      if (n == Atomic_loadSize(&markThreads->idle)) {
+        // All markers are idle: All stacks are empty.
+        return;
+      }
+      for (size_t i = 1; i < n && !stolen; ++i) {
+        Marker* victim = &(markThreads->markers[(self->index + i) % n]);
+        if (Atomic_loadSize(&victim->shared.size)) {
+          // A marker holding objects must not be counted as idle.
+          Atomic_addSize(&markThreads->idle, (size_t)-1);
+          stolen = Marker_steal(self, victim);
+          if (!stolen) {
+            Atomic_addSize(&markThreads->idle, 1);
+          }
+        }
+      }
+      if (!stolen) {
+        idlib_thread_yield();
+      }
+    }
+  }
+}
+
+static void
+MarkThreads_procedure
+  (
+    void* argument
+  )
+{
+  Marker* marker = (Marker*)argument;
+  MarkThreads* self = marker->markThreads;
+  g_marker = marker;
+  idlib_mutex_lock(&self->mutex);
+  for (;;) {
+    while (marker->epoch == self->epoch && !self->shutdown) {
+      idlib_condition_wait(&self->condition, &self->mutex);
+    }
+    if (self->shutdown) {
+      break;
+    }
+    marker->epoch = self->epoch;
+    idlib_mutex_unlock(&self->mutex);
+    Marker_run(marker);
+    idlib_mutex_lock(&self->mutex);
+    if (0 == --self->running) {
+      idlib_condition_signal_all(&self->condition);
+    }
+  }
+  idlib_mutex_unlock(&self->mutex);
+  g_marker = NULL;
+}
+
+static void
+MarkThreads_destroy
+  (
+    MarkThreads* self
+  )
+{
+  idlib_mutex_lock(&self->mutex);
+  self->shutdown = true;
+  idlib_condition_signal_all(&self->condition);
+  idlib_mutex_unlock(&self->mutex);
+  for (size_t i = 1, n = self->numberOfMarkers; i < n; ++i) {
+    idlib_thread_uninitialize(&self->markers[i].thread);
+  }
+  for (size_t i = 0, n = self->numberOfMarkers; i < n; ++i) {
+    idlib_mutex_uninitialize(&self->markers[i].mutex);
+    free(self->markers[i].local.elements);
+    free(self->markers[i].shared.elements);
+  }
+  idlib_condition_uninitialize(&self->condition);
+  idlib_mutex_uninitialize(&self->mutex);
+  free(self->markers);
+  free(self);
+}
+
+static Shizu_Gcx_Status
+MarkThreads_create
+  (
+    MarkThreads** RETURN,
+    size_t numberOfMarkers
+  )
+{
+  MarkThreads* self = malloc(sizeof(MarkThreads));
+  if (!self) {
+    return Shizu_Gcx_Status_AllocationFailed;
+  }
+  self->markers = calloc(numberOfMarkers, sizeof(Marker));
+  if (!self->markers) {
+    free(self);
+    self = NULL;
+    return Shizu_Gcx_Status_AllocationFailed;
+  }
+  self->numberOfMarkers = 0;
+  self->idle = 0;
+  self->epoch = 0;
+  self->running = 0;
+  self->shutdown = false;
+#if 1 == Shizu_Configuration_WithGcCompactHeader
+  self->singleton = NULL;
+#endif
+  if (idlib_mutex_initialize(&self->mutex)) {
+    free(self->markers);
+    free(self);
+    self = NULL;
+    return Shizu_Gcx_Status_EnvironmentFailed;
+  }
+  if (idlib_condition_intialize(&self->condition)) {
+    idlib_mutex_uninitialize(&self->mutex);
+    free(self->markers);
+    free(self);
+    self = NULL;
+    return Shizu_Gcx_Status_EnvironmentFailed;
+  }
+  // MarkThreads_destroy only destroys the first numberOfMarkers markers.
+  for (size_t i = 0; i < numberOfMarkers; ++i) {
+    Marker* marker = &(self->markers[i]);
+    marker->markThreads = self;
+    marker->index = i;
+    marker->epoch = 0;
+    if (idlib_mutex_initialize(&marker->mutex)) {
+      MarkThreads_destroy(self);
+      self = NULL;
+      return Shizu_Gcx_Status_EnvironmentFailed;
+    }
+    if (i > 0 && idlib_thread_initialize(&marker->thread, &MarkThreads_procedure, marker)) {
+      idlib_mutex_uninitialize(&marker->mutex);
+      MarkThreads_destroy(self);
+      self = NULL;
+      return Shizu_Gcx_Status_EnvironmentFailed;
+    }
+    self->numberOfMarkers++;
+  }
+  *RETURN = self;
+  return Shizu_Gcx_Status_Success;
+}
+
+// Mark the objects in the gray lists of the type nodes (or the gray stack of the singleton) in parallel.
+// Objects which could not be pushed to a stack remain in (or are added to) the gray lists of the type nodes (or the gray stack of the singleton).
+static size_t
+MarkThreads_mark
+  (
+    MarkThreads* self,
+    Singleton* singleton
+  )
+{
+  // Distribute the gray objects to the shared stacks of the markers.
+  size_t k = 0;
+#if 1 == Shizu_Configuration_WithGcCompactHeader
+  self->singleton = singleton;
+  TagStack* grayStack = &(singleton->grayStack);
+  while (grayStack->size) {
+    Marker* marker = &(self->markers[k]);
+    if (!MarkStack_reserve(&marker->shared, 1)) {
+      break;
+    }
+    marker->shared.elements[marker->shared.size++] = grayStack->elements[--grayStack->size];
+    k = (k + 1) % self->numberOfMarkers;
+  }
+#else
+  TypeManager* typeManager = singleton->typeManager;
+  for (size_t i = 0, n = typeManager->cp; i < n; ++i) {
+    for (TypeNode* node = typeManager->p[i]; NULL != node; node = node->next) {
+      while (node->gray) {
+        Marker* marker = &(self->markers[k]);
+        if (!MarkStack_reserve(&marker->shared, 1)) {
+          break;
+        }
+        Tag* tag = node->gray;
+        node->gray = tag->gray;
+        tag->type = node;
+        marker->shared.elements[marker->shared.size++] = tag;
+        k = (k + 1) % self->numberOfMarkers;
+      }
+    }
+  }
+#endif
+  for (size_t i = 0, n = self->numberOfMarkers; i < n; ++i) {
+    self->markers[i].marked = 0;
+  }
+  self->idle = 0;
+  // Start the marker threads.
+  idlib_mutex_lock(&self->mutex);
+  self->epoch++;
+  self->running = self->numberOfMarkers - 1;
+  idlib_condition_signal_all(&self->condition);
+  idlib_mutex_unlock(&self->mutex);
+  // The calling thread executes marker 0.
+  g_marker = &(self->markers[0]);
+  Marker_run(g_marker);
+  g_marker = NULL;
+  // Wait for the marker threads.
+  idlib_mutex_lock(&self->mutex);
+  while (self->running) {
+    idlib_condition_wait(&self->condition, &self->mutex);
+  }
+  idlib_mutex_unlock(&self->mutex);
+  size_t marked = 0;
+  for (size_t i = 0, n = self->numberOfMarkers; i < n; ++i) {
+    marked += self->markers[i].marked;
+  }
+  return marked;
+}
+
+#endif
+
+/*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+
+static Shizu_Gcx_Status
+hashName
+  (
+    char const* name,
+    size_t nameLength,
+    size_t* hashValue
+  );
+
+static Shizu_Gcx_Status
+startupPlsManager
+  (
+  );
+
+static Shizu_Gcx_Status
+shutdownPlsManager
+  (
+  );
+
+static Shizu_Gcx_Status
+startupTypeManager
+  (
+  );
+
+static Shizu_Gcx_Status
+shutdownTypeManager
+  (
+  );
+
+#if 1 == Shizu_Configuration_WithGcSizeClassHeap
+
+static Shizu_Gcx_Status
+startupHeap
+  (
+  );
+
+static Shizu_Gcx_Status
+shutdownHeap
+  (
+  );
+
+static Page*
+Heap_allocatePage
+  (
+    SizeClass* sizeClass
+  );
+
+static void
+Heap_deallocatePage
+  (
+    Page* page
+  );
+
+static Tag*
+Heap_allocate
+  (
+    Heap* heap,
+    size_t n
+  );
+
+static void
+Heap_deallocate
+  (
+    Heap* heap,
+    Tag* tag
+  );
+
+static void
+Heap_trim
+  (
+    Heap* heap
+  );
+
+#endif
+
+static void
+deallocateTag
+  (
+    Singleton* singleton,
+    Tag* tag
+  );
+
+static Shizu_Gcx_Status
+getSingletonVar
+  (
+    Singleton*** singleton
+  );
+
+static Shizu_Gcx_Status
+lockMutex
+  ( 
+  );
+
+static Shizu_Gcx_Status
+unlockMutex
+  (
+  );
+
+static Shizu_Gcx_Status
+hashName
+  (
+    char const* name,
+    size_t nameLength,
+    size_t* hashValue
+  )
+{
+  size_t hv = nameLength;
+  for (size_t i = 0; i < nameLength; ++i) {
+    hv = hv * 37 + (size_t)name[i];
+  }
+  *hashValue = hv;
+  return Shizu_Gcx_Status_Success;
+}
+
+static Shizu_Gcx_Status
+startupPlsManager
+  (
+  )
+{
+  Singleton** singleton = NULL;
+  Shizu_Gcx_Status status;
+  status = getSingletonVar(&singleton);
+  if (status) {
+    return status;
+  }
+  (*singleton)->plsManager = malloc(sizeof(PlsManager));
+  if (!(*singleton)->plsManager) {
+    fprintf(stdout, "%s:%d: unable to allocate %zu Bytes\n", __FILE__, __LINE__, sizeof(PlsManager));
+    return Shizu_Gcx_Status_AllocationFailed;
+  }
+  (*singleton)->plsManager->p = malloc(sizeof(PlsNode*) * 8);
+  if (!(*singleton)->plsManager->p) {
+    fprintf(stdout, "%s:%d: unable to allocate %zu Bytes\n", __FILE__, __LINE__, sizeof(PlsNode*) * 8);
+    free((*singleton)->plsManager);
+    (*singleton)->plsManager = NULL;
+    return Shizu_Gcx_Status_AllocationFailed;
   }
   for (size_t i = 0, n = 8; i < n; ++i) {
     (*singleton)->plsManager->p[i] = NULL;
@@ -426,7 +1473,7 @@ shutdownTypeManager
         *previous = current->next;
         current = current->next;
         free(node->name);
-        free(node);
+        TypeNode_deallocate(node);
         (*singleton)->typeManager->sz--;
       } else {
         previous = &(current->next);
@@ -443,205 +1490,1668 @@ shutdownTypeManager
   return Shizu_Gcx_Status_Success;
 }
 
+#if 1 == Shizu_Configuration_WithGcSizeClassHeap
+
 static Shizu_Gcx_Status
-lockMutex
+startupHeap
   (
   )
 {
-#if (Shizu_Configuration_OperatingSystem == Shizu_Configuration_OperatingSystem_Linux)  || \
-    (Shizu_Configuration_OperatingSystem == Shizu_Configuration_OperatingSystem_Cygwin) || \
-    (Shizu_Configuration_OperatingSystem == Shizu_Configuration_OperatingSystem_Macos)
-
-  return _lockImpl();
-
-#elif Shizu_Configuration_OperatingSystem == Shizu_Configuration_OperatingSystem_Windows
-
-  // We use GetModuleHandle(NULL) for that we always use the same instance of lockImpl that always uses the same instance of g_lock.
-  HMODULE module = GetModuleHandle(NULL);
-  if (!module) {
-    return Shizu_Gcx_Status_LockFailed;
+  Singleton** singleton = NULL;
+  Shizu_Gcx_Status status;
+  status = getSingletonVar(&singleton);
+  if (status) {
+    return status;
   }
-  Shizu_Gcx_Status(*f)() = (Shizu_Gcx_Status(*)())GetProcAddress(module, "_lockImpl");
-  if (!f) {
-    return Shizu_Gcx_Status_LockFailed;
+  (*singleton)->heap = malloc(sizeof(Heap));
+  if (!(*singleton)->heap) {
+    fprintf(stdout, "%s:%d: unable to allocate %zu Bytes\n", __FILE__, __LINE__, sizeof(Heap));
+    return Shizu_Gcx_Status_AllocationFailed;
+  }
+  for (size_t i = 0, n = Heap_NumberOfSizeClasses; i < n; ++i) {
+    SizeClass* sizeClass = &((*singleton)->heap->sizeClasses[i]);
+    sizeClass->slotSize = (i + 1) * Heap_Granularity;
+    sizeClass->pages = NULL;
+    sizeClass->available = NULL;
+  }
+  return Shizu_Gcx_Status_Success;
+}
+
+static Shizu_Gcx_Status
+shutdownHeap
+  (
+  )
+{
+  Singleton** singleton = NULL;
+  Shizu_Gcx_Status status;
+  status = getSingletonVar(&singleton);
+  if (status) {
+    return status;
+  }
+  for (size_t i = 0, n = Heap_NumberOfSizeClasses; i < n; ++i) {
+    SizeClass* sizeClass = &((*singleton)->heap->sizeClasses[i]);
+    while (sizeClass->pages) {
+      Page* page = sizeClass->pages;
+      sizeClass->pages = page->next;
+      Heap_deallocatePage(page);
+    }
+    sizeClass->available = NULL;
+  }
+  free((*singleton)->heap);
+  (*singleton)->heap = NULL;
+  return Shizu_Gcx_Status_Success;
+}
+
+static Page*
+Heap_allocatePage
+  (
+    SizeClass* sizeClass
+  )
+{
+  void* p = NULL;
+#if (Shizu_Configuration_OperatingSystem == Shizu_Configuration_OperatingSystem_Linux)  || \
+    (Shizu_Configuration_OperatingSystem == Shizu_Configuration_OperatingSystem_Cygwin) || \
+    (Shizu_Configuration_OperatingSystem == Shizu_Configuration_OperatingSystem_Macos)
+  if (posix_memalign(&p, Heap_PageSize, Heap_PageSize)) {
+    p = NULL;
+  }
+#elif Shizu_Configuration_OperatingSystem == Shizu_Configuration_OperatingSystem_Windows
+  p = _aligned_malloc(Heap_PageSize, Heap_PageSize);
+#else
+  #error("operating system not (yet) supported")
+#endif
+  if (!p) {
+    fprintf(stdout, "%s:%d: unable to allocate %zu Bytes\n", __FILE__, __LINE__, (size_t)Heap_PageSize);
+    return NULL;
+  }
+  Page* page = (Page*)p;
+  page->sizeClass = sizeClass;
+  page->used = 0;
+  page->bump = ((char*)page) + Page_SlotsOffset;
+  page->end = page->bump + ((Heap_PageSize - Page_SlotsOffset) / sizeClass->slotSize) * sizeClass->slotSize;
+  page->free = NULL;
+  page->next = sizeClass->pages;
+  sizeClass->pages = page;
+  page->nextAvailable = sizeClass->available;
+  sizeClass->available = page;
+  page->available = true;
+  return page;
+}
+
+static void
+Heap_deallocatePage
+  (
+    Page* page
+  )
+{
+#if (Shizu_Configuration_OperatingSystem == Shizu_Configuration_OperatingSystem_Linux)  || \
+    (Shizu_Configuration_OperatingSystem == Shizu_Configuration_OperatingSystem_Cygwin) || \
+    (Shizu_Configuration_OperatingSystem == Shizu_Configuration_OperatingSystem_Macos)
+  free(page);
+#elif Shizu_Configuration_OperatingSystem == Shizu_Configuration_OperatingSystem_Windows
+  _aligned_free(page);
+#else
+  #error("operating system not (yet) supported")
+#endif
+}
+
+static Tag*
+Heap_allocate
+  (
+    Heap* heap,
+    size_t n
+  )
+{
+  Shizu_Cxx_Debug_assert(0 < n && n <= Heap_MaximumSlotSize);
+  SizeClass* sizeClass = &(heap->sizeClasses[(n - 1) / Heap_Granularity]);
+  Page* page = sizeClass->available;
+  if (!page) {
+    page = Heap_allocatePage(sizeClass);
+    if (!page) {
+      return NULL;
+    }
+  }
+  Tag* tag = NULL;
+  if (page->free) {
+    Slot* slot = page->free;
+    page->free = slot->next;
+    tag = (Tag*)slot;
+  } else {
+    tag = (Tag*)page->bump;
+    page->bump += sizeClass->slotSize;
+  }
+  page->used++;
+  if (!page->free && page->bump == page->end) {
+    // The page is full. It is the head of the list of available pages.
+    sizeClass->available = page->nextAvailable;
+    page->nextAvailable = NULL;
+    page->available = false;
+  }
+  return tag;
+}
+
+static void
+Heap_deallocate
+  (
+    Heap* heap,
+    Tag* tag
+  )
+{
+  Page* page = (Page*)(((uintptr_t)tag) & ~((uintptr_t)(Heap_PageSize - 1)));
+  Slot* slot = (Slot*)tag;
+#if 1 == Shizu_Configuration_WithGcCompactHeader
+  slot->flags = NULL;
+#endif
+  slot->next = page->free;
+  page->free = slot;
+  page->used--;
+  if (!page->available) {
+    page->nextAvailable = page->sizeClass->available;
+    page->sizeClass->available = page;
+    page->available = true;
+  }
+}
+
+static void
+Heap_trim
+  (
+    Heap* heap
+  )
+{
+  for (size_t i = 0, n = Heap_NumberOfSizeClasses; i < n; ++i) {
+    SizeClass* sizeClass = &(heap->sizeClasses[i]);
+    // Release all empty pages but one and rebuild the list of available pages.
+    bool keptEmpty = false;
+    sizeClass->available = NULL;
+    Page** previous = &(sizeClass->pages);
+    Page* current = sizeClass->pages;
+    while (current) {
+      if (!current->used && keptEmpty) {
+        Page* page = current;
+        *previous = current->next;
+        current = current->next;
+        Heap_deallocatePage(page);
+      } else {
+        if (!current->used) {
+          keptEmpty = true;
+          // Reset the page such that slots are handed out in address order again.
+          current->free = NULL;
+          current->bump = ((char*)current) + Page_SlotsOffset;
+        }
+        if (current->free || current->bump != current->end) {
+          current->nextAvailable = sizeClass->available;
+          sizeClass->available = current;
+          current->available = true;
+        } else {
+          current->nextAvailable = NULL;
+          current->available = false;
+        }
+        previous = &(current->next);
+        current = current->next;
+      }
+    }
+  }
+}
+
+#endif
+
+// Allocate a tag for an object of the specified size from the thread-local allocation buffer of the context or by malloc.
+// Return the null pointer if the thread-local allocation buffer is empty or malloc failed.
+static inline Tag*
+ThreadContext_allocateTag
+  (
+    ThreadContext* self,
+    size_t size
+  )
+{
+#if 1 == Shizu_Configuration_WithGcCompactHeader
+  if (sizeof(Tag) + size > Heap_MaximumSlotSize) {
+    // Large objects are allocated under the lock by allocateLargeObject.
+    return NULL;
+  }
+  Slot** slots = &(self->slots[(sizeof(Tag) + size - 1) / Heap_Granularity]);
+  Slot* slot = *slots;
+  if (!slot) {
+    return NULL;
+  }
+  *slots = slot->next;
+  // The header remains the null pointer until ThreadContext_addObject publishes the object.
+  return (Tag*)slot;
+#else
+#if 1 == Shizu_Configuration_WithGcSizeClassHeap
+  if (sizeof(Tag) + size <= Heap_MaximumSlotSize) {
+    Slot** slots = &(self->slots[(sizeof(Tag) + size - 1) / Heap_Granularity]);
+    Slot* slot = *slots;
+    if (!slot) {
+      return NULL;
+    }
+    *slots = slot->next;
+    Tag* tag = (Tag*)slot;
+    tag->flags = (void*)(uintptr_t)Tag_Flags_Slot;
+    return tag;
+  }
+#endif
+  if (SIZE_MAX - sizeof(LargeObject) - sizeof(Tag) < size) {
+    return NULL;
+  }
+  LargeObject* largeObject = malloc(sizeof(LargeObject) + sizeof(Tag) + size);
+  if (!largeObject) {
+    return NULL;
+  }
+  largeObject->size = sizeof(Tag) + size;
+  Tag* tag = (Tag*)(largeObject + 1);
+  tag->flags = 0;
+  return tag;
+#endif
+}
+
+#if 1 == Shizu_Configuration_WithGcSizeClassHeap
+
+// Reserve at most ThreadContext_SlotsPerRefill slots for the thread-local allocation buffer of the size class of an object of the specified size.
+// Must be invoked under the lock.
+static void
+ThreadContext_refill
+  (
+    ThreadContext* self,
+    Heap* heap,
+    size_t size
+  )
+{
+  if (sizeof(Tag) + size > Heap_MaximumSlotSize) {
+    return;
+  }
+  Slot** slots = &(self->slots[(sizeof(Tag) + size - 1) / Heap_Granularity]);
+  // Append the slots such that they are handed out in the order the heap returned them.
+  while (*slots) {
+    slots = &((*slots)->next);
+  }
+  for (size_t i = 0; i < ThreadContext_SlotsPerRefill; ++i) {
+    Slot* slot = (Slot*)Heap_allocate(heap, sizeof(Tag) + size);
+    if (!slot) {
+      break;
+    }
+  #if 1 == Shizu_Configuration_WithGcCompactHeader
+    // The slot is not yet an object.
+    slot->flags = NULL;
+  #endif
+    slot->next = NULL;
+    *slots = slot;
+    slots = &(slot->next);
+  }
+}
+
+#endif
+
+// Initialize the tag of an object of the specified type and add the tag to the object list of the context.
+// Return a pointer to the object.
+static inline void*
+ThreadContext_addObject
+  (
+    ThreadContext* self,
+    Tag* tag,
+    TypeNode* typeNode
+  )
+{
+#if 1 == Shizu_Configuration_WithGcCompactHeader
+  uintptr_t flags = (uintptr_t)typeNode | Tag_Flags_White | Tag_Flags_Slot | Tag_Flags_New;
+  #if 1 != Shizu_Configuration_WithGcGenerational
+    flags |= Tag_Flags_Old;
+  #endif
+  // The objects are enumerated without synchronizing with this thread.
+  Atomic_storePointer(&tag->flags, (void*)flags);
+#else
+  Tag_setWhite(tag);
+  tag->type = typeNode;
+#if 1 != Shizu_Configuration_WithGcGenerational
+  tag->flags = (void*)(Tag_Flags_Old | (uintptr_t)tag->flags);
+#endif
+  tag->next = self->objects;
+  self->objects = tag;
+#endif
+  return (void*)(tag + 1);
+}
+
+#if 1 == Shizu_Configuration_WithGcCompactHeader
+
+// Allocate a large object of the specified type and size and add it to the large objects of the singleton.
+// Return a pointer to the object or the null pointer if malloc failed.
+// Must be invoked under the lock.
+static void*
+allocateLargeObject
+  (
+    Singleton* singleton,
+    TypeNode* typeNode,
+    size_t size
+  )
+{
+  if (SIZE_MAX - sizeof(LargeObject) - sizeof(Tag) < size) {
+    return NULL;
+  }
+  LargeObject* largeObject = malloc(sizeof(LargeObject) + sizeof(Tag) + size);
+  if (!largeObject) {
+    return NULL;
+  }
+  Tag* tag = (Tag*)(largeObject + 1);
+  largeObject->size = sizeof(Tag) + size;
+  uintptr_t flags = (uintptr_t)typeNode | Tag_Flags_White | Tag_Flags_New;
+#if 1 != Shizu_Configuration_WithGcGenerational
+  flags |= Tag_Flags_Old;
+#endif
+  tag->flags = (void*)flags;
+  largeObject->next = singleton->largeObjects;
+  singleton->largeObjects = largeObject;
+  return (void*)(tag + 1);
+}
+
+#endif
+
+#if (Shizu_Configuration_OperatingSystem == Shizu_Configuration_OperatingSystem_Linux)  || \
+    (Shizu_Configuration_OperatingSystem == Shizu_Configuration_OperatingSystem_Cygwin) || \
+    (Shizu_Configuration_OperatingSystem == Shizu_Configuration_OperatingSystem_Macos)
+
+  static void
+  onThreadExit
+    (
+      void* context
+    );
+
+#elif Shizu_Configuration_OperatingSystem == Shizu_Configuration_OperatingSystem_Windows
+
+  static VOID NTAPI
+  onThreadExit
+    (
+      PVOID context
+    );
+
+#else
+
+  #error("operating system not (yet) supported")
+
+#endif
+
+// Create a context for the calling thread and register it with the singleton.
+// Must be invoked under the lock.
+static Shizu_Gcx_Status
+registerThreadContext
+  (
+    Singleton* singleton,
+    ThreadContext** threadContext
+  )
+{
+#if (Shizu_Configuration_OperatingSystem == Shizu_Configuration_OperatingSystem_Linux)  || \
+    (Shizu_Configuration_OperatingSystem == Shizu_Configuration_OperatingSystem_Cygwin) || \
+    (Shizu_Configuration_OperatingSystem == Shizu_Configuration_OperatingSystem_Macos)
+  if (!g_threadContextKeyCreated) {
+    if (pthread_key_create(&g_threadContextKey, &onThreadExit)) {
+      return Shizu_Gcx_Status_AllocationFailed;
+    }
+    g_threadContextKeyCreated = true;
+  }
+#elif Shizu_Configuration_OperatingSystem == Shizu_Configuration_OperatingSystem_Windows
+  if (FLS_OUT_OF_INDEXES == g_threadContextKey) {
+    g_threadContextKey = FlsAlloc(&onThreadExit);
+    if (FLS_OUT_OF_INDEXES == g_threadContextKey) {
+      return Shizu_Gcx_Status_AllocationFailed;
+    }
+  }
+#endif
+  ThreadContext* context = malloc(sizeof(ThreadContext));
+  if (!context) {
+    return Shizu_Gcx_Status_AllocationFailed;
+  }
+  // The destructor is invoked only if the value is not the null pointer.
+#if (Shizu_Configuration_OperatingSystem == Shizu_Configuration_OperatingSystem_Linux)  || \
+    (Shizu_Configuration_OperatingSystem == Shizu_Configuration_OperatingSystem_Cygwin) || \
+    (Shizu_Configuration_OperatingSystem == Shizu_Configuration_OperatingSystem_Macos)
+  if (pthread_setspecific(g_threadContextKey, context)) {
+    free(context);
+    return Shizu_Gcx_Status_AllocationFailed;
+  }
+#elif Shizu_Configuration_OperatingSystem == Shizu_Configuration_OperatingSystem_Windows
+  if (!FlsSetValue(g_threadContextKey, context)) {
+    free(context);
+    return Shizu_Gcx_Status_AllocationFailed;
+  }
+#endif
+  context->singleton = NULL;
+#if 1 != Shizu_Configuration_WithGcCompactHeader
+  context->objects = NULL;
+  context->exited = false;
+#endif
+#if 1 == Shizu_Configuration_WithGcSizeClassHeap
+  for (size_t i = 0, n = Heap_NumberOfSizeClasses; i < n; ++i) {
+    context->slots[i] = NULL;
+  }
+#endif
+  g_threadContext = context;
+  g_threadContextGeneration = Atomic_loadSize(&g_threadContextsGeneration);
+  context->next = singleton->threadContexts;
+  singleton->threadContexts = context;
+  Atomic_storePointer((void* volatile*)&context->singleton, singleton);
+  *threadContext = context;
+  return Shizu_Gcx_Status_Success;
+}
+
+#if 1 != Shizu_Configuration_WithGcCompactHeader
+
+// Add the objects allocated by the thread of a context to the lists of their type nodes.
+// Must be invoked under the lock. The thread of the context may not allocate concurrently.
+static void
+mergeThreadContext
+  (
+    ThreadContext* context
+  )
+{
+  while (context->objects) {
+    Tag* tag = context->objects;
+    context->objects = tag->next;
+    TypeNode* typeNode = tag->type;
+    typeNode->usage++;
+    countAllocated(typeNode, tag);
+    // The object was colored black if it was allocated and marked during the collection in progress when it was allocated.
+    Tag_setWhite(tag);
+  #if 1 == Shizu_Configuration_WithGcGenerational
+    tag->next = typeNode->young;
+    typeNode->young = tag;
+  #else
+    tag->next = typeNode->all;
+    typeNode->all = tag;
+  #endif
+  }
+}
+
+// Add the objects allocated by the threads to the lists of their type nodes.
+// Deallocate the contexts of the threads which exited.
+// Must be invoked under the lock. No other thread may allocate concurrently.
+static void
+mergeThreadContexts
+  (
+    Singleton* singleton
+  )
+{
+  ThreadContext** previous = &(singleton->threadContexts);
+  ThreadContext* current = singleton->threadContexts;
+  while (current) {
+    mergeThreadContext(current);
+    if (current->exited) {
+      ThreadContext* context = current;
+      *previous = current->next;
+      current = current->next;
+      free(context);
+    } else {
+      previous = &(current->next);
+      current = current->next;
+    }
+  }
+}
+
+#endif
+
+// Merge the contexts (if the compact header is disabled), unregister them from the singleton, and deallocate them.
+// Must be invoked under the lock before the heap is shut down. No other thread may allocate concurrently.
+static void
+unregisterThreadContexts
+  (
+    Singleton* singleton
+  )
+{
+#if 1 != Shizu_Configuration_WithGcCompactHeader
+  mergeThreadContexts(singleton);
+#endif
+  while (singleton->threadContexts) {
+    ThreadContext* context = singleton->threadContexts;
+    singleton->threadContexts = context->next;
+    // The slots are released when the heap is shut down.
+    free(context);
+  }
+  // The thread-local variables of the threads still point to the deallocated contexts.
+  Atomic_addSize(&g_threadContextsGeneration, 1);
+}
+
+// Unregister the context of the calling thread from the singleton and deallocate it.
+// Must be invoked under the lock. The context must be registered with the singleton.
+static void
+exitThreadContext
+  (
+    Singleton* singleton,
+    ThreadContext* context
+  )
+{
+#if 1 == Shizu_Configuration_WithGcSizeClassHeap
+  // Return the slots of the thread-local allocation buffers to their pages.
+  for (size_t i = 0, n = Heap_NumberOfSizeClasses; i < n; ++i) {
+    while (context->slots[i]) {
+      Slot* slot = context->slots[i];
+      context->slots[i] = slot->next;
+      Heap_deallocate(singleton->heap, (Tag*)slot);
+    }
+  }
+#endif
+#if 1 != Shizu_Configuration_WithGcCompactHeader
+  if (Shizu_Gcx_Phase_None != singleton->phase) {
+    // The objects allocated during a collection are not collected by that collection.
+    // They are merged and the context is deallocated when the next collection begins.
+    context->exited = true;
+    return;
+  }
+  mergeThreadContext(context);
+#endif
+  ThreadContext** previous = &(singleton->threadContexts);
+  while (*previous != context) {
+    previous = &((*previous)->next);
+  }
+  *previous = context->next;
+  free(context);
+}
+
+#if (Shizu_Configuration_OperatingSystem == Shizu_Configuration_OperatingSystem_Linux)  || \
+    (Shizu_Configuration_OperatingSystem == Shizu_Configuration_OperatingSystem_Cygwin) || \
+    (Shizu_Configuration_OperatingSystem == Shizu_Configuration_OperatingSystem_Macos)
+
+  static void
+  onThreadExit
+    (
+      void* context
+    )
+
+#elif Shizu_Configuration_OperatingSystem == Shizu_Configuration_OperatingSystem_Windows
+
+  static VOID NTAPI
+  onThreadExit
+    (
+      PVOID context
+    )
+
+#endif
+{
+  // The context might have been deallocated by the shut down of the singleton.
+  // Its thread-local variables are still accessible.
+  if (lockMutex()) {
+    return;
+  }
+  if (context == getThreadContext()) {
+    Singleton** singleton = NULL;
+    if (!getSingletonVar(&singleton)) {
+      exitThreadContext(*singleton, (ThreadContext*)context);
+    }
+    g_threadContext = NULL;
+  }
+  unlockMutex();
+}
+
+static void
+deallocateTag
+  (
+    Singleton* singleton,
+    Tag* tag
+  )
+{
+#if 1 == Shizu_Configuration_WithGcSizeClassHeap
+  if (Tag_Flags_Slot & (uintptr_t)tag->flags) {
+    Heap_deallocate(singleton->heap, tag);
+    return;
+  }
+#endif
+#if 1 == Shizu_Configuration_WithGcCompactHeader
+  // The large object must have been removed from the large objects of the singleton.
+#endif
+  free(((LargeObject*)tag) - 1);
+}
+
+static Shizu_Gcx_Status
+lockMutex
+  (
+  )
+{
+#if (Shizu_Configuration_OperatingSystem == Shizu_Configuration_OperatingSystem_Linux)  || \
+    (Shizu_Configuration_OperatingSystem == Shizu_Configuration_OperatingSystem_Cygwin) || \
+    (Shizu_Configuration_OperatingSystem == Shizu_Configuration_OperatingSystem_Macos)
+
+  return _lockImpl();
+
+#elif Shizu_Configuration_OperatingSystem == Shizu_Configuration_OperatingSystem_Windows
+
+  // We use GetModuleHandle(NULL) for that we always use the same instance of lockImpl that always uses the same instance of g_lock.
+  // The address is resolved once. Concurrent resolutions store the same address.
+  static Shizu_Gcx_Status(* volatile f)() = NULL;
+  if (!f) {
+    HMODULE module = GetModuleHandle(NULL);
+    if (!module) {
+      return Shizu_Gcx_Status_LockFailed;
+    }
+    f = (Shizu_Gcx_Status(*)())GetProcAddress(module, "_lockImpl");
+    if (!f) {
+      return Shizu_Gcx_Status_LockFailed;
+    }
+  }
+  return (*f)();
+
+#else
+
+  #error("operating system not (yet) supported")
+
+#endif
+}
+
+static Shizu_Gcx_Status
+unlockMutex
+  (
+  )
+{
+#if (Shizu_Configuration_OperatingSystem == Shizu_Configuration_OperatingSystem_Linux)  || \
+    (Shizu_Configuration_OperatingSystem == Shizu_Configuration_OperatingSystem_Cygwin) || \
+    (Shizu_Configuration_OperatingSystem == Shizu_Configuration_OperatingSystem_Macos)
+
+  return _unlockImpl();
+
+#elif Shizu_Configuration_OperatingSystem == Shizu_Configuration_OperatingSystem_Windows
+
+  // We use GetModuleHandle(NULL) for that we always use the same instance of unlockImpl that always uses the same instance of g_lock.
+  // The address is resolved once. Concurrent resolutions store the same address.
+  static Shizu_Gcx_Status(* volatile f)() = NULL;
+  if (!f) {
+    HMODULE module = GetModuleHandle(NULL);
+    if (!module) {
+      return Shizu_Gcx_Status_LockFailed;
+    }
+    f = (Shizu_Gcx_Status(*)())GetProcAddress(module, "_unlockImpl");
+    if (!f) {
+      return Shizu_Gcx_Status_LockFailed;
+    }
+  }
+  return (*f)();
+
+#else
+
+  #error("operating system not (yet) supported")
+
+#endif
+}
+
+static Shizu_Gcx_Status
+getSingletonVar
+  (
+    Singleton*** singleton
+  )
+{
+#if (Shizu_Configuration_OperatingSystem == Shizu_Configuration_OperatingSystem_Linux)  || \
+    (Shizu_Configuration_OperatingSystem == Shizu_Configuration_OperatingSystem_Cygwin) || \
+    (Shizu_Configuration_OperatingSystem == Shizu_Configuration_OperatingSystem_Macos)
+
+  return _getSingletonVar(singleton);
+
+#elif Shizu_Configuration_OperatingSystem == Shizu_Configuration_OperatingSystem_Windows
+
+  // We use GetModuleHandle(NULL) for that we always use the same instance of unlockImpl that always uses the same instance of g_lock.
+  // The address is resolved once. Concurrent resolutions store the same address.
+  static Shizu_Gcx_Status(* volatile f)() = NULL;
+  if (!f) {
+    HMODULE module = GetModuleHandle(NULL);
+    if (!module) {
+      return Shizu_Gcx_Status_LockFailed;
+    }
+    f = (Shizu_Gcx_Status(*)())GetProcAddress(module, "_getSingletonVar");
+    if (!f) {
+      return Shizu_Gcx_Status_LockFailed;
+    }
+  }
+  return (*f)(singleton);
+
+#else
+
+  #error("operating system not (yet) supported")
+
+#endif
+}
+
+Shizu_Gcx_Status
+Shizu_Gcx_startup
+  (
+  )
+{
+  Shizu_Gcx_Status status;
+  status = lockMutex();
+  if (status) {
+    return status;
+  }
+  Singleton** singleton = NULL;
+  status = getSingletonVar(&singleton);
+  if (status) {
+    unlockMutex();
+    return status;
+  }
+  if (!(*singleton)) {
+    (*singleton) = malloc(sizeof(Singleton));
+    if (!(*singleton)) {
+      unlockMutex();
+      return Shizu_Gcx_Status_AllocationFailed;
+    }
+    (*singleton)->referenceCount = 0;
+    (*singleton)->typeManager = NULL;
+    (*singleton)->plsManager = NULL;
+#if 1 == Shizu_Configuration_WithGcSizeClassHeap
+    (*singleton)->heap = NULL;
+#endif
+    (*singleton)->rememberedSet.elements = NULL;
+    (*singleton)->rememberedSet.size = 0;
+    (*singleton)->rememberedSet.capacity = 0;
+    (*singleton)->rememberedSet.overflow = false;
+#if 1 == Shizu_Configuration_WithGcParallelMark
+    (*singleton)->markThreads = NULL;
+#endif
+    (*singleton)->phase = Shizu_Gcx_Phase_None;
+    (*singleton)->collection = Shizu_Gcx_Collection_Major;
+    (*singleton)->lazyDead = 0;
+    (*singleton)->lazyLive = 0;
+#if 1 == Shizu_Configuration_WithGcCompactHeader
+    (*singleton)->finalizationQueue.elements = NULL;
+    (*singleton)->finalizationQueue.size = 0;
+    (*singleton)->finalizationQueue.capacity = 0;
+    (*singleton)->grayStack.elements = NULL;
+    (*singleton)->grayStack.size = 0;
+    (*singleton)->grayStack.capacity = 0;
+    (*singleton)->grayStackOverflow = false;
+    (*singleton)->largeObjects = NULL;
+    (*singleton)->sweepCursor.sizeClass = 0;
+    (*singleton)->sweepCursor.page = NULL;
+    (*singleton)->sweepCursor.slot = NULL;
+    (*singleton)->sweepCursor.largeObject = NULL;
+#else
+    (*singleton)->finalizationQueue = NULL;
+#endif
+    (*singleton)->lazySweeping = 0;
+    (*singleton)->threadContexts = NULL;
+  }
+  if (0 == (*singleton)->referenceCount) {
+    status = startupTypeManager();
+    if (status) {
+      unlockMutex();
+      return status;
+    }
+    status = startupPlsManager();
+    if (status) {
+      shutdownTypeManager();
+      unlockMutex();
+      return status;
+    }
+#if 1 == Shizu_Configuration_WithGcSizeClassHeap
+    status = startupHeap();
+    if (status) {
+      shutdownPlsManager();
+      shutdownTypeManager();
+      unlockMutex();
+      return status;
+    }
+#endif
+    (*singleton)->referenceCount++;
+    unlockMutex();
+    return Shizu_Gcx_Status_Success;
+  } else if (INT64_MAX == (*singleton)->referenceCount) {
+    unlockMutex();
+    return Shizu_Gcx_Status_ReferenceCounterOverflow;
+  } else {
+    (*singleton)->referenceCount++;
+    unlockMutex();
+    return Shizu_Gcx_Status_Success;
+  }
+}
+
+Shizu_Gcx_Status
+Shizu_Gcx_shutdown
+  ( 
+  )
+{
+  Shizu_Gcx_Status status;
+
+  status = lockMutex();
+  if (status) {
+    return status;
+  }
+  Singleton** singleton = NULL;
+  status = getSingletonVar(&singleton);
+  if (status) {
+    unlockMutex();
+    return status;
+  }
+  if (1 == (*singleton)->referenceCount) {
+    unregisterThreadContexts(*singleton);
+    // Dead objects remaining in the finalization queue are deallocated without invoking their finalize callbacks.
+#if 1 == Shizu_Configuration_WithGcCompactHeader
+    while ((*singleton)->finalizationQueue.size) {
+      Tag* tag = (*singleton)->finalizationQueue.elements[--(*singleton)->finalizationQueue.size];
+      deallocateTag(*singleton, tag);
+    }
+    free((*singleton)->finalizationQueue.elements);
+    (*singleton)->finalizationQueue.elements = NULL;
+    free((*singleton)->grayStack.elements);
+    (*singleton)->grayStack.elements = NULL;
+    // The objects in slots are released when the heap is shut down.
+    while ((*singleton)->largeObjects) {
+      LargeObject* largeObject = (*singleton)->largeObjects;
+      (*singleton)->largeObjects = largeObject->next;
+      free(largeObject);
+    }
+#else
+    while ((*singleton)->finalizationQueue) {
+      Tag* tag = (*singleton)->finalizationQueue;
+      (*singleton)->finalizationQueue = tag->next;
+      tag->type->usage--;
+      deallocateTag(*singleton, tag);
+    }
+#endif
+#if 1 == Shizu_Configuration_WithGcParallelMark
+    if ((*singleton)->markThreads) {
+      MarkThreads_destroy((*singleton)->markThreads);
+      (*singleton)->markThreads = NULL;
+    }
+#endif
+#if 1 == Shizu_Configuration_WithGcSizeClassHeap
+    status = shutdownHeap();
+    if (status) {
+      /*We have to ignore this. Must not be reached. Proof of non-reachability required.*/
+    }
+#endif
+    status = shutdownPlsManager();
+    if (status) {
+      /*We have to ignore this. Must not be reached. Proof of non-reachability required.*/
+    }
+    status = shutdownTypeManager();
+    if (status) {
+      /*We have to ignore this. Must not be reached. Proof of non-reachability required.*/
+    }
+    free((*singleton)->rememberedSet.elements);
+    (*singleton)->rememberedSet.elements = NULL;
+    free(*singleton);
+    (*singleton) = NULL;
+    unlockMutex();
+    return Shizu_Gcx_Status_Success;
+  } else if (INT64_MIN == g_singleton->referenceCount) {
+    unlockMutex();
+    status = Shizu_Gcx_Status_ReferenceCounterOverflow;
+    return status;
+  } else {
+    (*singleton)->referenceCount--; 
+    unlockMutex();
+    return Shizu_Gcx_Status_Success;
+  }
+}
+
+Shizu_Gcx_Status
+Shizu_Gcx_registerType
+  (
+    char const* name,
+    size_t nameLength,
+    void* visitContext,
+    Shizu_Gcx_VisitCallback* visitCallback,
+    void* finalizeContext,
+    Shizu_Gcx_FinalizeCallback* finalizeCallback
+  )
+{
+  Shizu_Gcx_Status status;
+
+  if (!name || !visitCallback) {
+    status = Shizu_Gcx_Status_ArgumentInvalid;
+    return status;
+  }
+
+  status = lockMutex();
+  if (status) {
+    return status;
+  }
+
+  Singleton** singleton = NULL;
+  status = getSingletonVar(&singleton);
+  if (status) {
+    unlockMutex();
+    return status;
+  }
+ 
+  if (!(*singleton)->typeManager) {
+    unlockMutex();
+    status = Shizu_Gcx_Status_NotInitialized;
+    return status;
+  }
+
+  size_t hashValue;
+  status = hashName(name, nameLength, &hashValue);
+  if (status) {
+    unlockMutex();
+    return status;
+  }
+
+  size_t hashIndex = hashValue % (*singleton)->typeManager->cp;
+  
+  for (TypeNode* node = (*singleton)->typeManager->p[hashIndex]; NULL != node; node = node->next) {
+    if (node->hashValue == hashValue && node->nameLength == nameLength) {
+      if (!memcmp(node->name, name, nameLength)) {
+        unlockMutex();
+        status = Shizu_Gcx_Status_TypeExists;
+        return status;
+      }
+    }
+  }
+
+  // Too many types?
+  if ((*singleton)->typeManager->sz == SIZE_MAX / sizeof(TypeNode*)) {
+    unlockMutex();
+    return Shizu_Gcx_Status_AllocationFailed;
+  }
+
+  TypeNode* node = TypeNode_allocate();
+  if (!node) {
+    unlockMutex();
+    return Shizu_Gcx_Status_AllocationFailed;
+  }
+
+  node->name = malloc(nameLength > 0 ? nameLength : 1);
+  if (!node->name) {
+    TypeNode_deallocate(node);
+    unlockMutex();
+    return Shizu_Gcx_Status_AllocationFailed;
+  }
+  memcpy(node->name, name, nameLength);
+  node->nameLength = nameLength;
+  node->hashValue = hashValue;
+
+  node->visitContext = visitContext;
+  node->visitCallback = visitCallback;
+
+  node->finalizeContext = finalizeContext;
+  node->finalizeCallback = finalizeCallback;
+
+  node->usage = 1;
+
+  node->liveObjects = 0;
+  node->liveBytes = 0;
+  node->allocatedObjects = 0;
+  node->allocatedBytes = 0;
+  node->freedObjects = 0;
+  node->freedBytes = 0;
+
+  node->all = NULL;
+  node->young = NULL;
+  node->sweepAll = NULL;
+  node->sweepYoung = NULL;
+  node->gray = NULL;
+
+  node->next = (*singleton)->typeManager->p[hashIndex];
+  (*singleton)->typeManager->p[hashIndex] = node;
+  (*singleton)->typeManager->sz++;
+  
+  unlockMutex();
+  return Shizu_Gcx_Status_Success;
+}
+
+Shizu_Gcx_Status
+Shizu_Gcx_unregisterType
+  (
+    char const* name,
+    size_t nameLength
+  )  
+{
+  if (!name) {
+    return Shizu_Gcx_Status_ArgumentInvalid;
+  }
+
+  Shizu_Gcx_Status status;
+
+  status = lockMutex();
+  if (status) {
+    return status;
+  }
+
+  Singleton** singleton = NULL;
+  status = getSingletonVar(&singleton);
+  if (status) {
+    unlockMutex();
+    return status;
+  }
+
+  size_t hashValue;
+  status = hashName(name, nameLength, &hashValue);
+  if (status) {
+    unlockMutex();
+    return status;
+  }
+
+  size_t hashIndex = hashValue % (*singleton)->typeManager->cp;
+
+  for (TypeNode* node = (*singleton)->typeManager->p[hashIndex]; NULL != node; node = node->next) {
+    if (node->hashValue == hashValue && node->nameLength == nameLength) {
+      if (!memcmp(node->name, name, nameLength)) {
+        if (!node->usage) {
+          unlockMutex();
+          status = Shizu_Gcx_Status_ReferenceCounterOverflow;
+          return status;
+        } else {
+          node->usage--;
+          unlockMutex();
+          status = Shizu_Gcx_Status_TypeUsed;
+          return status;
+        }
+      }
+    }
+  }
+  unlockMutex();
+  status = Shizu_Gcx_Status_TypeNotExists;
+  return status;
+}
+
+Shizu_Gcx_Status
+Shizu_Gcx_acquireType
+  (
+    char const* name,
+    size_t nameLength,
+    Shizu_Gcx_Type** type
+  )
+{
+  Shizu_Gcx_Status status;
+
+  if (!name) {
+    status = Shizu_Gcx_Status_ArgumentInvalid;
+    return status;
+  }
+
+  status = lockMutex();
+  if (status) {
+    return status;
   }
-  return (*f)();
-
-#else
 
-  #error("operating system not (yet) supported")
+  Singleton** singleton = NULL;
+  status = getSingletonVar(&singleton);
+  if (status) {
+    unlockMutex();
+    return status;
+  }
 
-#endif
+  if (!(*singleton)->typeManager) {
+    unlockMutex();
+    status = Shizu_Gcx_Status_NotInitialized;
+    return status;
+  }
+
+  size_t hashValue;
+  status = hashName(name, nameLength, &hashValue);
+  if (status) {
+    unlockMutex();
+    return status;
+  }
+
+  size_t hashIndex = hashValue % (*singleton)->typeManager->cp;
+
+  for (TypeNode* node = (*singleton)->typeManager->p[hashIndex]; NULL != node; node = node->next) {
+    if (node->hashValue == hashValue && node->nameLength == nameLength) {
+      if (!memcmp(node->name, name, nameLength)) {
+        if (INT64_MAX == node->usage) {
+          unlockMutex();
+          status = Shizu_Gcx_Status_ReferenceCounterOverflow;
+          return status;
+        } else {
+          node->usage++;
+        }
+        *type = (Shizu_Gcx_Type*)node;
+        unlockMutex();
+        return Shizu_Gcx_Status_Success;
+      }
+    }
+  }
+  unlockMutex();
+  return Shizu_Gcx_Status_TypeNotExists;
 }
 
-static Shizu_Gcx_Status
-unlockMutex
+Shizu_Gcx_Status
+Shizu_Gcx_relinquishType
   (
+    Shizu_Gcx_Type* type
   )
 {
-#if (Shizu_Configuration_OperatingSystem == Shizu_Configuration_OperatingSystem_Linux)  || \
-    (Shizu_Configuration_OperatingSystem == Shizu_Configuration_OperatingSystem_Cygwin) || \
-    (Shizu_Configuration_OperatingSystem == Shizu_Configuration_OperatingSystem_Macos)
+  Shizu_Gcx_Status status;
 
-  return _unlockImpl();
+  if (!type) {
+    status = Shizu_Gcx_Status_ArgumentInvalid;
+    return status;
+  }
 
-#elif Shizu_Configuration_OperatingSystem == Shizu_Configuration_OperatingSystem_Windows
+  status = lockMutex();
+  if (status) {
+    return status;
+  }
 
-  // We use GetModuleHandle(NULL) for that we always use the same instance of unlockImpl that always uses the same instance of g_lock.
-  HMODULE module = GetModuleHandle(NULL);
-  if (!module) {
-    return Shizu_Gcx_Status_LockFailed;
+  Singleton** singleton = NULL;
+  status = getSingletonVar(&singleton);
+  if (status) {
+    unlockMutex();
+    return status;
   }
-  Shizu_Gcx_Status(*f)() = (Shizu_Gcx_Status(*)())GetProcAddress(module, "_unlockImpl");
-  if (!f) {
-    return Shizu_Gcx_Status_LockFailed;
+
+  if (!(*singleton)->typeManager) {
+    unlockMutex();
+    status = Shizu_Gcx_Status_NotInitialized;
+    return status;
   }
-  return (*f)();
+  if (0 == ((TypeNode*)type)->usage) {
+    unlockMutex();
+    status = Shizu_Gcx_Status_ReferenceCounterOverflow;
+    return status;
+  }
+  ((TypeNode*)type)->usage--;
 
-#else
+  unlockMutex();
+  return Shizu_Gcx_Status_Success;
+}
 
-  #error("operating system not (yet) supported")
+#if 1 == Shizu_Configuration_WithGcCompactHeader
 
-#endif
+// Get if an object with the specified header is swept by the collection in progress.
+// Free slots, objects in the finalization queue, and objects allocated after the collection began are not swept.
+// Old objects are not swept by a minor collection.
+static inline bool
+isSwept
+  (
+    Singleton* singleton,
+    uintptr_t flags
+  )
+{
+  if (!(Tag_Flags_Gray & flags) || (Tag_Flags_New & flags)) {
+    return false;
+  }
+  return Shizu_Gcx_Collection_Major == singleton->collection || !(Tag_Flags_Old & flags);
 }
 
-static Shizu_Gcx_Status
-getSingletonVar
+// Add a dead object to the finalization queue.
+// Objects in the finalization queue have no color such that they are neither swept nor colored by later collections.
+static inline bool
+enqueue
   (
-    Singleton*** singleton
+    Singleton* singleton,
+    Tag* tag
   )
 {
-#if (Shizu_Configuration_OperatingSystem == Shizu_Configuration_OperatingSystem_Linux)  || \
-    (Shizu_Configuration_OperatingSystem == Shizu_Configuration_OperatingSystem_Cygwin) || \
-    (Shizu_Configuration_OperatingSystem == Shizu_Configuration_OperatingSystem_Macos)
+  if (!TagStack_push(&singleton->finalizationQueue, tag)) {
+    return false;
+  }
+  tag->flags = (void*)(~((uintptr_t)Tag_Flags_Gray) & (uintptr_t)tag->flags);
+  return true;
+}
 
-  return _getSingletonVar(singleton);
+// Retain an object which survived the collection in progress.
+static inline void
+retain
+  (
+    Tag* tag
+  )
+{
+#if 1 == Shizu_Configuration_WithGcGenerational
+  // Promote the object to the old generation (if it is not already old).
+  // Old objects are black between collections such that a minor collection does not visit them.
+  tag->flags = (void*)(Tag_Flags_Old | (uintptr_t)tag->flags);
+#else
+  // Old objects are white between collections.
+  Tag_setWhite(tag);
+#endif
+}
 
-#elif Shizu_Configuration_OperatingSystem == Shizu_Configuration_OperatingSystem_Windows
+// Sweep at most budget objects starting at the sweep cursor.
+// The slots of the pages are swept first, then the large objects are swept.
+// If the finalize callback of a dead object can not be queued, Shizu_Gcx_Status_AllocationFailed is returned and the sweep can be resumed at that object.
+// Must be invoked under the lock.
+static Shizu_Gcx_Status
+sweepObjects
+  (
+    Singleton* singleton,
+    size_t budget,
+    size_t* dead,
+    size_t* live,
+    bool* done
+  )
+{
+  SweepCursor* cursor = &(singleton->sweepCursor);
+  size_t swept = 0;
+  *done = false;
+  while (cursor->sizeClass < Heap_NumberOfSizeClasses) {
+    SizeClass* sizeClass = &(singleton->heap->sizeClasses[cursor->sizeClass]);
+    if (!cursor->page) {
+      cursor->page = sizeClass->pages;
+      if (!cursor->page) {
+        cursor->sizeClass++;
+        continue;
+      }
+      cursor->slot = ((char*)cursor->page) + Page_SlotsOffset;
+    }
+    while (cursor->slot < cursor->page->bump) {
+      Tag* tag = (Tag*)cursor->slot;
+      if (isSwept(singleton, (uintptr_t)Atomic_loadPointer(&tag->flags))) {
+        if (swept == budget) {
+          return Shizu_Gcx_Status_Success;
+        }
+        if (Tag_isWhite(tag)) {
+          if (Tag_getType(tag)->finalizeCallback) {
+            // The finalize callback is invoked by Shizu_Gcx_finalize.
+            if (!enqueue(singleton, tag)) {
+              return Shizu_Gcx_Status_AllocationFailed;
+            }
+            countFreed(tag);
+          } else {
+            countFreed(tag);
+            Heap_deallocate(singleton->heap, tag);
+          }
+          (*dead)++;
+        } else {
+          retain(tag);
+          (*live)++;
+        }
+        swept++;
+      }
+      cursor->slot += sizeClass->slotSize;
+    }
+    cursor->page = cursor->page->next;
+    if (cursor->page) {
+      cursor->slot = ((char*)cursor->page) + Page_SlotsOffset;
+    } else {
+      cursor->sizeClass++;
+    }
+  }
+  while (*cursor->largeObject) {
+    LargeObject* largeObject = *cursor->largeObject;
+    Tag* tag = (Tag*)(largeObject + 1);
+    if (isSwept(singleton, (uintptr_t)tag->flags)) {
+      if (swept == budget) {
+        return Shizu_Gcx_Status_Success;
+      }
+      swept++;
+      if (Tag_isWhite(tag)) {
+        if (Tag_getType(tag)->finalizeCallback) {
+          // The finalize callback is invoked by Shizu_Gcx_finalize.
+          if (!enqueue(singleton, tag)) {
+            return Shizu_Gcx_Status_AllocationFailed;
+          }
+          countFreed(tag);
+          *cursor->largeObject = largeObject->next;
+        } else {
+          countFreed(tag);
+          *cursor->largeObject = largeObject->next;
+          free(largeObject);
+        }
+        (*dead)++;
+        continue;
+      }
+      retain(tag);
+      (*live)++;
+    }
+    cursor->largeObject = &(largeObject->next);
+  }
+  *done = true;
+  return Shizu_Gcx_Status_Success;
+}
 
-  // We use GetModuleHandle(NULL) for that we always use the same instance of unlockImpl that always uses the same instance of g_lock.
-  HMODULE module = GetModuleHandle(NULL);
-  if (!module) {
-    return Shizu_Gcx_Status_LockFailed;
+// Invoke a function on each object in a slot of a page and each large object.
+// Must be invoked under the lock.
+static void
+enumerateObjects
+  (
+    Singleton* singleton,
+    void* context,
+    void (*function)(Singleton* singleton, void* context, Tag* tag)
+  )
+{
+  for (size_t i = 0, n = Heap_NumberOfSizeClasses; i < n; ++i) {
+    SizeClass* sizeClass = &(singleton->heap->sizeClasses[i]);
+    for (Page* page = sizeClass->pages; NULL != page; page = page->next) {
+      for (char* slot = ((char*)page) + Page_SlotsOffset; slot < page->bump; slot += sizeClass->slotSize) {
+        Tag* tag = (Tag*)slot;
+        if (Atomic_loadPointer(&tag->flags)) {
+          (*function)(singleton, context, tag);
+        }
+      }
+    }
   }
-  Shizu_Gcx_Status(*f)() = (Shizu_Gcx_Status(*)())GetProcAddress(module, "_getSingletonVar");
-  if (!f) {
-    return Shizu_Gcx_Status_LockFailed;
+  for (LargeObject* largeObject = singleton->largeObjects; NULL != largeObject; largeObject = largeObject->next) {
+    (*function)(singleton, context, (Tag*)(largeObject + 1));
   }
-  return (*f)(singleton);
+}
 
 #else
 
-  #error("operating system not (yet) supported")
-
+static size_t
+sweep
+  (
+    Singleton* singleton,
+    TypeNode* node,
+    Tag** list,
+    size_t budget,
+    size_t* dead,
+    size_t* live
+  )
+{
+  size_t swept = 0;
+  while (*list && swept < budget) {
+    Tag* tag = *list;
+    *list = tag->next;
+    swept++;
+    if (Tag_isWhite(tag)) {
+      countFreed(tag);
+      if (tag->type->finalizeCallback) {
+        // The finalize callback is invoked by Shizu_Gcx_finalize.
+        tag->next = singleton->finalizationQueue;
+        singleton->finalizationQueue = tag;
+      } else {
+        tag->type->usage--;
+        deallocateTag(singleton, tag);
+      }
+      (*dead)++;
+    } else {
+#if 1 == Shizu_Configuration_WithGcGenerational
+      // Promote the object to the old generation (if it is not already old).
+      // Old objects are black between collections such that a minor collection does not visit them.
+      tag->flags = (void*)(Tag_Flags_Old | (uintptr_t)tag->flags);
+#else
+      // Old objects are white between collections.
+      Tag_setWhite(tag);
 #endif
+      tag->next = node->all;
+      node->all = tag;
+      (*live)++;
+    }
+  }
+  return swept;
 }
 
+#endif
+
 Shizu_Gcx_Status
-Shizu_Gcx_startup
+Shizu_Gcx_allocate
   (
+    size_t size,
+    Shizu_Gcx_Type* type,
+    void** object
   )
 {
   Shizu_Gcx_Status status;
+
+  if (!type || !object) {
+    status = Shizu_Gcx_Status_ArgumentInvalid;
+    return status;
+  }
+  if (SIZE_MAX - sizeof(Tag) < size) {
+    status = Shizu_Gcx_Status_AllocationFailed;
+    return status;
+  }
+
+  // Fast path: Neither take the lock nor perform an atomic read-modify-write operation.
+  ThreadContext* context = getThreadContext();
+  if (context) {
+    Singleton* singleton = (Singleton*)Atomic_loadPointer((void* volatile*)&context->singleton);
+    if (singleton && !Atomic_loadSize(&singleton->lazySweeping)) {
+      Tag* tag = ThreadContext_allocateTag(context, size);
+      if (tag) {
+        *object = ThreadContext_addObject(context, tag, (TypeNode*)type);
+        return Shizu_Gcx_Status_Success;
+      }
+    }
+  }
+
+  // Slow path: Register the context, sweep lazily, or refill the thread-local allocation buffer.
   status = lockMutex();
   if (status) {
     return status;
   }
+
   Singleton** singleton = NULL;
   status = getSingletonVar(&singleton);
   if (status) {
     unlockMutex();
     return status;
   }
-  if (!(*singleton)) {
-    (*singleton) = malloc(sizeof(Singleton));
-    if (!(*singleton)) {
-      unlockMutex();
-      return Shizu_Gcx_Status_AllocationFailed;
-    }
-    (*singleton)->referenceCount = 0;
-    (*singleton)->typeManager = NULL;
+
+  if (!(*singleton)->typeManager) {
+    unlockMutex();
+    status = Shizu_Gcx_Status_NotInitialized;
+    return status;
   }
-  if (0 == (*singleton)->referenceCount) {
-    status = startupTypeManager();
-    if (status) {
-      unlockMutex();
-      return status;
-    }
-    status = startupPlsManager();
+  if (!context) {
+    status = registerThreadContext(*singleton, &context);
     if (status) {
-      shutdownTypeManager();
       unlockMutex();
       return status;
     }
-    (*singleton)->referenceCount++;
-    unlockMutex();
-    return Shizu_Gcx_Status_Success;
-  } else if (INT64_MAX == (*singleton)->referenceCount) {
+  }
+  TypeNode* typeNode = (TypeNode*)type;
+  if (Shizu_Gcx_Phase_Sweep == (*singleton)->phase) {
+  #if 1 == Shizu_Configuration_WithGcCompactHeader
+    // Lazy sweeping: Sweep a slice of the objects before allocating an object.
+    // If a finalize callback can not be queued, the failure is reported by Shizu_Gcx_sweep.
+    bool done;
+    sweepObjects(*singleton, LazySweepBudget, &(*singleton)->lazyDead, &(*singleton)->lazyLive, &done);
+  #else
+    // Lazy sweeping: Sweep a slice of the objects of this type before allocating an object of this type.
+    size_t swept = sweep(*singleton, typeNode, &typeNode->sweepAll, LazySweepBudget, &(*singleton)->lazyDead, &(*singleton)->lazyLive);
+    sweep(*singleton, typeNode, &typeNode->sweepYoung, LazySweepBudget - swept, &(*singleton)->lazyDead, &(*singleton)->lazyLive);
+  #endif
+  }
+  if (INT64_MAX == typeNode->usage) {
     unlockMutex();
-    return Shizu_Gcx_Status_ReferenceCounterOverflow;
-  } else {
-    (*singleton)->referenceCount++;
+    status = Shizu_Gcx_Status_ReferenceCounterOverflow;
+    return status;
+  }
+#if 1 == Shizu_Configuration_WithGcCompactHeader
+  if (sizeof(Tag) + size > Heap_MaximumSlotSize) {
+    void* largeObject = allocateLargeObject(*singleton, typeNode, size);
     unlockMutex();
+    if (!largeObject) {
+      return Shizu_Gcx_Status_AllocationFailed;
+    }
+    *object = largeObject;
     return Shizu_Gcx_Status_Success;
   }
+#endif
+  Tag* tag = ThreadContext_allocateTag(context, size);
+#if 1 == Shizu_Configuration_WithGcSizeClassHeap
+  if (!tag) {
+    ThreadContext_refill(context, (*singleton)->heap, size);
+    tag = ThreadContext_allocateTag(context, size);
+  }
+#endif
+  if (!tag) {
+    unlockMutex();
+    status = Shizu_Gcx_Status_AllocationFailed;
+    return status;
+  }
+  *object = ThreadContext_addObject(context, tag, typeNode);
+  unlockMutex();
+  return Shizu_Gcx_Status_Success;
+}
+
+#if 1 == Shizu_Configuration_WithGcCompactHeader
+
+// Push a Tag colored gray on the gray stack.
+// If the gray stack can not grow, the Tag is found by enumerating the objects when the gray stack is empty.
+static inline void
+pushGray
+  (
+    Singleton* singleton,
+    Tag* tag
+  )
+{
+  if (!TagStack_push(&singleton->grayStack, tag)) {
+    singleton->grayStackOverflow = true;
+  }
+}
+
+static void
+pushGrayIfGray
+  (
+    Singleton* singleton,
+    void* context,
+    Tag* tag
+  )
+{
+  if (Tag_isGray(tag)) {
+    pushGray(singleton, tag);
+  }
+}
+
+static size_t
+mark
+  (
+    Singleton* singleton,
+    size_t budget
+  )
+{
+  size_t marked = 0;
+  TagStack* grayStack = &(singleton->grayStack);
+  for (;;) {
+    if (!grayStack->size) {
+      if (!singleton->grayStackOverflow) {
+        break;
+      }
+      // Find the gray objects which could not be pushed on the gray stack.
+      // The lock is taken as other threads might be adding pages to the heap.
+      if (lockMutex()) {
+        break;
+      }
+      singleton->grayStackOverflow = false;
+      enumerateObjects(singleton, NULL, &pushGrayIfGray);
+      unlockMutex();
+      if (!grayStack->size) {
+        break;
+      }
+    }
+    if (marked == budget) {
+      break;
+    }
+    Tag* tag = grayStack->elements[--grayStack->size];
+    // Mark the object as black.
+    Tag_setBlack(tag);
+    TypeNode* node = Tag_getType(tag);
+    if (node->visitCallback) {
+      node->visitCallback(node->visitContext, (void*)(tag + 1));
+    }
+    marked++;
+  }
+  return marked;
 }
 
-Shizu_Gcx_Status
-Shizu_Gcx_shutdown
-  ( 
+static bool
+isGrayListEmpty
+  (
+    Singleton* singleton
   )
-{
-  Shizu_Gcx_Status status;
+{ return !singleton->grayStack.size && !singleton->grayStackOverflow; }
 
-  status = lockMutex();
-  if (status) {
-    return status;
+// Prepare an object for the collection beginning.
+static void
+prepareObject
+  (
+    Singleton* singleton,
+    void* context,
+    Tag* tag
+  )
+{
+  if (!(Tag_Flags_Gray & (uintptr_t)tag->flags)) {
+    // The object is in the finalization queue.
+    return;
   }
-  Singleton** singleton = NULL;
-  status = getSingletonVar(&singleton);
-  if (status) {
-    unlockMutex();
-    return status;
+  if (Tag_Flags_New & (uintptr_t)tag->flags) {
+    countAllocated(Tag_getType(tag), tag);
   }
-  if (1 == (*singleton)->referenceCount) {
-    status = shutdownPlsManager();
-    if (status) {
-      /*We have to ignore this. Must not be reached. Proof of non-reachability required.*/
+  // The object is collected by this collection.
+  tag->flags = (void*)(~((uintptr_t)Tag_Flags_New) & (uintptr_t)tag->flags);
+  // Old objects are black between collections. Color them white if this collection is a major collection.
+  // The object was colored black if it was allocated and marked during the collection in progress when it was allocated.
+  if (Shizu_Gcx_Collection_Major == singleton->collection || !(Tag_Flags_Old & (uintptr_t)tag->flags)) {
+    Tag_setWhite(tag);
+  }
+}
+
+#else
+
+static size_t
+mark
+  (
+    Singleton* singleton,
+    size_t budget
+  )
+{
+  // Visiting an object of one type may gray objects of other types.
+  // Repeat until all gray lists are empty or the budget is exhausted.
+  size_t marked = 0;
+  bool progress;
+  do {
+    progress = false;
+    for (size_t i = 0, n = singleton->typeManager->cp; i < n; ++i) {
+      TypeNode* node = singleton->typeManager->p[i];
+      while (node) {
+        while (node->gray) {
+          if (marked == budget) {
+            return marked;
+          }
+          progress = true;
+          // Dequeue from gray list.
+          Tag* tag = node->gray;
+          node->gray = tag->gray;
+          // Restore the type pointer.
+          tag->type = node;
+          // Mark the object as black.
+          Tag_setBlack(tag);
+          // Note: The type should not be in the gray list if it has no visit function.
+          if (node->visitCallback) {
+            node->visitCallback(tag->type->visitContext, (void*)(tag + 1));
+          }
+          marked++;
+        }
+        node = node->next;
+      }
     }
-    status = shutdownTypeManager();
-    if (status) {
-      /*We have to ignore this. Must not be reached. Proof of non-reachability required.*/
+  } while (progress);
+  return marked;
+}
+
+static bool
+isGrayListEmpty
+  (
+    Singleton* singleton
+  )
+{
+  for (size_t i = 0, n = singleton->typeManager->cp; i < n; ++i) {
+    for (TypeNode* node = singleton->typeManager->p[i]; NULL != node; node = node->next) {
+      if (node->gray) {
+        return false;
+      }
     }
-    free(*singleton);
-    (*singleton) = NULL;
-    unlockMutex();
-    return Shizu_Gcx_Status_Success;
-  } else if (INT64_MIN == g_singleton->referenceCount) {
-    unlockMutex();
-    status = Shizu_Gcx_Status_ReferenceCounterOverflow;
-    return status;
-  } else {
-    (*singleton)->referenceCount--; 
-    unlockMutex();
-    return Shizu_Gcx_Status_Success;
   }
+  return true;
+}
+
+#endif
+
+// Remove the first n elements from the remembered set.
+// Elements added after these elements are retained.
+// Must be invoked under the lock.
+static void
+removeRememberedSetElements
+  (
+    Singleton* singleton,
+    size_t n
+  )
+{
+  RememberedSet* rememberedSet = &(singleton->rememberedSet);
+  for (size_t i = 0; i < n; ++i) {
+    Tag* tag = rememberedSet->elements[i];
+    tag->flags = (void*)(~((uintptr_t)Tag_Flags_Remembered) & (uintptr_t)tag->flags);
+  }
+  memmove(rememberedSet->elements, rememberedSet->elements + n, (rememberedSet->size - n) * sizeof(Tag*));
+  rememberedSet->size -= n;
 }
 
 Shizu_Gcx_Status
-Shizu_Gcx_registerType
+Shizu_Gcx_begin
   (
-    char const* name,
-    size_t nameLength,
-    void* visitContext,
-    Shizu_Gcx_VisitCallback* visitCallback,
-    void* finalizeContext,
-    Shizu_Gcx_FinalizeCallback* finalizeCallback
+    Shizu_Gcx_Collection collection
   )
 {
   Shizu_Gcx_Status status;
 
-  if (!name || !visitCallback) {
+  if (Shizu_Gcx_Collection_Major != collection && Shizu_Gcx_Collection_Minor != collection) {
     status = Shizu_Gcx_Status_ArgumentInvalid;
     return status;
   }
@@ -657,289 +3167,390 @@ Shizu_Gcx_registerType
     unlockMutex();
     return status;
   }
- 
+
   if (!(*singleton)->typeManager) {
     unlockMutex();
     status = Shizu_Gcx_Status_NotInitialized;
     return status;
   }
 
-  size_t hashValue;
-  status = hashName(name, nameLength, &hashValue);
-  if (status) {
+  if (Shizu_Gcx_Phase_None != (*singleton)->phase) {
     unlockMutex();
+    status = Shizu_Gcx_Status_OperationInvalid;
     return status;
   }
 
-  size_t hashIndex = hashValue % (*singleton)->typeManager->cp;
-  
-  for (TypeNode* node = (*singleton)->typeManager->p[hashIndex]; NULL != node; node = node->next) {
-    if (node->hashValue == hashValue && node->nameLength == nameLength) {
-      if (!memcmp(node->name, name, nameLength)) {
-        unlockMutex();
-        status = Shizu_Gcx_Status_TypeExists;
-        return status;
-      }
+  // The statistics of the types refer to the last collection.
+  for (size_t i = 0, n = (*singleton)->typeManager->cp; i < n; ++i) {
+    for (TypeNode* node = (*singleton)->typeManager->p[i]; NULL != node; node = node->next) {
+      node->allocatedObjects = 0;
+      node->allocatedBytes = 0;
+      node->freedObjects = 0;
+      node->freedBytes = 0;
     }
   }
 
-  // Too many types?
-  if ((*singleton)->typeManager->sz == SIZE_MAX / sizeof(TypeNode*)) {
-    unlockMutex();
-    return Shizu_Gcx_Status_AllocationFailed;
-  }
+#if 1 != Shizu_Configuration_WithGcCompactHeader
+  // The objects allocated since the last collection began are collected by this collection.
+  mergeThreadContexts(*singleton);
+#endif
 
-  TypeNode* node = malloc(sizeof(TypeNode));
-  if (!node) {
-    unlockMutex();
-    return Shizu_Gcx_Status_AllocationFailed;
+#if 1 == Shizu_Configuration_WithGcGenerational
+  if (Shizu_Gcx_Collection_Minor == collection && (*singleton)->rememberedSet.overflow) {
+    collection = Shizu_Gcx_Collection_Major;
   }
-
-  node->name = malloc(nameLength > 0 ? nameLength : 1);
-  if (!node->name) {
-    free(node);
-    unlockMutex();
-    return Shizu_Gcx_Status_AllocationFailed;
+  (*singleton)->rememberedSet.overflow = false;
+  #if 1 != Shizu_Configuration_WithGcCompactHeader
+  if (Shizu_Gcx_Collection_Major == collection) {
+    // Old objects are black between collections. Color them white.
+    for (size_t i = 0, n = (*singleton)->typeManager->cp; i < n; ++i) {
+      for (TypeNode* node = (*singleton)->typeManager->p[i]; NULL != node; node = node->next) {
+        for (Tag* tag = node->all; NULL != tag; tag = tag->next) {
+          Tag_setWhite(tag);
+        }
+      }
+    }
   }
-  memcpy(node->name, name, nameLength);
-  node->nameLength = nameLength;
-  node->hashValue = hashValue;
+  #endif
+#else
+  // All objects are old. A minor collection would not collect anything.
+  collection = Shizu_Gcx_Collection_Major;
+#endif
 
-  node->visitContext = visitContext;
-  node->visitCallback = visitCallback;
+  (*singleton)->collection = collection;
+#if 1 == Shizu_Configuration_WithGcCompactHeader
+  // The objects allocated since the last collection began are collected by this collection.
+  // The objects allocated after this collection began are not swept by this collection as they are allocated with Tag_Flags_New.
+  enumerateObjects(*singleton, NULL, &prepareObject);
+#endif
+  (*singleton)->phase = Shizu_Gcx_Phase_Mark;
+  // The number of elements of the remembered set when this collection began.
+  size_t numberOfRemembered = (*singleton)->rememberedSet.size;
 
-  node->finalizeContext = finalizeContext;
-  node->finalizeCallback = finalizeCallback;
+  unlockMutex();
 
-  node->usage = 1;
+  if (Shizu_Gcx_Collection_Minor == collection) {
+    // Old objects in the remembered set might store the only references to young objects.
+    RememberedSet* rememberedSet = &((*singleton)->rememberedSet);
+    for (size_t i = 0; i < numberOfRemembered; ++i) {
+      Tag* tag = rememberedSet->elements[i];
+      TypeNode* type = Tag_getType(tag);
+      if (type->visitCallback) {
+        type->visitCallback(type->visitContext, (void*)(tag + 1));
+      }
+    }
+  }
 
-  node->all = NULL;
-  node->gray = NULL;
+  if (numberOfRemembered) {
+    // The young objects referenced by these elements are grayed (or are collected by a major collection).
+    // Those young objects are either promoted or dead when this collection ends.
+    // The elements added by the write barrier after this collection began are retained:
+    // They might reference young objects allocated after this collection began which are not promoted by this collection.
+    status = lockMutex();
+    if (status) {
+      return status;
+    }
+    removeRememberedSetElements(*singleton, numberOfRemembered);
+    unlockMutex();
+  }
 
-  node->next = (*singleton)->typeManager->p[hashIndex];
-  (*singleton)->typeManager->p[hashIndex] = node;
-  (*singleton)->typeManager->sz++;
-  
-  unlockMutex();
   return Shizu_Gcx_Status_Success;
 }
 
 Shizu_Gcx_Status
-Shizu_Gcx_unregisterType
+Shizu_Gcx_getPhase
   (
-    char const* name,
-    size_t nameLength
-  )  
+    Shizu_Gcx_Phase* phase
+  )
 {
-  if (!name) {
+  if (!phase) {
     return Shizu_Gcx_Status_ArgumentInvalid;
   }
-
-  Shizu_Gcx_Status status;
-
-  status = lockMutex();
+  Singleton** singleton = NULL;
+  Shizu_Gcx_Status status = getSingletonVar(&singleton);
   if (status) {
     return status;
   }
+  if (!(*singleton)) {
+    return Shizu_Gcx_Status_NotInitialized;
+  }
+  *phase = (*singleton)->phase;
+  return Shizu_Gcx_Status_Success;
+}
 
+Shizu_Gcx_Status
+Shizu_Gcx_startupMarkThreads
+  (
+    size_t numberOfMarkThreads
+  )
+{
+  if (!numberOfMarkThreads) {
+    return Shizu_Gcx_Status_ArgumentInvalid;
+  }
+  Shizu_Gcx_Status status = lockMutex();
+  if (status) {
+    return status;
+  }
   Singleton** singleton = NULL;
   status = getSingletonVar(&singleton);
   if (status) {
     unlockMutex();
     return status;
   }
-
-  size_t hashValue;
-  status = hashName(name, nameLength, &hashValue);
-  if (status) {
+  if (!(*singleton)) {
     unlockMutex();
-    return status;
+    return Shizu_Gcx_Status_NotInitialized;
   }
-
-  size_t hashIndex = hashValue % (*singleton)->typeManager->cp;
-
-  for (TypeNode* node = (*singleton)->typeManager->p[hashIndex]; NULL != node; node = node->next) {
-    if (node->hashValue == hashValue && node->nameLength == nameLength) {
-      if (!memcmp(node->name, name, nameLength)) {
-        if (!node->usage) {
-          unlockMutex();
-          status = Shizu_Gcx_Status_ReferenceCounterOverflow;
-          return status;
-        } else {
-          node->usage--;
-          unlockMutex();
-          status = Shizu_Gcx_Status_TypeUsed;
-          return status;
-        }
-      }
+#if 1 == Shizu_Configuration_WithGcParallelMark
+  if ((*singleton)->markThreads) {
+    unlockMutex();
+    return Shizu_Gcx_Status_OperationInvalid;
+  }
+  if (numberOfMarkThreads > 1) {
+    status = MarkThreads_create(&(*singleton)->markThreads, numberOfMarkThreads);
+    if (status) {
+      unlockMutex();
+      return status;
     }
   }
+#endif
   unlockMutex();
-  status = Shizu_Gcx_Status_TypeNotExists;
-  return status;
+  return Shizu_Gcx_Status_Success;
 }
 
 Shizu_Gcx_Status
-Shizu_Gcx_acquireType
+Shizu_Gcx_shutdownMarkThreads
   (
-    char const* name,
-    size_t nameLength,
-    Shizu_Gcx_Type** type
   )
 {
-  Shizu_Gcx_Status status;
-
-  if (!name) {
-    status = Shizu_Gcx_Status_ArgumentInvalid;
-    return status;
-  }
-
-  status = lockMutex();
+  Shizu_Gcx_Status status = lockMutex();
   if (status) {
     return status;
   }
-
   Singleton** singleton = NULL;
   status = getSingletonVar(&singleton);
   if (status) {
     unlockMutex();
     return status;
   }
-
-  if (!(*singleton)->typeManager) {
+  if (!(*singleton)) {
     unlockMutex();
-    status = Shizu_Gcx_Status_NotInitialized;
-    return status;
+    return Shizu_Gcx_Status_NotInitialized;
   }
+#if 1 == Shizu_Configuration_WithGcParallelMark
+  if ((*singleton)->markThreads) {
+    MarkThreads_destroy((*singleton)->markThreads);
+    (*singleton)->markThreads = NULL;
+  }
+#endif
+  unlockMutex();
+  return Shizu_Gcx_Status_Success;
+}
 
-  size_t hashValue;
-  status = hashName(name, nameLength, &hashValue);
+Shizu_Gcx_Status
+Shizu_Gcx_mark
+  (
+    size_t budget,
+    size_t* marked,
+    bool* done
+  )
+{
+  if (!marked || !done) {
+    return Shizu_Gcx_Status_ArgumentInvalid;
+  }
+  Singleton** singleton = NULL;
+  Shizu_Gcx_Status status = getSingletonVar(&singleton);
   if (status) {
-    unlockMutex();
     return status;
   }
+  if (Shizu_Gcx_Phase_Mark != (*singleton)->phase) {
+    return Shizu_Gcx_Status_OperationInvalid;
+  }
+#if 1 == Shizu_Configuration_WithGcParallelMark
+  if (SIZE_MAX == budget && (*singleton)->markThreads) {
+    // Objects which could not be marked in parallel remain in the gray lists.
+    size_t marked1 = MarkThreads_mark((*singleton)->markThreads, *singleton);
+    *marked = marked1 + mark(*singleton, budget);
+    *done = isGrayListEmpty(*singleton);
+    return Shizu_Gcx_Status_Success;
+  }
+#endif
+  *marked = mark(*singleton, budget);
+  *done = isGrayListEmpty(*singleton);
+  return Shizu_Gcx_Status_Success;
+}
 
-  size_t hashIndex = hashValue % (*singleton)->typeManager->cp;
-
-  for (TypeNode* node = (*singleton)->typeManager->p[hashIndex]; NULL != node; node = node->next) {
-    if (node->hashValue == hashValue && node->nameLength == nameLength) {
-      if (!memcmp(node->name, name, nameLength)) {
-        if (INT64_MAX == node->usage) {
-          unlockMutex();
-          status = Shizu_Gcx_Status_ReferenceCounterOverflow;
-          return status;
-        } else {
-          node->usage++;
-        }
-        *type = (Shizu_Gcx_Type*)node;
-        unlockMutex();
-        return Shizu_Gcx_Status_Success;
+Shizu_Gcx_Status
+Shizu_Gcx_beginSweep
+  (
+  )
+{
+  Shizu_Gcx_Status status = lockMutex();
+  if (status) {
+    return status;
+  }
+  Singleton** singleton = NULL;
+  status = getSingletonVar(&singleton);
+  if (status) {
+    unlockMutex();
+    return status;
+  }
+  if (Shizu_Gcx_Phase_Mark != (*singleton)->phase || !isGrayListEmpty(*singleton)) {
+    unlockMutex();
+    return Shizu_Gcx_Status_OperationInvalid;
+  }
+#if 1 == Shizu_Configuration_WithGcCompactHeader
+  // Objects allocated after this collection began are not swept by this collection.
+  (*singleton)->sweepCursor.sizeClass = 0;
+  (*singleton)->sweepCursor.page = NULL;
+  (*singleton)->sweepCursor.slot = NULL;
+  (*singleton)->sweepCursor.largeObject = &((*singleton)->largeObjects);
+#else
+  // Detach the lists to sweep.
+  // Objects allocated after this collection began are in the object lists of the thread contexts and are not swept by this collection.
+  for (size_t i = 0, n = (*singleton)->typeManager->cp; i < n; ++i) {
+    for (TypeNode* node = (*singleton)->typeManager->p[i]; NULL != node; node = node->next) {
+      if (Shizu_Gcx_Collection_Major == (*singleton)->collection) {
+        node->sweepAll = node->all;
+        node->all = NULL;
+      } else {
+        node->sweepAll = NULL;
       }
+      node->sweepYoung = node->young;
+      node->young = NULL;
     }
   }
+#endif
+  (*singleton)->lazyDead = 0;
+  (*singleton)->lazyLive = 0;
+  (*singleton)->phase = Shizu_Gcx_Phase_Sweep;
+  Atomic_storeSize(&(*singleton)->lazySweeping, 1);
   unlockMutex();
-  return Shizu_Gcx_Status_TypeNotExists;
+  return Shizu_Gcx_Status_Success;
 }
 
 Shizu_Gcx_Status
-Shizu_Gcx_relinquishType
+Shizu_Gcx_sweep
   (
-    Shizu_Gcx_Type* type
+    size_t budget,
+    size_t* dead,
+    size_t* live,
+    bool* done
   )
 {
-  Shizu_Gcx_Status status;
-
-  if (!type) {
-    status = Shizu_Gcx_Status_ArgumentInvalid;
-    return status;
+  if (!dead || !live || !done) {
+    return Shizu_Gcx_Status_ArgumentInvalid;
   }
-
-  status = lockMutex();
+  Shizu_Gcx_Status status = lockMutex();
   if (status) {
     return status;
   }
-
   Singleton** singleton = NULL;
   status = getSingletonVar(&singleton);
   if (status) {
     unlockMutex();
     return status;
   }
-
-  if (!(*singleton)->typeManager) {
+  if (Shizu_Gcx_Phase_Sweep != (*singleton)->phase) {
     unlockMutex();
-    status = Shizu_Gcx_Status_NotInitialized;
-    return status;
+    return Shizu_Gcx_Status_OperationInvalid;
   }
-  if (0 == ((TypeNode*)type)->usage) {
+  size_t dead1 = (*singleton)->lazyDead;
+  size_t live1 = (*singleton)->lazyLive;
+  (*singleton)->lazyDead = 0;
+  (*singleton)->lazyLive = 0;
+#if 1 == Shizu_Configuration_WithGcCompactHeader
+  bool done1;
+  status = sweepObjects(*singleton, budget, &dead1, &live1, &done1);
+  if (status) {
+    // Report the objects swept so far by the next call.
+    (*singleton)->lazyDead = dead1;
+    (*singleton)->lazyLive = live1;
     unlockMutex();
-    status = Shizu_Gcx_Status_ReferenceCounterOverflow;
     return status;
   }
-  ((TypeNode*)type)->usage--;
-
+#else
+  size_t swept = 0;
+  bool done1 = true;
+  for (size_t i = 0, n = (*singleton)->typeManager->cp; i < n; ++i) {
+    for (TypeNode* node = (*singleton)->typeManager->p[i]; NULL != node; node = node->next) {
+      swept += sweep(*singleton, node, &node->sweepAll, budget - swept, &dead1, &live1);
+      swept += sweep(*singleton, node, &node->sweepYoung, budget - swept, &dead1, &live1);
+      if (node->sweepAll || node->sweepYoung) {
+        done1 = false;
+      }
+    }
+  }
+#endif
+  if (done1) {
+  #if 1 == Shizu_Configuration_WithGcSizeClassHeap
+    Heap_trim((*singleton)->heap);
+  #endif
+    (*singleton)->phase = Shizu_Gcx_Phase_None;
+    Atomic_storeSize(&(*singleton)->lazySweeping, 0);
+  }
   unlockMutex();
+  *dead = dead1;
+  *live = live1;
+  *done = done1;
   return Shizu_Gcx_Status_Success;
 }
 
 Shizu_Gcx_Status
-Shizu_Gcx_allocate
+Shizu_Gcx_finalize
   (
-    size_t size,
-    Shizu_Gcx_Type* type,
-    void** object
+    size_t budget,
+    size_t* finalized,
+    bool* done
   )
 {
-  Shizu_Gcx_Status status;
-
-  if (!type || !object) {
-    status = Shizu_Gcx_Status_ArgumentInvalid;
-    return status;
+  if (!finalized || !done) {
+    return Shizu_Gcx_Status_ArgumentInvalid;
   }
-
-  status = lockMutex();
+  Shizu_Gcx_Status status = lockMutex();
   if (status) {
     return status;
   }
-
   Singleton** singleton = NULL;
   status = getSingletonVar(&singleton);
   if (status) {
     unlockMutex();
     return status;
   }
-
-  if (!(*singleton)->typeManager) {
-    unlockMutex();
-    status = Shizu_Gcx_Status_NotInitialized;
-    return status;
-  }
-  if (SIZE_MAX - sizeof(Tag) < size) {
-    unlockMutex();
-    status = Shizu_Gcx_Status_AllocationFailed;
-    return status;
-  }
-  Tag* tag = malloc(sizeof(Tag) + size);
-  if (!tag) {
+  if (!(*singleton)) {
     unlockMutex();
-    status = Shizu_Gcx_Status_AllocationFailed;
-    return status;
+    return Shizu_Gcx_Status_NotInitialized;
   }
-  TypeNode* typeNode = (TypeNode*)type;
-  if (INT64_MAX == typeNode->usage) {
+  size_t finalized1 = 0;
+#if 1 == Shizu_Configuration_WithGcCompactHeader
+  while ((*singleton)->finalizationQueue.size && finalized1 < budget) {
+    Tag* tag = (*singleton)->finalizationQueue.elements[--(*singleton)->finalizationQueue.size];
+#else
+  while ((*singleton)->finalizationQueue && finalized1 < budget) {
+    Tag* tag = (*singleton)->finalizationQueue;
+    (*singleton)->finalizationQueue = tag->next;
+#endif
+    TypeNode* type = Tag_getType(tag);
+    // The lock is not held while the finalize callback is invoked such that the callback may invoke Gcx functions.
     unlockMutex();
-    free(tag);
-    status = Shizu_Gcx_Status_ReferenceCounterOverflow;
-    return status;
+    type->finalizeCallback(type->finalizeContext, (void*)(tag + 1));
+    status = lockMutex();
+    if (status) {
+      return status;
+    }
+#if 1 != Shizu_Configuration_WithGcCompactHeader
+    type->usage--;
+#endif
+    deallocateTag(*singleton, tag);
+    finalized1++;
   }
-  typeNode->usage++;
-  tag->flags = 0;
-  Tag_setWhite(tag);
-  tag->type = typeNode;
-  tag->next = typeNode->all;
-  typeNode->all = tag;
-  //tag->gray = NULL;
-  *object = (void*)(tag + 1);
+#if 1 == Shizu_Configuration_WithGcCompactHeader
+  *done = 0 == (*singleton)->finalizationQueue.size;
+#else
+  *done = NULL == (*singleton)->finalizationQueue;
+#endif
+  unlockMutex();
+  *finalized = finalized1;
   return Shizu_Gcx_Status_Success;
 }
 
@@ -951,63 +3562,26 @@ Shizu_Gcx_run
   )
 {
   Shizu_Gcx_Status status;
-  size_t dead1 = 0;
-  size_t live1 = 0;
+  size_t marked;
+  bool done;
 
-  Singleton** singleton = NULL;
-  status = getSingletonVar(&singleton);
+  status = Shizu_Gcx_mark(SIZE_MAX, &marked, &done);
   if (status) {
-    unlockMutex();
     return status;
   }
-
-  for (size_t i = 0, n = (*singleton)->typeManager->cp; i < n; ++i) {
-    TypeNode* node = (*singleton)->typeManager->p[i];
-    while (node) {
-      while (node->gray) {
-        // Dequeue from gray list.
-        Tag* tag = node->gray;
-        node->gray = tag->gray;
-        // Restore the type pointer.
-        tag->type = node;
-        // Mark the object as black.
-        Tag_setBlack(tag);
-        // Note: The type should not be in the gray list if it has no visit function.
-        if (node->visitCallback) {
-          node->visitCallback(tag->type->visitContext, (void*)(tag + 1));
-        }
-      }
-      node = node->next;
-    }
-  }
-  for (size_t i = 0; i < (*singleton)->typeManager->cp; ++i) {
-    TypeNode* node = (*singleton)->typeManager->p[i];
-    while (node) {
-      Tag** previous = &(node->all);
-      Tag* current = node->all;
-      while (current) {
-        if (Tag_isWhite(current)) {
-          Tag* tag = current;
-          *previous = current->next;
-          current = current->next;
-          if (tag->type->finalizeCallback) {
-            tag->type->finalizeCallback(tag->type->finalizeContext, (void*)(tag + 1));
-          }
-          tag->type->usage--;
-          free(tag);
-          dead1++;
-        } else {
-          Tag_setWhite(current);
-          previous = &current->next;
-          current = current->next;
-          live1++;
-        }
-      }
-      node = node->next;
-    }
+  status = Shizu_Gcx_beginSweep();
+  if (status) {
+    return status;
+  }
+  status = Shizu_Gcx_sweep(SIZE_MAX, dead, live, &done);
+  if (status) {
+    return status;
+  }
+  size_t finalized;
+  status = Shizu_Gcx_finalize(SIZE_MAX, &finalized, &done);
+  if (status) {
+    return status;
   }
-  *dead = dead1;
-  *live = live1;
   return Shizu_Gcx_Status_Success;
 }
 
@@ -1018,15 +3592,345 @@ Shizu_Gcx_visit
   )
 {
   Tag* tag = ((Tag*)object) - 1;
+#if 1 == Shizu_Configuration_WithGcParallelMark
+  if (g_marker) {
+    Marker_visit(g_marker, tag);
+    return;
+  }
+#endif
+  // Old objects are black during a minor collection and are not visited.
   if (Tag_isWhite(tag)) {
+  #if 1 == Shizu_Configuration_WithGcCompactHeader
+    Singleton** singleton = NULL;
+    if (getSingletonVar(&singleton)) {
+      return;
+    }
+    Tag_setGray(tag);
+    pushGray(*singleton, tag);
+  #else
     TypeNode* type = tag->type;
     Shizu_Cxx_Debug_assert(NULL != type);
     tag->gray = type->gray;
     type->gray = tag;
     Tag_setGray(tag);
+  #endif
+  }
+}
+
+void
+Shizu_Gcx_visitObjects
+  (
+    void* const* objects,
+    size_t numberOfObjects
+  )
+{
+  // Issue the loads of the headers before testing them such that the loads overlap.
+  for (size_t i = 0; i < numberOfObjects; ++i) {
+    prefetch(((Tag*)objects[i]) - 1);
+  }
+#if 1 == Shizu_Configuration_WithGcParallelMark
+  if (g_marker) {
+    for (size_t i = 0; i < numberOfObjects; ++i) {
+      Marker_visit(g_marker, ((Tag*)objects[i]) - 1);
+    }
+    return;
+  }
+#endif
+#if 1 == Shizu_Configuration_WithGcCompactHeader
+  Singleton** singleton = NULL;
+  if (getSingletonVar(&singleton)) {
+    return;
+  }
+#endif
+  for (size_t i = 0; i < numberOfObjects; ++i) {
+    Tag* tag = ((Tag*)objects[i]) - 1;
+    // Old objects are black during a minor collection and are not visited.
+    if (Tag_isWhite(tag)) {
+    #if 1 == Shizu_Configuration_WithGcCompactHeader
+      Tag_setGray(tag);
+      pushGray(*singleton, tag);
+    #else
+      TypeNode* type = tag->type;
+      Shizu_Cxx_Debug_assert(NULL != type);
+      tag->gray = type->gray;
+      type->gray = tag;
+      Tag_setGray(tag);
+    #endif
+    }
   }
 }
 
+void
+Shizu_Gcx_writeBarrier
+  (
+    void* object,
+    void* value
+  )
+{
+  Tag* tag = ((Tag*)object) - 1;
+  // Only stores into black objects can violate the tri-color invariant (black objects do not reference white objects).
+  // If generational collection is enabled, old objects are black between collections.
+  if (!Tag_isBlack(tag)) {
+    return;
+  }
+  Tag* valueTag = value ? ((Tag*)value) - 1 : NULL;
+#if 1 == Shizu_Configuration_WithGcGenerational
+  // Stores of young objects into old objects must be remembered even if the young objects are not white:
+  // Young objects allocated and marked during a collection are neither swept nor promoted by that collection.
+  if (valueTag && !Tag_isWhite(valueTag) && (Tag_Flags_Old & (uintptr_t)valueTag->flags)) {
+    return;
+  }
+#else
+  if (valueTag && !Tag_isWhite(valueTag)) {
+    return;
+  }
+#endif
+  Singleton** singleton = NULL;
+  if (getSingletonVar(&singleton)) {
+    return;
+  }
+  if (Shizu_Gcx_Phase_Mark == (*singleton)->phase) {
+    if (valueTag) {
+      // Dijkstra (insertion) barrier: Color the referenced object gray (if it is white).
+      Shizu_Gcx_visit(value);
+    } else {
+      // The referenced object is unknown: Color the referencing object gray again.
+    #if 1 == Shizu_Configuration_WithGcCompactHeader
+      Tag_setGray(tag);
+      pushGray(*singleton, tag);
+    #else
+      TypeNode* type = tag->type;
+      tag->gray = type->gray;
+      type->gray = tag;
+      Tag_setGray(tag);
+    #endif
+    }
+  }
+#if 1 == Shizu_Configuration_WithGcGenerational
+  if (valueTag && (Tag_Flags_Old & (uintptr_t)valueTag->flags)) {
+    return;
+  }
+  // The referencing object is old (if it is black between collections) or it might be promoted by the collection in progress.
+  // Remember it until the next collection begins.
+  if (Tag_Flags_Remembered & (uintptr_t)tag->flags) {
+    return;
+  }
+  if (lockMutex()) {
+    (*singleton)->rememberedSet.overflow = true;
+    return;
+  }
+  RememberedSet* rememberedSet = &((*singleton)->rememberedSet);
+  if (rememberedSet->size == rememberedSet->capacity) {
+    size_t newCapacity = rememberedSet->capacity ? rememberedSet->capacity * 2 : 8;
+    Tag** newElements = NULL;
+    if (newCapacity > rememberedSet->capacity && newCapacity <= SIZE_MAX / sizeof(Tag*)) {
+      newElements = realloc(rememberedSet->elements, newCapacity * sizeof(Tag*));
+    }
+    if (!newElements) {
+      // The next collection must be a major collection.
+      rememberedSet->overflow = true;
+      unlockMutex();
+      return;
+    }
+    rememberedSet->elements = newElements;
+    rememberedSet->capacity = newCapacity;
+  }
+  rememberedSet->elements[rememberedSet->size++] = tag;
+  tag->flags = (void*)(Tag_Flags_Remembered | (uintptr_t)tag->flags);
+  unlockMutex();
+#endif
+}
+
+/*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+
+Shizu_Gcx_Status
+Shizu_Gcx_getTypeStatistics
+  (
+    Shizu_Gcx_Type* type,
+    Shizu_Gcx_TypeStatistics* statistics
+  )
+{
+  if (!type || !statistics) {
+    return Shizu_Gcx_Status_ArgumentInvalid;
+  }
+  Shizu_Gcx_Status status = lockMutex();
+  if (status) {
+    return status;
+  }
+  TypeNode* node = (TypeNode*)type;
+  statistics->liveObjects = node->liveObjects;
+  statistics->liveBytes = node->liveBytes;
+  statistics->allocatedObjects = node->allocatedObjects;
+  statistics->allocatedBytes = node->allocatedBytes;
+  statistics->freedObjects = node->freedObjects;
+  statistics->freedBytes = node->freedBytes;
+  unlockMutex();
+  return Shizu_Gcx_Status_Success;
+}
+
+void
+Shizu_Gcx_setRecordFlag
+  (
+    void* object,
+    bool flag
+  )
+{
+  Tag* tag = ((Tag*)object) - 1;
+  if (flag) {
+    tag->flags = (void*)(Tag_Flags_Record | (uintptr_t)tag->flags);
+  } else {
+    tag->flags = (void*)(~((uintptr_t)Tag_Flags_Record) & (uintptr_t)tag->flags);
+  }
+}
+
+bool
+Shizu_Gcx_getRecordFlag
+  (
+    void const* object
+  )
+{
+  Tag const* tag = ((Tag const*)object) - 1;
+  return 0 != (Tag_Flags_Record & (uintptr_t)tag->flags);
+}
+
+bool
+Shizu_Gcx_isWhite
+  (
+    void const* object
+  )
+{
+  Tag const* tag = ((Tag const*)object) - 1;
+  return Tag_isWhite(tag);
+}
+
+Shizu_Gcx_Status
+Shizu_Gcx_getObjectSize
+  (
+    void* object,
+    size_t* size
+  )
+{
+  if (!object || !size) {
+    return Shizu_Gcx_Status_ArgumentInvalid;
+  }
+  *size = Tag_getSize(((Tag*)object) - 1);
+  return Shizu_Gcx_Status_Success;
+}
+
+typedef struct EnumerateContext {
+  TypeNode* type;
+  void* context;
+  Shizu_Gcx_EnumerateCallback* callback;
+} EnumerateContext;
+
+#if 1 == Shizu_Configuration_WithGcCompactHeader
+
+static void
+enumerateObject
+  (
+    Singleton* singleton,
+    void* context,
+    Tag* tag
+  )
+{
+  EnumerateContext* enumerateContext = (EnumerateContext*)context;
+  uintptr_t flags = (uintptr_t)tag->flags;
+  if (!(Tag_Flags_Gray & flags)) {
+    // The object is in the finalization queue.
+    return;
+  }
+  if (enumerateContext->type == Tag_getType(tag)) {
+    enumerateContext->callback(enumerateContext->context, (void*)(tag + 1), Tag_getSize(tag), 0 != (Tag_Flags_New & flags));
+  }
+}
+
+#else
+
+static void
+enumerateList
+  (
+    EnumerateContext* context,
+    Tag* list
+  )
+{
+  for (Tag* tag = list; NULL != tag; tag = tag->next) {
+    context->callback(context->context, (void*)(tag + 1), Tag_getSize(tag), false);
+  }
+}
+
+// Get the type node of a Tag in the object list of a thread context.
+// If the Tag is in a gray list, its type node is found by searching the gray lists.
+static TypeNode*
+getContextObjectType
+  (
+    Singleton* singleton,
+    Tag* tag
+  )
+{
+  if (!Tag_isGray(tag)) {
+    return tag->type;
+  }
+  for (size_t i = 0, n = singleton->typeManager->cp; i < n; ++i) {
+    for (TypeNode* node = singleton->typeManager->p[i]; NULL != node; node = node->next) {
+      for (Tag* gray = node->gray; NULL != gray; gray = gray->gray) {
+        if (gray == tag) {
+          return node;
+        }
+      }
+    }
+  }
+  return NULL;
+}
+
+#endif
+
+Shizu_Gcx_Status
+Shizu_Gcx_enumerateObjects
+  (
+    Shizu_Gcx_Type* type,
+    void* context,
+    Shizu_Gcx_EnumerateCallback* callback
+  )
+{
+  if (!type || !callback) {
+    return Shizu_Gcx_Status_ArgumentInvalid;
+  }
+  Shizu_Gcx_Status status = lockMutex();
+  if (status) {
+    return status;
+  }
+  Singleton** singleton = NULL;
+  status = getSingletonVar(&singleton);
+  if (status) {
+    unlockMutex();
+    return status;
+  }
+  if (!(*singleton)) {
+    unlockMutex();
+    return Shizu_Gcx_Status_NotInitialized;
+  }
+  EnumerateContext enumerateContext = { .type = (TypeNode*)type, .context = context, .callback = callback };
+#if 1 == Shizu_Configuration_WithGcCompactHeader
+  enumerateObjects(*singleton, &enumerateContext, &enumerateObject);
+#else
+  TypeNode* node = (TypeNode*)type;
+  enumerateList(&enumerateContext, node->all);
+  enumerateList(&enumerateContext, node->young);
+  enumerateList(&enumerateContext, node->sweepAll);
+  enumerateList(&enumerateContext, node->sweepYoung);
+  // The objects allocated since the last collection began are in the object lists of the thread contexts.
+  for (ThreadContext* threadContext = (*singleton)->threadContexts; NULL != threadContext; threadContext = threadContext->next) {
+    for (Tag* tag = threadContext->objects; NULL != tag; tag = tag->next) {
+      if (node == getContextObjectType(*singleton, tag)) {
+        callback(context, (void*)(tag + 1), Tag_getSize(tag), true);
+      }
+    }
+  }
+#endif
+  unlockMutex();
+  return Shizu_Gcx_Status_Success;
+}
+
 /*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
 
 Shizu_Gcx_Status
@@ -25,6 +25,13 @@
 #include "Shizu/Runtime/State2.h"
 #include "Shizu/Runtime/Object.h"
 #include "Shizu/Runtime/Type.private.h"
+#include "Shizu/Runtime/Extensions.h"
+#include "Shizu/Runtime/getMonotonicTime.h"
+#include "Shizu/Runtime/Objects/CxxProcedure.h"
+#include "Shizu/Runtime/Objects/Environment.h"
+#include "Shizu/Runtime/Objects/Map.h"
+#include "Shizu/Runtime/Objects/String.private.h"
+#include "Shizu/Runtime/Objects/WeakReference.private.h"
 
 // stderr, fprintf
 #include <stdio.h>
@@ -49,12 +56,59 @@ Shizu_GcxInterface_visitCallback
 
 #define Shizu_Object_Flags_Gray (Shizu_Object_Flags_White|Shizu_Object_Flags_Black)
 
+// The minimum capacity of the side record table. Must be a power of two.
+#define ObjectRecordsMinimumCapacity (8)
+
+// Hash the address of an object.
+// The low bits of object addresses are zero due to alignment:
+// The bits are mixed such that the low bits of the hash value depend on all bits of the address.
+static inline size_t
+hashObject
+  (
+    Shizu_Object const* object
+  )
+{
+  uint64_t x = (uint64_t)(uintptr_t)object;
+  x ^= x >> 33;
+  x *= UINT64_C(0xff51afd7ed558ccd);
+  x ^= x >> 33;
+  return (size_t)x;
+}
+
+// Compute the heap size triggering the next collection by growth.
+static void
+updatePacing
+  (
+    Shizu_Gc* self
+  )
+{
+  Shizu_Gc_Pacing const* policy = &self->pacing.policy;
+  if (!policy->growthFactor) {
+    self->pacing.triggerBytes = SIZE_MAX;
+    return;
+  }
+  size_t base = self->statistics.liveBytes < policy->minimumHeapSize ? policy->minimumHeapSize : self->statistics.liveBytes;
+  size_t quotient = base / 100, remainder = base % 100;
+  size_t growth;
+  if (policy->growthFactor > SIZE_MAX / 100 || policy->growthFactor > SIZE_MAX / (quotient + 1)) {
+    growth = SIZE_MAX;
+  } else {
+    growth = quotient * policy->growthFactor + remainder * policy->growthFactor / 100;
+  }
+  self->pacing.triggerBytes = base > SIZE_MAX - growth ? SIZE_MAX : base + growth;
+}
+
 Shizu_Gc*
 Shizu_Gc_create
   (
-    Shizu_State2* state
+    Shizu_State2* state,
+    size_t numberOfMarkThreads
   )
 {
+  if (!numberOfMarkThreads) {
+    Shizu_State2_setStatus(state, Shizu_Status_ArgumentValueInvalid);
+    Shizu_State2_jump(state);
+  }
   if (Shizu_Gcx_startup()) {
     Shizu_State2_setStatus(state, Shizu_Status_AllocationFailed);
     Shizu_State2_jump(state);
@@ -80,13 +134,72 @@ Shizu_Gc_create
     Shizu_State2_setStatus(state, Shizu_Status_AllocationFailed);
     Shizu_State2_jump(state);
   }
+  if (Shizu_Gcx_startupMarkThreads(numberOfMarkThreads)) {
+    Shizu_Gcx_relinquishType(self->type);
+    self->type = NULL;
+    Shizu_Gcx_unregisterType("Shizu.GcxInterface.Object", strlen("Shizu.GcxInterface.Object"));
+    Shizu_Gcx_shutdown();
+    Shizu_State1_deallocate(Shizu_State2_getState1(state), self);
+    self = NULL;
+    Shizu_State2_setStatus(state, Shizu_Status_EnvironmentFailed);
+    Shizu_State2_jump(state);
+  }
 
   self->all = NULL;
   self->gray = NULL;
-  self->preMarkHooks.nodes = NULL;
+  self->minorRuns = 0;
+  self->collection = Shizu_Gcx_Collection_Major;
+  self->current.marked = 0;
+  self->current.dead = 0;
+  self->current.live = 0;
+  self->current.markDuration = 0;
+  self->current.sweepDuration = 0;
+  self->collectionsBegun = 0;
+  self->statistics.collections = 0;
+  self->statistics.minorCollections = 0;
+  self->statistics.markDuration = 0;
+  self->statistics.sweepDuration = 0;
+  self->statistics.totalMarkDuration = 0;
+  self->statistics.totalSweepDuration = 0;
+  self->statistics.pacedCollections = 0;
+  self->statistics.liveBytes = 0;
+  self->statistics.allocatedBytes = 0;
+  self->pacing.policy.growthFactor = Shizu_Configuration_GcGrowthFactor;
+  self->pacing.policy.minimumHeapSize = Shizu_Gc_MinimumHeapSize;
+  self->pacing.policy.maximumHeapSize = Shizu_Configuration_GcMaximumHeapSize;
+  self->pacing.policy.minimumInterval = (uint64_t)Shizu_Configuration_GcMinimumInterval * 1000000;
+  self->pacing.lastCollectionEnd = Shizu_getMonotonicTime(Shizu_State2_getState1(state));
+  updatePacing(self);
+  self->preMarkHooks.elements = NULL;
+  self->preMarkHooks.size = 0;
+  self->preMarkHooks.capacity = 0;
   self->preMarkHooks.running = false;
-  self->objectFinalizeHooks.nodes = NULL;
+  self->rootRanges.elements = NULL;
+  self->rootRanges.size = 0;
+  self->rootRanges.capacity = 0;
+  self->objectFinalizeHooks.elements = NULL;
+  self->objectFinalizeHooks.size = 0;
+  self->objectFinalizeHooks.capacity = 0;
   self->objectFinalizeHooks.running = false;
+  self->objectRecords.size = 0;
+  self->objectRecords.capacity = ObjectRecordsMinimumCapacity;
+  self->objectRecords.free = NULL;
+  self->objectRecords.freeSize = 0;
+  self->objectRecords.buckets = Shizu_State1_allocate(Shizu_State2_getState1(state), sizeof(Shizu_ObjectRecord*) * self->objectRecords.capacity);
+  if (!self->objectRecords.buckets) {
+    Shizu_Gcx_shutdownMarkThreads();
+    Shizu_Gcx_relinquishType(self->type);
+    self->type = NULL;
+    Shizu_Gcx_unregisterType("Shizu.GcxInterface.Object", strlen("Shizu.GcxInterface.Object"));
+    Shizu_Gcx_shutdown();
+    Shizu_State1_deallocate(Shizu_State2_getState1(state), self);
+    self = NULL;
+    Shizu_State2_setStatus(state, Shizu_Status_AllocationFailed);
+    Shizu_State2_jump(state);
+  }
+  for (size_t i = 0, n = self->objectRecords.capacity; i < n; ++i) {
+    self->objectRecords.buckets[i] = NULL;
+  }
 
   return self;
 }
@@ -98,41 +211,52 @@ Shizu_Gc_destroy
     Shizu_Gc* self
   )
 {
-  if (self->preMarkHooks.nodes) {
-    fprintf(stderr, "%s: %d: warning: premark hook list not empty\n", __FILE__, __LINE__);
-  }
   if (self->gray) {
     fprintf(stderr, "%s: %d: warning: gray list not empty\n", __FILE__, __LINE__);
   }
   if (self->all) {
     fprintf(stderr, "%s: %d: warning: all list not empty\n", __FILE__, __LINE__);
   }
-  if (self->preMarkHooks.nodes) {
-    size_t live = 0;
-    do {
-      PreMarkHookNode* node = self->preMarkHooks.nodes;
-      self->preMarkHooks.nodes = node->next;
-      if (!node->dead) {
-        live++;
-      }
-      Shizu_State1_deallocate(Shizu_State2_getState1(state), node);
-    } while (self->preMarkHooks.nodes);
-    fprintf(stderr, "%s: %d: warning: pre mark hook node list not empty\n", __FILE__, __LINE__);
-  }
-  if (self->objectFinalizeHooks.nodes) {
-    size_t live = 0;
-    do {
-      ObjectFinalizeHookNode* node = self->objectFinalizeHooks.nodes;
-      self->objectFinalizeHooks.nodes = node->next;
-      if (!node->dead) {
-        live++;
-      }
-      Shizu_State1_deallocate(Shizu_State2_getState1(state), node);
-    } while (self->objectFinalizeHooks.nodes);
-    if (live) {
-      fprintf(stderr, "%s: %d: warning: object finalize hook node list not empty\n", __FILE__, __LINE__);
+  if (self->preMarkHooks.size) {
+    fprintf(stderr, "%s: %d: warning: pre mark hook array not empty\n", __FILE__, __LINE__);
+  }
+  if (self->preMarkHooks.elements) {
+    Shizu_State1_deallocate(Shizu_State2_getState1(state), self->preMarkHooks.elements);
+    self->preMarkHooks.elements = NULL;
+  }
+  if (self->rootRanges.size) {
+    fprintf(stderr, "%s: %d: warning: root range array not empty\n", __FILE__, __LINE__);
+  }
+  if (self->rootRanges.elements) {
+    Shizu_State1_deallocate(Shizu_State2_getState1(state), self->rootRanges.elements);
+    self->rootRanges.elements = NULL;
+  }
+  if (self->objectFinalizeHooks.size) {
+    fprintf(stderr, "%s: %d: warning: object finalize hook array not empty\n", __FILE__, __LINE__);
+  }
+  if (self->objectFinalizeHooks.elements) {
+    Shizu_State1_deallocate(Shizu_State2_getState1(state), self->objectFinalizeHooks.elements);
+    self->objectFinalizeHooks.elements = NULL;
+  }
+  if (self->objectRecords.size) {
+    fprintf(stderr, "%s: %d: warning: object record table not empty\n", __FILE__, __LINE__);
+  }
+  for (size_t i = 0, n = self->objectRecords.capacity; i < n; ++i) {
+    while (self->objectRecords.buckets[i]) {
+      Shizu_ObjectRecord* record = self->objectRecords.buckets[i];
+      self->objectRecords.buckets[i] = record->next;
+      Shizu_State1_deallocate(Shizu_State2_getState1(state), record);
     }
   }
+  Shizu_State1_deallocate(Shizu_State2_getState1(state), self->objectRecords.buckets);
+  self->objectRecords.buckets = NULL;
+  while (self->objectRecords.free) {
+    Shizu_ObjectRecord* record = self->objectRecords.free;
+    self->objectRecords.free = record->next;
+    Shizu_State1_deallocate(Shizu_State2_getState1(state), record);
+  }
+  self->objectRecords.freeSize = 0;
+  Shizu_Gcx_shutdownMarkThreads();
   Shizu_Gcx_relinquishType(self->type);
   self->type = NULL;
   Shizu_Gcx_unregisterType("Shizu.GcxInterface.Object", strlen("Shizu.GcxInterface.Object"));
@@ -160,16 +284,35 @@ Shizu_Gc_allocateObject
     Shizu_State1_setStatus(Shizu_State2_getState1(state), 1);
     Shizu_State1_jump(Shizu_State2_getState1(state));
   }
+  Shizu_Gc* gc = Shizu_State2_getGc(state);
   Shizu_Object* self = NULL;
-  if (Shizu_Gcx_allocate(size, Shizu_State2_getGc(state)->type, &self)) {
+  if (Shizu_Gcx_allocate(size, gc->type, &self)) {
     fprintf(stderr, "%s:%d: unable to allocate `%zu` Bytes\n", __FILE__, __LINE__, size);
     Shizu_State1_setStatus(Shizu_State2_getState1(state), Shizu_Status_AllocationFailed);
     Shizu_State1_jump(Shizu_State2_getState1(state));
   }
+  // Count the object for the pacing policy. A collection is not triggered here (see Shizu_Gc_poll).
+  gc->statistics.allocatedBytes += size;
   self->type = Shizu_Object_getType(state);
   return self;
 }
 
+// Remove the object finalize hooks marked as dead.
+static void
+removeDeadObjectFinalizeHooks
+  (
+    Shizu_Gc* self
+  )
+{
+  size_t j = 0;
+  for (size_t i = 0, n = self->objectFinalizeHooks.size; i < n; ++i) {
+    if (!self->objectFinalizeHooks.elements[i].dead) {
+      self->objectFinalizeHooks.elements[j++] = self->objectFinalizeHooks.elements[i];
+    }
+  }
+  self->objectFinalizeHooks.size = j;
+}
+
 static void
 notifyObjectFinalizeHooks
   (
@@ -180,33 +323,37 @@ notifyObjectFinalizeHooks
 {
   self->objectFinalizeHooks.running = true;
   size_t dead = 0;
-  ObjectFinalizeHookNode* node = self->objectFinalizeHooks.nodes;
-  while (node) {
-    if (node->dead) {
+  // Hooks added by a hook are not notified.
+  for (size_t i = 0, n = self->objectFinalizeHooks.size; i < n; ++i) {
+    // Index the array in each iteration as a hook may add a hook such that the array is reallocated.
+    ObjectFinalizeHook* hook = self->objectFinalizeHooks.elements + i;
+    if (hook->dead) {
       dead++;
       continue;
     }
-    node->function(Shizu_State2_getState1(state), self, node->context, object);
-    node = node->next;
+    hook->function(Shizu_State2_getState1(state), self, hook->context, object);
   }
   self->objectFinalizeHooks.running = false;
   // This is very unlikely to happen.
   if (dead > 0) {
-    ObjectFinalizeHookNode** previous = &self->objectFinalizeHooks.nodes;
-    ObjectFinalizeHookNode* current = self->objectFinalizeHooks.nodes;
-    while (current) {
-      if (current->dead) {
-        ObjectFinalizeHookNode* node = current;
-        *previous = current->next;
-        current = current->next;
-        Shizu_State1_deallocate(Shizu_State2_getState1(state), node);
-      } else {
-        previous = &current->next;
-        current = current->next;
-      }
-      node->function(Shizu_State2_getState1(state), self, node->context, object);
+    removeDeadObjectFinalizeHooks(self);
+  }
+}
+
+// Remove the pre mark hooks marked as dead.
+static void
+removeDeadPreMarkHooks
+  (
+    Shizu_Gc* self
+  )
+{
+  size_t j = 0;
+  for (size_t i = 0, n = self->preMarkHooks.size; i < n; ++i) {
+    if (!self->preMarkHooks.elements[i].dead) {
+      self->preMarkHooks.elements[j++] = self->preMarkHooks.elements[i];
     }
   }
+  self->preMarkHooks.size = j;
 }
 
 static void
@@ -218,33 +365,182 @@ notifyPreMarkHooks
 {
   self->preMarkHooks.running = true;
   size_t dead = 0;
-  PreMarkHookNode* node = self->preMarkHooks.nodes;
-  while (node) {
-    if (node->dead) {
+  // Hooks added by a hook are not notified.
+  for (size_t i = 0, n = self->preMarkHooks.size; i < n; ++i) {
+    // Index the array in each iteration as a hook may add a hook such that the array is reallocated.
+    PreMarkHook* hook = self->preMarkHooks.elements + i;
+    if (hook->dead) {
       dead++;
       continue;
     }
-    node->function(Shizu_State2_getState1(state), self, node->context);
-    node = node->next;
+    hook->function(Shizu_State2_getState1(state), self, hook->context);
   }
   self->preMarkHooks.running = false;
   // This is very unlikely to happen.
   if (dead > 0) {
-    PreMarkHookNode** previous = &self->preMarkHooks.nodes;
-    PreMarkHookNode* current = self->preMarkHooks.nodes;
-    while (current) {
-      if (current->dead) {
-        PreMarkHookNode* node = current;
-        *previous = current->next;
-        current = current->next;
-        Shizu_State1_deallocate(Shizu_State2_getState1(state), node);
-      } else {
-        previous = &current->next;
-        current = current->next;
+    removeDeadPreMarkHooks(self);
+  }
+}
+
+// The maximum number of objects visited by one invocation of Shizu_Gcx_visitObjects when visiting the root ranges.
+#define RootRangeBatchSize (64)
+
+// Visit the objects referenced by the values of the root ranges.
+// The objects are collected into a batch such that Gcx is invoked once per batch and not once per value.
+static void
+visitRootRanges
+  (
+    Shizu_State2* state,
+    Shizu_Gc* self
+  )
+{
+  void* batch[RootRangeBatchSize];
+  size_t batchSize = 0;
+  for (size_t i = 0, n = self->rootRanges.size; i < n; ++i) {
+    Shizu_Value const* values = *self->rootRanges.elements[i].values;
+    size_t numberOfValues = *self->rootRanges.elements[i].numberOfValues;
+    for (size_t j = 0; j < numberOfValues; ++j) {
+      if (Shizu_Value_isObject(&values[j])) {
+        batch[batchSize++] = Shizu_Value_getObject(&values[j]);
+        if (RootRangeBatchSize == batchSize) {
+          Shizu_Gcx_visitObjects(batch, batchSize);
+          batchSize = 0;
+        }
       }
-      node->function(Shizu_State2_getState1(state), self, node->context);
     }
   }
+  if (batchSize) {
+    Shizu_Gcx_visitObjects(batch, batchSize);
+  }
+}
+
+// Visit the locked objects.
+static void
+visitLockedObjects
+  (
+    Shizu_State2* state,
+    Shizu_Gc* self
+  )
+{
+  for (size_t i = 0, n = self->objectRecords.capacity; i < n; ++i) {
+    for (Shizu_ObjectRecord* record = self->objectRecords.buckets[i]; NULL != record; record = record->next) {
+      if (record->lockCount) {
+        Shizu_Gcx_visit(record->object);
+      }
+    }
+  }
+}
+
+// Visit the roots: Notify the pre mark hooks, visit the root ranges, and visit the locked objects.
+static void
+visitRoots
+  (
+    Shizu_State2* state,
+    Shizu_Gc* self
+  )
+{
+  notifyPreMarkHooks(state, self);
+  visitRootRanges(state, self);
+  visitLockedObjects(state, self);
+}
+
+// Rehash the side records into a table of the specified capacity (a power of two).
+// If the table can not be allocated, the side records stay in the current table.
+// Side records in excess of the new capacity are removed from the free list.
+static void
+resizeObjectRecords
+  (
+    Shizu_State1* state1,
+    Shizu_Gc* self,
+    size_t newCapacity
+  )
+{
+  Shizu_ObjectRecord** newBuckets = Shizu_State1_allocate(state1, sizeof(Shizu_ObjectRecord*) * newCapacity);
+  if (!newBuckets) {
+    return;
+  }
+  for (size_t i = 0; i < newCapacity; ++i) {
+    newBuckets[i] = NULL;
+  }
+  for (size_t i = 0, n = self->objectRecords.capacity; i < n; ++i) {
+    while (self->objectRecords.buckets[i]) {
+      Shizu_ObjectRecord* record = self->objectRecords.buckets[i];
+      self->objectRecords.buckets[i] = record->next;
+      size_t hashIndex = record->hashValue & (newCapacity - 1);
+      record->next = newBuckets[hashIndex];
+      newBuckets[hashIndex] = record;
+    }
+  }
+  Shizu_State1_deallocate(state1, self->objectRecords.buckets);
+  self->objectRecords.buckets = newBuckets;
+  self->objectRecords.capacity = newCapacity;
+  while (self->objectRecords.freeSize > newCapacity) {
+    Shizu_ObjectRecord* record = self->objectRecords.free;
+    self->objectRecords.free = record->next;
+    self->objectRecords.freeSize--;
+    Shizu_State1_deallocate(state1, record);
+  }
+}
+
+// Find the side record of an object.
+// The object must have a side record.
+static inline Shizu_ObjectRecord*
+findObjectRecord
+  (
+    Shizu_Gc* self,
+    Shizu_Object* object
+  )
+{
+  Shizu_ObjectRecord* current = self->objectRecords.buckets[hashObject(object) & (self->objectRecords.capacity - 1)];
+  while (current->object != object) {
+    current = current->next;
+  }
+  return current;
+}
+
+// Remove a side record from the table and put it into the free list.
+// Shrink the table if its load factor falls below 1/8.
+static void
+removeObjectRecord
+  (
+    Shizu_State1* state1,
+    Shizu_Gc* self,
+    Shizu_ObjectRecord* record
+  )
+{
+  Shizu_ObjectRecord** previous = &(self->objectRecords.buckets[record->hashValue & (self->objectRecords.capacity - 1)]);
+  while (*previous != record) {
+    previous = &(*previous)->next;
+  }
+  *previous = record->next;
+  self->objectRecords.size--;
+  if (self->objectRecords.freeSize < self->objectRecords.capacity) {
+    record->next = self->objectRecords.free;
+    self->objectRecords.free = record;
+    self->objectRecords.freeSize++;
+  } else {
+    Shizu_State1_deallocate(state1, record);
+  }
+  if (self->objectRecords.capacity > ObjectRecordsMinimumCapacity && self->objectRecords.size < self->objectRecords.capacity / 8) {
+    resizeObjectRecords(state1, self, self->objectRecords.capacity / 2);
+  }
+}
+
+// Remove the side record of an object which is finalized.
+// The weak references to the object are cleared.
+static void
+finalizeObjectRecord
+  (
+    Shizu_State2* state,
+    Shizu_Gc* self,
+    Shizu_Object* object
+  )
+{
+  Shizu_ObjectRecord* record = findObjectRecord(self, object);
+  if (record->weakReferences) {
+    Shizu_WeakReferenceState_notifyObjectFinalize(Shizu_State2_getState1(state), self, Shizu_State2_getWeakReferences(state), record);
+  }
+  removeObjectRecord(Shizu_State2_getState1(state), self, record);
 }
 
 static void
@@ -256,16 +552,32 @@ Shizu_GcxInterface_finalizeCallback
 {
   Shizu_State2* state1 = (Shizu_State2*)finalizeContext;
   Shizu_Object* object1 = (Shizu_Object*)object;
+  Shizu_Gc* gc = Shizu_State2_getGc(state1);
 
-  // TODO: Shizu_Locks_notifyDestroy as well as Shizu_WeakReferences_notifyDestroy perform an object address hash lookup.
-  //       Investigage if there is a relevant performance gain when only one hash table is used?
-  notifyObjectFinalizeHooks(state1, Shizu_State2_getGc(state1), object);
-  while (object1->type) {
-    if (object1->type->objectType.descriptor->finalize) {
-      object1->type->objectType.descriptor->finalize(state1, object);
-    }
-    object1->type = object1->type->objectType.parentType;
+  // Count the object as freed.
+  Shizu_Type* type = object1->type;
+  if (type->objectType.freed.collection != gc->collectionsBegun) {
+    type->objectType.freed.collection = gc->collectionsBegun;
+    type->objectType.freed.objects = 0;
+    type->objectType.freed.bytes = 0;
   }
+  size_t size = 0;
+  Shizu_Gcx_getObjectSize(object, &size);
+  type->objectType.freed.objects++;
+  type->objectType.freed.bytes += size;
+
+  // Only objects with the record flag set have a side record to remove.
+  if (Shizu_Gcx_getRecordFlag(object)) {
+    finalizeObjectRecord(state1, gc, object1);
+  }
+  notifyObjectFinalizeHooks(state1, gc, object);
+  // The type of the object is the type of the finalize callback when that callback is invoked.
+  Shizu_ObjectTypeFinalizer const* finalizers = type->objectType.finalizers.elements;
+  for (size_t i = 0, n = type->objectType.finalizers.size; i < n; ++i) {
+    object1->type = finalizers[i].type;
+    finalizers[i].finalize(state1, object);
+  }
+  object1->type = NULL;
 }
 
 static void
@@ -278,29 +590,593 @@ Shizu_GcxInterface_visitCallback
   Shizu_State2* state1 = (Shizu_State2*)visitContext;
   Shizu_Object* object1 = (Shizu_Object*)object;
   Shizu_Type* type = object1->type;
-  while (type) {
-    if (type->objectType.descriptor->visit) {
-      type->objectType.descriptor->visit(state1, object1);
+  // Objects of types without reference fields and visit callbacks (for example, byte arrays) do not reference other objects.
+  Shizu_ObjectTypeField const* fields = type->objectType.fields.elements;
+  for (size_t i = 0, n = type->objectType.fields.size; i < n; ++i) {
+    char* field = (char*)object1 + fields[i].offset;
+    if (Shizu_ObjectTypeFieldKind_Object == fields[i].kind) {
+      Shizu_Object* reference = *(Shizu_Object**)field;
+      if (reference) {
+        Shizu_Gcx_visit(reference);
+      }
+    } else {
+      Shizu_Value* value = (Shizu_Value*)field;
+      if (Shizu_Value_isObject(value)) {
+        Shizu_Gcx_visit(Shizu_Value_getObject(value));
+      }
     }
-    type = type->objectType.parentType;
+  }
+  Shizu_OnVisitCallback** visitors = type->objectType.visitors.elements;
+  for (size_t i = 0, n = type->objectType.visitors.size; i < n; ++i) {
+    visitors[i](state1, object1);
   }
 }
 
-void
-Shizu_Gc_run
+static void
+beginCollection
   (
     Shizu_State2* state,
     Shizu_Gc* self,
-    Shizu_Gc_SweepInfo* sweepInfo
+    Shizu_Gcx_Collection collection
   )
 {
   Shizu_Cxx_Debug_assert(NULL == self->gray);
-  notifyPreMarkHooks(state, self);
+  uint64_t start = Shizu_getMonotonicTime(Shizu_State2_getState1(state));
+  if (Shizu_Gcx_begin(collection)) {
+    Shizu_State2_setStatus(state, Shizu_Status_OperationInvalid);
+    Shizu_State2_jump(state);
+  }
+  self->collectionsBegun++;
+  self->statistics.allocatedBytes = 0;
+  self->collection = collection;
+  self->current.marked = 0;
+  self->current.dead = 0;
+  self->current.live = 0;
+  self->current.markDuration = 0;
+  self->current.sweepDuration = 0;
+  visitRoots(state, self);
+  self->current.markDuration += Shizu_getMonotonicTime(Shizu_State2_getState1(state)) - start;
+}
+
+// Mark without a budget and begin the sweep.
+// The strings not marked are removed from the intern table before the sweep begins
+// such that the intern table never yields a string reclaimed by this collection.
+static void
+markAndBeginSweep
+  (
+    Shizu_State2* state,
+    Shizu_Gc* self
+  )
+{
+  size_t marked;
+  bool done;
+  if (Shizu_Gcx_mark(SIZE_MAX, &marked, &done)) {
+    Shizu_State2_setStatus(state, Shizu_Status_OperationInvalid);
+    Shizu_State2_jump(state);
+  }
+  self->current.marked += marked;
+  Shizu_Strings_notifyMarkComplete(Shizu_State2_getState1(state), self, Shizu_State2_getStrings(state));
+  if (Shizu_Gcx_beginSweep()) {
+    Shizu_State2_setStatus(state, Shizu_Status_OperationInvalid);
+    Shizu_State2_jump(state);
+  }
+}
+
+// Visit the roots again, mark without a budget, and begin the sweep.
+// The roots must be visited again as the mutator may have modified them without invoking the write barrier.
+static void
+endMark
+  (
+    Shizu_State2* state,
+    Shizu_Gc* self
+  )
+{
+  uint64_t start = Shizu_getMonotonicTime(Shizu_State2_getState1(state));
+  visitRoots(state, self);
+  markAndBeginSweep(state, self);
+  self->current.markDuration += Shizu_getMonotonicTime(Shizu_State2_getState1(state)) - start;
+}
+
+static void
+sweep
+  (
+    Shizu_State2* state,
+    Shizu_Gc* self,
+    size_t budget
+  )
+{
+  uint64_t start = Shizu_getMonotonicTime(Shizu_State2_getState1(state));
   size_t dead, live;
-  Shizu_Gcx_run(&dead, &live);
+  bool done;
+  if (Shizu_Gcx_sweep(budget, &dead, &live, &done)) {
+    Shizu_State2_setStatus(state, Shizu_Status_OperationInvalid);
+    Shizu_State2_jump(state);
+  }
+  self->current.dead += dead;
+  self->current.live += live;
+  uint64_t end = Shizu_getMonotonicTime(Shizu_State2_getState1(state));
+  self->current.sweepDuration += end - start;
+  if (done) {
+    if (Shizu_Gcx_Collection_Major == self->collection) {
+      self->minorRuns = 0;
+    } else {
+      self->minorRuns++;
+      self->statistics.minorCollections++;
+    }
+    self->statistics.collections++;
+    self->statistics.markDuration = self->current.markDuration;
+    self->statistics.sweepDuration = self->current.sweepDuration;
+    self->statistics.totalMarkDuration += self->current.markDuration;
+    self->statistics.totalSweepDuration += self->current.sweepDuration;
+    Shizu_Gcx_TypeStatistics typeStatistics;
+    if (Shizu_Gcx_getTypeStatistics(self->type, &typeStatistics)) {
+      Shizu_State2_setStatus(state, Shizu_Status_OperationInvalid);
+      Shizu_State2_jump(state);
+    }
+    self->statistics.liveBytes = typeStatistics.liveBytes;
+    self->pacing.lastCollectionEnd = end;
+    updatePacing(self);
+  }
+}
+
+// Invoke the finalizers of at most budget dead objects and deallocate these objects.
+// Return the number of objects finalized.
+static size_t
+finalize
+  (
+    Shizu_State2* state,
+    Shizu_Gc* self,
+    size_t budget
+  )
+{
+  size_t finalized;
+  bool done;
+  if (Shizu_Gcx_finalize(budget, &finalized, &done)) {
+    Shizu_State2_setStatus(state, Shizu_Status_OperationInvalid);
+    Shizu_State2_jump(state);
+  }
+  return finalized;
+}
+
+static Shizu_Gcx_Phase
+getPhase
+  (
+    Shizu_State2* state
+  )
+{
+  Shizu_Gcx_Phase phase;
+  if (Shizu_Gcx_getPhase(&phase)) {
+    Shizu_State2_setStatus(state, Shizu_Status_OperationInvalid);
+    Shizu_State2_jump(state);
+  }
+  return phase;
+}
+
+static Shizu_Gcx_Collection
+selectCollection
+  (
+    Shizu_Gc* self
+  )
+{
+#if 1 == Shizu_Configuration_WithGcGenerational
+  if (self->minorRuns < Shizu_Gc_MinorRunsPerMajorRun) {
+    return Shizu_Gcx_Collection_Minor;
+  } else {
+    return Shizu_Gcx_Collection_Major;
+  }
+#else
+  return Shizu_Gcx_Collection_Major;
+#endif
+}
+
+static void
+getSweepInfo
+  (
+    Shizu_State2* state,
+    Shizu_Gc* self,
+    Shizu_Gc_SweepInfo* sweepInfo
+  )
+{
+  sweepInfo->marked = self->current.marked;
+  sweepInfo->dead = self->current.dead;
+  sweepInfo->live = self->current.live;
+  switch (getPhase(state)) {
+    case Shizu_Gcx_Phase_Mark: {
+      sweepInfo->phase = Shizu_Gc_Phase_Mark;
+    } break;
+    case Shizu_Gcx_Phase_Sweep: {
+      sweepInfo->phase = Shizu_Gc_Phase_Sweep;
+    } break;
+    default: {
+      sweepInfo->phase = Shizu_Gc_Phase_None;
+    } break;
+  };
+}
+
+// Complete the collection in progress (if any).
+static void
+complete
+  (
+    Shizu_State2* state,
+    Shizu_Gc* self
+  )
+{
+  Shizu_Gcx_Phase phase = getPhase(state);
+  if (Shizu_Gcx_Phase_Mark == phase) {
+    endMark(state, self);
+    phase = Shizu_Gcx_Phase_Sweep;
+  }
+  if (Shizu_Gcx_Phase_Sweep == phase) {
+    sweep(state, self, SIZE_MAX);
+  }
+}
+
+static void
+run
+  (
+    Shizu_State2* state,
+    Shizu_Gc* self,
+    Shizu_Gcx_Collection collection,
+    Shizu_Gc_SweepInfo* sweepInfo
+  )
+{
+  complete(state, self);
+  beginCollection(state, self, collection);
+  uint64_t start = Shizu_getMonotonicTime(Shizu_State2_getState1(state));
+  markAndBeginSweep(state, self);
+  self->current.markDuration += Shizu_getMonotonicTime(Shizu_State2_getState1(state)) - start;
+  sweep(state, self, SIZE_MAX);
+  size_t finalized = finalize(state, self, SIZE_MAX);
   if (sweepInfo) {
-    sweepInfo->dead = dead;
-    sweepInfo->live = live;
+    getSweepInfo(state, self, sweepInfo);
+    sweepInfo->finalized = finalized;
+  }
+}
+
+void
+Shizu_Gc_step
+  (
+    Shizu_State2* state,
+    Shizu_Gc* self,
+    size_t budget,
+    Shizu_Gc_SweepInfo* sweepInfo
+  )
+{
+  if (!budget) {
+    Shizu_State2_setStatus(state, Shizu_Status_ArgumentValueInvalid);
+    Shizu_State2_jump(state);
+  }
+  switch (getPhase(state)) {
+    case Shizu_Gcx_Phase_None: {
+      beginCollection(state, self, selectCollection(self));
+    } break;
+    case Shizu_Gcx_Phase_Mark: {
+      uint64_t start = Shizu_getMonotonicTime(Shizu_State2_getState1(state));
+      size_t marked;
+      bool done;
+      if (Shizu_Gcx_mark(budget, &marked, &done)) {
+        Shizu_State2_setStatus(state, Shizu_Status_OperationInvalid);
+        Shizu_State2_jump(state);
+      }
+      self->current.marked += marked;
+      self->current.markDuration += Shizu_getMonotonicTime(Shizu_State2_getState1(state)) - start;
+      if (done) {
+        endMark(state, self);
+      }
+    } break;
+    case Shizu_Gcx_Phase_Sweep: {
+      sweep(state, self, budget);
+    } break;
+  };
+  // This is a safe point to invoke the finalizers of the objects reclaimed by this or a previous collection.
+  size_t finalized = finalize(state, self, budget);
+  if (sweepInfo) {
+    getSweepInfo(state, self, sweepInfo);
+    sweepInfo->finalized = finalized;
+  }
+}
+
+void
+Shizu_Gc_run
+  (
+    Shizu_State2* state,
+    Shizu_Gc* self,
+    Shizu_Gc_SweepInfo* sweepInfo
+  )
+{
+  run(state, self, selectCollection(self), sweepInfo);
+}
+
+void
+Shizu_Gc_runMinor
+  (
+    Shizu_State2* state,
+    Shizu_Gc* self,
+    Shizu_Gc_SweepInfo* sweepInfo
+  )
+{
+#if 1 == Shizu_Configuration_WithGcGenerational
+  run(state, self, Shizu_Gcx_Collection_Minor, sweepInfo);
+#else
+  run(state, self, Shizu_Gcx_Collection_Major, sweepInfo);
+#endif
+}
+
+void
+Shizu_Gc_runMajor
+  (
+    Shizu_State2* state,
+    Shizu_Gc* self,
+    Shizu_Gc_SweepInfo* sweepInfo
+  )
+{
+  run(state, self, Shizu_Gcx_Collection_Major, sweepInfo);
+}
+
+void
+Shizu_Gc_getPacing
+  (
+    Shizu_State2* state,
+    Shizu_Gc* self,
+    Shizu_Gc_Pacing* pacing
+  )
+{
+  if (!pacing) {
+    Shizu_State2_setStatus(state, Shizu_Status_ArgumentValueInvalid);
+    Shizu_State2_jump(state);
+  }
+  *pacing = self->pacing.policy;
+}
+
+void
+Shizu_Gc_setPacing
+  (
+    Shizu_State2* state,
+    Shizu_Gc* self,
+    Shizu_Gc_Pacing const* pacing
+  )
+{
+  if (!pacing) {
+    Shizu_State2_setStatus(state, Shizu_Status_ArgumentValueInvalid);
+    Shizu_State2_jump(state);
+  }
+  self->pacing.policy = *pacing;
+  updatePacing(self);
+}
+
+bool
+Shizu_Gc_poll
+  (
+    Shizu_State2* state,
+    Shizu_Gc* self,
+    Shizu_Gc_SweepInfo* sweepInfo
+  )
+{
+  Shizu_Gc_Pacing const* policy = &self->pacing.policy;
+  size_t heapBytes = self->statistics.liveBytes > SIZE_MAX - self->statistics.allocatedBytes
+                   ? SIZE_MAX : self->statistics.liveBytes + self->statistics.allocatedBytes;
+  // The maximum heap size triggers a collection regardless of the growth factor and the minimum interval.
+  if (!policy->maximumHeapSize || heapBytes < policy->maximumHeapSize) {
+    if (heapBytes < self->pacing.triggerBytes) {
+      return false;
+    }
+    if (Shizu_getMonotonicTime(Shizu_State2_getState1(state)) - self->pacing.lastCollectionEnd < policy->minimumInterval) {
+      return false;
+    }
+  }
+  if (Shizu_Gcx_Phase_None != getPhase(state)) {
+    complete(state, self);
+    size_t finalized = finalize(state, self, SIZE_MAX);
+    if (sweepInfo) {
+      getSweepInfo(state, self, sweepInfo);
+      sweepInfo->finalized = finalized;
+    }
+  } else {
+    run(state, self, selectCollection(self), sweepInfo);
+  }
+  self->statistics.pacedCollections++;
+  return true;
+}
+
+void
+Shizu_Gc_getStatistics
+  (
+    Shizu_State2* state,
+    Shizu_Gc* self,
+    Shizu_Gc_Statistics* statistics
+  )
+{
+  if (!statistics) {
+    Shizu_State2_setStatus(state, Shizu_Status_ArgumentValueInvalid);
+    Shizu_State2_jump(state);
+  }
+  *statistics = self->statistics;
+}
+
+typedef struct CensusContext {
+  Shizu_Type* type;
+  Shizu_Gc_TypeStatistics* statistics;
+} CensusContext;
+
+static void
+censusCallback
+  (
+    CensusContext* context,
+    Shizu_Object* object,
+    size_t size,
+    bool recent
+  )
+{
+  if (object->type != context->type) {
+    return;
+  }
+  context->statistics->liveObjects++;
+  context->statistics->liveBytes += size;
+  if (recent) {
+    context->statistics->allocatedObjects++;
+    context->statistics->allocatedBytes += size;
+  }
+}
+
+void
+Shizu_Gc_getTypeStatistics
+  (
+    Shizu_State2* state,
+    Shizu_Gc* self,
+    Shizu_Type* type,
+    Shizu_Gc_TypeStatistics* statistics
+  )
+{
+  if (!statistics || !type || !Shizu_Types_isObjectType(Shizu_State2_getState1(state), Shizu_State2_getTypes(state), type)) {
+    Shizu_State2_setStatus(state, Shizu_Status_ArgumentValueInvalid);
+    Shizu_State2_jump(state);
+  }
+  statistics->liveObjects = 0;
+  statistics->liveBytes = 0;
+  statistics->allocatedObjects = 0;
+  statistics->allocatedBytes = 0;
+  CensusContext context = { .type = type, .statistics = statistics };
+  if (Shizu_Gcx_enumerateObjects(self->type, &context, (Shizu_Gcx_EnumerateCallback*)&censusCallback)) {
+    Shizu_State2_setStatus(state, Shizu_Status_OperationInvalid);
+    Shizu_State2_jump(state);
+  }
+  if (type->objectType.freed.collection == self->collectionsBegun) {
+    statistics->freedObjects = type->objectType.freed.objects;
+    statistics->freedBytes = type->objectType.freed.bytes;
+  } else {
+    statistics->freedObjects = 0;
+    statistics->freedBytes = 0;
+  }
+}
+
+static void
+setCount
+  (
+    Shizu_State2* state,
+    Shizu_Map* map,
+    char const* name,
+    size_t count
+  )
+{
+  Shizu_Value key, value;
+  Shizu_Value_setObject(&key, (Shizu_Object*)Shizu_String_createInterned(state, name, strlen(name)));
+  Shizu_Value_setInteger32(&value, count > Shizu_Integer32_Maximum ? Shizu_Integer32_Maximum : (Shizu_Integer32)count);
+  Shizu_Map_set(state, map, &key, &value);
+}
+
+static void
+setDuration
+  (
+    Shizu_State2* state,
+    Shizu_Map* map,
+    char const* name,
+    uint64_t duration
+  )
+{
+  Shizu_Value key, value;
+  Shizu_Value_setObject(&key, (Shizu_Object*)Shizu_String_createInterned(state, name, strlen(name)));
+  Shizu_Value_setFloat32(&value, (Shizu_Float32)((double)duration / 1000000.0));
+  Shizu_Map_set(state, map, &key, &value);
+}
+
+// Gc.getStatistics() : Map
+static void
+getStatisticsProcedure
+  (
+    Shizu_State2* state,
+    Shizu_Value* returnValue,
+    Shizu_Integer32 numberOfArgumentValues,
+    Shizu_Value* argumentValues
+  )
+{
+  if (0 != numberOfArgumentValues) {
+    Shizu_State2_setStatus(state, Shizu_Status_NumberOfArgumentsInvalid);
+    Shizu_State2_jump(state);
+  }
+  Shizu_Gc_Statistics statistics;
+  Shizu_Gc_getStatistics(state, Shizu_State2_getGc(state), &statistics);
+  Shizu_Map* map = Shizu_Runtime_Extensions_createMap(state);
+  setCount(state, map, "collections", statistics.collections);
+  setCount(state, map, "minorCollections", statistics.minorCollections);
+  setDuration(state, map, "markDuration", statistics.markDuration);
+  setDuration(state, map, "sweepDuration", statistics.sweepDuration);
+  setDuration(state, map, "totalMarkDuration", statistics.totalMarkDuration);
+  setDuration(state, map, "totalSweepDuration", statistics.totalSweepDuration);
+  setCount(state, map, "pacedCollections", statistics.pacedCollections);
+  setCount(state, map, "liveBytes", statistics.liveBytes);
+  setCount(state, map, "allocatedBytes", statistics.allocatedBytes);
+  Shizu_Value_setObject(returnValue, (Shizu_Object*)map);
+}
+
+// Gc.getTypeStatistics(name : String) : Map
+static void
+getTypeStatisticsProcedure
+  (
+    Shizu_State2* state,
+    Shizu_Value* returnValue,
+    Shizu_Integer32 numberOfArgumentValues,
+    Shizu_Value* argumentValues
+  )
+{
+  if (1 != numberOfArgumentValues) {
+    Shizu_State2_setStatus(state, Shizu_Status_NumberOfArgumentsInvalid);
+    Shizu_State2_jump(state);
+  }
+  Shizu_String* name = Shizu_Runtime_Extensions_getStringValue(state, &argumentValues[0]);
+  Shizu_Type* type = Shizu_Types_getTypeByName(Shizu_State2_getState1(state), Shizu_State2_getTypes(state), Shizu_String_getBytes(state, name), Shizu_String_getNumberOfBytes(state, name));
+  if (!type || !Shizu_Types_isObjectType(Shizu_State2_getState1(state), Shizu_State2_getTypes(state), type)) {
+    Shizu_State2_setStatus(state, Shizu_Status_ArgumentValueInvalid);
+    Shizu_State2_jump(state);
+  }
+  Shizu_Gc_TypeStatistics statistics;
+  Shizu_Gc_getTypeStatistics(state, Shizu_State2_getGc(state), type, &statistics);
+  Shizu_Map* map = Shizu_Runtime_Extensions_createMap(state);
+  setCount(state, map, "liveObjects", statistics.liveObjects);
+  setCount(state, map, "liveBytes", statistics.liveBytes);
+  setCount(state, map, "allocatedObjects", statistics.allocatedObjects);
+  setCount(state, map, "allocatedBytes", statistics.allocatedBytes);
+  setCount(state, map, "freedObjects", statistics.freedObjects);
+  setCount(state, map, "freedBytes", statistics.freedBytes);
+  Shizu_Value_setObject(returnValue, (Shizu_Object*)map);
+}
+
+void
+Shizu_Gc_registerProcedures
+  (
+    Shizu_State2* state
+  )
+{
+  Shizu_Environment* environment = Shizu_Runtime_Extensions_getOrCreateEnvironment(state, Shizu_State2_getGlobalEnvironment(state), Shizu_String_createInterned(state, "Gc", strlen("Gc")));
+  Shizu_Value value;
+  Shizu_Value_setObject(&value, (Shizu_Object*)Shizu_CxxProcedure_create(state, &getStatisticsProcedure, NULL));
+  Shizu_Environment_set(state, environment, Shizu_String_createInterned(state, "getStatistics", strlen("getStatistics")), &value);
+  Shizu_Value_setObject(&value, (Shizu_Object*)Shizu_CxxProcedure_create(state, &getTypeStatisticsProcedure, NULL));
+  Shizu_Environment_set(state, environment, Shizu_String_createInterned(state, "getTypeStatistics", strlen("getTypeStatistics")), &value);
+}
+
+void
+Shizu_Gc_writeBarrier
+  (
+    Shizu_State1* state1,
+    Shizu_Gc* gc,
+    Shizu_Object* object,
+    Shizu_Object* value
+  )
+{
+  Shizu_Gcx_writeBarrier(object, value);
+}
+
+void
+Shizu_Gc_writeBarrierValue
+  (
+    Shizu_State1* state1,
+    Shizu_Gc* gc,
+    Shizu_Object* object,
+    Shizu_Value const* value
+  )
+{
+  if (Shizu_Value_isObject(value)) {
+    Shizu_Gcx_writeBarrier(object, Shizu_Value_getObject(value));
   }
 }
 
@@ -315,6 +1191,89 @@ Shizu_Gc_visitObject
   Shizu_Gcx_visit(object);
 }
 
+void
+Shizu_Gc_readBarrier
+  (
+    Shizu_State1* state1,
+    Shizu_Gc* self,
+    Shizu_Object* object
+  )
+{
+  Shizu_Gcx_Phase phase;
+  if (Shizu_Gcx_getPhase(&phase)) {
+    Shizu_State1_setStatus(state1, Shizu_Status_OperationInvalid);
+    Shizu_State1_jump(state1);
+  }
+  if (Shizu_Gcx_Phase_Mark == phase) {
+    Shizu_Gcx_visit(object);
+  }
+}
+
+bool
+Shizu_Object_isWhite
+  (
+    Shizu_Object const* object
+  )
+{
+  return Shizu_Gcx_isWhite(object);
+}
+
+Shizu_ObjectRecord*
+Shizu_Gc_getObjectRecord
+  (
+    Shizu_State1* state1,
+    Shizu_Gc* self,
+    Shizu_Object* object,
+    bool create
+  )
+{
+  if (Shizu_Gcx_getRecordFlag(object)) {
+    return findObjectRecord(self, object);
+  }
+  if (!create) {
+    return NULL;
+  }
+  Shizu_ObjectRecord* record = self->objectRecords.free;
+  if (record) {
+    self->objectRecords.free = record->next;
+    self->objectRecords.freeSize--;
+  } else {
+    record = Shizu_State1_allocate(state1, sizeof(Shizu_ObjectRecord));
+    if (!record) {
+      Shizu_State1_setStatus(state1, Shizu_Status_AllocationFailed);
+      Shizu_State1_jump(state1);
+    }
+  }
+  record->object = object;
+  record->hashValue = hashObject(object);
+  record->lockCount = 0;
+  record->weakReferences = NULL;
+  size_t hashIndex = record->hashValue & (self->objectRecords.capacity - 1);
+  record->next = self->objectRecords.buckets[hashIndex];
+  self->objectRecords.buckets[hashIndex] = record;
+  self->objectRecords.size++;
+  Shizu_Gcx_setRecordFlag(object, true);
+  if (self->objectRecords.size > self->objectRecords.capacity / 4 * 3 && self->objectRecords.capacity <= SIZE_MAX / 2 / sizeof(Shizu_ObjectRecord*)) {
+    resizeObjectRecords(state1, self, self->objectRecords.capacity * 2);
+  }
+  return record;
+}
+
+void
+Shizu_Gc_releaseObjectRecord
+  (
+    Shizu_State1* state1,
+    Shizu_Gc* self,
+    Shizu_ObjectRecord* record
+  )
+{
+  if (record->lockCount || record->weakReferences) {
+    return;
+  }
+  Shizu_Gcx_setRecordFlag(record->object, false);
+  removeObjectRecord(state1, self, record);
+}
+
 void
 Shizu_Gc_visitValue
   (
@@ -323,7 +1282,7 @@ Shizu_Gc_visitValue
     Shizu_Value* value
   )
 {
-  switch (value->tag) {
+  switch (Shizu_Value_getTag(value)) {
     case Shizu_Value_Tag_Object: {
       Shizu_Gc_visitObject(state1, gc, (Shizu_Object*)Shizu_Value_getObject(value));
     } break;
@@ -342,16 +1301,20 @@ Shizu_Gc_addPreMarkHook
     Shizu_Gc_PreMarkCallbackFunction* function
   )
 {
-  PreMarkHookNode* node = Shizu_State1_allocate(state, sizeof(PreMarkHookNode));
-  if (!node) {
-    Shizu_State1_setStatus(state, Shizu_Status_AllocationFailed);
-    Shizu_State1_jump(state);
+  if (gc->preMarkHooks.size == gc->preMarkHooks.capacity) {
+    size_t newCapacity = gc->preMarkHooks.capacity ? 2 * gc->preMarkHooks.capacity : 8;
+    PreMarkHook* newElements = Shizu_State1_reallocate(state, gc->preMarkHooks.elements, sizeof(PreMarkHook) * newCapacity);
+    if (!newElements) {
+      Shizu_State1_setStatus(state, Shizu_Status_AllocationFailed);
+      Shizu_State1_jump(state);
+    }
+    gc->preMarkHooks.elements = newElements;
+    gc->preMarkHooks.capacity = newCapacity;
   }
-  node->next = gc->preMarkHooks.nodes;
-  gc->preMarkHooks.nodes = node;
-  node->context = context;
-  node->function = function;
-  node->dead = false;
+  PreMarkHook* hook = gc->preMarkHooks.elements + gc->preMarkHooks.size++;
+  hook->context = context;
+  hook->function = function;
+  hook->dead = false;
 }
 
 void
@@ -363,29 +1326,67 @@ Shizu_Gc_removePreMarkHook
     Shizu_Gc_PreMarkCallbackFunction* function
   )
 {
-  if (gc->preMarkHooks.running) {
-    PreMarkHookNode* node = gc->preMarkHooks.nodes;
-    while (node) {
-      if (node->context == context && node->function == function) {
-        node->dead = true;
-      }
-      node = node->next;
+  for (size_t i = 0, n = gc->preMarkHooks.size; i < n; ++i) {
+    PreMarkHook* hook = gc->preMarkHooks.elements + i;
+    if (hook->context == context && hook->function == function) {
+      hook->dead = true;
     }
-  } else {
-    PreMarkHookNode** previous = &gc->preMarkHooks.nodes;
-    PreMarkHookNode* current = gc->preMarkHooks.nodes;
-    while (current) {
-      if (current->dead || (current->context == context && current->function == function)) {
-        *previous = current->next;
-        PreMarkHookNode* node = current;
-        current = current->next;
-        Shizu_State1_deallocate(state, node);
-      } else {
-        previous = &current->next;
-        current = current->next;
-      }
+  }
+  // If the hooks are being notified, the dead hooks are removed after the notification.
+  if (!gc->preMarkHooks.running) {
+    removeDeadPreMarkHooks(gc);
+  }
+}
+
+void
+Shizu_Gc_addRootRange
+  (
+    Shizu_State1* state,
+    Shizu_Gc* gc,
+    Shizu_Value* const* values,
+    size_t const* numberOfValues
+  )
+{
+  if (!values || !numberOfValues) {
+    Shizu_State1_setStatus(state, Shizu_Status_ArgumentValueInvalid);
+    Shizu_State1_jump(state);
+  }
+  if (gc->rootRanges.size == gc->rootRanges.capacity) {
+    size_t newCapacity = gc->rootRanges.capacity ? 2 * gc->rootRanges.capacity : 8;
+    RootRange* newElements = Shizu_State1_reallocate(state, gc->rootRanges.elements, sizeof(RootRange) * newCapacity);
+    if (!newElements) {
+      Shizu_State1_setStatus(state, Shizu_Status_AllocationFailed);
+      Shizu_State1_jump(state);
+    }
+    gc->rootRanges.elements = newElements;
+    gc->rootRanges.capacity = newCapacity;
+  }
+  RootRange* rootRange = gc->rootRanges.elements + gc->rootRanges.size++;
+  rootRange->values = values;
+  rootRange->numberOfValues = numberOfValues;
+}
+
+void
+Shizu_Gc_removeRootRange
+  (
+    Shizu_State1* state,
+    Shizu_Gc* gc,
+    Shizu_Value* const* values,
+    size_t const* numberOfValues
+  )
+{
+  if (!values || !numberOfValues) {
+    Shizu_State1_setStatus(state, Shizu_Status_ArgumentValueInvalid);
+    Shizu_State1_jump(state);
+  }
+  size_t j = 0;
+  for (size_t i = 0, n = gc->rootRanges.size; i < n; ++i) {
+    RootRange* rootRange = gc->rootRanges.elements + i;
+    if (rootRange->values != values || rootRange->numberOfValues != numberOfValues) {
+      gc->rootRanges.elements[j++] = *rootRange;
     }
   }
+  gc->rootRanges.size = j;
 }
 
 void
@@ -397,16 +1398,20 @@ Shizu_Gc_addObjectFinalizeHook
     Shizu_Gc_ObjectFinalizeCallbackFunction* function
   )
 {
-  ObjectFinalizeHookNode* node = Shizu_State1_allocate(state, sizeof(ObjectFinalizeHookNode));
-  if (!node) {
-    Shizu_State1_setStatus(state, Shizu_Status_AllocationFailed);
-    Shizu_State1_jump(state);
+  if (gc->objectFinalizeHooks.size == gc->objectFinalizeHooks.capacity) {
+    size_t newCapacity = gc->objectFinalizeHooks.capacity ? 2 * gc->objectFinalizeHooks.capacity : 8;
+    ObjectFinalizeHook* newElements = Shizu_State1_reallocate(state, gc->objectFinalizeHooks.elements, sizeof(ObjectFinalizeHook) * newCapacity);
+    if (!newElements) {
+      Shizu_State1_setStatus(state, Shizu_Status_AllocationFailed);
+      Shizu_State1_jump(state);
+    }
+    gc->objectFinalizeHooks.elements = newElements;
+    gc->objectFinalizeHooks.capacity = newCapacity;
   }
-  node->next = gc->objectFinalizeHooks.nodes;
-  gc->objectFinalizeHooks.nodes = node;
-  node->context = context;
-  node->function = function;
-  node->dead = false;
+  ObjectFinalizeHook* hook = gc->objectFinalizeHooks.elements + gc->objectFinalizeHooks.size++;
+  hook->context = context;
+  hook->function = function;
+  hook->dead = false;
 }
 
 void
@@ -418,27 +1423,14 @@ Shizu_Gc_removeObjectFinalizeHook
     Shizu_Gc_ObjectFinalizeCallbackFunction* function
   )
 {
-  if (gc->objectFinalizeHooks.running) {
-    ObjectFinalizeHookNode* node = gc->objectFinalizeHooks.nodes;
-    while (node) {
-      if (node->context == context && node->function == function) {
-        node->dead = true;
-      }
-      node = node->next;
-    }
-  } else {
-    ObjectFinalizeHookNode** previous = &gc->objectFinalizeHooks.nodes;
-    ObjectFinalizeHookNode* current = gc->objectFinalizeHooks.nodes;
-    while (current) {
-      if (current->dead || (current->context == context && current->function == function)) {
-        *previous = current->next;
-        ObjectFinalizeHookNode* node = current;
-        current = current->next;
-        Shizu_State1_deallocate(state, node);
-      } else {
-        previous = &current->next;
-        current = current->next;
-      }
+  for (size_t i = 0, n = gc->objectFinalizeHooks.size; i < n; ++i) {
+    ObjectFinalizeHook* hook = gc->objectFinalizeHooks.elements + i;
+    if (hook->context == context && hook->function == function) {
+      hook->dead = true;
     }
   }
+  // If the hooks are being notified, the dead hooks are removed after the notification.
+  if (!gc->objectFinalizeHooks.running) {
+    removeDeadObjectFinalizeHooks(gc);
+  }
 }
@@ -26,30 +26,14 @@
 #include "Shizu/Runtime/Status.h"
 #include "Shizu/Runtime/State1.h"
 
-/// @unmanaged
-typedef struct LockNode LockNode;
-
-/// @unmanaged
-typedef struct Locks Locks;
-
-struct LockNode {
-  LockNode* next;
-  size_t hashValue;
-  size_t count;
-  Shizu_Object* object;
-};
-
+// The lock counts are stored in the side records of the objects (see Shizu_ObjectRecord).
+// The locked objects are visited by the "gc" state.
 struct Shizu_Locks {
-  LockNode* free;
-  LockNode** buckets;
+  Shizu_Gc* gc;
+  /// The number of locked objects.
   size_t size;
-  size_t capacity;
-  size_t minimalCapacity;
-  size_t maximalCapacity;
 };
 
-static Locks* g = NULL;
-
 void
 Shizu_Object_lock
   (
@@ -58,33 +42,17 @@ Shizu_Object_lock
     Shizu_Object* self
   )
 {
-  size_t hashValue = (size_t)(uintptr_t)self;
-  size_t hashIndex = hashValue % locks->capacity;
-  LockNode* current = locks->buckets[hashIndex];
-  // Find the lock node if it exists.
-  while (current != NULL && current->object != self) {
-    current = current->next;
-  }
-  if (!current) {
-    // Create the lock node if it does not exist.
-    current = Shizu_State1_allocate(state1, sizeof(LockNode));
-    if (!current) {
-      Shizu_State1_setStatus(state1, Shizu_Status_AllocationFailed);
-      Shizu_State1_jump(state1);
-    }
-    current->next = locks->buckets[hashIndex];
-    locks->buckets[hashIndex] = current;
-    current->hashValue = hashValue;
-    current->object = self;
-    current->count = 0;
-  }
+  Shizu_ObjectRecord* record = Shizu_Gc_getObjectRecord(state1, locks->gc, self, true);
   // Assert the number of locks does not overflow.
-  if (current->count == Shizu_Integer32_Maximum) {
+  if (record->lockCount == Shizu_Integer32_Maximum) {
     Shizu_State1_setStatus(state1, 1);
     Shizu_State1_jump(state1);
   }
   // Increment the lock count.
-  current->count++;
+  if (!record->lockCount) {
+    locks->size++;
+  }
+  record->lockCount++;
 }
 
 void
@@ -95,27 +63,27 @@ Shizu_Object_unlock
     Shizu_Object* self
   )
 {
-  size_t hashValue = (size_t)(uintptr_t)self;
-  size_t hashIndex = hashValue % locks->capacity;
-  LockNode* current = locks->buckets[hashIndex];
-  while (current != NULL && current->object != self) {
-    current = current->next;
-  }
-  if (!current) {
+  Shizu_ObjectRecord* record = Shizu_Gc_getObjectRecord(state1, locks->gc, self, false);
+  if (!record) {
     Shizu_State1_setStatus(state1, 1);
     Shizu_State1_jump(state1);
   }
-  if (current->count == 0) {
+  if (record->lockCount == 0) {
     Shizu_State1_setStatus(state1, 1);
     Shizu_State1_jump(state1);
   }
-  current->count--;
+  record->lockCount--;
+  if (!record->lockCount) {
+    locks->size--;
+    Shizu_Gc_releaseObjectRecord(state1, locks->gc, record);
+  }
 }
 
 Shizu_Locks*
 Shizu_Locks_create
   (
-    Shizu_State1* state1
+    Shizu_State1* state1,
+    Shizu_Gc* gc
   )
 {
   Shizu_Locks* self = Shizu_State1_allocate(state1, sizeof(Shizu_Locks));
@@ -123,36 +91,8 @@ Shizu_Locks_create
     Shizu_State1_setStatus(state1, Shizu_Status_AllocationFailed);
     Shizu_State1_jump(state1);
   }
-
-  // (2)
-  self->minimalCapacity = 8;
-  self->maximalCapacity = SIZE_MAX / sizeof(LockNode*);
-  if (self->maximalCapacity > Shizu_Integer32_Maximum) {
-    self->maximalCapacity = Shizu_Integer32_Maximum;
-  }
-  if (self->maximalCapacity < self->minimalCapacity) {
-    Shizu_State1_deallocate(state1, self);
-    self = NULL;
-    Shizu_State1_setStatus(state1, 1);
-    Shizu_State1_jump(state1);
-  }
-
-  // (3)
-  self->capacity = self->minimalCapacity;
-  self->buckets = Shizu_State1_allocate(state1, sizeof(LockNode*) * self->capacity);
-  if (!self->buckets) {
-    Shizu_State1_deallocate(state1, self);
-    self = NULL;
-    Shizu_State1_setStatus(state1, Shizu_Status_AllocationFailed);
-    Shizu_State1_jump(state1);
-  }
-  for (size_t i = 0, n = self->capacity; i < n; ++i) {
-    self->buckets[i] = NULL;
-  }
-
-  // (4)
+  self->gc = gc;
   self->size = 0;
-
   return self;
 }
 
@@ -163,22 +103,8 @@ Shizu_Locks_destroy
     Shizu_Locks* self
   )
 {
-  // TODO: In debug mode, assert the table must be empty.
-  // (4), (3)
   self->size = 0;
-  for (size_t i = 0, n = self->capacity; i < n; ++i) {
-    LockNode** bucket = &(self->buckets[i]);
-    while (*bucket) {
-      LockNode* node = *bucket;
-      *bucket = (*bucket)->next;
-      Shizu_State1_deallocate(state1, node);
-    }
-  }
-  self->capacity = 0;
-  Shizu_State1_deallocate(state1, self->buckets);
-  self->buckets = NULL;
-
-  // (2)
+  self->gc = NULL;
   Shizu_State1_deallocate(state1, self);
   self = NULL;
 }
@@ -190,48 +116,3 @@ Shizu_Locks_getSize
     Shizu_Locks* self
   )
 { return self->size; }
-
-void
-Shizu_Locks_notifyPreMark
-  (
-    Shizu_State1* state1,
-    Shizu_Gc* gc,
-    Shizu_Locks* self
-  )
-{
-  // Premark locks.
-  for (size_t i = 0, n = self->capacity; i < n; ++i) {
-    LockNode* lockNode = self->buckets[i];
-    while (lockNode) {
-      if (lockNode->count > 0) {
-        Shizu_Object* object = (Shizu_Object*)lockNode->object;
-        Shizu_Gc_visitObject(state1, gc, object);
-      }
-      lockNode = lockNode->next;
-    }
-  }
-}
-
-void
-Shizu_Locks_notifyObjectFinalize
-  (
-    Shizu_State1* state1,
-    Shizu_Gc* gc,
-    Shizu_Locks* self,
-    Shizu_Object* object
-  )
-{
-  size_t hashValue = (size_t)(uintptr_t)object;
-  size_t hashIndex = hashValue % self->capacity;
-  LockNode** previous = &(self->buckets[hashIndex]);
-  LockNode* current = self->buckets[hashIndex];
-  // Find the lock node if it exists.
-  while (current != NULL && current->object != object) {
-    previous = &current->next;
-    current = current->next;
-  }
-  if (current) {
-    *previous = current->next;
-    Shizu_State1_deallocate(state1, current);
-  }
-}
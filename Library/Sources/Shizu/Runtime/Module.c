@@ -38,13 +38,6 @@ Shizu_Module_finalize
     Shizu_Module* rendition
   );
 
-static void
-Shizu_Module_visit
-  (
-    Shizu_State2* state,
-    Shizu_Module* rendition
-  );
-
 static void
 Shizu_Module_construct
   (
@@ -69,6 +62,10 @@ Shizu_Module_ensureLibraryLoaded
     Shizu_Module* self
   );
 
+static Shizu_ObjectTypeField const Shizu_Module_fields[] = {
+  Shizu_ObjectTypeField_Object(Shizu_Module, path),
+};
+
 static Shizu_ObjectTypeDescriptor const Shizu_Module_Type = {
   .postCreateType = NULL,
   .preDestroyType = NULL,
@@ -76,7 +73,9 @@ static Shizu_ObjectTypeDescriptor const Shizu_Module_Type = {
   .size = sizeof(Shizu_Module),
   .construct = &Shizu_Module_constructImpl,
   .finalize = (Shizu_OnFinalizeCallback*)&Shizu_Module_finalize,
-  .visit = (Shizu_OnVisitCallback*)&Shizu_Module_visit,
+  .visit = NULL,
+  .fields = Shizu_Module_fields,
+  .numberOfFields = sizeof(Shizu_Module_fields) / sizeof(Shizu_ObjectTypeField),
   .dispatchSize = sizeof(Shizu_Module_Dispatch),
   .dispatchInitialize = NULL,
   .dispatchUninitialize = NULL,
@@ -97,18 +96,6 @@ Shizu_Module_finalize
   }
 }
 
-static void
-Shizu_Module_visit
-  (
-    Shizu_State2* state,
-    Shizu_Module* self
-  )
-{
-  if (self->path) {
-    Shizu_Gc_visitObject(Shizu_State2_getState1(state), Shizu_State2_getGc(state), (Shizu_Object*)self->path);
-  }
-}
-
 static void
 Shizu_Module_construct
   (
@@ -209,7 +196,7 @@ Shizu_Module_getName
       Shizu_State2_jump(state);
     }
     char const* p = getName(Shizu_State2_getState1(state));
-    Shizu_String* name = Shizu_String_create(state, p, strlen(p));
+    Shizu_String* name = Shizu_String_createInterned(state, p, strlen(p));
     Shizu_State2_popJumpTarget(state);
     return name;
   } else {
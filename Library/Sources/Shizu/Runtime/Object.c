@@ -151,10 +151,10 @@ Shizu_Object_isEqualToImpl
     Shizu_Value const* other
   )
 {
-  if (Shizu_Value_Tag_Object != other->tag) {
+  if (!Shizu_Value_isObject(other)) {
     return Shizu_Boolean_False;
   }
-  return self == other->objectValue;
+  return self == Shizu_Value_getObject(other);
 }
 
 static void
@@ -56,13 +56,6 @@ Shizu_ByteArray_preDestroyType
     Shizu_State1* state1
   );
 
-static void
-Shizu_ByteArray_visit
-  (
-    Shizu_State2* state,
-    Shizu_ByteArray* self
-  );
-
 static void
 Shizu_ByteArray_finalize
   (
@@ -85,7 +78,7 @@ static Shizu_ObjectTypeDescriptor const Shizu_ByteArray_Type = {
   .visitType = NULL,
   .size = sizeof(Shizu_ByteArray),
   .construct = &Shizu_ByteArray_constructImpl,
-  .visit = (Shizu_OnVisitCallback*) & Shizu_ByteArray_visit,
+  .visit = NULL,
   .finalize = (Shizu_OnFinalizeCallback*) & Shizu_ByteArray_finalize,
   .dispatchSize = sizeof(Shizu_ByteArray_Dispatch),
   .dispatchInitialize = NULL,
@@ -93,6 +86,7 @@ static Shizu_ObjectTypeDescriptor const Shizu_ByteArray_Type = {
 };
 
 static const char* namedMemoryName = "Shizu.ByteArray.NamedMemory";
+static Shizu_NamedStorageHandle namedMemoryHandle = Shizu_NamedStorageHandle_Initializer;
 
 typedef struct ByteArrays {
   Shizu_Integer32 maximumPowerOfTwoInteger32;
@@ -113,8 +107,8 @@ getNewBestCapacity
     return self->capacity;
   }
 
-  ByteArrays* g = NULL;
-  if (Shizu_State1_getNamedStorage(Shizu_State2_getState1(state), namedMemoryName, (void**)&g)) {
+  ByteArrays* g = Shizu_NamedStorageHandle_get(&namedMemoryHandle);
+  if (!g) {
     Shizu_State2_setStatus(state, 1);
     Shizu_State2_jump(state);
   }
@@ -150,12 +144,13 @@ Shizu_ByteArray_postCreateType
     Shizu_State1_jump(state1);
   }
 
-  ByteArrays* g = NULL;
-  if (Shizu_State1_getNamedStorage(state1, namedMemoryName, (void**)&g)) {
+  if (Shizu_State1_getNamedStorageHandle(state1, namedMemoryName, &namedMemoryHandle)) {
     Shizu_State1_deallocateNamedStorage(state1, namedMemoryName);
+    Shizu_NamedStorageHandle_invalidate(&namedMemoryHandle);
     Shizu_State1_setStatus(state1, 1);
     Shizu_State1_jump(state1);
   }
+  ByteArrays* g = Shizu_NamedStorageHandle_get(&namedMemoryHandle);
 
   g->minimumCapacity = 8;
 
@@ -179,16 +174,9 @@ Shizu_ByteArray_preDestroyType
   )
 {
   Shizu_State1_deallocateNamedStorage(state1, namedMemoryName);
+  Shizu_NamedStorageHandle_invalidate(&namedMemoryHandle);
 }
 
-static void
-Shizu_ByteArray_visit
-  (
-    Shizu_State2* state,
-    Shizu_ByteArray* self
-  )
-{ }
-
 static void
 Shizu_ByteArray_finalize
   (
@@ -25,11 +25,12 @@
 #include "Shizu/Runtime/State2.h"
 #include "Shizu/Runtime/State1.h"
 #include "Shizu/Runtime/Gc.h"
+#include "Shizu/Runtime/countTrailingZeroes.h"
 
 #include "Shizu/Runtime/Objects/CxxProcedure.h"
 #include "Shizu/Runtime/Objects/List.h"
 #include "Shizu/Runtime/Objects/Map.h"
-#include "Shizu/Runtime/Objects/String.h"
+#include "Shizu/Runtime/Objects/String.private.h"
 #include "Shizu/Runtime/Objects/WeakReference.h"
 
 // memcmp, memcpy
@@ -90,12 +91,234 @@ static Shizu_ObjectTypeDescriptor const Shizu_Environment_Type = {
 };
 
 static const char* namedMemoryName = "Shizu.Environments.NamedMemory";
+static Shizu_NamedStorageHandle namedMemoryHandle = Shizu_NamedStorageHandle_Initializer;
 
 typedef struct Environments {
+  /// The minimum and the maximum number of slots of the index of an environment.
   size_t minimumCapacity;
   size_t maximumCapacity;
 } Environments;
 
+// The number of slots of a group of the index.
+#define GroupSize (8)
+
+// The control byte of an empty slot of the index.
+#define ControlEmpty (0x80)
+
+// A control byte in each byte of a 64 bit word.
+#define Lsbs (UINT64_C(0x0101010101010101))
+#define Msbs (UINT64_C(0x8080808080808080))
+
+// The index of a variable which does not exist.
+#define NotFound (SIZE_MAX)
+
+// Scramble the hash value of a name.
+// The group of a name is determined by bits 32 and above and its control byte by bits 25 to 31 of the scrambled hash value.
+static inline uint64_t
+scramble
+  (
+    size_t hashValue
+  )
+{
+  return (uint64_t)hashValue * UINT64_C(0x9E3779B97F4A7C15);
+}
+
+static inline uint8_t
+getControl
+  (
+    uint64_t h
+  )
+{
+  return (uint8_t)((h >> 25) & 0x7F);
+}
+
+static inline size_t
+getGroupIndex
+  (
+    Shizu_Environment const* self,
+    uint64_t h
+  )
+{
+  return (size_t)(h >> 32) & (self->capacity / GroupSize - 1);
+}
+
+// Load the control bytes of a group.
+// The i-th control byte is byte i of the word (little endian, as on all supported instruction set architectures).
+static inline uint64_t
+loadGroup
+  (
+    uint8_t const* controls
+  )
+{
+  uint64_t group;
+  memcpy(&group, controls, sizeof(uint64_t));
+  return group;
+}
+
+// Get a word with the most significant bit of byte i set if control byte i of the group may be equal to the specified control byte.
+// False positives are possible and are rejected by comparing the names.
+// Empty slots are never matched.
+static inline uint64_t
+matchControl
+  (
+    uint64_t group,
+    uint8_t control
+  )
+{
+  uint64_t x = group ^ (Lsbs * control);
+  return (x - Lsbs) & ~x & Msbs;
+}
+
+// Get a word with the most significant bit of byte i set if slot i of the group is empty.
+static inline uint64_t
+matchEmpty
+  (
+    uint64_t group
+  )
+{
+  return group & Msbs;
+}
+
+// Compare names without invoking Shizu_Object_isEqualTo.
+static inline bool
+isEqualName
+  (
+    Shizu_String const* x,
+    Shizu_String const* y
+  )
+{
+  if (x == y) {
+    return true;
+  }
+  if (x->interned && y->interned) {
+    return false;
+  }
+  return x->hashValue == y->hashValue
+      && x->numberOfBytes == y->numberOfBytes
+      && !memcmp(x->bytes, y->bytes, x->numberOfBytes);
+}
+
+// Find a variable.
+// Return the index of the variable if it was found, NotFound otherwise.
+static size_t
+find
+  (
+    Shizu_State2* state,
+    Shizu_Environment* self,
+    Shizu_String* name
+  )
+{
+#if 1 == Shizu_Configuration_WithStringRopes
+  // isEqualName accesses the Bytes of the name directly.
+  Shizu_String_getBytes(state, name);
+#endif
+  uint64_t h = scramble(name->hashValue);
+  uint8_t control = getControl(h);
+  size_t mask = self->capacity / GroupSize - 1;
+  size_t groupIndex = getGroupIndex(self, h);
+  for (size_t i = 0; i <= mask; ++i) {
+    uint64_t group = loadGroup(self->controls + groupIndex * GroupSize);
+    for (uint64_t m = matchControl(group, control); m; m &= m - 1) {
+      size_t j = groupIndex * GroupSize + Shizu_countTrailingZeroesU64(Shizu_State2_getState1(state), m) / 8;
+      uint32_t k = self->indices[j];
+      if (isEqualName(self->variables[k].name, name)) {
+        return k;
+      }
+    }
+    // If the group has an empty slot, then the probe sequence of the name ends here.
+    if (matchEmpty(group)) {
+      return NotFound;
+    }
+    groupIndex = (groupIndex + 1) & mask;
+  }
+  return NotFound;
+}
+
+// Add a variable to the index.
+// The index must have an empty slot.
+static void
+insertUnchecked
+  (
+    Shizu_State2* state,
+    Shizu_Environment* self,
+    size_t k
+  )
+{
+  uint64_t h = scramble(self->variables[k].name->hashValue);
+  size_t mask = self->capacity / GroupSize - 1;
+  size_t groupIndex = getGroupIndex(self, h);
+  while (true) {
+    uint64_t m = matchEmpty(loadGroup(self->controls + groupIndex * GroupSize));
+    if (m) {
+      size_t j = groupIndex * GroupSize + Shizu_countTrailingZeroesU64(Shizu_State2_getState1(state), m) / 8;
+      self->controls[j] = getControl(h);
+      self->indices[j] = (uint32_t)k;
+      return;
+    }
+    groupIndex = (groupIndex + 1) & mask;
+  }
+}
+
+// Allocate an index of the specified capacity and add all variables to it.
+// The environment is not modified if an allocation fails.
+static void
+rebuildIndex
+  (
+    Shizu_State2* state,
+    Shizu_Environment* self,
+    size_t capacity
+  )
+{
+  uint8_t* p = Shizu_State1_allocate(Shizu_State2_getState1(state), capacity * (sizeof(uint32_t) + sizeof(uint8_t)));
+  if (!p) {
+    Shizu_State2_setStatus(state, Shizu_Status_AllocationFailed);
+    Shizu_State2_jump(state);
+  }
+  if (self->indices) {
+    Shizu_State1_deallocate(Shizu_State2_getState1(state), self->indices);
+  }
+  self->indices = (uint32_t*)p;
+  self->controls = p + capacity * sizeof(uint32_t);
+  self->capacity = capacity;
+  memset(self->controls, ControlEmpty, capacity);
+  for (size_t k = 0; k < self->size; ++k) {
+    insertUnchecked(state, self, k);
+  }
+}
+
+// Ensure a variable can be added.
+// The environment is not modified if an allocation fails.
+static void
+ensureFreeCapacity
+  (
+    Shizu_State2* state,
+    Shizu_Environment* self
+  )
+{
+  Environments* g = Shizu_NamedStorageHandle_get(&namedMemoryHandle);
+  if (self->size == self->variablesCapacity) {
+    if (self->variablesCapacity >= (size_t)Shizu_Integer32_Maximum / 2) {
+      Shizu_State2_setStatus(state, Shizu_Status_AllocationFailed);
+      Shizu_State2_jump(state);
+    }
+    size_t newCapacity = self->variablesCapacity * 2;
+    Shizu_Environment_Variable* newVariables = Shizu_State1_reallocate(Shizu_State2_getState1(state), self->variables, newCapacity * sizeof(Shizu_Environment_Variable));
+    if (!newVariables) {
+      Shizu_State2_setStatus(state, Shizu_Status_AllocationFailed);
+      Shizu_State2_jump(state);
+    }
+    self->variables = newVariables;
+    self->variablesCapacity = newCapacity;
+  }
+  if (self->size + 1 > self->capacity / 4 * 3) {
+    if (self->capacity >= g->maximumCapacity) {
+      Shizu_State2_setStatus(state, Shizu_Status_AllocationFailed);
+      Shizu_State2_jump(state);
+    }
+    rebuildIndex(state, self, self->capacity * 2);
+  }
+}
+
 static void
 Shizu_Environment_postCreateType
   (
@@ -106,16 +329,17 @@ Shizu_Environment_postCreateType
     Shizu_State1_setStatus(state1, 1);
     Shizu_State1_jump(state1);
   }
-  Environments* g = NULL;
-  if (Shizu_State1_getNamedStorage(state1, namedMemoryName, (void**)&g)) {
+  if (Shizu_State1_getNamedStorageHandle(state1, namedMemoryName, &namedMemoryHandle)) {
     Shizu_State1_deallocateNamedStorage(state1, namedMemoryName);
+    Shizu_NamedStorageHandle_invalidate(&namedMemoryHandle);
     Shizu_State1_setStatus(state1, 1);
     Shizu_State1_jump(state1);
   }
-  g->minimumCapacity = 8;
-  g->maximumCapacity = SIZE_MAX / sizeof(Shizu_Environment_Node*);
-  if (g->maximumCapacity > Shizu_Integer32_Maximum) {
-    g->maximumCapacity = Shizu_Integer32_Maximum;
+  Environments* g = Shizu_NamedStorageHandle_get(&namedMemoryHandle);
+  g->minimumCapacity = GroupSize;
+  g->maximumCapacity = GroupSize;
+  while (g->maximumCapacity <= SIZE_MAX / (sizeof(uint32_t) + sizeof(uint8_t)) / 2 && g->maximumCapacity <= (size_t)Shizu_Integer32_Maximum / 2) {
+    g->maximumCapacity *= 2;
   }
 }
 
@@ -126,6 +350,7 @@ Shizu_Environment_preDestroyType
   )
 {
   Shizu_State1_deallocateNamedStorage(state1, namedMemoryName);
+  Shizu_NamedStorageHandle_invalidate(&namedMemoryHandle);
 }
 
 static void
@@ -135,13 +360,9 @@ Shizu_Environment_visit
     Shizu_Environment* self
   )
 {
-  for (size_t i = 0, n = self->capacity; i < n; ++i) {
-    Shizu_Environment_Node* node = self->buckets[i];
-    while (node) {
-      Shizu_Gc_visitObject(Shizu_State2_getState1(state), Shizu_State2_getGc(state), (Shizu_Object*)node->name);
-      Shizu_Gc_visitValue(Shizu_State2_getState1(state), Shizu_State2_getGc(state), &node->value);
-      node = node->next;
-    }
+  for (size_t i = 0, n = self->size; i < n; ++i) {
+    Shizu_Gc_visitObject(Shizu_State2_getState1(state), Shizu_State2_getGc(state), (Shizu_Object*)self->variables[i].name);
+    Shizu_Gc_visitValue(Shizu_State2_getState1(state), Shizu_State2_getGc(state), &self->variables[i].value);
   }
 }
 
@@ -152,16 +373,15 @@ Shizu_Environment_finalize
     Shizu_Environment* self
   )
 {
-  for (size_t i = 0, n = self->capacity; i < n; ++i) {
-    Shizu_Environment_Node** bucket = &(self->buckets[i]);
-    while (*bucket) {
-      Shizu_Environment_Node* node = *bucket;
-      *bucket = node->next;
-      Shizu_State1_deallocate(Shizu_State2_getState1(state), node);
-    }
+  if (self->indices) {
+    Shizu_State1_deallocate(Shizu_State2_getState1(state), self->indices);
+    self->indices = NULL;
+    self->controls = NULL;
+  }
+  if (self->variables) {
+    Shizu_State1_deallocate(Shizu_State2_getState1(state), self->variables);
+    self->variables = NULL;
   }
-  Shizu_State1_deallocate(Shizu_State2_getState1(state), self->buckets);
-  self->buckets = NULL;
 }
 
 static void
@@ -184,16 +404,23 @@ Shizu_Environment_constructImpl
   Shizu_Environment* SELF = (Shizu_Environment*)Shizu_Value_getObject(&argumentValues[0]);
   Shizu_Type* TYPE = Shizu_Environment_getType(state);
   Shizu_Object_construct(state, (Shizu_Object*)SELF);
-  SELF->buckets = Shizu_State1_allocate(Shizu_State2_getState1(state), sizeof(Shizu_Environment_Node*) * 8);
-  if (!SELF->buckets) {
+  SELF->variables = NULL;
+  SELF->size = 0;
+  SELF->variablesCapacity = 0;
+  SELF->indices = NULL;
+  SELF->controls = NULL;
+  SELF->capacity = 0;
+  Environments* g = Shizu_NamedStorageHandle_get(&namedMemoryHandle);
+  rebuildIndex(state, SELF, g->minimumCapacity);
+  SELF->variables = Shizu_State1_allocate(Shizu_State2_getState1(state), g->minimumCapacity * sizeof(Shizu_Environment_Variable));
+  if (!SELF->variables) {
+    Shizu_State1_deallocate(Shizu_State2_getState1(state), SELF->indices);
+    SELF->indices = NULL;
+    SELF->controls = NULL;
     Shizu_State2_setStatus(state, Shizu_Status_AllocationFailed);
     Shizu_State2_jump(state);
   }
-  for (size_t i = 0, n = 8; i < n; ++i) {
-    SELF->buckets[i] = NULL;
-  }
-  SELF->size = 0;
-  SELF->capacity = 8;
+  SELF->variablesCapacity = g->minimumCapacity;
   ((Shizu_Object*)SELF)->type = TYPE;
 }
 
@@ -206,7 +433,7 @@ Shizu_Environment_getSize
     Shizu_Environment* self
   )
 {
-  return self->size;
+  return (Shizu_Integer32)self->size;
 }
 
 void
@@ -218,27 +445,18 @@ Shizu_Environment_set
     Shizu_Value* value
   )
 {
-  size_t hashValue = Shizu_Object_getHashValue(state, (Shizu_Object*)name);
-  size_t hashIndex = hashValue % self->capacity;
-  Shizu_Value nameValue = Shizu_Value_InitializerVoid(Shizu_Void_Void);
-  Shizu_Value_setObject(&nameValue, (Shizu_Object*)name);
-  for (Shizu_Environment_Node* node = self->buckets[hashIndex]; NULL != node; node = node->next) {
-    if (Shizu_Object_isEqualTo(state, (Shizu_Object*)node->name, &nameValue)) {
-      node->name = name;
-      node->value = *value;
-      return;
-    }
-  }
-  Shizu_Environment_Node* node = Shizu_State1_allocate(Shizu_State2_getState1(state), sizeof(Shizu_Environment_Node));
-  if (!node) {
-    Shizu_State2_setStatus(state, Shizu_Status_AllocationFailed);
-    Shizu_State2_jump(state);
+  size_t k = find(state, self, name);
+  if (NotFound == k) {
+    // The names of the variables are interned such that lookups with interned names are decided by identity.
+    name = Shizu_String_intern(state, name);
+    ensureFreeCapacity(state, self);
+    k = self->size++;
+    self->variables[k].name = name;
+    insertUnchecked(state, self, k);
+    Shizu_Gc_writeBarrier(Shizu_State2_getState1(state), Shizu_State2_getGc(state), (Shizu_Object*)self, (Shizu_Object*)name);
   }
-  node->name = name;
-  node->value = *value;
-  node->next = self->buckets[hashIndex];
-  self->buckets[hashIndex] = node;
-  self->size++;
+  self->variables[k].value = *value;
+  Shizu_Gc_writeBarrierValue(Shizu_State2_getState1(state), Shizu_State2_getGc(state), (Shizu_Object*)self, value);
 }
 
 Shizu_Value
@@ -249,17 +467,60 @@ Shizu_Environment_get
     Shizu_String* name
   )
 {
-  size_t hashValue = Shizu_Object_getHashValue(state, (Shizu_Object*)name);
-  size_t hashIndex = hashValue % self->capacity;
-  Shizu_Value nameValue = Shizu_Value_InitializerVoid(Shizu_Void_Void);
-  Shizu_Value_setObject(&nameValue, (Shizu_Object*)name);
-  for (Shizu_Environment_Node* node = self->buckets[hashIndex]; NULL != node; node = node->next) {
-    if (Shizu_Object_isEqualTo(state, (Shizu_Object*)node->name, &nameValue)) {
-      return node->value;
-    }
+  size_t k = find(state, self, name);
+  if (NotFound == k) {
+    Shizu_State2_setStatus(state, Shizu_Status_NotExists);
+    Shizu_State2_jump(state);
   }
-  Shizu_State2_setStatus(state, Shizu_Status_NotExists);
-  Shizu_State2_jump(state);
+  return self->variables[k].value;
+}
+
+Shizu_Integer32
+Shizu_Environment_getSlot
+  (
+    Shizu_State2* state,
+    Shizu_Environment* self,
+    Shizu_String* name
+  )
+{
+  size_t k = find(state, self, name);
+  if (NotFound == k) {
+    Shizu_State2_setStatus(state, Shizu_Status_NotExists);
+    Shizu_State2_jump(state);
+  }
+  return (Shizu_Integer32)k;
+}
+
+Shizu_Value
+Shizu_Environment_getAt
+  (
+    Shizu_State2* state,
+    Shizu_Environment* self,
+    Shizu_Integer32 slot
+  )
+{
+  if (slot < 0 || (size_t)slot >= self->size) {
+    Shizu_State2_setStatus(state, Shizu_Status_ArgumentOutOfRange);
+    Shizu_State2_jump(state);
+  }
+  return self->variables[slot].value;
+}
+
+void
+Shizu_Environment_setAt
+  (
+    Shizu_State2* state,
+    Shizu_Environment* self,
+    Shizu_Integer32 slot,
+    Shizu_Value* value
+  )
+{
+  if (slot < 0 || (size_t)slot >= self->size) {
+    Shizu_State2_setStatus(state, Shizu_Status_ArgumentOutOfRange);
+    Shizu_State2_jump(state);
+  }
+  self->variables[slot].value = *value;
+  Shizu_Gc_writeBarrierValue(Shizu_State2_getState1(state), Shizu_State2_getGc(state), (Shizu_Object*)self, value);
 }
 
 Shizu_Object*
@@ -403,14 +664,5 @@ Shizu_Environment_isDefined
     Shizu_String* name
   )
 {
-  size_t hashValue = Shizu_Object_getHashValue(state, (Shizu_Object*)name);
-  size_t hashIndex = hashValue % self->capacity;
-  Shizu_Value nameValue = Shizu_Value_InitializerVoid(Shizu_Void_Void);
-  Shizu_Value_setObject(&nameValue, (Shizu_Object*)name);
-  for (Shizu_Environment_Node* node = self->buckets[hashIndex]; NULL != node; node = node->next) {
-    if (Shizu_Object_isEqualTo(state, (Shizu_Object*)node->name, &nameValue)) {
-      Shizu_Boolean_True;
-    }
-  }
-  return Shizu_Boolean_False;
+  return NotFound != find(state, self, name);
 }
@@ -97,6 +97,7 @@ static Shizu_ObjectTypeDescriptor const Shizu_List_Type = {
 Shizu_defineObjectType("Shizu.List", Shizu_List, Shizu_Object);
 
 static const char* namedMemoryName = "Shizu.Lists.NamedMemory";
+static Shizu_NamedStorageHandle namedMemoryHandle = Shizu_NamedStorageHandle_Initializer;
 
 typedef struct Lists {
   size_t minimumCapacity;
@@ -113,12 +114,13 @@ Shizu_List_postCreateType
     Shizu_State1_setStatus(state1, 1);
     Shizu_State1_jump(state1);
   }
-  Lists* g = NULL;
-  if (Shizu_State1_getNamedStorage(state1, namedMemoryName, (void**)&g)) {
+  if (Shizu_State1_getNamedStorageHandle(state1, namedMemoryName, &namedMemoryHandle)) {
     Shizu_State1_deallocateNamedStorage(state1, namedMemoryName);
+    Shizu_NamedStorageHandle_invalidate(&namedMemoryHandle);
     Shizu_State1_setStatus(state1, 1);
     Shizu_State1_jump(state1);
   }
+  Lists* g = Shizu_NamedStorageHandle_get(&namedMemoryHandle);
   g->minimumCapacity = 8;
   g->maximumCapacity = SIZE_MAX / sizeof(Shizu_Value);
   if (g->maximumCapacity > Shizu_Integer32_Maximum) {
@@ -139,6 +141,7 @@ Shizu_List_preDestroyType
   )
 {
   Shizu_State1_deallocateNamedStorage(state1, namedMemoryName);
+  Shizu_NamedStorageHandle_invalidate(&namedMemoryHandle);
 }
 
 static void
@@ -205,8 +208,8 @@ Shizu_List_ensureFreeCapacity
     size_t requiredFreeCapacity
   ) 
 {
-  Lists* g = NULL;
-  if (Shizu_State1_getNamedStorage(Shizu_State2_getState1(state), namedMemoryName, (void**)&g)) {
+  Lists* g = Shizu_NamedStorageHandle_get(&namedMemoryHandle);
+  if (!g) {
     Shizu_State2_setStatus(state, Shizu_Status_AllocationFailed);
     Shizu_State2_jump(state);
   }
@@ -241,7 +244,7 @@ Shizu_List_ensureFreeCapacity
   self->capacity = newCapacity;
 }
 
-static Shizu_Value const IndexOutOfBounds = { .tag = Shizu_Value_Tag_Void, .voidValue = Shizu_Void_Void };
+static Shizu_Value const IndexOutOfBounds = Shizu_Value_InitializerVoid(Shizu_Void_Void);
 
 void
 Shizu_List_clear
@@ -301,6 +304,7 @@ Shizu_List_insertValue
   }
   self->elements[index] = *value;
   self->size++;
+  Shizu_Gc_writeBarrierValue(Shizu_State2_getState1(state), Shizu_State2_getGc(state), (Shizu_Object*)self, value);
 }
 
 void
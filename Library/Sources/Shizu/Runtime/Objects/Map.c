@@ -26,11 +26,13 @@
 #include "Shizu/Runtime/State1.h"
 #include "Shizu/Runtime/Gc.h"
 #include "Shizu/Runtime/countLeadingZeroes.h"
+#include "Shizu/Runtime/countTrailingZeroes.h"
 
 // INT_MAX, SIZE_MAX
 #include <limits.h>
 
 static const char* namedMemoryName = "Shizu.Maps.NamedMemory";
+static Shizu_NamedStorageHandle namedMemoryHandle = Shizu_NamedStorageHandle_Initializer;
 
 typedef struct Maps {
   Shizu_Integer32 minimumCapacity;
@@ -72,57 +74,158 @@ Shizu_Map_constructImpl
     Shizu_Value* argumentValues
   );
 
+// The size of a slot (its pair and its control), in Bytes.
+#define SlotSize (sizeof(Shizu_Map_Slot) + sizeof(Shizu_Map_Control))
+
+// Get the index of the home slot of a key of the specified hash value.
+// The hash value is scrambled (Fibonacci hashing) as the hash values of Integer32 values are the values themselves.
+static inline size_t
+getHomeIndex
+  (
+    Shizu_Map const* self,
+    Shizu_Integer32 hashValue
+  )
+{
+  return (size_t)(((uint32_t)hashValue * UINT32_C(2654435769)) >> self->shift);
+}
+
+// Get the smallest capacity not smaller than the minimum capacity such that the specified number of pairs does not exceed 3/4 of it.
+static size_t
+getCapacityFor
+  (
+    Shizu_State2* state,
+    size_t numberOfPairs
+  )
+{
+  Maps* g = Shizu_NamedStorageHandle_get(&namedMemoryHandle);
+  size_t capacity = (size_t)g->minimumCapacity;
+  while (capacity / 4 * 3 < numberOfPairs) {
+    if (capacity >= (size_t)g->maximumCapacity) {
+      Shizu_State2_setStatus(state, Shizu_Status_AllocationFailed);
+      Shizu_State2_jump(state);
+    }
+    capacity *= 2;
+  }
+  return capacity;
+}
+
+// Allocate the slots of this map for the specified capacity and mark them empty.
+// The old slots are neither copied nor deallocated.
 static void
-optimize
+allocateSlots
   (
     Shizu_State2* state,
-    Shizu_Map* self
+    Shizu_Map* self,
+    size_t capacity
   )
 {
-  float load = (float)self->size / (float)self->capacity;
-  if (load > 0.75f) {
-    Shizu_JumpTarget jumpTarget;
-    Shizu_State2_pushJumpTarget(state, &jumpTarget);
-    if (!setjmp(jumpTarget.environment)) {
-      Maps* g = NULL;
-      if (Shizu_State1_getNamedStorage(Shizu_State2_getState1(state), namedMemoryName, (void**)&g)) {
-        Shizu_State1_setStatus(Shizu_State2_getState1(state), Shizu_Status_AllocationFailed);
-        Shizu_State1_jump(Shizu_State2_getState1(state));
-      }
-      if (self->capacity == g->minimumCapacity) {
-        return;
-      }
-      Shizu_Integer32 oldCapacity = self->capacity;
-      Shizu_Integer32 newCapacity = self->capacity * 2;
-      Shizu_Map_Node** oldBuckets = self->buckets;
-      Shizu_Map_Node** newBuckets = Shizu_State1_allocate(Shizu_State2_getState1(state), (size_t)newCapacity * sizeof(Shizu_Map_Node*));
-      if (!newBuckets) {
-        Shizu_State1_setStatus(Shizu_State2_getState1(state), Shizu_Status_AllocationFailed);
-        Shizu_State1_jump(Shizu_State2_getState1(state));
-      }
-      for (Shizu_Integer32 i = 0, n = newCapacity; i < n; ++i) {
-        newBuckets[i] = NULL;
-      }
-      for (Shizu_Integer32 i = 0, n = oldCapacity; i  < n; ++i) {
-        while (oldBuckets[i]){
-          Shizu_Map_Node* node = oldBuckets[i];
-          oldBuckets[i] = node->next;
-          Shizu_Integer32 hashValue = node->hashValue;
-          Shizu_Integer32 hashIndex = (hashValue & 0x7FFFFFFF) % self->capacity;
-          node->next = newBuckets[hashIndex];
-          newBuckets[hashIndex] = node;
-        }
-      }
-      Shizu_State1_deallocate(Shizu_State2_getState1(state), oldBuckets);
-      self->capacity = newCapacity;
-      self->buckets = newBuckets;
-      Shizu_State2_popJumpTarget(state);
-    } else {
-      Shizu_State2_popJumpTarget(state);
+  uint8_t* p = Shizu_State1_allocate(Shizu_State2_getState1(state), capacity * SlotSize);
+  if (!p) {
+    Shizu_State2_setStatus(state, Shizu_Status_AllocationFailed);
+    Shizu_State2_jump(state);
+  }
+  self->slots = (Shizu_Map_Slot*)p;
+  self->controls = (Shizu_Map_Control*)(p + capacity * sizeof(Shizu_Map_Slot));
+  for (size_t i = 0; i < capacity; ++i) {
+    self->controls[i].distance = 0;
+  }
+  self->capacity = capacity;
+  self->shift = 32 - (uint32_t)Shizu_countTrailingZeroesU32(Shizu_State2_getState1(state), (uint32_t)capacity);
+}
+
+// Find the slot of a key.
+// Return the index of the slot if the key was found, the capacity otherwise.
+static size_t
+findSlot
+  (
+    Shizu_State2* state,
+    Shizu_Map* self,
+    Shizu_Value* key,
+    Shizu_Integer32 hashValue
+  )
+{
+  size_t mask = self->capacity - 1;
+  size_t index = getHomeIndex(self, hashValue);
+  for (uint32_t distance = 1; ; ++distance) {
+    Shizu_Map_Control const* control = &self->controls[index];
+    // If the slot is empty or closer to its home slot than the key would be, then the key is not in the map.
+    if (control->distance < distance) {
+      return self->capacity;
+    }
+    if (control->hashValue == hashValue && Shizu_Value_isEqualTo(state, &self->slots[index].key, key)) {
+      return index;
     }
+    index = (index + 1) & mask;
   }
 }
 
+// Insert a pair which is not in the map.
+// The map must have a free slot.
+static void
+insertUnchecked
+  (
+    Shizu_Map* self,
+    Shizu_Integer32 hashValue,
+    Shizu_Map_Slot slot
+  )
+{
+  size_t mask = self->capacity - 1;
+  size_t index = getHomeIndex(self, hashValue);
+  Shizu_Map_Control control = { .distance = 1, .hashValue = hashValue };
+  while (self->controls[index].distance) {
+    // Robin Hood: Take the slot from a pair closer to its home slot and continue with that pair.
+    if (self->controls[index].distance < control.distance) {
+      Shizu_Map_Control t = self->controls[index];
+      self->controls[index] = control;
+      control = t;
+      Shizu_Map_Slot u = self->slots[index];
+      self->slots[index] = slot;
+      slot = u;
+    }
+    index = (index + 1) & mask;
+    control.distance++;
+  }
+  self->controls[index] = control;
+  self->slots[index] = slot;
+  self->size++;
+}
+
+// Change the capacity of this map.
+// The map is not modified if an allocation fails.
+static void
+resize
+  (
+    Shizu_State2* state,
+    Shizu_Map* self,
+    size_t newCapacity
+  )
+{
+  Shizu_Map_Slot* oldSlots = self->slots;
+  Shizu_Map_Control* oldControls = self->controls;
+  size_t oldCapacity = self->capacity;
+  uint32_t oldShift = self->shift;
+  Shizu_JumpTarget jumpTarget;
+  Shizu_State2_pushJumpTarget(state, &jumpTarget);
+  if (!setjmp(jumpTarget.environment)) {
+    allocateSlots(state, self, newCapacity);
+    Shizu_State2_popJumpTarget(state);
+  } else {
+    Shizu_State2_popJumpTarget(state);
+    self->slots = oldSlots;
+    self->controls = oldControls;
+    self->capacity = oldCapacity;
+    self->shift = oldShift;
+    Shizu_State2_jump(state);
+  }
+  self->size = 0;
+  for (size_t i = 0; i < oldCapacity; ++i) {
+    if (oldControls[i].distance) {
+      insertUnchecked(self, oldControls[i].hashValue, oldSlots[i]);
+    }
+  }
+  Shizu_State1_deallocate(Shizu_State2_getState1(state), oldSlots);
+}
+
 static Shizu_ObjectTypeDescriptor const Shizu_Map_Type = {
   .postCreateType = (Shizu_PostCreateTypeCallback*) & Shizu_Map_postCreateType,
   .preDestroyType = (Shizu_PreDestroyTypeCallback*) & Shizu_Map_preDestroyType,
@@ -146,12 +249,13 @@ Shizu_Map_postCreateType
     Shizu_State1_setStatus(state1, 1);
     Shizu_State1_jump(state1);
   }
-  Maps* g = NULL;
-  if (Shizu_State1_getNamedStorage(state1, namedMemoryName, (void**)&g)) {
+  if (Shizu_State1_getNamedStorageHandle(state1, namedMemoryName, &namedMemoryHandle)) {
     Shizu_State1_deallocateNamedStorage(state1, namedMemoryName);
+    Shizu_NamedStorageHandle_invalidate(&namedMemoryHandle);
     Shizu_State1_setStatus(state1, 1);
     Shizu_State1_jump(state1);
   }
+  Maps* g = Shizu_NamedStorageHandle_get(&namedMemoryHandle);
   Shizu_JumpTarget jumpTarget;
   Shizu_State1_pushJumpTarget(state1, &jumpTarget);
   if (!setjmp(jumpTarget.environment)) {
@@ -173,7 +277,7 @@ Shizu_Map_postCreateType
     t = ((size_t)1 << shift);
     g->minimumCapacity = t;
     // Determine maximum capacity.
-    t = SIZE_MAX / sizeof(Shizu_Map_Node*);
+    t = SIZE_MAX / SlotSize;
     if (t > Shizu_Integer32_Maximum) {
       t = Shizu_Integer32_Maximum;
     }
@@ -194,6 +298,7 @@ Shizu_Map_postCreateType
   } else {
     Shizu_State1_popJumpTarget(state1);
     Shizu_State1_deallocateNamedStorage(state1, namedMemoryName);
+    Shizu_NamedStorageHandle_invalidate(&namedMemoryHandle);
     Shizu_State1_jump(state1);
   }
 }
@@ -205,6 +310,7 @@ Shizu_Map_preDestroyType
   )
 {
   Shizu_State1_deallocateNamedStorage(state1, namedMemoryName);
+  Shizu_NamedStorageHandle_invalidate(&namedMemoryHandle);
 }
 
 static void
@@ -215,11 +321,9 @@ Shizu_Map_visit
   )
 {
   for (size_t i = 0, n = self->capacity; i < n; ++i) {
-    Shizu_Map_Node* node = self->buckets[i];
-    while (node) {
-      Shizu_Gc_visitValue(Shizu_State2_getState1(state), Shizu_State2_getGc(state), &node->key);
-      Shizu_Gc_visitValue(Shizu_State2_getState1(state), Shizu_State2_getGc(state), &node->value);
-      node = node->next;
+    if (self->controls[i].distance) {
+      Shizu_Gc_visitValue(Shizu_State2_getState1(state), Shizu_State2_getGc(state), &self->slots[i].key);
+      Shizu_Gc_visitValue(Shizu_State2_getState1(state), Shizu_State2_getGc(state), &self->slots[i].value);
     }
   }
 }
@@ -231,16 +335,9 @@ Shizu_Map_finalize
     Shizu_Map* self
   )
 {
-  for (size_t i = 0, n = self->capacity; i < n; ++i) {
-    Shizu_Map_Node** bucket = &(self->buckets[i]);
-    while (*bucket) {
-      Shizu_Map_Node* node = *bucket;
-      *bucket = node->next;
-      Shizu_State1_deallocate(Shizu_State2_getState1(state), node);
-    }
-  }
-  Shizu_State1_deallocate(Shizu_State2_getState1(state), self->buckets);
-  self->buckets = NULL;
+  Shizu_State1_deallocate(Shizu_State2_getState1(state), self->slots);
+  self->slots = NULL;
+  self->controls = NULL;
 }
 
 static void
@@ -263,16 +360,12 @@ Shizu_Map_constructImpl
   Shizu_Map* SELF = (Shizu_Map*)Shizu_Value_getObject(&argumentValues[0]);
   Shizu_Type* TYPE = Shizu_Map_getType(state);
   Shizu_Object_construct(state, (Shizu_Object*)SELF);
-  SELF->buckets = Shizu_State1_allocate(Shizu_State2_getState1(state), sizeof(Shizu_Map_Node*) * 8);
-  if (!SELF->buckets) {
-    Shizu_State2_setStatus(state, Shizu_Status_AllocationFailed);
-    Shizu_State2_jump(state);
-  }
-  for (size_t i = 0, n = 8; i < n; ++i) {
-    SELF->buckets[i] = NULL;
-  }
+  SELF->slots = NULL;
+  SELF->controls = NULL;
   SELF->size = 0;
-  SELF->capacity = 8;
+  SELF->capacity = 0;
+  Maps* g = Shizu_NamedStorageHandle_get(&namedMemoryHandle);
+  allocateSlots(state, SELF, (size_t)g->minimumCapacity);
   ((Shizu_Object*)SELF)->type = TYPE;
 }
 
@@ -286,14 +379,7 @@ Shizu_Map_clear
   )
 {
   for (size_t i = 0, n = self->capacity; i < n; ++i) {
-    for (size_t i = 0, n = self->capacity; i < n; ++i) {
-      Shizu_Map_Node** bucket = &(self->buckets[i]);
-      while (*bucket) {
-        Shizu_Map_Node* node = *bucket;
-        *bucket = node->next;
-        Shizu_State1_deallocate(Shizu_State2_getState1(state), node);
-      }
-    }
+    self->controls[i].distance = 0;
   }
   self->size = 0;
 }
@@ -322,33 +408,23 @@ Shizu_Map_set
   if (Shizu_Value_isVoid(key)) {
     return;
   }
-  Shizu_Integer32 hashValue = Shizu_Value_getHashValue(state, key);
-  Shizu_Integer32 hashIndex = (hashValue & 0x7FFFFFFF) % self->capacity;
-  Shizu_Map_Node* node;
-  for (node = self->buckets[hashIndex]; NULL != node; node = node->next) {
-    if (node->hashValue == hashValue) {
-      if (Shizu_Value_isEqualTo(state, &node->key, key)) {
-        break;
-      }
-    }
+  if (Shizu_Value_isVoid(value)) {
+    Shizu_Map_remove(state, self, key);
+    return;
   }
-  if (node) {
-    node->key = *key;
-    node->value = *value;
+  Shizu_Integer32 hashValue = Shizu_Value_getHashValue(state, key);
+  size_t index = findSlot(state, self, key, hashValue);
+  if (index < self->capacity) {
+    self->slots[index].key = *key;
+    self->slots[index].value = *value;
   } else {
-    node = Shizu_State1_allocate(Shizu_State2_getState1(state), sizeof(Shizu_Map_Node));
-    if (!node) {
-      Shizu_State2_setStatus(state, Shizu_Status_AllocationFailed);
-      Shizu_State2_jump(state);
+    if (self->size + 1 > self->capacity / 4 * 3) {
+      resize(state, self, getCapacityFor(state, self->size + 1));
     }
-    node->key = *key;
-    node->value = *value;
-    node->hashValue = hashValue;
-    node->next = self->buckets[hashIndex];
-    self->buckets[hashIndex] = node;
-    self->size++;
-    optimize(state, self);
+    insertUnchecked(self, hashValue, (Shizu_Map_Slot) { .key = *key, .value = *value });
   }
+  Shizu_Gc_writeBarrierValue(Shizu_State2_getState1(state), Shizu_State2_getGc(state), (Shizu_Object*)self, key);
+  Shizu_Gc_writeBarrierValue(Shizu_State2_getState1(state), Shizu_State2_getGc(state), (Shizu_Object*)self, value);
 }
 
 Shizu_Value
@@ -363,14 +439,95 @@ Shizu_Map_get
   if (Shizu_Value_isVoid(key)) {
     return result;
   }
-  Shizu_Integer32 hashValue = Shizu_Value_getHashValue(state, key);
-  Shizu_Integer32 hashIndex = (hashValue & 0x7FFFFFFF) % self->capacity;
-  for (Shizu_Map_Node* node = self->buckets[hashIndex]; NULL != node; node = node->next) {
-    if (node->hashValue == hashValue) {
-      if (Shizu_Value_isEqualTo(state, &node->key, key)) {
-        return node->value;
-      }
-    }
+  size_t index = findSlot(state, self, key, Shizu_Value_getHashValue(state, key));
+  if (index < self->capacity) {
+    return self->slots[index].value;
   }
   return result;
 }
+
+void
+Shizu_Map_remove
+  (
+    Shizu_State2* state,
+    Shizu_Map* self,
+    Shizu_Value* key
+  )
+{
+  if (Shizu_Value_isVoid(key)) {
+    return;
+  }
+  size_t index = findSlot(state, self, key, Shizu_Value_getHashValue(state, key));
+  if (index == self->capacity) {
+    return;
+  }
+  // Shift the following pairs which are not in their home slots one slot backwards.
+  size_t mask = self->capacity - 1;
+  size_t next = (index + 1) & mask;
+  while (self->controls[next].distance > 1) {
+    self->controls[index].distance = self->controls[next].distance - 1;
+    self->controls[index].hashValue = self->controls[next].hashValue;
+    self->slots[index] = self->slots[next];
+    index = next;
+    next = (next + 1) & mask;
+  }
+  self->controls[index].distance = 0;
+  self->size--;
+}
+
+void
+Shizu_Map_reserve
+  (
+    Shizu_State2* state,
+    Shizu_Map* self,
+    Shizu_Integer32 numberOfPairs
+  )
+{
+  if (numberOfPairs < 0) {
+    Shizu_State2_setStatus(state, Shizu_Status_ArgumentOutOfRange);
+    Shizu_State2_jump(state);
+  }
+  if ((size_t)numberOfPairs <= self->capacity / 4 * 3) {
+    return;
+  }
+  resize(state, self, getCapacityFor(state, (size_t)numberOfPairs));
+}
+
+void
+Shizu_Map_shrinkToFit
+  (
+    Shizu_State2* state,
+    Shizu_Map* self
+  )
+{
+  size_t newCapacity = getCapacityFor(state, self->size);
+  if (newCapacity < self->capacity) {
+    resize(state, self, newCapacity);
+  }
+}
+
+bool
+Shizu_Map_iterate
+  (
+    Shizu_State2* state,
+    Shizu_Map* self,
+    Shizu_Integer32* iterator,
+    Shizu_Value* key,
+    Shizu_Value* value
+  )
+{
+  if (*iterator < 0) {
+    Shizu_State2_setStatus(state, Shizu_Status_ArgumentOutOfRange);
+    Shizu_State2_jump(state);
+  }
+  for (size_t i = (size_t)*iterator, n = self->capacity; i < n; ++i) {
+    if (self->controls[i].distance) {
+      *key = self->slots[i].key;
+      *value = self->slots[i].value;
+      *iterator = (Shizu_Integer32)(i + 1);
+      return true;
+    }
+  }
+  *iterator = (Shizu_Integer32)self->capacity;
+  return false;
+}
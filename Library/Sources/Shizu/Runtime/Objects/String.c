@@ -24,7 +24,7 @@
 
 #include "Shizu/Runtime/State2.h"
 #include "Shizu/Runtime/State1.h"
-#include "Shizu/Runtime/Gc.h"
+#include "Shizu/Runtime/Gc.private.h"
 
 // memcmp, memcpy
 #include <string.h>
@@ -64,6 +64,13 @@ Shizu_String_initializeDispatch
     Shizu_String_Dispatch* self
   );
 
+#if 1 == Shizu_Configuration_WithStringRopes
+static Shizu_ObjectTypeField const Shizu_String_fields[] = {
+  Shizu_ObjectTypeField_Object(Shizu_String, left),
+  Shizu_ObjectTypeField_Object(Shizu_String, right),
+};
+#endif
+
 static Shizu_ObjectTypeDescriptor const Shizu_String_Type = {
   .postCreateType = NULL,
   .preDestroyType = NULL,
@@ -72,6 +79,10 @@ static Shizu_ObjectTypeDescriptor const Shizu_String_Type = {
   .construct = NULL,
   .visit = NULL,
   .finalize = (Shizu_OnFinalizeCallback*)&Shizu_String_finalize,
+#if 1 == Shizu_Configuration_WithStringRopes
+  .fields = Shizu_String_fields,
+  .numberOfFields = sizeof(Shizu_String_fields) / sizeof(Shizu_ObjectTypeField),
+#endif
   .dispatchSize = sizeof(Shizu_String_Dispatch),
   .dispatchInitialize = (Shizu_OnDispatchInitializeCallback*)Shizu_String_initializeDispatch,
   .dispatchUninitialize = NULL,
@@ -79,6 +90,245 @@ static Shizu_ObjectTypeDescriptor const Shizu_String_Type = {
 
 Shizu_defineObjectType("Shizu.String", Shizu_String, Shizu_Object);
 
+// The minimum capacity of the intern table. Must be a power of two.
+#define StringsMinimumCapacity (64)
+
+struct Shizu_Strings {
+  /// The buckets of the intern table. The strings of a bucket are linked by their next fields.
+  /// The capacity is a power of two. The table grows if the load factor exceeds 3/4 and shrinks if it falls below 1/8.
+  Shizu_String** buckets;
+  size_t size;
+  size_t capacity;
+};
+
+static inline size_t
+hashBytes
+  (
+    size_t hashValue,
+    char const* bytes,
+    size_t numberOfBytes
+  )
+{
+  for (size_t i = 0, n = numberOfBytes; i < n; ++i) {
+    hashValue = hashValue * 37 + (size_t)(uint8_t)bytes[i];
+  }
+  return hashValue;
+}
+
+// Compute 37^exponent.
+// Used to derive the hash value of a concatenation from the hash values of its operands:
+// hash(x y) = hash(x) * 37^|y| + hash(y).
+static inline size_t
+powerOf37
+  (
+    size_t exponent
+  )
+{
+  size_t result = 1, base = 37;
+  while (exponent) {
+    if (exponent & 1) {
+      result *= base;
+    }
+    base *= base;
+    exponent >>= 1;
+  }
+  return result;
+}
+
+// The index of the bucket of a hash value.
+// The hash value is scrambled as the low bits of the hash value mostly depend on the last Bytes of a string.
+static inline size_t
+getBucketIndex
+  (
+    Shizu_Strings const* self,
+    size_t hashValue
+  )
+{
+  return (size_t)(((uint64_t)hashValue * UINT64_C(0x9E3779B97F4A7C15)) >> 32) & (self->capacity - 1);
+}
+
+// Rehash the strings into a table of the specified capacity (a power of two).
+// If the table can not be allocated, the strings stay in the current table.
+static void
+resizeStrings
+  (
+    Shizu_State1* state1,
+    Shizu_Strings* self,
+    size_t newCapacity
+  )
+{
+  Shizu_String** newBuckets = Shizu_State1_allocate(state1, sizeof(Shizu_String*) * newCapacity);
+  if (!newBuckets) {
+    return;
+  }
+  for (size_t i = 0; i < newCapacity; ++i) {
+    newBuckets[i] = NULL;
+  }
+  size_t oldCapacity = self->capacity;
+  Shizu_String** oldBuckets = self->buckets;
+  self->buckets = newBuckets;
+  self->capacity = newCapacity;
+  for (size_t i = 0; i < oldCapacity; ++i) {
+    while (oldBuckets[i]) {
+      Shizu_String* string = oldBuckets[i];
+      oldBuckets[i] = string->next;
+      size_t j = getBucketIndex(self, string->hashValue);
+      string->next = newBuckets[j];
+      newBuckets[j] = string;
+    }
+  }
+  Shizu_State1_deallocate(state1, oldBuckets);
+}
+
+// Find the interned string of the specified Bytes.
+// Return a pointer to that string or the null pointer if there is no such string.
+static inline Shizu_String*
+findInterned
+  (
+    Shizu_Strings* self,
+    size_t hashValue,
+    char const* bytes,
+    size_t numberOfBytes
+  )
+{
+  Shizu_String* current = self->buckets[getBucketIndex(self, hashValue)];
+  while (current) {
+    if (current->hashValue == hashValue && current->numberOfBytes == numberOfBytes && !memcmp(current->bytes, bytes, numberOfBytes)) {
+      return current;
+    }
+    current = current->next;
+  }
+  return NULL;
+}
+
+// Add a string to the intern table.
+// The intern table must not store a string equal to that string.
+static void
+addInterned
+  (
+    Shizu_State1* state1,
+    Shizu_Strings* self,
+    Shizu_String* string
+  )
+{
+  size_t i = getBucketIndex(self, string->hashValue);
+  string->next = self->buckets[i];
+  self->buckets[i] = string;
+  string->interned = true;
+  self->size++;
+  if (self->size > self->capacity / 4 * 3 && self->capacity <= SIZE_MAX / sizeof(Shizu_String*) / 2) {
+    resizeStrings(state1, self, self->capacity * 2);
+  }
+}
+
+// Remove a string from the intern table.
+// If @a shrink is true, shrink the table if its load factor falls below 1/8.
+static void
+removeInterned
+  (
+    Shizu_State1* state1,
+    Shizu_Strings* self,
+    Shizu_String* string,
+    bool shrink
+  )
+{
+  Shizu_String** previous = &(self->buckets[getBucketIndex(self, string->hashValue)]);
+  while (*previous != string) {
+    previous = &(*previous)->next;
+  }
+  *previous = string->next;
+  string->next = NULL;
+  string->interned = false;
+  self->size--;
+  if (shrink && self->capacity > StringsMinimumCapacity && self->size < self->capacity / 8) {
+    resizeStrings(state1, self, self->capacity / 2);
+  }
+}
+
+Shizu_Strings*
+Shizu_Strings_create
+  (
+    Shizu_State1* state
+  )
+{
+  Shizu_Strings* self = Shizu_State1_allocate(state, sizeof(Shizu_Strings));
+  if (!self) {
+    Shizu_State1_setStatus(state, Shizu_Status_AllocationFailed);
+    Shizu_State1_jump(state);
+  }
+  self->size = 0;
+  self->capacity = StringsMinimumCapacity;
+  self->buckets = Shizu_State1_allocate(state, sizeof(Shizu_String*) * self->capacity);
+  if (!self->buckets) {
+    Shizu_State1_deallocate(state, self);
+    self = NULL;
+    Shizu_State1_setStatus(state, Shizu_Status_AllocationFailed);
+    Shizu_State1_jump(state);
+  }
+  for (size_t i = 0, n = self->capacity; i < n; ++i) {
+    self->buckets[i] = NULL;
+  }
+  return self;
+}
+
+void
+Shizu_Strings_destroy
+  (
+    Shizu_State1* state,
+    Shizu_Strings* self
+  )
+{
+  // Strings still alive (for example, because they are locked) are no longer interned.
+  for (size_t i = 0, n = self->capacity; i < n; ++i) {
+    while (self->buckets[i]) {
+      Shizu_String* string = self->buckets[i];
+      self->buckets[i] = string->next;
+      string->next = NULL;
+      string->interned = false;
+    }
+  }
+  Shizu_State1_deallocate(state, self->buckets);
+  self->buckets = NULL;
+  Shizu_State1_deallocate(state, self);
+  self = NULL;
+}
+
+void
+Shizu_Strings_notifyMarkComplete
+  (
+    Shizu_State1* state1,
+    Shizu_Gc* gc,
+    Shizu_Strings* self
+  )
+{
+  if (!self) {
+    return;
+  }
+  // Strings handed out by the intern table while the collection was marking were colored gray by the read barrier.
+  // Hence a white string is not reachable and is reclaimed by the sweep.
+  for (size_t i = 0, n = self->capacity; i < n; ++i) {
+    Shizu_String** previous = &(self->buckets[i]);
+    while (*previous) {
+      Shizu_String* string = *previous;
+      if (Shizu_Object_isWhite((Shizu_Object*)string)) {
+        *previous = string->next;
+        string->next = NULL;
+        string->interned = false;
+        self->size--;
+      } else {
+        previous = &string->next;
+      }
+    }
+  }
+  size_t newCapacity = self->capacity;
+  while (newCapacity > StringsMinimumCapacity && self->size < newCapacity / 8) {
+    newCapacity /= 2;
+  }
+  if (newCapacity != self->capacity) {
+    resizeStrings(state1, self, newCapacity);
+  }
+}
+
 static void
 Shizu_String_finalize
   (
@@ -86,12 +336,124 @@ Shizu_String_finalize
     Shizu_String* self
   )
 {
+  if (self->interned) {
+    Shizu_Strings* strings = Shizu_State2_getStrings(state);
+    if (strings) {
+      removeInterned(Shizu_State2_getState1(state), strings, self, true);
+    }
+  }
   if (self->bytes) {
-    Shizu_State1_deallocate(Shizu_State2_getState1(state), self->bytes);
+    if (self->bytes != self->inlineBytes) {
+      Shizu_State1_deallocate(Shizu_State2_getState1(state), self->bytes);
+    }
     self->bytes = NULL;
   }
 }
 
+// Let the bytes field of a string point to storage for the specified number of Bytes.
+// The object of the string must have been allocated with Shizu_String_getObjectSize(numberOfBytes) Bytes.
+static void
+allocateBytes
+  (
+    Shizu_State2* state,
+    Shizu_String* self,
+    size_t numberOfBytes
+  )
+{
+  if (numberOfBytes <= Shizu_String_MaximumInlineNumberOfBytes) {
+    self->bytes = self->inlineBytes;
+    return;
+  }
+  self->bytes = Shizu_State1_allocate(Shizu_State2_getState1(state), numberOfBytes);
+  if (!self->bytes) {
+    fprintf(stderr, "%s:%d: unable to allocate `%zu` Bytes\n", __FILE__, __LINE__, numberOfBytes);
+    Shizu_State2_setStatus(state, Shizu_Status_AllocationFailed);
+    Shizu_State2_jump(state);
+  }
+}
+
+#if 1 == Shizu_Configuration_WithStringRopes
+
+// Copy the Bytes of a rope into a single array and release the strings the rope is the concatenation of.
+// The Bytes are copied from the back to the front such that flattening a rope built by appending to a rope does not
+// require more than a constant number of pending strings.
+static void
+flatten
+  (
+    Shizu_State2* state,
+    Shizu_String* self
+  )
+{
+  Shizu_State1* state1 = Shizu_State2_getState1(state);
+  char* bytes = Shizu_State1_allocate(state1, self->numberOfBytes);
+  if (!bytes) {
+    Shizu_State2_setStatus(state, Shizu_Status_AllocationFailed);
+    Shizu_State2_jump(state);
+  }
+  // The stack of the pending strings.
+  // Starts with a fixed-size array and grows (by doubling) in a separate allocation if necessary.
+  Shizu_String* fixedPending[32];
+  Shizu_String** pending = fixedPending;
+  size_t numberOfPending = 0, capacityOfPending = 32;
+  size_t end = self->numberOfBytes;
+  Shizu_String* current = self;
+  while (true) {
+    while (!current->bytes) {
+      if (numberOfPending == capacityOfPending) {
+        Shizu_String** newPending = NULL;
+        if (capacityOfPending <= SIZE_MAX / sizeof(Shizu_String*) / 2) {
+          newPending = Shizu_State1_allocate(state1, sizeof(Shizu_String*) * capacityOfPending * 2);
+        }
+        if (!newPending) {
+          if (pending != fixedPending) {
+            Shizu_State1_deallocate(state1, pending);
+          }
+          Shizu_State1_deallocate(state1, bytes);
+          Shizu_State2_setStatus(state, Shizu_Status_AllocationFailed);
+          Shizu_State2_jump(state);
+        }
+        memcpy(newPending, pending, sizeof(Shizu_String*) * numberOfPending);
+        if (pending != fixedPending) {
+          Shizu_State1_deallocate(state1, pending);
+        }
+        pending = newPending;
+        capacityOfPending *= 2;
+      }
+      pending[numberOfPending++] = current->left;
+      current = current->right;
+    }
+    end -= current->numberOfBytes;
+    memcpy(bytes + end, current->bytes, current->numberOfBytes);
+    if (!numberOfPending) {
+      break;
+    }
+    current = pending[--numberOfPending];
+  }
+  if (pending != fixedPending) {
+    Shizu_State1_deallocate(state1, pending);
+  }
+  self->bytes = bytes;
+  self->left = NULL;
+  self->right = NULL;
+}
+
+#endif
+
+// Ensure the Bytes of a string are stored in a single array.
+static inline void
+ensureFlat
+  (
+    Shizu_State2* state,
+    Shizu_String* self
+  )
+{
+#if 1 == Shizu_Configuration_WithStringRopes
+  if (!self->bytes) {
+    flatten(state, self);
+  }
+#endif
+}
+
 static Shizu_Integer32
 Shizu_String_getHashValueImpl
   (
@@ -120,7 +482,13 @@ Shizu_String_isEqualToImpl
   if (Shizu_Types_isSubTypeOf(Shizu_State2_getState1(state), Shizu_State2_getTypes(state), Shizu_Object_getObjectType(state, otherObject), Shizu_String_getType(state))) {
     Shizu_String* x = self;
     Shizu_String* y = (Shizu_String*)otherObject;
+    // Two different interned strings are not equal.
+    if (x->interned && y->interned) {
+      return Shizu_Boolean_False;
+    }
     if (x->hashValue == y->hashValue && x->numberOfBytes == y->numberOfBytes) {
+      ensureFlat(state, x);
+      ensureFlat(state, y);
       return !memcmp(x->bytes, y->bytes, x->numberOfBytes);
     } else {
       return Shizu_Boolean_False;
@@ -152,18 +520,15 @@ Shizu_String_construct
 {
   Shizu_Type* TYPE = Shizu_String_getType(state);
   Shizu_Object_construct(state, (Shizu_Object*)self);
-  self->bytes = Shizu_State1_allocate(Shizu_State2_getState1(state), numberOfBytes);
-  if (!self->bytes) {
-    fprintf(stderr, "%s:%d: unable to allocate `%zu` Bytes\n", __FILE__, __LINE__, numberOfBytes);
-    Shizu_State2_setStatus(state, Shizu_Status_AllocationFailed);
-    Shizu_State2_jump(state);
-  }
-  size_t hashValue = numberOfBytes;
-  for (size_t i = 0, n = numberOfBytes; i < n; ++i) {
-    hashValue = ((hashValue << 5) ^ (hashValue >> 3)) | (size_t)bytes[i];
-  }
-  self->hashValue = hashValue;
+  allocateBytes(state, self, numberOfBytes);
+  self->next = NULL;
+#if 1 == Shizu_Configuration_WithStringRopes
+  self->left = NULL;
+  self->right = NULL;
+#endif
+  self->hashValue = hashBytes(0, bytes, numberOfBytes);
   self->numberOfBytes = numberOfBytes;
+  self->interned = false;
   memcpy(self->bytes, bytes, numberOfBytes);
   ((Shizu_Object*)self)->type = TYPE;
 }
@@ -176,9 +541,7 @@ Shizu_String_create
     size_t numberOfBytes
   )
 {
-  Shizu_Type* TYPE = Shizu_String_getType(state);
-  Shizu_ObjectTypeDescriptor const* DESCRIPTOR = Shizu_Type_getObjectTypeDescriptor(Shizu_State2_getState1(state), Shizu_State2_getTypes(state), TYPE);
-  Shizu_String* SELF = (Shizu_String*)Shizu_Gc_allocateObject(state, DESCRIPTOR->size);
+  Shizu_String* SELF = (Shizu_String*)Shizu_Gc_allocateObject(state, Shizu_String_getObjectSize(numberOfBytes));
   Shizu_String_construct(state, SELF, bytes, numberOfBytes);
   return SELF;
 }
@@ -196,38 +559,109 @@ Shizu_String_concatenate
     Shizu_State2_setStatus(state, 1);
     Shizu_State2_jump(state);
   }
-  size_t hashValue = self->numberOfBytes + other->numberOfBytes;
-  for (size_t i = 0, n = self->numberOfBytes; i < n; ++i) {
-    hashValue = (hashValue << 5) ^ (hashValue >> 3) | (size_t)self->bytes[i];
-  }
-  for (size_t i = 0, n = other->numberOfBytes; i < n; ++i) {
-    hashValue = (hashValue << 5) ^ (hashValue >> 3) | (size_t)other->bytes[i];
-  }
+  // The hash value is derived from the hash values of the operands and not computed from the Bytes.
+  size_t hashValue = self->hashValue * powerOf37(other->numberOfBytes) + other->hashValue;
   Shizu_Type* TYPE = Shizu_String_getType(state);
-  Shizu_String* new = (Shizu_String*)Shizu_Gc_allocateObject(state, sizeof(Shizu_String));
-  Shizu_Object_construct(state, (Shizu_Object*)new);
   size_t numberOfBytes = self->numberOfBytes + other->numberOfBytes;
-  new->bytes = malloc(numberOfBytes > 0 ?  numberOfBytes : 1);
-  if (!new->bytes) {
-    fprintf(stderr, "%s:%d: unable to allocate `%zu` Bytes\n", __FILE__, __LINE__, numberOfBytes > 0 ? numberOfBytes : 1);
-    Shizu_State2_setStatus(state, 1);
-    Shizu_State2_jump(state);
+#if 1 == Shizu_Configuration_WithStringRopes
+  if (numberOfBytes >= Shizu_String_MinimumRopeNumberOfBytes && self->numberOfBytes && other->numberOfBytes) {
+    Shizu_String* new = (Shizu_String*)Shizu_Gc_allocateObject(state, sizeof(Shizu_String));
+    Shizu_Object_construct(state, (Shizu_Object*)new);
+    new->bytes = NULL;
+    new->next = NULL;
+    new->left = self;
+    new->right = other;
+    new->hashValue = hashValue;
+    new->numberOfBytes = numberOfBytes;
+    new->interned = false;
+    ((Shizu_Object*)new)->type = TYPE;
+    Shizu_Gc_writeBarrier(Shizu_State2_getState1(state), Shizu_State2_getGc(state), (Shizu_Object*)new, (Shizu_Object*)self);
+    Shizu_Gc_writeBarrier(Shizu_State2_getState1(state), Shizu_State2_getGc(state), (Shizu_Object*)new, (Shizu_Object*)other);
+    return new;
   }
+#endif
+  ensureFlat(state, self);
+  ensureFlat(state, other);
+  Shizu_String* new = (Shizu_String*)Shizu_Gc_allocateObject(state, Shizu_String_getObjectSize(numberOfBytes));
+  Shizu_Object_construct(state, (Shizu_Object*)new);
+  allocateBytes(state, new, numberOfBytes);
+  new->next = NULL;
+#if 1 == Shizu_Configuration_WithStringRopes
+  new->left = NULL;
+  new->right = NULL;
+#endif
   new->hashValue = hashValue;
   new->numberOfBytes = numberOfBytes;
+  new->interned = false;
   memcpy(new->bytes, self->bytes, self->numberOfBytes);
   memcpy(new->bytes + self->numberOfBytes, other->bytes, other->numberOfBytes);
   ((Shizu_Object*)new)->type = TYPE;
   return new;
 }
 
+Shizu_String*
+Shizu_String_createInterned
+  (
+    Shizu_State2* state,
+    char const* bytes,
+    size_t numberOfBytes
+  )
+{
+  Shizu_Strings* strings = Shizu_State2_getStrings(state);
+  if (!strings) {
+    return Shizu_String_create(state, bytes, numberOfBytes);
+  }
+  Shizu_String* self = findInterned(strings, hashBytes(0, bytes, numberOfBytes), bytes, numberOfBytes);
+  if (!self) {
+    self = Shizu_String_create(state, bytes, numberOfBytes);
+    addInterned(Shizu_State2_getState1(state), strings, self);
+  }
+  Shizu_Gc_readBarrier(Shizu_State2_getState1(state), Shizu_State2_getGc(state), (Shizu_Object*)self);
+  return self;
+}
+
+Shizu_String*
+Shizu_String_intern
+  (
+    Shizu_State2* state,
+    Shizu_String* self
+  )
+{
+  if (self->interned) {
+    return self;
+  }
+  Shizu_Strings* strings = Shizu_State2_getStrings(state);
+  if (!strings) {
+    return self;
+  }
+  ensureFlat(state, self);
+  Shizu_String* interned = findInterned(strings, self->hashValue, self->bytes, self->numberOfBytes);
+  if (!interned) {
+    interned = self;
+    addInterned(Shizu_State2_getState1(state), strings, interned);
+  }
+  Shizu_Gc_readBarrier(Shizu_State2_getState1(state), Shizu_State2_getGc(state), (Shizu_Object*)interned);
+  return interned;
+}
+
+Shizu_Boolean
+Shizu_String_isInterned
+  (
+    Shizu_State2* state,
+    Shizu_String* self
+  )
+{ return self->interned; }
+
 char const*
 Shizu_String_getBytes
   (
     Shizu_State2* state,
     Shizu_String* self
   )
-{ return self->bytes; }
+{
+  ensureFlat(state, self);
+  return self->bytes;
+}
 
 size_t
 Shizu_String_getNumberOfBytes
@@ -248,6 +682,8 @@ Shizu_String_startsWith
   if (prefix->numberOfBytes > self->numberOfBytes) {
     return false;
   }
+  ensureFlat(state, self);
+  ensureFlat(state, prefix);
   return !memcmp(prefix->bytes, self->bytes, prefix->numberOfBytes);
 }
 
@@ -262,6 +698,8 @@ Shizu_String_endsWith
   if (suffix->numberOfBytes > self->numberOfBytes) {
     return false;
   }
+  ensureFlat(state, self);
+  ensureFlat(state, suffix);
   size_t start = self->numberOfBytes - suffix->numberOfBytes;
   return !memcmp(suffix->bytes, self->bytes + start, suffix->numberOfBytes);
 }
@@ -0,0 +1,188 @@
+/*
+  Shizu
+  Copyright (C) 2024 Michael Heilmann. All rights reserved.
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+#define SHIZU_RUNTIME_PRIVATE (1)
+#include "Shizu/Runtime/Objects/StringBuilder.private.h"
+
+#include "Shizu/Runtime/State2.h"
+#include "Shizu/Runtime/State1.h"
+#include "Shizu/Runtime/Gc.h"
+
+// memcpy
+#include <string.h>
+
+// The initial capacity of the buffer of a string builder.
+#define MinimumCapacity (64)
+
+static void
+Shizu_StringBuilder_finalize
+  (
+    Shizu_State2* state,
+    Shizu_StringBuilder* self
+  );
+
+static void
+Shizu_StringBuilder_constructImpl
+  (
+    Shizu_State2* state,
+    Shizu_Value* returnValue,
+    Shizu_Integer32 numberOfArgumentValues,
+    Shizu_Value* argumentValues
+  );
+
+static Shizu_ObjectTypeDescriptor const Shizu_StringBuilder_Type = {
+  .postCreateType = NULL,
+  .preDestroyType = NULL,
+  .visitType = NULL,
+  .size = sizeof(Shizu_StringBuilder),
+  .construct = &Shizu_StringBuilder_constructImpl,
+  .visit = NULL,
+  .finalize = (Shizu_OnFinalizeCallback*) & Shizu_StringBuilder_finalize,
+  .dispatchSize = sizeof(Shizu_StringBuilder_Dispatch),
+  .dispatchInitialize = NULL,
+  .dispatchUninitialize = NULL,
+};
+
+Shizu_defineObjectType("Shizu.StringBuilder", Shizu_StringBuilder, Shizu_Object);
+
+static void
+Shizu_StringBuilder_finalize
+  (
+    Shizu_State2* state,
+    Shizu_StringBuilder* self
+  )
+{
+  self->size = 0;
+  Shizu_State1_deallocate(Shizu_State2_getState1(state), self->bytes);
+  self->bytes = NULL;
+  self->capacity = 0;
+}
+
+static void
+Shizu_StringBuilder_constructImpl
+  (
+    Shizu_State2* state,
+    Shizu_Value* returnValue,
+    Shizu_Integer32 numberOfArgumentValues,
+    Shizu_Value* argumentValues
+  )
+{
+  if (1 != numberOfArgumentValues) {
+    Shizu_State2_setStatus(state, Shizu_Status_NumberOfArgumentsInvalid);
+    Shizu_State2_jump(state);
+  }
+  if (!Shizu_Value_isObject(&argumentValues[0])) {
+    Shizu_State2_setStatus(state, Shizu_Status_ArgumentTypeInvalid);
+    Shizu_State2_jump(state);
+  }
+  Shizu_StringBuilder* SELF = (Shizu_StringBuilder*)Shizu_Value_getObject(&argumentValues[0]);
+  Shizu_Type* TYPE = Shizu_StringBuilder_getType(state);
+  Shizu_Object_construct(state, (Shizu_Object*)SELF);
+  SELF->bytes = Shizu_State1_allocate(Shizu_State2_getState1(state), MinimumCapacity);
+  if (!SELF->bytes) {
+    Shizu_State2_setStatus(state, Shizu_Status_AllocationFailed);
+    Shizu_State2_jump(state);
+  }
+  SELF->size = 0;
+  SELF->capacity = MinimumCapacity;
+  ((Shizu_Object*)SELF)->type = TYPE;
+}
+
+Shizu_StringBuilder*
+Shizu_StringBuilder_create
+  (
+    Shizu_State2* state
+  )
+{
+  Shizu_Type* TYPE = Shizu_StringBuilder_getType(state);
+  Shizu_ObjectTypeDescriptor const* DESCRIPTOR = Shizu_Type_getObjectTypeDescriptor(Shizu_State2_getState1(state), Shizu_State2_getTypes(state), TYPE);
+  Shizu_StringBuilder* SELF = (Shizu_StringBuilder*)Shizu_Gc_allocateObject(state, DESCRIPTOR->size);
+  Shizu_Value returnValue = Shizu_Value_InitializerVoid(Shizu_Void_Void);
+  Shizu_Value argumentValues[] = { Shizu_Value_InitializerVoid(Shizu_Void_Void), };
+  Shizu_Value_setObject(&argumentValues[0], (Shizu_Object*)SELF);
+  DESCRIPTOR->construct(state, &returnValue, 1, &(argumentValues[0]));
+  return SELF;
+}
+
+void
+Shizu_StringBuilder_appendBytes
+  (
+    Shizu_State2* state,
+    Shizu_StringBuilder* self,
+    char const* bytes,
+    size_t numberOfBytes
+  )
+{
+  if (self->capacity - self->size < numberOfBytes) {
+    if (SIZE_MAX - self->size < numberOfBytes) {
+      Shizu_State2_setStatus(state, Shizu_Status_AllocationFailed);
+      Shizu_State2_jump(state);
+    }
+    size_t newCapacity = self->capacity;
+    while (newCapacity - self->size < numberOfBytes) {
+      newCapacity = newCapacity <= SIZE_MAX / 2 ? newCapacity * 2 : SIZE_MAX;
+    }
+    char* newBytes = Shizu_State1_reallocate(Shizu_State2_getState1(state), self->bytes, newCapacity);
+    if (!newBytes) {
+      Shizu_State2_setStatus(state, Shizu_Status_AllocationFailed);
+      Shizu_State2_jump(state);
+    }
+    self->bytes = newBytes;
+    self->capacity = newCapacity;
+  }
+  memcpy(self->bytes + self->size, bytes, numberOfBytes);
+  self->size += numberOfBytes;
+}
+
+void
+Shizu_StringBuilder_appendString
+  (
+    Shizu_State2* state,
+    Shizu_StringBuilder* self,
+    Shizu_String* string
+  )
+{
+  Shizu_StringBuilder_appendBytes(state, self, Shizu_String_getBytes(state, string), Shizu_String_getNumberOfBytes(state, string));
+}
+
+size_t
+Shizu_StringBuilder_getNumberOfBytes
+  (
+    Shizu_State2* state,
+    Shizu_StringBuilder* self
+  )
+{ return self->size; }
+
+void
+Shizu_StringBuilder_clear
+  (
+    Shizu_State2* state,
+    Shizu_StringBuilder* self
+  )
+{ self->size = 0; }
+
+Shizu_String*
+Shizu_StringBuilder_toString
+  (
+    Shizu_State2* state,
+    Shizu_StringBuilder* self
+  )
+{ return Shizu_String_create(state, self->bytes, self->size); }
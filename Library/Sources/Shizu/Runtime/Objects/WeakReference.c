@@ -24,7 +24,7 @@
 
 #include "Shizu/Runtime/State2.h"
 #include "Shizu/Runtime/State1.h"
-#include "Shizu/Runtime/Gc.h"
+#include "Shizu/Runtime/Gc.private.h"
 
 // memcmp, memcpy
 #include <string.h>
@@ -54,12 +54,6 @@ Shizu_WeakReference_finalize
     Shizu_WeakReference* self
   );
 
-static size_t
-hashPointer
-  (
-    void* p
-  );
-
 static void
 Shizu_WeakReference_constructImpl
   (
@@ -75,6 +69,7 @@ struct Shizu_WeakReference_Dispatch {
 
 struct Shizu_WeakReference {
   Shizu_Object _parent;
+  /// @brief A pointer to the next weak reference in the list of weak references of the side record of the referenced object.
   Shizu_WeakReference* next;
   /// @brief A pointer to the Shizu_Object value or the null pointer.
   Shizu_Object* reference;
@@ -95,24 +90,10 @@ static Shizu_ObjectTypeDescriptor const Shizu_WeakReference_Type = {
 
 Shizu_defineObjectType("Shizu.WeakReference", Shizu_WeakReference, Shizu_Object);
 
-typedef struct WeakReferenceNode WeakReferenceNode;
-
-struct WeakReferenceNode {
-  WeakReferenceNode* next;
-  /// @brief A pointer to the object or the null pointer.
-  Shizu_Object* reference;
-  /// @brief The hash value of the address of the managed object.
-  size_t hashValue;
-  /// @brief A pointer to the weak reference.
-  Shizu_WeakReference* weakReference;
-};
-
+// The weak references are stored in the side records of the referenced objects (see Shizu_ObjectRecord).
 struct Shizu_WeakReferences {
-  Shizu_WeakReference** buckets;
+  /// @brief The number of weak references referencing an object.
   size_t size;
-  size_t capacity;
-  size_t minimalCapacity;
-  size_t maximalCapacity;
 };
 
 Shizu_WeakReferences*
@@ -121,39 +102,12 @@ Shizu_WeakReferences_create
     Shizu_State1* state
   )
 {
-  // (1)
   Shizu_WeakReferences* self = Shizu_State1_allocate(state, sizeof(Shizu_WeakReferences));
   if (!self) {
     Shizu_State1_setStatus(state, Shizu_Status_AllocationFailed);
     Shizu_State1_jump(state);
   }
-  // (2)
-  self->minimalCapacity = 8;
-  self->maximalCapacity = SIZE_MAX / sizeof(WeakReferenceNode*);
-  if (self->maximalCapacity > Shizu_Integer32_Maximum) {
-    self->maximalCapacity = Shizu_Integer32_Maximum;
-  }
-  if (self->maximalCapacity < self->minimalCapacity) {
-    Shizu_State1_deallocate(state, self);
-    self = NULL;
-    Shizu_State1_setStatus(state, 1);
-    Shizu_State1_jump(state);
-  }
-  // (3)
-  self->capacity = self->minimalCapacity;
-  self->buckets = Shizu_State1_allocate(state, sizeof(Shizu_WeakReference*) * self->capacity);
-  if (!self->buckets) {
-    Shizu_State1_deallocate(state, self);
-    self = NULL;
-    Shizu_State1_setStatus(state, 1);
-    Shizu_State1_jump(state);
-  }
-  for (size_t i = 0, n = self->capacity; i < n; ++i) {
-    self->buckets[i] = NULL;
-  }
-  // (4)
   self->size = 0;
-  // (5)
   return self;
 }
 
@@ -164,19 +118,8 @@ Shizu_WeakReferences_destroy
     Shizu_WeakReferences* self
   )
 {
-  // @todo In debug mode, assert the table is empty.
+  // @todo In debug mode, assert there are no weak references referencing an object.
   self->size = 0;
-  for (size_t i = 0, n = self->capacity; i < n; ++i) {
-    Shizu_WeakReference** bucket = &(self->buckets[i]);
-    while (*bucket) {
-      Shizu_WeakReference* node = *bucket;
-      *bucket = (*bucket)->next;
-      Shizu_State1_deallocate(state, node);
-    }
-  }
-  self->capacity = 0;
-  Shizu_State1_deallocate(state, self->buckets);
-  self->buckets = NULL;
   Shizu_State1_deallocate(state, self);
   self = NULL;
 }
@@ -187,27 +130,17 @@ Shizu_WeakReferenceState_notifyObjectFinalize
     Shizu_State1* state1,
     Shizu_Gc* gc,
     Shizu_WeakReferences* self,
-    Shizu_Object* reference
+    Shizu_ObjectRecord* record
   )
 {
-  // Remove all weak references to that object from the hash table.
-  // Set their reference field to null.
-  // Remove the weak reference from the hash table.
-  size_t hashValue = hashPointer(reference);
-  size_t hashIndex = hashValue % self->capacity;
-  Shizu_WeakReference** previous = &(self->buckets[hashIndex]);
-  Shizu_WeakReference* current = self->buckets[hashIndex];
-  while (current) {
-    if (current->reference == reference) {
-      Shizu_WeakReference* weakReference = current;
-      *previous = current->next;
-      current = current->next;
-      weakReference->next = NULL;
+  // Set the reference fields of the weak references to null and remove them from the side record.
+  while (record->weakReferences) {
+    Shizu_WeakReference* weakReference = record->weakReferences;
+    record->weakReferences = weakReference->next;
+    weakReference->next = NULL;
+    weakReference->reference = NULL;
+    if (self) {
       self->size--;
-      break;
-    } else {
-      previous = &current->next;
-      current = current->next;
     }
   }
 }
@@ -239,31 +172,24 @@ Shizu_WeakReference_finalize
     Shizu_State2_setStatus(state, Shizu_Status_OperationInvalid);
     Shizu_State2_jump(state);
   }
-  // Remove the weak reference from the hash table.
-  size_t hashValue = hashPointer(self->reference);
-  size_t hashIndex = hashValue % g->capacity;
-  Shizu_WeakReference** previous = &(g->buckets[hashIndex]);
-  Shizu_WeakReference* current = g->buckets[hashIndex];
-  while (current) {
-    if (current == self) {
-      *previous = current->next;
-      self->next = NULL;
-      g->size--;
-      break;
-    } else {
-      previous = &current->next;
-      current = current->next;
-    }
+  if (!self->reference) {
+    // The referenced object was finalized before or there was no referenced object.
+    return;
+  }
+  // Remove the weak reference from the side record of the referenced object.
+  Shizu_Gc* gc = Shizu_State2_getGc(state);
+  Shizu_ObjectRecord* record = Shizu_Gc_getObjectRecord(Shizu_State2_getState1(state), gc, self->reference, false);
+  Shizu_WeakReference** previous = &record->weakReferences;
+  while (*previous != self) {
+    previous = &(*previous)->next;
   }
+  *previous = self->next;
+  self->next = NULL;
+  self->reference = NULL;
+  g->size--;
+  Shizu_Gc_releaseObjectRecord(Shizu_State2_getState1(state), gc, record);
 }
 
-static size_t
-hashPointer
-  (
-    void* p
-  )
-{ return (size_t)(uintptr_t)p; }
-
 static void
 Shizu_WeakReference_constructImpl
   (
@@ -293,13 +219,16 @@ Shizu_WeakReference_constructImpl
   Shizu_WeakReference* SELF = (Shizu_WeakReference*)Shizu_Value_getObject(&argumentValues[0]);
   Shizu_Type* TYPE = Shizu_WeakReference_getType(state);
   Shizu_Object_construct(state, (Shizu_Object*)SELF);
-  Shizu_WeakReferences* g = Shizu_State2_getWeakReferences(state);
-  // Add the weak reference to the hash table.
-  size_t hashValue = hashPointer(reference);
-  size_t hashIndex = hashValue % g->capacity;
-  SELF->reference = reference;
-  SELF->next = g->buckets[hashIndex];
-  g->buckets[hashIndex] = SELF;
-  g->size++;
+  SELF->reference = NULL;
+  SELF->next = NULL;
+  if (reference) {
+    // Add the weak reference to the side record of the referenced object.
+    Shizu_WeakReferences* g = Shizu_State2_getWeakReferences(state);
+    Shizu_ObjectRecord* record = Shizu_Gc_getObjectRecord(Shizu_State2_getState1(state), Shizu_State2_getGc(state), reference, true);
+    SELF->reference = reference;
+    SELF->next = record->weakReferences;
+    record->weakReferences = SELF;
+    g->size++;
+  }
   ((Shizu_Object*)SELF)->type = TYPE;
 }
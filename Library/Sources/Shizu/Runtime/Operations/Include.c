@@ -123,7 +123,7 @@ Shizu_Operations_typeOf
     Shizu_State2_jump(state);
   }
   Shizu_Value* argumentValue = &(argumentValues[0]);
-  switch (argumentValue->tag) {
+  switch (Shizu_Value_getTag(argumentValue)) {
     case Shizu_Value_Tag_Boolean: {
       Shizu_Value_setType(returnValue, Shizu_Boolean_getType(state));
     } break;
@@ -89,16 +89,26 @@ Shizu_Stack_destroy
 }
 
 void
-Shizu_Stack_notifyPreMark
+Shizu_Stack_addRootRange
   (
     Shizu_State1* state1,
     Shizu_Gc* gc,
     Shizu_Stack* self
   )
 {
-  for (size_t i = 0, n = self->size; i < n; ++i) {
-    Shizu_Gc_visitValue(state1, gc, self->elements + i);
-  }
+  // The GC reads the variables whenever it visits the roots such that the elements may be reallocated.
+  Shizu_Gc_addRootRange(state1, gc, &self->elements, &self->size);
+}
+
+void
+Shizu_Stack_removeRootRange
+  (
+    Shizu_State1* state1,
+    Shizu_Gc* gc,
+    Shizu_Stack* self
+  )
+{
+  Shizu_Gc_removeRootRange(state1, gc, &self->elements, &self->size);
 }
 
 size_t
@@ -664,35 +664,21 @@ Shizu_State1_allocateNamedStorage
     size_t n
   )
 {
-  idlib_process* process = NULL;
-  if (idlib_process_acquire(&process)) {
-    return 1;
-  }
-
   void* p = NULL;
-  int result = idlib_get_global(process, name, strlen(name), (void**)&p);
+  int result = idlib_get_global(state1->process, name, strlen(name), (void**)&p);
   if (result != IDLIB_SUCCESS && result != IDLIB_NOT_EXISTS) {
-    idlib_process_relinquish(process);
-    process = NULL;
     return 1;
   }
   if (result == IDLIB_NOT_EXISTS) {
     p = malloc(n > 0 ? n : 1);
     if (!p) {
-      idlib_process_relinquish(process);
-      process = NULL;
       return 1;
     }
-    if (idlib_add_global(process, name, strlen(name), p)) {
+    if (idlib_add_global(state1->process, name, strlen(name), p)) {
       free(p);
       p = NULL;
-      idlib_process_relinquish(process);
-      process = NULL;
       return 1;
     }
-  } else {
-    idlib_process_relinquish(process);
-    process = NULL;
   }
   return 0;
 }
@@ -704,26 +690,15 @@ Shizu_State1_deallocateNamedStorage
     char const* name
   )
 {
-  idlib_process* process = NULL;
-  if (idlib_process_acquire(&process)) {
-    return 1;
-  }
-
   void* p = NULL;
-  int result = idlib_get_global(process, name, strlen(name), (void**)&p);
+  int result = idlib_get_global(state1->process, name, strlen(name), (void**)&p);
   if (result != IDLIB_SUCCESS && result != IDLIB_NOT_EXISTS) {
-    idlib_process_relinquish(process);
-    process = NULL;
     return 1;
   }
   if (result == IDLIB_NOT_EXISTS) {
-    idlib_process_relinquish(process);
-    process = NULL;
     return 0;
   }
-  idlib_remove_global(process, name, strlen(name));
-  idlib_process_relinquish(process);
-  process = NULL;
+  idlib_remove_global(state1->process, name, strlen(name));
   free(p);
   p = NULL;
   return 0;
@@ -737,12 +712,22 @@ Shizu_State1_getNamedStorage
     void** p
   )
 {
-  idlib_process* process = NULL;
-  if (idlib_process_acquire(&process)) {
+  int result = idlib_get_global(state1->process, name, strlen(name), p);
+  return IDLIB_SUCCESS != result;
+}
+
+int
+Shizu_State1_getNamedStorageHandle
+  (
+    Shizu_State1* state1,
+    char const* name,
+    Shizu_NamedStorageHandle* handle
+  )
+{
+  void* p = NULL;
+  if (Shizu_State1_getNamedStorage(state1, name, &p)) {
     return 1;
   }
-  int result = idlib_get_global(process, name, strlen(name), p);
-  idlib_process_relinquish(process);
-  process = NULL;
-  return IDLIB_SUCCESS != result;
+  handle->p = p;
+  return 0;
 }
@@ -47,7 +47,8 @@
 #include "Shizu/Runtime/Objects/List.private.h"
 #include "Shizu/Runtime/Objects/Environment.private.h"
 #include "Shizu/Runtime/Objects/WeakReference.private.h"
-#include "Shizu/Runtime/Objects/String.h"
+#include "Shizu/Runtime/Objects/String.private.h"
+#include "Shizu/Runtime/Objects/StringBuilder.h"
 
 #include "Shizu/Runtime/Operations/Include.h"
 
@@ -71,6 +72,8 @@ struct Shizu_State2 {
   Shizu_Stack* stack;
   /// The "weak references" state.
   Shizu_WeakReferences* weakReferences;
+  /// The "strings" state.
+  Shizu_Strings* strings;
   /// The global environment.
   Shizu_Environment* globalEnvironment;
 
@@ -113,7 +116,7 @@ static void shutdown2(Shizu_State2* state) {
 }
 
 static void startup3(Shizu_State2* state) {
-  state->gc = Shizu_Gc_create(state);
+  state->gc = Shizu_Gc_create(state, Shizu_Configuration_GcNumberOfMarkThreads);
 }
 
 static void shutdown3(Shizu_State2* state) {
@@ -124,31 +127,7 @@ static void shutdown3(Shizu_State2* state) {
 }
 
 static void startup4(Shizu_State2* state) {
-  state->locks = Shizu_Locks_create(state->state1);
-  Shizu_JumpTarget jumpTarget;
-  //
-  Shizu_State1_pushJumpTarget(state->state1, &jumpTarget);
-  if (!setjmp(jumpTarget.environment)) {
-    Shizu_Gc_addPreMarkHook(state->state1, state->gc, state->locks, &Shizu_Locks_notifyPreMark);
-    Shizu_State1_popJumpTarget(state->state1);
-  } else {
-    Shizu_State1_popJumpTarget(state->state1);
-    Shizu_Locks_destroy(state->state1, state->locks);
-    state->locks = NULL;
-    Shizu_State1_jump(state->state1);
-  }
-  //
-  Shizu_State1_pushJumpTarget(state->state1, &jumpTarget);
-  if (!setjmp(jumpTarget.environment)) {
-    Shizu_Gc_addObjectFinalizeHook(state->state1, state->gc, state->locks, &Shizu_Locks_notifyObjectFinalize);
-    Shizu_State1_popJumpTarget(state->state1);
-  } else {
-    Shizu_State1_popJumpTarget(state->state1);
-    Shizu_Gc_removePreMarkHook(state->state1, state->gc, state->locks, &Shizu_Locks_notifyPreMark);
-    Shizu_Locks_destroy(state->state1, state->locks);
-    state->locks = NULL;
-    Shizu_State1_jump(state->state1);
-  }
+  state->locks = Shizu_Locks_create(state->state1, state->gc);
 }
 
 static void shutdown4(Shizu_State2* state) {
@@ -158,39 +137,34 @@ static void shutdown4(Shizu_State2* state) {
   if (size > 0) {
     fprintf(stderr, "%s: %d: warning: expected number of locks is %zu. received number of locks is %zu\n", __FILE__, __LINE__, (size_t)0, size);
   }
-  Shizu_Gc_removeObjectFinalizeHook(state->state1, state->gc, state->locks, &Shizu_Locks_notifyObjectFinalize);
-  Shizu_Gc_removePreMarkHook(state->state1, state->gc, state->locks, &Shizu_Locks_notifyPreMark);
   Shizu_Locks_destroy(state->state1, state->locks);
   state->locks = NULL;
 }
 
 static void startup5(Shizu_State2* state) {
   state->weakReferences = Shizu_WeakReferences_create(state->state1);
-  Shizu_JumpTarget jumpTarget;
-  Shizu_State1_pushJumpTarget(state->state1, &jumpTarget);
-  if (!setjmp(jumpTarget.environment)) {
-    Shizu_Gc_addObjectFinalizeHook(state->state1, state->gc, state->weakReferences, &Shizu_WeakReferenceState_notifyObjectFinalize);
-    Shizu_State1_popJumpTarget(state->state1);
-  } else {
-    Shizu_State1_popJumpTarget(state->state1);
-    Shizu_WeakReferences_destroy(state->state1, state->weakReferences);
-    state->weakReferences = NULL;
-    Shizu_State1_jump(state->state1);
-  }
 }
 
 static void shutdown5(Shizu_State2* state) {
-  Shizu_Gc_removeObjectFinalizeHook(state->state1, state->gc, state->weakReferences, &Shizu_WeakReferenceState_notifyObjectFinalize);
   Shizu_WeakReferences_destroy(state->state1, state->weakReferences);
   state->weakReferences = NULL;
 }
 
 static void startup6(Shizu_State2* state) {
+  state->strings = Shizu_Strings_create(state->state1);
+}
+
+static void shutdown6(Shizu_State2* state) {
+  Shizu_Strings_destroy(state->state1, state->strings);
+  state->strings = NULL;
+}
+
+static void startup7(Shizu_State2* state) {
   state->stack = Shizu_Stack_create(state->state1);
   Shizu_JumpTarget jumpTarget;
   Shizu_State1_pushJumpTarget(state->state1, &jumpTarget);
   if (!setjmp(jumpTarget.environment)) {
-    Shizu_Gc_addPreMarkHook(state->state1, state->gc, state->stack, &Shizu_Stack_notifyPreMark);
+    Shizu_Stack_addRootRange(state->state1, state->gc, state->stack);
     Shizu_State1_popJumpTarget(state->state1);
   } else {
     Shizu_State1_popJumpTarget(state->state1);
@@ -200,42 +174,53 @@ static void startup6(Shizu_State2* state) {
   }
 }
 
-static void shutdown6(Shizu_State2* state) {
+static void shutdown7(Shizu_State2* state) {
   size_t size;
   size = Shizu_Stack_getSize(state->state1, state->stack);
   if (size > 0) {
     fprintf(stderr, "%s: %d: warning: expected number of stack elements is %zu. received number of stack elements is %zu. Clearing stack.\n", __FILE__, __LINE__, (size_t)0, size);
     Shizu_Stack_clear(state->state1, state->stack);
   }
-  Shizu_Gc_removePreMarkHook(state->state1, state->gc, state->stack, &Shizu_Stack_notifyPreMark);
+  Shizu_Stack_removeRootRange(state->state1, state->gc, state->stack);
   Shizu_Stack_destroy(state->state1, state->stack);
   state->stack = NULL;
 }
 
-static void startup7(Shizu_State2* state) {
+static void startup8(Shizu_State2* state) {
   Shizu_Environment* globalEnvironment = Shizu_Runtime_Extensions_createEnvironment(state);
   Shizu_Object_lock(Shizu_State2_getState1(state), Shizu_State2_getLocks(state), (Shizu_Object*)globalEnvironment);
   state->globalEnvironment = globalEnvironment;
+  Shizu_JumpTarget jumpTarget;
+  Shizu_State2_pushJumpTarget(state, &jumpTarget);
+  if (!setjmp(jumpTarget.environment)) {
+    Shizu_Gc_registerProcedures(state);
+    Shizu_State2_popJumpTarget(state);
+  } else {
+    Shizu_State2_popJumpTarget(state);
+    Shizu_Object_unlock(Shizu_State2_getState1(state), Shizu_State2_getLocks(state), (Shizu_Object*)globalEnvironment);
+    state->globalEnvironment = NULL;
+    Shizu_State2_jump(state);
+  }
 }
 
-static void shutdown7(Shizu_State2* state) {
+static void shutdown8(Shizu_State2* state) {
   Shizu_Object_unlock(Shizu_State2_getState1(state), Shizu_State2_getLocks(state), (Shizu_Object*)state->globalEnvironment);
   state->globalEnvironment = NULL;
   Shizu_Gc_SweepInfo sweepInfo = { .dead = 0, .live = 0 };
   do {
     sweepInfo.dead = 0;
     sweepInfo.live = 0;
-    Shizu_Gc_run(state, Shizu_State2_getGc(state), &sweepInfo);
+    Shizu_Gc_runMajor(state, Shizu_State2_getGc(state), &sweepInfo);
   } while (sweepInfo.dead);
 }
 
-static void startup8(Shizu_State2* state) {
+static void startup9(Shizu_State2* state) {
   Shizu_List* modules = Shizu_Runtime_Extensions_createList(state);
   Shizu_Object_lock(Shizu_State2_getState1(state), Shizu_State2_getLocks(state), (Shizu_Object*)modules);
   state->modules = modules;
 }
 
-static void shutdown8(Shizu_State2* state) {
+static void shutdown9(Shizu_State2* state) {
   Shizu_JumpTarget jumpTarget;
   Shizu_State2_pushJumpTarget(state, &jumpTarget);
   if (!setjmp(jumpTarget.environment)) {
@@ -302,6 +287,10 @@ static const ComponentDescriptor g_components[] =
     .startup = &startup8,
     .shutdown = &shutdown8,
   },
+  {
+    .startup = &startup9,
+    .shutdown = &shutdown9,
+  },
 };
 
 static const size_t g_numberOfComponents = sizeof(g_components) / sizeof(ComponentDescriptor);
@@ -330,6 +319,8 @@ Shizu_State2_create
   self->gc = NULL;
   self->locks = NULL;
   self->stack = NULL;
+  self->weakReferences = NULL;
+  self->strings = NULL;
   self->globalEnvironment = NULL;
   self->modules = NULL;
 
@@ -569,6 +560,13 @@ Shizu_State2_getWeakReferences
   )
 { return self->weakReferences; }
 
+Shizu_Strings*
+Shizu_State2_getStrings
+  (
+    Shizu_State2* self
+  )
+{ return self->strings; }
+
 Shizu_Environment*
 Shizu_State2_getGlobalEnvironment
   (
@@ -580,6 +578,8 @@ typedef struct LoadModulesContext {
   Shizu_State2* state;
   Shizu_List* list;
   Shizu_String* prefix;
+  // Builds the paths of the files such that each path is copied once.
+  Shizu_StringBuilder* builder;
 } LoadModulesContext;
 
 static bool
@@ -594,8 +594,10 @@ loadModulesCallback
   Shizu_State2_pushJumpTarget(context->state, &jumpTarget);
   bool result = true;
   if (!setjmp(jumpTarget.environment)) {
-    Shizu_String* string = Shizu_String_create(context->state, bytes, numberOfBytes);
-    string = Shizu_String_concatenate(context->state, context->prefix, string);
+    Shizu_StringBuilder_clear(context->state, context->builder);
+    Shizu_StringBuilder_appendString(context->state, context->builder, context->prefix);
+    Shizu_StringBuilder_appendBytes(context->state, context->builder, bytes, numberOfBytes);
+    Shizu_String* string = Shizu_StringBuilder_toString(context->state, context->builder);
     Shizu_List_appendObject(context->state, context->list, (Shizu_Object*)string);
     Shizu_State2_popJumpTarget(context->state);
   } else {
@@ -609,6 +611,7 @@ static bool
 isModule
   (
     Shizu_State2* state,
+    Shizu_StringBuilder* builder,
     Shizu_String* path
   )
 {
@@ -618,7 +621,10 @@ isModule
     return false;
   }
   // Second level condition: Load the dll.
-  Shizu_Dl* dl = Shizu_State1_getOrLoadDl(Shizu_State2_getState1(state), Shizu_String_getBytes(state, Shizu_String_concatenate(state, path, Shizu_String_create(state, "", 1))), true);
+  Shizu_StringBuilder_clear(state, builder);
+  Shizu_StringBuilder_appendString(state, builder, path);
+  Shizu_StringBuilder_appendBytes(state, builder, "", 1);
+  Shizu_Dl* dl = Shizu_State1_getOrLoadDl(Shizu_State2_getState1(state), Shizu_String_getBytes(state, Shizu_StringBuilder_toString(state, builder)), true);
   if (!dl) {
     return false;
   }
@@ -670,11 +676,18 @@ Shizu_State2_ensureModulesLoaded
 {
   Shizu_String* workingDirectory = Shizu_getWorkingDirectory(state);
   Shizu_List* modules = Shizu_Runtime_Extensions_createList(state);
-  LoadModulesContext context = { .state = NULL, .list = NULL, .prefix = NULL };
+  Shizu_StringBuilder* builder = Shizu_StringBuilder_create(state);
+  LoadModulesContext context = { .state = NULL, .list = NULL, .prefix = NULL, .builder = NULL };
   context.state = state;
   context.list = modules;
-  context.prefix = Shizu_String_concatenate(state, workingDirectory, Shizu_String_create(state, Shizu_OperatingSystem_DirectorySeparator, strlen(Shizu_OperatingSystem_DirectorySeparator)));
-  if (idlib_enumerate_files(Shizu_String_getBytes(state, Shizu_String_concatenate(state, Shizu_getWorkingDirectory(state), Shizu_String_create(state, "", 1))),
+  context.builder = builder;
+  Shizu_StringBuilder_appendString(state, builder, workingDirectory);
+  Shizu_StringBuilder_appendBytes(state, builder, Shizu_OperatingSystem_DirectorySeparator, strlen(Shizu_OperatingSystem_DirectorySeparator));
+  context.prefix = Shizu_StringBuilder_toString(state, builder);
+  Shizu_StringBuilder_clear(state, builder);
+  Shizu_StringBuilder_appendString(state, builder, workingDirectory);
+  Shizu_StringBuilder_appendBytes(state, builder, "", 1);
+  if (idlib_enumerate_files(Shizu_String_getBytes(state, Shizu_StringBuilder_toString(state, builder)),
     &context, (idlib_enumerate_files_callback_function*)&loadModulesCallback, true, true)) {
     Shizu_State2_setStatus(state, Shizu_Status_EnvironmentFailed);
     Shizu_State2_jump(state);
@@ -682,7 +695,7 @@ Shizu_State2_ensureModulesLoaded
   size_t size = Shizu_List_getSize(state, modules);
   for (Shizu_Integer32 i = 0, n = (Shizu_Integer32)size; i < n; ++i) {
     Shizu_Value element = Shizu_List_getValue(state, modules, i);
-    if (isModule(state, (Shizu_String*)Shizu_Value_getObject(&element))) {
+    if (isModule(state, builder, (Shizu_String*)Shizu_Value_getObject(&element))) {
       Shizu_Module* module = Shizu_Module_create(state, (Shizu_String*)Shizu_Value_getObject(&element));
       Shizu_List_appendObject(state, state->modules, (Shizu_Object*)module);
       Shizu_Module_ensureLoaded(state, module);
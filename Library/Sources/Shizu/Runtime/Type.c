@@ -81,14 +81,9 @@ Shizu_Types_isSubTypeOf
     // "y" cannot be supertype of any type except of itself.
     return x == y;
   }
-  Shizu_Type const* z = x;
-  do {
-    if (z == y) {
-      break;
-    }
-    z = z->objectType.parentType;
-  } while (z);
-  return NULL != z;
+  // "x" is a sub-type of "y" if "y" is the ancestor type of "x" of the depth of "y".
+  return y->objectType.depth <= x->objectType.depth
+      && y == x->objectType.ancestors[y->objectType.depth];
 }
 
 bool
@@ -110,15 +105,9 @@ Shizu_Types_isTrueSubTypeOf
     // However, not type can be a true supertype of itself.
     return false;
   }
-
-  Shizu_Type const* z = x;
-  do {
-    if (z->objectType.parentType == y) {
-      break;
-    }
-    z = z->objectType.parentType;
-  } while (z);
-  return NULL != z;
+  // "x" is a true sub-type of "y" if "y" is the ancestor type of "x" of the depth of "y" and "x" is not "y".
+  return y->objectType.depth < x->objectType.depth
+      && y == x->objectType.ancestors[y->objectType.depth];
 }
 
 Shizu_ObjectTypeDescriptor const*
@@ -182,7 +171,39 @@ Shizu_Types_getTypeHash
     Shizu_Type* x
   )
 {
-  return x->name.hashValue;
+  return (Shizu_Integer32)x->name.hashValue;
+}
+
+size_t
+Shizu_Types_getTypeId
+  (
+    Shizu_State1* state,
+    Shizu_Types* self,
+    Shizu_Type* x
+  )
+{
+  return x->id;
+}
+
+size_t
+Shizu_Types_getTypeIdBound
+  (
+    Shizu_State1* state,
+    Shizu_Types* self
+  )
+{
+  return self->byId.size;
+}
+
+Shizu_Type*
+Shizu_Types_getTypeById
+  (
+    Shizu_State1* state,
+    Shizu_Types* self,
+    size_t id
+  )
+{
+  return id < self->byId.size ? self->byId.elements[id] : NULL;
 }
 
 Shizu_Object_Dispatch*
@@ -243,6 +264,7 @@ typedef struct Float32 {
 } Float32;
 
 static const char Float32NamedStorageNamed[] = "Shizu.Float32";
+static Shizu_NamedStorageHandle Float32NamedStorageHandle = Shizu_NamedStorageHandle_Initializer;
 
 static void
 Shizu_Float32_postCreateType
@@ -273,12 +295,13 @@ Shizu_Float32_postCreateType
     Shizu_State1_setStatus(state, Shizu_Status_AllocationFailed);
     Shizu_State1_jump(state);
   }
-  Float32* g = NULL;
-  if (Shizu_State1_getNamedStorage(state, Float32NamedStorageNamed, (void**)&g)) {
+  if (Shizu_State1_getNamedStorageHandle(state, Float32NamedStorageNamed, &Float32NamedStorageHandle)) {
     Shizu_State1_deallocateNamedStorage(state, Float32NamedStorageNamed);
+    Shizu_NamedStorageHandle_invalidate(&Float32NamedStorageHandle);
     Shizu_State1_setStatus(state, Shizu_Status_AllocationFailed);
     Shizu_State1_jump(state);
   }
+  Float32* g = Shizu_NamedStorageHandle_get(&Float32NamedStorageHandle);
   g->precision = Shizu_Float32_SignificandBits + 1;
   // W := S - P := 32 - 24 = 8 
   g->fractionBitsCount = Shizu_Float32_SignificandBits;
@@ -299,6 +322,7 @@ Shizu_Float32_postCreateType
   g->buffer.p = Shizu_State1_allocate(state, 1024 + 1);
   if (!g->buffer.p) {
     Shizu_State1_deallocateNamedStorage(state, Float32NamedStorageNamed);
+    Shizu_NamedStorageHandle_invalidate(&Float32NamedStorageHandle);
     Shizu_State1_setStatus(state, Shizu_Status_AllocationFailed);
     Shizu_State1_jump(state);
   }
@@ -311,14 +335,15 @@ Shizu_Float32_preDestroyType
     Shizu_State1* state
   )
 {
-  Float32* g = NULL;
-  if (Shizu_State1_getNamedStorage(state, Float32NamedStorageNamed, (void**)&g)) {
+  Float32* g = Shizu_NamedStorageHandle_get(&Float32NamedStorageHandle);
+  if (!g) {
     /*Unable to recover.*/
   }
   Shizu_State1_deallocate(state, g->buffer.p);
   g->buffer.p = NULL;
   g->buffer.n = 0;
   Shizu_State1_deallocateNamedStorage(state, Float32NamedStorageNamed);
+  Shizu_NamedStorageHandle_invalidate(&Float32NamedStorageHandle);
 }
 
 Shizu_definePrimitiveType(Shizu_Float32);
@@ -364,8 +389,8 @@ Shizu_Float32_getExponentBitsMask
     Shizu_State1* state
   )
 {
-  Float32* g = NULL;
-  if (Shizu_State1_getNamedStorage(state, Float32NamedStorageNamed, (void**)&g)) {
+  Float32* g = Shizu_NamedStorageHandle_get(&Float32NamedStorageHandle);
+  if (!g) {
     Shizu_State1_setStatus(state, Shizu_Status_EnvironmentFailed);
     Shizu_State1_jump(state);
   }
@@ -378,8 +403,8 @@ Shizu_Float32_getExponentBitsShift
     Shizu_State1* state
   )
 {
-  Float32* g = NULL;
-  if (Shizu_State1_getNamedStorage(state, Float32NamedStorageNamed, (void**)&g)) {
+  Float32* g = Shizu_NamedStorageHandle_get(&Float32NamedStorageHandle);
+  if (!g) {
     Shizu_State1_setStatus(state, Shizu_Status_EnvironmentFailed);
     Shizu_State1_jump(state);
   }
@@ -392,8 +417,8 @@ Shizu_Float32_getSignBitsMask
     Shizu_State1* state
   )
 {
-  Float32* g = NULL;
-  if (Shizu_State1_getNamedStorage(state, Float32NamedStorageNamed, (void**)&g)) {
+  Float32* g = Shizu_NamedStorageHandle_get(&Float32NamedStorageHandle);
+  if (!g) {
     Shizu_State1_setStatus(state, Shizu_Status_EnvironmentFailed);
     Shizu_State1_jump(state);
   }
@@ -406,8 +431,8 @@ Shizu_Float32_getSignBitsShift
     Shizu_State1* state
   )
 {
-  Float32* g = NULL;
-  if (Shizu_State1_getNamedStorage(state, Float32NamedStorageNamed, (void**)&g)) {
+  Float32* g = Shizu_NamedStorageHandle_get(&Float32NamedStorageHandle);
+  if (!g) {
     Shizu_State1_setStatus(state, Shizu_Status_EnvironmentFailed);
     Shizu_State1_jump(state);
   }
@@ -420,8 +445,8 @@ Shizu_Float32_getFractionBitsMask
     Shizu_State1* state
   )
 {
-  Float32* g = NULL;
-  if (Shizu_State1_getNamedStorage(state, Float32NamedStorageNamed, (void**)&g)) {
+  Float32* g = Shizu_NamedStorageHandle_get(&Float32NamedStorageHandle);
+  if (!g) {
     Shizu_State1_setStatus(state, Shizu_Status_EnvironmentFailed);
     Shizu_State1_jump(state);
   }
@@ -434,8 +459,8 @@ Shizu_Float32_getFractionBitsShift
     Shizu_State1* state
   )
 {
-  Float32* g = NULL;
-  if (Shizu_State1_getNamedStorage(state, Float32NamedStorageNamed, (void**)&g)) {
+  Float32* g = Shizu_NamedStorageHandle_get(&Float32NamedStorageHandle);
+  if (!g) {
     Shizu_State1_setStatus(state, Shizu_Status_EnvironmentFailed);
     Shizu_State1_jump(state);
   }
@@ -469,6 +494,7 @@ typedef struct Float64 {
 } Float64;
 
 static const char Float64NamedStorageNamed[] = "Shizu.Float64";
+static Shizu_NamedStorageHandle Float64NamedStorageHandle = Shizu_NamedStorageHandle_Initializer;
 
 static void
 Shizu_Float64_postCreateType
@@ -499,12 +525,13 @@ Shizu_Float64_postCreateType
     Shizu_State1_setStatus(state, Shizu_Status_AllocationFailed);
     Shizu_State1_jump(state);
   }
-  Float64* g = NULL;
-  if (Shizu_State1_getNamedStorage(state, Float64NamedStorageNamed, (void**)&g)) {
+  if (Shizu_State1_getNamedStorageHandle(state, Float64NamedStorageNamed, &Float64NamedStorageHandle)) {
     Shizu_State1_deallocateNamedStorage(state, Float64NamedStorageNamed);
+    Shizu_NamedStorageHandle_invalidate(&Float64NamedStorageHandle);
     Shizu_State1_setStatus(state, Shizu_Status_AllocationFailed);
     Shizu_State1_jump(state);
   }
+  Float64* g = Shizu_NamedStorageHandle_get(&Float64NamedStorageHandle);
 
   g->precision = Shizu_Float64_Precision + 1;
 
@@ -526,6 +553,7 @@ Shizu_Float64_postCreateType
   g->buffer.p = Shizu_State1_allocate(state, 1024+1);
   if (!g->buffer.p) {
     Shizu_State1_deallocateNamedStorage(state, Float64NamedStorageNamed);
+    Shizu_NamedStorageHandle_invalidate(&Float64NamedStorageHandle);
     Shizu_State1_setStatus(state, Shizu_Status_AllocationFailed);
     Shizu_State1_jump(state);
   }
@@ -538,14 +566,15 @@ Shizu_Float64_preDestroyType
     Shizu_State1* state
   )
 {
-  Float64* g = NULL;
-  if (Shizu_State1_getNamedStorage(state, Float64NamedStorageNamed, (void**)&g)) {
+  Float64* g = Shizu_NamedStorageHandle_get(&Float64NamedStorageHandle);
+  if (!g) {
     /*Unable to recover.*/
   }
   Shizu_State1_deallocate(state, g->buffer.p);
   g->buffer.p = NULL;
   g->buffer.n = 0;
   Shizu_State1_deallocateNamedStorage(state, Float64NamedStorageNamed);
+  Shizu_NamedStorageHandle_invalidate(&Float64NamedStorageHandle);
 }
 
 Shizu_definePrimitiveType(Shizu_Float64);
@@ -591,8 +620,8 @@ Shizu_Float64_getExponentBitsMask
     Shizu_State1* state
   )
 {
-  Float64* g = NULL;
-  if (Shizu_State1_getNamedStorage(state, Float64NamedStorageNamed, (void**)&g)) {
+  Float64* g = Shizu_NamedStorageHandle_get(&Float64NamedStorageHandle);
+  if (!g) {
     Shizu_State1_setStatus(state, Shizu_Status_EnvironmentFailed);
     Shizu_State1_jump(state);
   }
@@ -605,8 +634,8 @@ Shizu_Float64_getExponentBitsShift
     Shizu_State1* state
   )
 {
-  Float64* g = NULL;
-  if (Shizu_State1_getNamedStorage(state, Float64NamedStorageNamed, (void**)&g)) {
+  Float64* g = Shizu_NamedStorageHandle_get(&Float64NamedStorageHandle);
+  if (!g) {
     Shizu_State1_setStatus(state, Shizu_Status_EnvironmentFailed);
     Shizu_State1_jump(state);
   }
@@ -619,8 +648,8 @@ Shizu_Float64_getSignBitsMask
     Shizu_State1* state
   )
 {
-  Float64* g = NULL;
-  if (Shizu_State1_getNamedStorage(state, Float64NamedStorageNamed, (void**)&g)) {
+  Float64* g = Shizu_NamedStorageHandle_get(&Float64NamedStorageHandle);
+  if (!g) {
     Shizu_State1_setStatus(state, Shizu_Status_EnvironmentFailed);
     Shizu_State1_jump(state);
   }
@@ -633,8 +662,8 @@ Shizu_Float64_getSignBitsShift
     Shizu_State1* state
   )
 {
-  Float64* g = NULL;
-  if (Shizu_State1_getNamedStorage(state, Float64NamedStorageNamed, (void**)&g)) {
+  Float64* g = Shizu_NamedStorageHandle_get(&Float64NamedStorageHandle);
+  if (!g) {
     Shizu_State1_setStatus(state, Shizu_Status_EnvironmentFailed);
     Shizu_State1_jump(state);
   }
@@ -647,8 +676,8 @@ Shizu_Float64_getSignificandBitsMask
     Shizu_State1* state
   )
 {
-  Float64* g = NULL;
-  if (Shizu_State1_getNamedStorage(state, Float64NamedStorageNamed, (void**)&g)) {
+  Float64* g = Shizu_NamedStorageHandle_get(&Float64NamedStorageHandle);
+  if (!g) {
     Shizu_State1_setStatus(state, Shizu_Status_EnvironmentFailed);
     Shizu_State1_jump(state);
   }
@@ -661,8 +690,8 @@ Shizu_Float64_getSignificandBitsShift
     Shizu_State1* state
   )
 {
-  Float64* g = NULL;
-  if (Shizu_State1_getNamedStorage(state, Float64NamedStorageNamed, (void**)&g)) {
+  Float64* g = Shizu_NamedStorageHandle_get(&Float64NamedStorageHandle);
+  if (!g) {
     Shizu_State1_setStatus(state, Shizu_Status_EnvironmentFailed);
     Shizu_State1_jump(state);
   }
@@ -30,6 +30,189 @@
 
 #include "Shizu/Runtime/Object.h"
 
+// The initial capacity of the hash table of the types.
+#define Types_MinimumCapacity (8)
+
+size_t
+Shizu_Types_hashName
+  (
+    uint8_t const* bytes,
+    size_t numberOfBytes
+  )
+{
+  size_t hashValue = numberOfBytes;
+  for (size_t i = 0, n = numberOfBytes; i < n; ++i) {
+    hashValue = hashValue * 37 + (size_t)bytes[i];
+  }
+  return hashValue;
+}
+
+// Get the type of the specified name.
+// Return a pointer to the type if it exists. Return the null pointer otherwise.
+static Shizu_Type*
+Types_find
+  (
+    Shizu_Types* self,
+    size_t hashValue,
+    uint8_t const* bytes,
+    size_t numberOfBytes
+  )
+{
+  size_t mask = self->capacity - 1;
+  for (size_t i = hashValue & mask; NULL != self->elements[i].type; i = (i + 1) & mask) {
+    Shizu_TypesSlot* slot = self->elements + i;
+    if (slot->hashValue == hashValue && (size_t)slot->type->name.numberOfBytes == numberOfBytes) {
+      if (!memcmp(slot->type->name.bytes, bytes, numberOfBytes)) {
+        return slot->type;
+      }
+    }
+  }
+  return NULL;
+}
+
+// Insert a type into the hash table without checking the load factor.
+static void
+Types_insertUnchecked
+  (
+    Shizu_TypesSlot* elements,
+    size_t capacity,
+    size_t hashValue,
+    Shizu_Type* type
+  )
+{
+  size_t mask = capacity - 1;
+  size_t i = hashValue & mask;
+  while (elements[i].type) {
+    i = (i + 1) & mask;
+  }
+  elements[i].hashValue = hashValue;
+  elements[i].type = type;
+}
+
+// Ensure a type can be added to the hash table without allocating.
+static void
+Types_ensureSlotAvailable
+  (
+    Shizu_State1* state1,
+    Shizu_Types* self
+  )
+{
+  if (self->size + 1 <= self->capacity / 4 * 3) {
+    return;
+  }
+  if (self->capacity > SIZE_MAX / 2 / sizeof(Shizu_TypesSlot)) {
+    Shizu_State1_setStatus(state1, Shizu_Status_AllocationFailed);
+    Shizu_State1_jump(state1);
+  }
+  size_t newCapacity = self->capacity * 2;
+  Shizu_TypesSlot* newElements = Shizu_State1_allocate(state1, sizeof(Shizu_TypesSlot) * newCapacity);
+  if (!newElements) {
+    Shizu_State1_setStatus(state1, Shizu_Status_AllocationFailed);
+    Shizu_State1_jump(state1);
+  }
+  for (size_t i = 0; i < newCapacity; ++i) {
+    newElements[i].hashValue = 0;
+    newElements[i].type = NULL;
+  }
+  for (size_t i = 0, n = self->capacity; i < n; ++i) {
+    if (self->elements[i].type) {
+      Types_insertUnchecked(newElements, newCapacity, self->elements[i].hashValue, self->elements[i].type);
+    }
+  }
+  Shizu_State1_deallocate(state1, self->elements);
+  self->elements = newElements;
+  self->capacity = newCapacity;
+}
+
+// Add a type to the hash table.
+// Types_ensureSlotAvailable must have been invoked before.
+static void
+Types_insert
+  (
+    Shizu_Types* self,
+    Shizu_Type* type
+  )
+{
+  Types_insertUnchecked(self->elements, self->capacity, type->name.hashValue, type);
+  self->size++;
+}
+
+// Remove the type in the slot of the specified index from the hash table.
+// The following types of the cluster are shifted backwards such that no tombstones are required.
+static void
+Types_removeAt
+  (
+    Shizu_Types* self,
+    size_t i
+  )
+{
+  size_t mask = self->capacity - 1;
+  size_t j = i;
+  while (true) {
+    j = (j + 1) & mask;
+    if (!self->elements[j].type) {
+      break;
+    }
+    // The type in slot j can be moved to slot i if its home slot k is not cyclically in (i, j].
+    size_t k = self->elements[j].hashValue & mask;
+    if ((j > i && (k <= i || k > j)) || (j < i && (k <= i && k > j))) {
+      self->elements[i] = self->elements[j];
+      i = j;
+    }
+  }
+  self->elements[i].hashValue = 0;
+  self->elements[i].type = NULL;
+  self->size--;
+}
+
+// Fail if a type of the specified name exists.
+static void
+Types_ensureNameUnused
+  (
+    Shizu_State1* state1,
+    Shizu_Types* self,
+    size_t hashValue,
+    char const* bytes,
+    size_t numberOfBytes
+  )
+{
+  if (Types_find(self, hashValue, (uint8_t const*)bytes, numberOfBytes)) {
+    fprintf(stderr, "%s:%d: a type of name `%.*s` was already registered\n", __FILE__, __LINE__, (int)numberOfBytes, bytes);
+    /// @todo Add and use Shizu_Status_TypeExists.
+    Shizu_State1_setStatus(state1, 1/*Shizu_Status_TypeExists*/);
+    Shizu_State1_jump(state1);
+  }
+}
+
+// Allocate a type and its name.
+// The type is not added to the hash table.
+static Shizu_Type*
+Types_allocateType
+  (
+    Shizu_State1* state1,
+    Shizu_Types* self,
+    size_t hashValue,
+    char const* bytes,
+    size_t numberOfBytes
+  )
+{
+  if (numberOfBytes > Shizu_Integer32_Maximum || numberOfBytes > SIZE_MAX - sizeof(Shizu_Type)) {
+    Shizu_State1_setStatus(state1, Shizu_Status_ArgumentValueInvalid);
+    Shizu_State1_jump(state1);
+  }
+  Shizu_Type* type = Shizu_State1_allocate(state1, sizeof(Shizu_Type) + numberOfBytes);
+  if (!type) {
+    fprintf(stderr, "%s:%d: allocation of `%zu` Bytes failed\n", __FILE__, __LINE__, sizeof(Shizu_Type) + numberOfBytes);
+    Shizu_State1_setStatus(state1, Shizu_Status_AllocationFailed);
+    Shizu_State1_jump(state1);
+  }
+  type->name.bytes = (uint8_t*)(type + 1);
+  memcpy(type->name.bytes, bytes, numberOfBytes);
+  type->name.hashValue = hashValue;
+  type->name.numberOfBytes = (Shizu_Integer32)numberOfBytes;
+  return type;
+}
+
 Shizu_Types*
 Shizu_Types_startup
   (
@@ -72,16 +255,20 @@ Shizu_Types_initialize
     Shizu_Types* self
   )
 {
-  self->elements = Shizu_State1_allocate(state1, sizeof(Shizu_Type) * 8);
+  self->elements = Shizu_State1_allocate(state1, sizeof(Shizu_TypesSlot) * Types_MinimumCapacity);
   if (!self->elements) {
     Shizu_State1_setStatus(state1, Shizu_Status_AllocationFailed);
     Shizu_State1_jump(state1);
   }
-  for (size_t i = 0, n = 8; i < n; ++i) {
-    self->elements[i] = NULL;
+  for (size_t i = 0, n = Types_MinimumCapacity; i < n; ++i) {
+    self->elements[i].hashValue = 0;
+    self->elements[i].type = NULL;
   }
   self->size = 0;
-  self->capacity = 8;
+  self->capacity = Types_MinimumCapacity;
+  self->byId.elements = NULL;
+  self->byId.size = 0;
+  self->byId.capacity = 0;
 }
 
 void
@@ -94,38 +281,40 @@ Shizu_Types_uninitialize
   // Uninitialize all dispatches such that
   // the dispatch of a child type is uninitialized before the dispatch of its parent type.
   for (size_t i = 0, n = self->capacity; i < n; ++i) {
-    Shizu_Type* type = self->elements[i];
-    while (type) {
+    Shizu_Type* type = self->elements[i].type;
+    if (type) {
       Shizu_Types_ensureDispatchUninitialized(state1, self, type);
-      type = type->next;
     }
   }
   while (self->size) {
-    // Worst-case is k^n where n is the number of types and k is the capacity.
-    // Do *no*u use this in performance critical code.
-    for (size_t i = 0, n = self->capacity; i < n; ++i) {
-      Shizu_Type** previous = &(self->elements[i]);
-      Shizu_Type* current = self->elements[i];
-      while (current) {
-        if (!Shizu_Types_getTypeChildCount(state1, self, current)) {
-          if (0 != (Shizu_TypeFlags_DispatchInitialized & current->flags)) {
-            fprintf(stderr, "%s:%d: unreachable code reached\n", __FILE__, __LINE__);
-          }
-          Shizu_Type* type = current;
-          *previous = current->next;
-          current = current->next;
-          self->size--;
-          if (type->typeDestroyed) {
-            type->typeDestroyed(state1);
-          }
-          Shizu_Type_destroy(state1, self, type);
-        } else {
-          previous = &current->next;
-          current = current->next;
+    // Worst-case is n^2 where n is the number of types.
+    // Do *not* use this in performance critical code.
+    for (size_t i = 0, n = self->capacity; i < n; ) {
+      Shizu_Type* type = self->elements[i].type;
+      if (type && !Shizu_Types_getTypeChildCount(state1, self, type)) {
+        if (0 != (Shizu_TypeFlags_DispatchInitialized & type->flags)) {
+          fprintf(stderr, "%s:%d: unreachable code reached\n", __FILE__, __LINE__);
+        }
+        // Another type might be shifted into this slot: Do not advance.
+        Types_removeAt(self, i);
+        if (type->typeDestroyed) {
+          type->typeDestroyed(state1);
         }
+        Shizu_Type_destroy(state1, self, type);
+      } else {
+        ++i;
       }
     }
   }
+  Shizu_State1_deallocate(state1, self->elements);
+  self->elements = NULL;
+  self->capacity = 0;
+  if (self->byId.elements) {
+    Shizu_State1_deallocate(state1, self->byId.elements);
+    self->byId.elements = NULL;
+  }
+  self->byId.size = 0;
+  self->byId.capacity = 0;
 }
 
 void
@@ -251,6 +440,201 @@ Shizu_Types_ensureDispatchInitialized
   type->flags |= Shizu_TypeFlags_DispatchInitialized;
 }
 
+// Deallocate the arrays of reference fields, visit callbacks, finalize callbacks, and ancestor types of an object type.
+static void
+ObjectTypeNode_uninitializeTables
+  (
+    Shizu_State1* state1,
+    Shizu_Type* type
+  )
+{
+  if (type->objectType.finalizers.elements) {
+    Shizu_State1_deallocate(state1, type->objectType.finalizers.elements);
+    type->objectType.finalizers.elements = NULL;
+  }
+  type->objectType.finalizers.size = 0;
+  if (type->objectType.visitors.elements) {
+    Shizu_State1_deallocate(state1, type->objectType.visitors.elements);
+    type->objectType.visitors.elements = NULL;
+  }
+  type->objectType.visitors.size = 0;
+  if (type->objectType.fields.elements) {
+    Shizu_State1_deallocate(state1, type->objectType.fields.elements);
+    type->objectType.fields.elements = NULL;
+  }
+  type->objectType.fields.size = 0;
+  if (type->objectType.ancestors) {
+    Shizu_State1_deallocate(state1, type->objectType.ancestors);
+    type->objectType.ancestors = NULL;
+  }
+  type->objectType.depth = 0;
+}
+
+// Compute the arrays of reference fields, visit callbacks, finalize callbacks, and ancestor types of an object type
+// from its descriptor and the arrays of its parent type.
+// Return Shizu_Status_NoError on success and an error status on failure.
+static Shizu_Status
+ObjectTypeNode_initializeTables
+  (
+    Shizu_State1* state1,
+    Shizu_Type* type
+  )
+{
+  Shizu_ObjectTypeDescriptor const* descriptor = type->objectType.descriptor;
+  Shizu_Type* parentType = type->objectType.parentType;
+  type->objectType.fields.elements = NULL;
+  type->objectType.fields.size = 0;
+  type->objectType.visitors.elements = NULL;
+  type->objectType.visitors.size = 0;
+  type->objectType.finalizers.elements = NULL;
+  type->objectType.finalizers.size = 0;
+  type->objectType.depth = 0;
+  type->objectType.ancestors = NULL;
+  // Validate the fields: Each field must be within the object and must not overlap with the Shizu_Object header.
+  if (descriptor->numberOfFields && !descriptor->fields) {
+    return Shizu_Status_ArgumentValueInvalid;
+  }
+  for (size_t i = 0, n = descriptor->numberOfFields; i < n; ++i) {
+    Shizu_ObjectTypeField const* field = descriptor->fields + i;
+    size_t fieldSize;
+    switch (field->kind) {
+      case Shizu_ObjectTypeFieldKind_Object: {
+        fieldSize = sizeof(Shizu_Object*);
+      } break;
+      case Shizu_ObjectTypeFieldKind_Value: {
+        fieldSize = sizeof(Shizu_Value);
+      } break;
+      default: {
+        return Shizu_Status_ArgumentValueInvalid;
+      } break;
+    };
+    if (field->offset < sizeof(Shizu_Object) || field->offset > descriptor->size || descriptor->size - field->offset < fieldSize) {
+      return Shizu_Status_ArgumentValueInvalid;
+    }
+  }
+  size_t numberOfFields = descriptor->numberOfFields + (parentType ? parentType->objectType.fields.size : 0);
+  size_t numberOfVisitors = (descriptor->visit ? 1 : 0) + (parentType ? parentType->objectType.visitors.size : 0);
+  size_t numberOfFinalizers = (descriptor->finalize ? 1 : 0) + (parentType ? parentType->objectType.finalizers.size : 0);
+  size_t depth = parentType ? parentType->objectType.depth + 1 : 0;
+  type->objectType.ancestors = Shizu_State1_allocate(state1, sizeof(Shizu_Type*) * (depth + 1));
+  if (!type->objectType.ancestors) {
+    return Shizu_Status_AllocationFailed;
+  }
+  for (size_t i = 0; i < depth; ++i) {
+    type->objectType.ancestors[i] = parentType->objectType.ancestors[i];
+  }
+  type->objectType.ancestors[depth] = type;
+  type->objectType.depth = depth;
+  if (numberOfFields) {
+    type->objectType.fields.elements = Shizu_State1_allocate(state1, sizeof(Shizu_ObjectTypeField) * numberOfFields);
+    if (!type->objectType.fields.elements) {
+      ObjectTypeNode_uninitializeTables(state1, type);
+      return Shizu_Status_AllocationFailed;
+    }
+  }
+  if (numberOfVisitors) {
+    type->objectType.visitors.elements = Shizu_State1_allocate(state1, sizeof(Shizu_OnVisitCallback*) * numberOfVisitors);
+    if (!type->objectType.visitors.elements) {
+      ObjectTypeNode_uninitializeTables(state1, type);
+      return Shizu_Status_AllocationFailed;
+    }
+  }
+  if (numberOfFinalizers) {
+    type->objectType.finalizers.elements = Shizu_State1_allocate(state1, sizeof(Shizu_ObjectTypeFinalizer) * numberOfFinalizers);
+    if (!type->objectType.finalizers.elements) {
+      ObjectTypeNode_uninitializeTables(state1, type);
+      return Shizu_Status_AllocationFailed;
+    }
+  }
+  for (size_t i = 0, n = descriptor->numberOfFields; i < n; ++i) {
+    type->objectType.fields.elements[type->objectType.fields.size++] = descriptor->fields[i];
+  }
+  if (descriptor->visit) {
+    type->objectType.visitors.elements[type->objectType.visitors.size++] = descriptor->visit;
+  }
+  if (descriptor->finalize) {
+    Shizu_ObjectTypeFinalizer* finalizer = type->objectType.finalizers.elements + type->objectType.finalizers.size++;
+    finalizer->type = type;
+    finalizer->finalize = descriptor->finalize;
+  }
+  if (parentType) {
+    for (size_t i = 0, n = parentType->objectType.fields.size; i < n; ++i) {
+      type->objectType.fields.elements[type->objectType.fields.size++] = parentType->objectType.fields.elements[i];
+    }
+    for (size_t i = 0, n = parentType->objectType.visitors.size; i < n; ++i) {
+      type->objectType.visitors.elements[type->objectType.visitors.size++] = parentType->objectType.visitors.elements[i];
+    }
+    for (size_t i = 0, n = parentType->objectType.finalizers.size; i < n; ++i) {
+      type->objectType.finalizers.elements[type->objectType.finalizers.size++] = parentType->objectType.finalizers.elements[i];
+    }
+  }
+  return Shizu_Status_NoError;
+}
+
+// Ensure an ID can be assigned to a type without allocating.
+static void
+Types_ensureIdAvailable
+  (
+    Shizu_State1* state1,
+    Shizu_Types* self
+  )
+{
+  if (self->byId.size < self->byId.capacity) {
+    return;
+  }
+  for (size_t i = 0, n = self->byId.size; i < n; ++i) {
+    if (!self->byId.elements[i]) {
+      return;
+    }
+  }
+  size_t newCapacity = self->byId.capacity ? self->byId.capacity * 2 : 8;
+  if (newCapacity <= self->byId.capacity || newCapacity > SIZE_MAX / sizeof(Shizu_Type*)) {
+    Shizu_State1_setStatus(state1, Shizu_Status_AllocationFailed);
+    Shizu_State1_jump(state1);
+  }
+  Shizu_Type** newElements = Shizu_State1_reallocate(state1, self->byId.elements, newCapacity * sizeof(Shizu_Type*));
+  if (!newElements) {
+    Shizu_State1_setStatus(state1, Shizu_Status_AllocationFailed);
+    Shizu_State1_jump(state1);
+  }
+  self->byId.elements = newElements;
+  self->byId.capacity = newCapacity;
+}
+
+// Assign the least unused ID to a type.
+// Types_ensureIdAvailable must have been invoked before.
+static void
+Types_assignId
+  (
+    Shizu_Types* self,
+    Shizu_Type* type
+  )
+{
+  size_t id = 0;
+  while (id < self->byId.size && self->byId.elements[id]) {
+    id++;
+  }
+  if (id == self->byId.size) {
+    self->byId.size++;
+  }
+  self->byId.elements[id] = type;
+  type->id = id;
+}
+
+// Release the ID of a type.
+static void
+Types_releaseId
+  (
+    Shizu_Types* self,
+    Shizu_Type* type
+  )
+{
+  self->byId.elements[type->id] = NULL;
+  while (self->byId.size && !self->byId.elements[self->byId.size - 1]) {
+    self->byId.size--;
+  }
+}
+
 void
 Shizu_Type_destroy
   (
@@ -259,6 +643,7 @@ Shizu_Type_destroy
     Shizu_Type* type
   )
 {
+  Types_releaseId(self, type);
   Shizu_Types_onPreDestroyType(state1, self, type);
   if (Shizu_TypeFlags_ObjectType == (Shizu_TypeFlags_ObjectType & type->flags)) {
     // Remove this type from the array of references to child types of its parent type.
@@ -267,10 +652,9 @@ Shizu_Type_destroy
     }
     // Deallocate array of references to children.
     SmallTypeArray_uninitialize(&type->objectType.children);
+    // Deallocate the arrays of reference fields, visit callbacks, finalize callbacks, and ancestor types.
+    ObjectTypeNode_uninitializeTables(state1, type);
   }
-  // Deallocate the name.
-  Shizu_State1_deallocate(state1, type->name.bytes);
-  type->name.bytes = NULL;
   //
   if (type->dl) {
     Shizu_State1_unrefDl(state1, type->dl);
@@ -303,19 +687,11 @@ Shizu_Types_getTypeByName
     Shizu_Integer32 numberOfBytes
   )
 {
-  Shizu_Integer32 hashValue = numberOfBytes;
-  for (Shizu_Integer32 i = 0, n = numberOfBytes; i < n; ++i) {
-    hashValue = hashValue * 37 + (Shizu_Integer32)bytes[i];
-  }
-  Shizu_Integer32 hashIndex = (hashValue & (0x7FFFFFFF)) % self->capacity;
-  for (Shizu_Type* type = self->elements[hashIndex]; NULL != type; type = type->next) {
-    if (type->name.hashValue == hashValue && type->name.numberOfBytes == numberOfBytes) {
-      if (!memcmp(type->name.bytes, bytes, (size_t)numberOfBytes)) {
-        return type;
-      }
-    }
+  if (numberOfBytes < 0) {
+    return NULL;
   }
-  return NULL;
+  size_t hashValue = Shizu_Types_hashName(bytes, (size_t)numberOfBytes);
+  return Types_find(self, hashValue, bytes, (size_t)numberOfBytes);
 }
 
 Shizu_Type*
@@ -331,38 +707,11 @@ Shizu_Types_createObjectType
     Shizu_ObjectTypeDescriptor const* typeDescriptor
   )
 {
-  size_t hashValue = numberOfBytes;
-  for (size_t i = 0, n = numberOfBytes; i < n; ++i) {
-    hashValue = hashValue * 37 + (size_t)bytes[i];
-  }
-  size_t hashIndex = hashValue % self->capacity;
-  for (Shizu_Type* type = self->elements[hashIndex]; NULL != type; type = type->next) {
-    if (type->name.hashValue == hashValue && type->name.numberOfBytes == numberOfBytes) {
-      if (!memcmp(type->name.bytes, bytes, numberOfBytes)) {
-        fprintf(stderr, "%s:%d: a type of name `%.*s` was already registered\n", __FILE__, __LINE__, (int)numberOfBytes, bytes);
-        /// @todo Add and use Shizu_Status_TypeExists.
-        Shizu_State1_setStatus(state1, 1/*Shizu_Status_TypeExists*/);
-        Shizu_State1_jump(state1);
-      }
-    }
-  }
-  Shizu_Type* type = Shizu_State1_allocate(state1, sizeof(Shizu_Type));
-  if (!type) {
-    fprintf(stderr, "%s:%d: allocation of `%zu` Bytes failed\n", __FILE__, __LINE__, sizeof(Shizu_Type));
-    Shizu_State1_setStatus(state1, Shizu_Status_AllocationFailed);
-    Shizu_State1_jump(state1);
-  }
-  type->name.bytes = Shizu_State1_allocate(state1, numberOfBytes);
-  if (!type->name.bytes) {
-    Shizu_State1_deallocate(state1, type);
-    type = NULL;
-    Shizu_State1_setStatus(state1, Shizu_Status_AllocationFailed);
-    Shizu_State1_jump(state1);
-  }
-  memcpy(type->name.bytes, bytes, numberOfBytes);
-  type->name.hashValue = hashValue;
-  type->name.numberOfBytes = numberOfBytes;
-  type->next = NULL;
+  size_t hashValue = Shizu_Types_hashName((uint8_t const*)bytes, numberOfBytes);
+  Types_ensureNameUnused(state1, self, hashValue, bytes, numberOfBytes);
+  Types_ensureSlotAvailable(state1, self);
+  Types_ensureIdAvailable(state1, self);
+  Shizu_Type* type = Types_allocateType(state1, self, hashValue, bytes, numberOfBytes);
   type->flags = Shizu_TypeFlags_ObjectType;
   type->typeDestroyed = typeDestroyed;
   type->dl = dl;
@@ -373,10 +722,22 @@ Shizu_Types_createObjectType
   type->objectType.dispatch = NULL;
   type->objectType.parentType = parentType;
   type->objectType.descriptor = typeDescriptor;
+  type->objectType.freed.collection = 0;
+  type->objectType.freed.objects = 0;
+  type->objectType.freed.bytes = 0;
+  // Compute the arrays of reference fields, visit callbacks, and finalize callbacks.
+  Shizu_Status status = ObjectTypeNode_initializeTables(state1, type);
+  if (status) {
+    if (Shizu_Status_ArgumentValueInvalid == status) {
+      fprintf(stderr, "%s:%d: the fields of the type `%.*s` are invalid\n", __FILE__, __LINE__, (int)numberOfBytes, bytes);
+    }
+    Shizu_State1_deallocate(state1, type);
+    Shizu_State1_setStatus(state1, status);
+    Shizu_State1_jump(state1);
+  }
   // Allocate array for references to children.
   if (SmallTypeArray_initialize(&type->objectType.children)) {
-    Shizu_State1_deallocate(state1, type->name.bytes);
-    type->name.bytes = NULL;
+    ObjectTypeNode_uninitializeTables(state1, type);
     Shizu_State1_deallocate(state1, type);
     Shizu_State1_setStatus(state1, Shizu_Status_AllocationFailed);
     Shizu_State1_jump(state1);
@@ -384,17 +745,15 @@ Shizu_Types_createObjectType
   // Add this type to the array of references to children of its parent type.
   if (parentType) {
     if (SmallTypeArray_append(&parentType->objectType.children, type)) {
-      SmallTypeArray_uninitialize(&parentType->objectType.children);
-      Shizu_State1_deallocate(state1, type->name.bytes);
-      type->name.bytes = NULL;
+      SmallTypeArray_uninitialize(&type->objectType.children);
+      ObjectTypeNode_uninitializeTables(state1, type);
       Shizu_State1_deallocate(state1, type);
       Shizu_State1_setStatus(state1, Shizu_Status_AllocationFailed);
       Shizu_State1_jump(state1);
     }
   }
-  type->next = self->elements[hashIndex];
-  self->elements[hashIndex] = type;
-  self->size++;
+  Types_assignId(self, type);
+  Types_insert(self, type);
 
   Shizu_Types_onPostCreateType(state1, self, type);
 
@@ -413,38 +772,11 @@ Shizu_Types_createEnumerationType
     Shizu_EnumerationTypeDescriptor const* typeDescriptor
   )
 {
-  size_t hashValue = numberOfBytes;
-  for (size_t i = 0, n = numberOfBytes; i < n; ++i) {
-    hashValue = hashValue * 37 + (size_t)bytes[i];
-  }
-  size_t hashIndex = hashValue % self->capacity;
-  for (Shizu_Type* type = self->elements[hashIndex]; NULL != type; type = type->next) {
-    if (type->name.hashValue == hashValue && type->name.numberOfBytes == numberOfBytes) {
-      if (!memcmp(type->name.bytes, bytes, numberOfBytes)) {
-        fprintf(stderr, "%s:%d: a type of name `%.*s` was already registered\n", __FILE__, __LINE__, (int)numberOfBytes, bytes);
-        /// @todo Add and use Shizu_Status_TypeExists.
-        Shizu_State1_setStatus(state1, 1/*Shizu_Status_TypeExists*/);
-        Shizu_State1_jump(state1);
-      }
-    }
-  }
-  Shizu_Type* type = Shizu_State1_allocate(state1, sizeof(Shizu_Type));
-  if (!type) {
-    fprintf(stderr, "%s:%d: allocation of `%zu` Bytes failed\n", __FILE__, __LINE__, sizeof(Shizu_Type));
-    Shizu_State1_setStatus(state1, Shizu_Status_AllocationFailed);
-    Shizu_State1_jump(state1);
-  }
-  type->name.bytes = Shizu_State1_allocate(state1, numberOfBytes);
-  if (!type->name.bytes) {
-    Shizu_State1_deallocate(state1, type);
-    type = NULL;
-    Shizu_State1_setStatus(state1, Shizu_Status_AllocationFailed);
-    Shizu_State1_jump(state1);
-  }
-  memcpy(type->name.bytes, bytes, numberOfBytes);
-  type->name.hashValue = hashValue;
-  type->name.numberOfBytes = numberOfBytes;
-  type->next = NULL;
+  size_t hashValue = Shizu_Types_hashName((uint8_t const*)bytes, numberOfBytes);
+  Types_ensureNameUnused(state1, self, hashValue, bytes, numberOfBytes);
+  Types_ensureSlotAvailable(state1, self);
+  Types_ensureIdAvailable(state1, self);
+  Shizu_Type* type = Types_allocateType(state1, self, hashValue, bytes, numberOfBytes);
   type->flags = Shizu_TypeFlags_EnumerationType;
   type->typeDestroyed = typeDestroyed;
   type->dl = dl;
@@ -454,9 +786,8 @@ Shizu_Types_createEnumerationType
 
   type->enumerationType.descriptor = typeDescriptor;
 
-  type->next = self->elements[hashIndex];
-  self->elements[hashIndex] = type;
-  self->size++;
+  Types_assignId(self, type);
+  Types_insert(self, type);
 
   Shizu_Types_onPostCreateType(state1, self, type);
 
@@ -475,38 +806,11 @@ Shizu_Types_createPrimitiveType
     Shizu_PrimitiveTypeDescriptor const* typeDescriptor
   )
 {
-  size_t hashValue = numberOfBytes;
-  for (size_t i = 0, n = numberOfBytes; i < n; ++i) {
-    hashValue = hashValue * 37 + (size_t)bytes[i];
-  }
-  size_t hashIndex = hashValue % self->capacity;
-  for (Shizu_Type* type = self->elements[hashIndex]; NULL != type; type = type->next) {
-    if (type->name.hashValue == hashValue && type->name.numberOfBytes == numberOfBytes) {
-      if (!memcmp(type->name.bytes, bytes, numberOfBytes)) {
-        fprintf(stderr, "%s:%d: a type of name `%.*s` was already registered\n", __FILE__, __LINE__, (int)numberOfBytes, bytes);
-        /// @todo Add and use Shizu_Status_TypeExists.
-        Shizu_State1_setStatus(state1, 1/*Shizu_Status_TypeExists*/);
-        Shizu_State1_jump(state1);
-      }
-    }
-  }
-  Shizu_Type* type = Shizu_State1_allocate(state1, sizeof(Shizu_Type));
-  if (!type) {
-    fprintf(stderr, "%s:%d: allocation of `%zu` Bytes failed\n", __FILE__, __LINE__, sizeof(Shizu_Type));
-    Shizu_State1_setStatus(state1, Shizu_Status_AllocationFailed);
-    Shizu_State1_jump(state1);
-  }
-  type->name.bytes = Shizu_State1_allocate(state1, numberOfBytes);
-  if (!type->name.bytes) {
-    Shizu_State1_deallocate(state1, type);
-    type = NULL;
-    Shizu_State1_setStatus(state1, Shizu_Status_AllocationFailed);
-    Shizu_State1_jump(state1);
-  }
-  memcpy(type->name.bytes, bytes, numberOfBytes);
-  type->name.hashValue = hashValue;
-  type->name.numberOfBytes = numberOfBytes;
-  type->next = NULL;
+  size_t hashValue = Shizu_Types_hashName((uint8_t const*)bytes, numberOfBytes);
+  Types_ensureNameUnused(state1, self, hashValue, bytes, numberOfBytes);
+  Types_ensureSlotAvailable(state1, self);
+  Types_ensureIdAvailable(state1, self);
+  Shizu_Type* type = Types_allocateType(state1, self, hashValue, bytes, numberOfBytes);
   type->flags = Shizu_TypeFlags_PrimitiveType;
   type->typeDestroyed = typeDestroyed;
   type->dl = dl;
@@ -516,9 +820,8 @@ Shizu_Types_createPrimitiveType
 
   type->primitiveType.descriptor = typeDescriptor;
 
-  type->next = self->elements[hashIndex];
-  self->elements[hashIndex] = type;
-  self->size++;
+  Types_assignId(self, type);
+  Types_insert(self, type);
 
   Shizu_Types_onPostCreateType(state1, self, type);
 
@@ -58,305 +58,10 @@ hashBytes
   return h;
 }
 
-Shizu_Boolean
-Shizu_Value_getBoolean
-  (
-    Shizu_Value const* self
-  )
-{
-  Shizu_Cxx_Debug_assert(Shizu_Value_isBoolean(self));
-  return self->booleanValue;
-}
-
-bool
-Shizu_Value_isBoolean
-  (
-    Shizu_Value const* self
-  )
-{
-  Shizu_Cxx_Debug_assert(NULL != self);
-  return Shizu_Value_Tag_Boolean == self->tag;
-}
-
-void
-Shizu_Value_setBoolean
-  (
-    Shizu_Value* self,
-    Shizu_Boolean booleanValue
-  )
-{
-  Shizu_Cxx_Debug_assert(NULL != self);
-  self->booleanValue = booleanValue;
-  self->tag = Shizu_Value_Tag_Boolean;
-}
-
-Shizu_CxxFunction*
-Shizu_Value_getCxxFunction
-  (
-    Shizu_Value const* self
-  )
-{
-  Shizu_Cxx_Debug_assert(Shizu_Value_isCxxFunction(self));
-  return self->cxxFunctionValue;
-}
-
-bool
-Shizu_Value_isCxxFunction
-  (
-    Shizu_Value const* self
-  )
-{
-  Shizu_Cxx_Debug_assert(NULL != self);
-  return Shizu_Value_Tag_CxxFunction == self->tag;
-}
-
-void
-Shizu_Value_setCxxFunction
-  (
-    Shizu_Value* self,
-    Shizu_CxxFunction* cxxFunctionValue
-  )
-{
-  Shizu_Cxx_Debug_assert(NULL != self);
-  Shizu_Cxx_Debug_assert(NULL != cxxFunctionValue);
-  self->cxxFunctionValue = cxxFunctionValue;
-  self->tag = Shizu_Value_Tag_CxxFunction;
-}
-
-Shizu_Float32
-Shizu_Value_getFloat32
-  (
-    Shizu_Value const* self
-  )
-{
-  Shizu_Cxx_Debug_assert(Shizu_Value_isFloat32(self));
-  return self->float32Value;
-}
-
-bool
-Shizu_Value_isFloat32
-  (
-    Shizu_Value const* self
-  )
-{
-  Shizu_Cxx_Debug_assert(NULL != self);
-  return Shizu_Value_Tag_Float32 == self->tag;
-}
-
-void
-Shizu_Value_setFloat32
-  (
-    Shizu_Value* self,
-    Shizu_Float32 float32Value
-  )
-{
-  Shizu_Cxx_Debug_assert(NULL != self);
-  self->float32Value = float32Value;
-  self->tag = Shizu_Value_Tag_Float32;
-}
-
-#if 1 == Shizu_Configuration_WithFloat64
-
-Shizu_Float64
-Shizu_Value_getFloat64
-  (
-    Shizu_Value const* self
-  )
-{
-  Shizu_Cxx_Debug_assert(Shizu_Value_isFloat64(self));
-  return self->float64Value;
-}
-
-bool
-Shizu_Value_isFloat64
-  (
-    Shizu_Value const* self
-  )
-{
-  Shizu_Cxx_Debug_assert(NULL != self);
-  return Shizu_Value_Tag_Float64 == self->tag;
-}
-
-void
-Shizu_Value_setFloat64
-  (
-    Shizu_Value* self,
-    Shizu_Float64 float64Value
-  )
-{
-  Shizu_Cxx_Debug_assert(NULL != self);
-  self->float64Value = float64Value;
-  self->tag = Shizu_Value_Tag_Float64;
-}
-
+#if 0 == Shizu_Configuration_WithInlineValueAccessors
+  #include "Shizu/Runtime/Value.inline.h"
 #endif
 
-Shizu_Integer32
-Shizu_Value_getInteger32
-  (
-    Shizu_Value const* self
-  )
-{
-  Shizu_Cxx_Debug_assert(Shizu_Value_isInteger32(self));
-  return self->integer32Value;
-}
-
-bool
-Shizu_Value_isInteger32
-  (
-    Shizu_Value const* self
-  )
-{
-  Shizu_Cxx_Debug_assert(NULL != self);
-  return Shizu_Value_Tag_Integer32 == self->tag;
-}
-
-void
-Shizu_Value_setInteger32
-  (
-    Shizu_Value* self,
-    Shizu_Integer32 integer32Value
-  )
-{
-  Shizu_Cxx_Debug_assert(NULL != self);
-  self->integer32Value = integer32Value;
-  self->tag = Shizu_Value_Tag_Integer32;
-}
-
-#if 1 == Shizu_Configuration_WithInteger64
-
-Shizu_Integer64
-Shizu_Value_getInteger64
-  (
-    Shizu_Value const* self
-  )
-{
-  Shizu_Cxx_Debug_assert(Shizu_Value_isInteger64(self));
-  return self->integer64Value;
-}
-
-bool
-Shizu_Value_isInteger64
-  (
-    Shizu_Value const* self
-  )
-{
-  Shizu_Cxx_Debug_assert(NULL != self);
-  return Shizu_Value_Tag_Integer64 == self->tag;
-}
-
-void
-Shizu_Value_setInteger64
-  (
-    Shizu_Value* self,
-    Shizu_Integer64 integer64Value
-  )
-{
-  Shizu_Cxx_Debug_assert(NULL != self);
-  self->integer64Value = integer64Value;
-  self->tag = Shizu_Value_Tag_Integer64;
-}
-
-#endif
-
-Shizu_Object*
-Shizu_Value_getObject
-  (
-    Shizu_Value const* self
-  )
-{
-  Shizu_Cxx_Debug_assert(Shizu_Value_isObject(self));
-  return self->objectValue;
-}
-
-bool
-Shizu_Value_isObject
-  (
-    Shizu_Value const* self
-  )
-{
-  Shizu_Cxx_Debug_assert(NULL != self);
-  return Shizu_Value_Tag_Object == self->tag;
-}
-
-void
-Shizu_Value_setObject
-  (
-    Shizu_Value* self,
-    Shizu_Object* objectValue
-  )
-{
-  Shizu_Cxx_Debug_assert(NULL != self);
-  Shizu_Cxx_Debug_assert(NULL != objectValue);
-  self->objectValue = objectValue;
-  self->tag = Shizu_Value_Tag_Object;
-}
-
-Shizu_Type*
-Shizu_Value_getType
-  (
-    Shizu_Value const* self
-  )
-{
-  Shizu_Cxx_Debug_assert(Shizu_Value_isType(self));
-  return self->typeValue;
-}
-
-bool
-Shizu_Value_isType
-  (
-    Shizu_Value const* self
-  )
-{
-  Shizu_Cxx_Debug_assert(NULL != self);
-  return Shizu_Value_Tag_Type == self->tag;
-}
-
-void
-Shizu_Value_setType
-  (
-    Shizu_Value* self,
-    Shizu_Type* typeValue
-  )
-{
-  Shizu_Cxx_Debug_assert(NULL != self);
-  Shizu_Cxx_Debug_assert(NULL != typeValue);
-  self->typeValue = typeValue;
-  self->tag = Shizu_Value_Tag_Type;
-}
-
-Shizu_Void
-Shizu_Value_getVoid
-  (
-    Shizu_Value const* self
-  )
-{
-  Shizu_Cxx_Debug_assert(Shizu_Value_isVoid(self));
-  return self->voidValue;
-}
-
-bool
-Shizu_Value_isVoid
-  (
-    Shizu_Value const* self
-  )
-{
-  Shizu_Cxx_Debug_assert(NULL != self);
-  return Shizu_Value_Tag_Void == self->tag;
-}
-
-void
-Shizu_Value_setVoid
-  (
-    Shizu_Value* self,
-    Shizu_Void voidValue
-  )
-{
-  Shizu_Cxx_Debug_assert(NULL != self);
-  self->voidValue = voidValue;
-  self->tag = Shizu_Value_Tag_Void;
-}
-
 Shizu_Boolean
 Shizu_Value_isEqualTo
   (
@@ -365,33 +70,38 @@ Shizu_Value_isEqualTo
     Shizu_Value const* y
   )
 {
-  if (Shizu_Value_Tag_Object == x->tag) {
+  uint8_t tag = Shizu_Value_getTag(x);
+  if (Shizu_Value_Tag_Object == tag) {
     return Shizu_Object_isEqualTo(state, Shizu_Value_getObject(x), y);
   }
-  if (x->tag != y->tag) {
+  if (tag != Shizu_Value_getTag(y)) {
     return Shizu_Boolean_False;
   }
-  switch (x->tag) {
+  switch (tag) {
     case Shizu_Value_Tag_Boolean: {
-      return x->booleanValue == y->booleanValue;
+      return Shizu_Value_getBoolean(x) == Shizu_Value_getBoolean(y);
     } break;
     case Shizu_Value_Tag_CxxFunction: {
-      return x->cxxFunctionValue == y->cxxFunctionValue;
+      return Shizu_Value_getCxxFunction(x) == Shizu_Value_getCxxFunction(y);
     } break;
     case Shizu_Value_Tag_Float32: {
-      return x->float32Value == y->float32Value;
+      return Shizu_Value_getFloat32(x) == Shizu_Value_getFloat32(y);
     } break;
+  #if 1 == Shizu_Configuration_WithFloat64
     case Shizu_Value_Tag_Float64: {
-      return x->float64Value == y->float64Value;
+      return Shizu_Value_getFloat64(x) == Shizu_Value_getFloat64(y);
     } break;
+  #endif
     case Shizu_Value_Tag_Integer32: {
-      return x->integer32Value == y->integer32Value;
+      return Shizu_Value_getInteger32(x) == Shizu_Value_getInteger32(y);
     } break;
+  #if 1 == Shizu_Configuration_WithInteger64
     case Shizu_Value_Tag_Integer64: {
-      return x->integer64Value == y->integer64Value;
+      return Shizu_Value_getInteger64(x) == Shizu_Value_getInteger64(y);
     } break;
+  #endif
     case Shizu_Value_Tag_Type: {
-      return x->typeValue == y->typeValue;
+      return Shizu_Value_getType(x) == Shizu_Value_getType(y);
     } break;
     case Shizu_Value_Tag_Void: {
       return Shizu_Boolean_True;
@@ -410,19 +120,19 @@ Shizu_Value_getHashValue
     Shizu_Value const* x
   )
 {
-  switch (x->tag) {
+  switch (Shizu_Value_getTag(x)) {
     case Shizu_Value_Tag_Boolean: {
-      if (x->booleanValue) {
+      if (Shizu_Value_getBoolean(x)) {
         return 1231;
       } else {
         return 1237;
       }
     } break;
     case Shizu_Value_Tag_CxxFunction: {
-      return (intptr_t)(uintptr_t)x->cxxFunctionValue;
+      return (intptr_t)(uintptr_t)Shizu_Value_getCxxFunction(x);
     } break;
     case Shizu_Value_Tag_Float32: {
-      Shizu_Float32 y = x->float32Value;
+      Shizu_Float32 y = Shizu_Value_getFloat32(x);
       if (0.0f != y) {
         if (isnan(y)) {
           // Any nan maps to -3.
@@ -435,8 +145,9 @@ Shizu_Value_getHashValue
         return 0;
       }
     } break;
+  #if 1 == Shizu_Configuration_WithFloat64
     case Shizu_Value_Tag_Float64: {
-      Shizu_Float64 y = x->float64Value;
+      Shizu_Float64 y = Shizu_Value_getFloat64(x);
       if (0.0f != y) {
         if (isnan(y)) {
           // Any nan maps to -3.
@@ -449,17 +160,20 @@ Shizu_Value_getHashValue
         return 0;
       }
     } break;
+  #endif
     case Shizu_Value_Tag_Integer32: {
-      return (Shizu_Integer32)x->integer32Value;
+      return Shizu_Value_getInteger32(x);
     } break;
+  #if 1 == Shizu_Configuration_WithInteger64
     case Shizu_Value_Tag_Integer64: {
-      return (Shizu_Integer32)x->integer64Value;
+      return (Shizu_Integer32)Shizu_Value_getInteger64(x);
     } break;
+  #endif
     case Shizu_Value_Tag_Object: {
-      return Shizu_Object_getHashValue(state, x->objectValue);
+      return Shizu_Object_getHashValue(state, Shizu_Value_getObject(x));
     } break;
     case Shizu_Value_Tag_Type: {
-      return Shizu_Types_getTypeHash(Shizu_State2_getState1(state), Shizu_State2_getTypes(state), x->typeValue);
+      return Shizu_Types_getTypeHash(Shizu_State2_getState1(state), Shizu_State2_getTypes(state), Shizu_Value_getType(x));
     } break;
     case Shizu_Value_Tag_Void: {
       return 0;
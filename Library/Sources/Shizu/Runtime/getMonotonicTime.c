@@ -0,0 +1,65 @@
+/*
+  Shizu
+  Copyright (C) 2024 Michael Heilmann. All rights reserved.
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+#define SHIZU_RUNTIME_PRIVATE (1)
+#include "Shizu/Runtime/getMonotonicTime.h"
+
+#include "Shizu/Runtime/State1.h"
+
+#if (Shizu_Configuration_OperatingSystem == Shizu_Configuration_OperatingSystem_Linux)  || \
+    (Shizu_Configuration_OperatingSystem == Shizu_Configuration_OperatingSystem_Cygwin) || \
+    (Shizu_Configuration_OperatingSystem == Shizu_Configuration_OperatingSystem_Macos)
+  // clock_gettime, CLOCK_MONOTONIC
+  #include <time.h>
+#elif Shizu_Configuration_OperatingSystem == Shizu_Configuration_OperatingSystem_Windows
+  #define WIN32_LEAN_AND_MEAN
+  #include <Windows.h>
+#else
+  #error("operating system not (yet) supported")
+#endif
+
+uint64_t
+Shizu_getMonotonicTime
+  (
+    Shizu_State1* state
+  )
+{
+#if (Shizu_Configuration_OperatingSystem == Shizu_Configuration_OperatingSystem_Linux)  || \
+    (Shizu_Configuration_OperatingSystem == Shizu_Configuration_OperatingSystem_Cygwin) || \
+    (Shizu_Configuration_OperatingSystem == Shizu_Configuration_OperatingSystem_Macos)
+  struct timespec t;
+  if (clock_gettime(CLOCK_MONOTONIC, &t)) {
+    Shizu_State1_setStatus(state, Shizu_Status_EnvironmentFailed);
+    Shizu_State1_jump(state);
+  }
+  return (uint64_t)t.tv_sec * UINT64_C(1000000000) + (uint64_t)t.tv_nsec;
+#elif Shizu_Configuration_OperatingSystem == Shizu_Configuration_OperatingSystem_Windows
+  LARGE_INTEGER frequency, counter;
+  if (!QueryPerformanceFrequency(&frequency) || !QueryPerformanceCounter(&counter)) {
+    Shizu_State1_setStatus(state, Shizu_Status_EnvironmentFailed);
+    Shizu_State1_jump(state);
+  }
+  // Split the conversion such that the multiplication does not overflow.
+  uint64_t seconds = (uint64_t)counter.QuadPart / (uint64_t)frequency.QuadPart;
+  uint64_t remainder = (uint64_t)counter.QuadPart % (uint64_t)frequency.QuadPart;
+  return seconds * UINT64_C(1000000000) + remainder * UINT64_C(1000000000) / (uint64_t)frequency.QuadPart;
+#endif
+}
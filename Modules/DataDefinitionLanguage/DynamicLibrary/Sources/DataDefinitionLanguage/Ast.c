@@ -46,13 +46,6 @@ Ast_callImpl
     Shizu_Value* arguments
   );
 
-static void
-Ast_visit
-  (
-    Shizu_State2* state,
-    Ast* self
-  );
-
 static void
 Ast_initializeDispatch
   (
@@ -60,14 +53,21 @@ Ast_initializeDispatch
     Ast_Dispatch* self
   );
 
+static Shizu_ObjectTypeField const Ast_fields[] = {
+  Shizu_ObjectTypeField_Object(Ast, text),
+  Shizu_ObjectTypeField_Object(Ast, children),
+};
+
 static Shizu_ObjectTypeDescriptor const Ast_Type = {
   .postCreateType = (Shizu_PostCreateTypeCallback*)NULL,
   .preDestroyType = (Shizu_PreDestroyTypeCallback*)NULL,
   .visitType = NULL,
   .size = sizeof(Ast),
   .construct = &Ast_constructImpl,
-  .visit = (Shizu_OnVisitCallback*)&Ast_visit,
+  .visit = NULL,
   .finalize = (Shizu_OnFinalizeCallback*)NULL,
+  .fields = Ast_fields,
+  .numberOfFields = sizeof(Ast_fields) / sizeof(Shizu_ObjectTypeField),
   .dispatchSize = sizeof(Ast_Dispatch),
   .dispatchInitialize = (Shizu_OnDispatchInitializeCallback*)&Ast_initializeDispatch,
   .dispatchUninitialize = NULL,
@@ -169,21 +169,6 @@ Ast_callImpl
   Shizu_State2_jump(state);
 }
 
-static void
-Ast_visit
-  (
-    Shizu_State2* state,
-    Ast* self
-  )
-{
-  if (self->children) {
-    Shizu_Gc_visitObject(Shizu_State2_getState1(state), Shizu_State2_getGc(state), (Shizu_Object*)self->children);
-  }
-  if (self->text) {
-    Shizu_Gc_visitObject(Shizu_State2_getState1(state), Shizu_State2_getGc(state), (Shizu_Object*)self->text);
-  }
-}
-
 static void
 Ast_initializeDispatch
   (
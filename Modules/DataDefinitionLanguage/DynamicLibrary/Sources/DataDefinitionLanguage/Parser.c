@@ -25,13 +25,6 @@
 #include "DataDefinitionLanguage/Scanner.h"
 #include "idlib/byte_sequence.h"
 
-static void
-Parser_visit
-  (
-    Shizu_State2* state,
-    Parser* self
-  );
-
 static void
 Parser_initializeDispatch
   (
@@ -67,14 +60,20 @@ Parser_parseValueImpl
     Parser* self
   );
 
+static Shizu_ObjectTypeField const Parser_fields[] = {
+  Shizu_ObjectTypeField_Object(Parser, scanner),
+};
+
 static Shizu_ObjectTypeDescriptor const Parser_Type = {
   .postCreateType = (Shizu_PostCreateTypeCallback*)NULL,
   .preDestroyType = (Shizu_PreDestroyTypeCallback*)NULL,
   .visitType = NULL,
   .size = sizeof(Parser),
   .construct = &Parser_constructImpl,
-  .visit = (Shizu_OnVisitCallback*)&Parser_visit,
+  .visit = NULL,
   .finalize = (Shizu_OnFinalizeCallback*)NULL,
+  .fields = Parser_fields,
+  .numberOfFields = sizeof(Parser_fields) / sizeof(Shizu_ObjectTypeField),
   .dispatchSize = sizeof(Parser_Dispatch),
   .dispatchInitialize = (Shizu_OnDispatchInitializeCallback*)&Parser_initializeDispatch,
   .dispatchUninitialize = NULL,
@@ -82,18 +81,6 @@ static Shizu_ObjectTypeDescriptor const Parser_Type = {
 
 Shizu_defineObjectType("DataDefinitionLanguage.Parser", Parser, Shizu_Object);
 
-static void
-Parser_visit
-  (
-    Shizu_State2* state,
-    Parser* self
-  )
-{
-  if (self->scanner) {
-    Shizu_Gc_visitObject(Shizu_State2_getState1(state), Shizu_State2_getGc(state), (Shizu_Object*)self->scanner);
-  }
-}
-
 static void
 Parser_initializeDispatch
   (
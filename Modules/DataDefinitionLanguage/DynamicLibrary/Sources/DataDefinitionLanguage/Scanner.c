@@ -23,13 +23,6 @@
 
 #include "idlib/byte_sequence.h"
 
-static void
-Scanner_visit
-  (
-    Shizu_State2* state,
-    Scanner* self
-  );
-
 static void
 Scanner_initializeDispatch
   (
@@ -58,14 +51,21 @@ Scanner_constructImpl
     Shizu_Value* argumentValues
   );
 
+static Shizu_ObjectTypeField const Scanner_fields[] = {
+  Shizu_ObjectTypeField_Object(Scanner, input),
+  Shizu_ObjectTypeField_Object(Scanner, buffer),
+};
+
 static Shizu_ObjectTypeDescriptor const Scanner_Type = {
   .postCreateType = (Shizu_PostCreateTypeCallback*)NULL,
   .preDestroyType = (Shizu_PreDestroyTypeCallback*)NULL,
   .visitType = NULL,
   .size = sizeof(Scanner),
   .construct = &Scanner_constructImpl,
-  .visit = (Shizu_OnVisitCallback*)&Scanner_visit,
+  .visit = NULL,
   .finalize = (Shizu_OnFinalizeCallback*)NULL,
+  .fields = Scanner_fields,
+  .numberOfFields = sizeof(Scanner_fields) / sizeof(Shizu_ObjectTypeField),
   .dispatchSize = sizeof(Scanner_Dispatch),
   .dispatchInitialize = (Shizu_OnDispatchInitializeCallback*)&Scanner_initializeDispatch,
   .dispatchUninitialize = NULL,
@@ -73,21 +73,6 @@ static Shizu_ObjectTypeDescriptor const Scanner_Type = {
 
 Shizu_defineObjectType("DataDefinitionLanguage.Scanner", Scanner, Shizu_Object);
 
-static void
-Scanner_visit
-  (
-    Shizu_State2* state,
-    Scanner* self
-  )
-{
-  if (self->buffer) {
-    Shizu_Gc_visitObject(Shizu_State2_getState1(state), Shizu_State2_getGc(state), (Shizu_Object*)self->buffer);
-  }
-  if (self->input) {
-    Shizu_Gc_visitObject(Shizu_State2_getState1(state), Shizu_State2_getGc(state), (Shizu_Object*)self->input);
-  }
-}
-
 static void
 Scanner_initializeDispatch
   (
@@ -200,6 +185,7 @@ Scanner_setInput
   )
 {
   self->input = input;
+  Shizu_Gc_writeBarrier(Shizu_State2_getState1(state), Shizu_State2_getGc(state), (Shizu_Object*)self, (Shizu_Object*)input);
   self->reader.start = Shizu_String_getBytes(state, self->input);
   self->reader.end = self->reader.start + Shizu_String_getNumberOfBytes(state, self->input);
   self->reader.current = self->reader.start;
@@ -657,6 +643,11 @@ Scanner_getTokenText
     Scanner* self
   )
 {
+  // Names are the keys of maps and repeat often.
+  if (TokenType_Name == self->tokenType) {
+    return Shizu_String_createInterned(state, Shizu_ByteArray_getRawBytes(state, self->buffer),
+                                              Shizu_ByteArray_getNumberOfRawBytes(state, self->buffer));
+  }
   return Shizu_String_create(state, Shizu_ByteArray_getRawBytes(state, self->buffer),
                                     Shizu_ByteArray_getNumberOfRawBytes(state, self->buffer));
 }
@@ -32,12 +32,9 @@ Token_constructImpl
     Shizu_Value* argumentValues
   );
 
-static void
-Token_visit
-  (
-    Shizu_State2* state,
-    Token* self
-  );
+static Shizu_ObjectTypeField const Token_fields[] = {
+  Shizu_ObjectTypeField_Object(Token, text),
+};
 
 static Shizu_ObjectTypeDescriptor const Token_Type = {
   .postCreateType = (Shizu_PostCreateTypeCallback*)NULL,
@@ -45,8 +42,10 @@ static Shizu_ObjectTypeDescriptor const Token_Type = {
   .visitType = NULL,
   .size = sizeof(Token),
   .construct = &Token_constructImpl,
-  .visit = (Shizu_OnVisitCallback*)&Token_visit,
+  .visit = NULL,
   .finalize = (Shizu_OnFinalizeCallback*)NULL,
+  .fields = Token_fields,
+  .numberOfFields = sizeof(Token_fields) / sizeof(Shizu_ObjectTypeField),
   .dispatchSize = sizeof(Token_Dispatch),
   .dispatchInitialize = NULL,
   .dispatchUninitialize = NULL,
@@ -78,18 +77,6 @@ Token_constructImpl
   ((Shizu_Object*)self)->type = TYPE;
 }
 
-static void
-Token_visit
-  (
-    Shizu_State2* state,
-    Token* self
-  )
-{
-  if (self->text) {
-    Shizu_Gc_visitObject(Shizu_State2_getState1(state), Shizu_State2_getGc(state), (Shizu_Object*)self->text);
-  }
-}
-
 Token*
 Token_create
   (
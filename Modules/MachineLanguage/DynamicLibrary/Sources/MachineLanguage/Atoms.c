@@ -10,13 +10,6 @@ Atom_finalize
     Atom* self
   );
 
-static void
-Atom_visit
-  (
-    Shizu_State2* state,
-    Atom* self
-  );
-
 static void
 Atom_constructImpl
   (
@@ -26,14 +19,20 @@ Atom_constructImpl
     Shizu_Value* argumentValues
   );
 
+static Shizu_ObjectTypeField const Atom_fields[] = {
+  Shizu_ObjectTypeField_Object(Atom, next),
+};
+
 static Shizu_ObjectTypeDescriptor const Atom_Type = {
   .postCreateType = (Shizu_PostCreateTypeCallback*)NULL,
   .preDestroyType = (Shizu_PreDestroyTypeCallback*)NULL,
   .visitType = NULL,
   .size = sizeof(Atom),
   .construct = &Atom_constructImpl,
-  .visit = (Shizu_OnVisitCallback*)&Atom_visit,
+  .visit = NULL,
   .finalize = (Shizu_OnFinalizeCallback*)&Atom_finalize,
+  .fields = Atom_fields,
+  .numberOfFields = sizeof(Atom_fields) / sizeof(Shizu_ObjectTypeField),
   .dispatchSize = sizeof(Atom_Dispatch),
   .dispatchInitialize = (Shizu_OnDispatchInitializeCallback*)NULL,
   .dispatchUninitialize = NULL,
@@ -54,18 +53,6 @@ Atom_finalize
   }
 }
 
-static void
-Atom_visit
-  (
-    Shizu_State2* state,
-    Atom* self
-  )
-{
-  if (self->next) {
-    Shizu_Gc_visitObject(Shizu_State2_getState1(state), Shizu_State2_getGc(state), (Shizu_Object*)self->next);
-  }
-}
-
 static void
 Atom_constructImpl
   (
@@ -23,13 +23,6 @@
 
 Shizu_defineEnumerationType("MachineLanguage.TokenType", TokenType);
 
-static void
-Token_visit
-  (
-    Shizu_State2* state,
-    Token* self
-  );
-
 static void
 Token_constructImpl
   (
@@ -39,14 +32,20 @@ Token_constructImpl
     Shizu_Value* argumentValues
   );
 
+static Shizu_ObjectTypeField const Token_fields[] = {
+  Shizu_ObjectTypeField_Object(Token, text),
+};
+
 static Shizu_ObjectTypeDescriptor const Token_Type = {
   .postCreateType = (Shizu_PostCreateTypeCallback*)NULL,
   .preDestroyType = (Shizu_PreDestroyTypeCallback*)NULL,
   .visitType = NULL,
   .size = sizeof(Token),
   .construct = &Token_constructImpl,
-  .visit = (Shizu_OnVisitCallback*)&Token_visit,
+  .visit = NULL,
   .finalize = (Shizu_OnFinalizeCallback*)NULL,
+  .fields = Token_fields,
+  .numberOfFields = sizeof(Token_fields) / sizeof(Shizu_ObjectTypeField),
   .dispatchSize = sizeof(Token_Dispatch),
   .dispatchInitialize = NULL,
   .dispatchUninitialize = NULL,
@@ -54,18 +53,6 @@ static Shizu_ObjectTypeDescriptor const Token_Type = {
 
 Shizu_defineObjectType("MachineLanguage.Token", Token, Shizu_Object);
 
-static void
-Token_visit
-  (
-    Shizu_State2* state,
-    Token* self
-  )
-{
-  if (self->text) {
-    Shizu_Gc_visitObject(Shizu_State2_getState1(state), Shizu_State2_getGc(state), (Shizu_Object*)self->text);
-  }
-}
-
 static void
 Token_constructImpl
   (
@@ -0,0 +1,185 @@
+/*
+  Shizu
+  Copyright (C) 2024 Michael Heilmann. All rights reserved.
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+#include "Shizu/Runtime/Include.h"
+
+// EXIT_SUCCESS, EXIT_FAILURE
+#include <stdlib.h>
+// fprintf, snprintf, stdout, stderr
+#include <stdio.h>
+// strlen
+#include <string.h>
+
+#define NumberOfVariables (4096)
+
+static void
+check
+  (
+    Shizu_State2* state,
+    bool condition
+  )
+{
+  if (!condition) {
+    Shizu_State2_setStatus(state, Shizu_Status_RuntimeTestFailed);
+    Shizu_State2_jump(state);
+  }
+}
+
+static Shizu_String*
+createName
+  (
+    Shizu_State2* state,
+    Shizu_Integer32 i
+  )
+{
+  char buffer[64];
+  int n = snprintf(buffer, sizeof(buffer), "Shizu.Test.Environment.variable%d", (int)i);
+  return Shizu_String_create(state, buffer, (size_t)n);
+}
+
+/* Define many variables, look them up by name and by slot, and redefine them. */
+static void
+test1Body
+  (
+    Shizu_State2* state,
+    Shizu_Environment* environment,
+    Shizu_List* names
+  )
+{
+  for (Shizu_Integer32 i = 0; i < NumberOfVariables; ++i) {
+    Shizu_String* name = createName(state, i);
+    Shizu_List_appendObject(state, names, (Shizu_Object*)name);
+    Shizu_Environment_setInteger32(state, environment, name, i);
+  }
+  check(state, NumberOfVariables == Shizu_Environment_getSize(state, environment));
+  // Look up by names which are equal but not identical to the names of the variables.
+  for (Shizu_Integer32 i = 0; i < NumberOfVariables; ++i) {
+    Shizu_String* name = createName(state, i);
+    check(state, Shizu_Environment_isDefined(state, environment, name));
+    check(state, i == Shizu_Environment_getInteger32(state, environment, name));
+    check(state, i == Shizu_Environment_getSlot(state, environment, name));
+  }
+  check(state, !Shizu_Environment_isDefined(state, environment, createName(state, NumberOfVariables)));
+  // Redefine by name and assign by slot.
+  for (Shizu_Integer32 i = 0; i < NumberOfVariables; i += 2) {
+    Shizu_Environment_setInteger32(state, environment, createName(state, i), -i);
+  }
+  for (Shizu_Integer32 i = 1; i < NumberOfVariables; i += 2) {
+    Shizu_Value value = Shizu_Value_InitializerInteger32(-i);
+    Shizu_Environment_setAt(state, environment, i, &value);
+  }
+  check(state, NumberOfVariables == Shizu_Environment_getSize(state, environment));
+  for (Shizu_Integer32 i = 0; i < NumberOfVariables; ++i) {
+    Shizu_Value value = Shizu_Environment_getAt(state, environment, i);
+    check(state, Shizu_Value_isInteger32(&value) && -i == Shizu_Value_getInteger32(&value));
+  }
+  // Invalid slots.
+  Shizu_JumpTarget jumpTarget;
+  Shizu_State2_pushJumpTarget(state, &jumpTarget);
+  if (!setjmp(jumpTarget.environment)) {
+    Shizu_Environment_getAt(state, environment, NumberOfVariables);
+    Shizu_State2_popJumpTarget(state);
+    check(state, false);
+  } else {
+    Shizu_State2_popJumpTarget(state);
+    check(state, Shizu_Status_ArgumentOutOfRange == Shizu_State2_getStatus(state));
+    Shizu_State2_setStatus(state, Shizu_Status_NoError);
+  }
+  // Look up by the names of the variables.
+  for (Shizu_Integer32 i = 0; i < NumberOfVariables; ++i) {
+    Shizu_Value value = Shizu_List_getValue(state, names, i);
+    Shizu_String* name = (Shizu_String*)Shizu_Value_getObject(&value);
+    check(state, -i == Shizu_Environment_getInteger32(state, environment, name));
+    check(state, i == Shizu_Environment_getSlot(state, environment, name));
+  }
+}
+
+static void
+test1
+  (
+    Shizu_State2* state
+  )
+{
+  Shizu_Environment* environment = Shizu_Runtime_Extensions_createEnvironment(state);
+  Shizu_Object_lock(Shizu_State2_getState1(state), Shizu_State2_getLocks(state), (Shizu_Object*)environment);
+  Shizu_List* names = NULL;
+  Shizu_JumpTarget jumpTarget;
+  Shizu_State2_pushJumpTarget(state, &jumpTarget);
+  if (!setjmp(jumpTarget.environment)) {
+    names = Shizu_Runtime_Extensions_createList(state);
+    Shizu_Object_lock(Shizu_State2_getState1(state), Shizu_State2_getLocks(state), (Shizu_Object*)names);
+    test1Body(state, environment, names);
+    Shizu_State2_popJumpTarget(state);
+  } else {
+    Shizu_State2_popJumpTarget(state);
+    if (names) {
+      Shizu_Object_unlock(Shizu_State2_getState1(state), Shizu_State2_getLocks(state), (Shizu_Object*)names);
+    }
+    Shizu_Object_unlock(Shizu_State2_getState1(state), Shizu_State2_getLocks(state), (Shizu_Object*)environment);
+    Shizu_State2_jump(state);
+  }
+  Shizu_Object_unlock(Shizu_State2_getState1(state), Shizu_State2_getLocks(state), (Shizu_Object*)names);
+  Shizu_Object_unlock(Shizu_State2_getState1(state), Shizu_State2_getLocks(state), (Shizu_Object*)environment);
+}
+
+static int
+safeExecute
+  (
+    void (*test)(Shizu_State2* state)
+  )
+{
+  if (!test) {
+    return 1;
+  }
+  Shizu_State2* state = NULL;
+  if (Shizu_State2_acquire(&state)) {
+    return 1;
+  }
+  Shizu_JumpTarget jumpTarget;
+  Shizu_State2_pushJumpTarget(state, &jumpTarget);
+  if (!setjmp(jumpTarget.environment)) {
+    Shizu_State2_ensureModulesLoaded(state);
+    (*test)(state);
+    Shizu_State2_popJumpTarget(state);
+  } else {
+    Shizu_State2_popJumpTarget(state);
+    Shizu_State2_relinquish(state);
+    state = NULL;
+    return 1;
+  }
+  Shizu_State2_relinquish(state);
+  state = NULL;
+  return 0;
+}
+
+int
+main
+  (
+    int argc,
+    char** argv
+  )
+{
+  bool failed = false;
+  if (safeExecute(&test1)) {
+    failed = true;
+  }
+  return failed ? EXIT_FAILURE : EXIT_SUCCESS;
+}
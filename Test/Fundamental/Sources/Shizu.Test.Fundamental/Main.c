@@ -28,7 +28,7 @@
 // strlen
 #include <string.h>
 
-/* Test store and load of scalar values (Shizu_Boolean, Shizu_Float32, Shizu_Integer32, Shizu_Void) in/from Shizu_Value. */
+/* Test store and load of scalar values (Shizu_Boolean, Shizu_Float32, Shizu_Float64, Shizu_Integer32, Shizu_Type, Shizu_Void) in/from Shizu_Value. */
 static void
 test1
   (
@@ -143,6 +143,58 @@ test1
     Shizu_State2_setStatus(state, 1);
     Shizu_State2_jump(state);
   }
+  if (Shizu_Value_Tag_Integer32 != Shizu_Value_getTag(&value)) {
+    Shizu_State2_setStatus(state, 1);
+    Shizu_State2_jump(state);
+  }
+
+#if 1 == Shizu_Configuration_WithFloat64
+  /* Shizu_Float64 */
+  Shizu_Float64 float64Values[] = {
+    0.0,
+    -0.0,
+    Shizu_Float64_Maximum,
+    Shizu_Float64_Minimum,
+    Shizu_Float64_Infinity,
+    -Shizu_Float64_Infinity,
+  };
+  for (size_t i = 0, n = sizeof(float64Values) / sizeof(Shizu_Float64); i < n; ++i) {
+    Shizu_Value_setFloat64(&value, float64Values[i]);
+    if (!Shizu_Value_isFloat64(&value) || Shizu_Value_Tag_Float64 != Shizu_Value_getTag(&value)) {
+      Shizu_State2_setStatus(state, 1);
+      Shizu_State2_jump(state);
+    }
+    if (float64Values[i] != Shizu_Value_getFloat64(&value) || signbit(float64Values[i]) != signbit(Shizu_Value_getFloat64(&value))) {
+      Shizu_State2_setStatus(state, 1);
+      Shizu_State2_jump(state);
+    }
+  }
+  // Any NaN must remain a Float64 value.
+  Shizu_Value_setFloat64(&value, -NAN);
+  if (!Shizu_Value_isFloat64(&value) || !isnan(Shizu_Value_getFloat64(&value))) {
+    Shizu_State2_setStatus(state, 1);
+    Shizu_State2_jump(state);
+  }
+  Shizu_Value_setFloat64(&value, NAN);
+  if (!Shizu_Value_isFloat64(&value) || !isnan(Shizu_Value_getFloat64(&value))) {
+    Shizu_State2_setStatus(state, 1);
+    Shizu_State2_jump(state);
+  }
+#endif
+
+  /* Shizu_Void */
+  Shizu_Value_setVoid(&value, Shizu_Void_Void);
+  if (!Shizu_Value_isVoid(&value) || Shizu_Value_Tag_Void != Shizu_Value_getTag(&value)) {
+    Shizu_State2_setStatus(state, 1);
+    Shizu_State2_jump(state);
+  }
+
+  /* Shizu_Type */
+  Shizu_Value_setType(&value, Shizu_List_getType(state));
+  if (!Shizu_Value_isType(&value) || Shizu_List_getType(state) != Shizu_Value_getType(&value)) {
+    Shizu_State2_setStatus(state, 1);
+    Shizu_State2_jump(state);
+  }
 }
 
 static void
@@ -151,12 +203,70 @@ test2
     Shizu_State2* state
   )
 {
-  Shizu_ByteArray_getType(state);
-  Shizu_List_getType(state);
-  Shizu_Map_getType(state);
-  Shizu_Object_getType(state);
-  Shizu_String_getType(state);
-  Shizu_WeakReference_getType(state);
+  Shizu_Type* types[] = {
+    Shizu_ByteArray_getType(state),
+    Shizu_List_getType(state),
+    Shizu_Map_getType(state),
+    Shizu_Object_getType(state),
+    Shizu_String_getType(state),
+    Shizu_WeakReference_getType(state),
+  };
+  /* Getting a type again yields the same type. */
+  if (types[4] != Shizu_String_getType(state)) {
+    Shizu_State2_setStatus(state, 1);
+    Shizu_State2_jump(state);
+  }
+  /* The IDs of the types are distinct, less than the ID bound, and map back to the types. */
+  Shizu_Types* typesState = Shizu_State2_getTypes(state);
+  size_t bound = Shizu_Types_getTypeIdBound(Shizu_State2_getState1(state), typesState);
+  for (size_t i = 0, n = sizeof(types) / sizeof(Shizu_Type*); i < n; ++i) {
+    size_t id = Shizu_Types_getTypeId(Shizu_State2_getState1(state), typesState, types[i]);
+    if (id >= bound || types[i] != Shizu_Types_getTypeById(Shizu_State2_getState1(state), typesState, id)) {
+      Shizu_State2_setStatus(state, 1);
+      Shizu_State2_jump(state);
+    }
+    for (size_t j = 0; j < i; ++j) {
+      if (id == Shizu_Types_getTypeId(Shizu_State2_getState1(state), typesState, types[j])) {
+        Shizu_State2_setStatus(state, 1);
+        Shizu_State2_jump(state);
+      }
+    }
+  }
+  if (NULL != Shizu_Types_getTypeById(Shizu_State2_getState1(state), typesState, bound)) {
+    Shizu_State2_setStatus(state, 1);
+    Shizu_State2_jump(state);
+  }
+  /* The types are found by their names. */
+  for (size_t i = 0, n = sizeof(types) / sizeof(Shizu_Type*); i < n; ++i) {
+    uint8_t const* bytes = NULL;
+    Shizu_Integer32 numberOfBytes = 0;
+    Shizu_Types_getTypeName(Shizu_State2_getState1(state), typesState, types[i], &bytes, &numberOfBytes);
+    if (types[i] != Shizu_Types_getTypeByName(Shizu_State2_getState1(state), typesState, bytes, numberOfBytes)) {
+      Shizu_State2_setStatus(state, 1);
+      Shizu_State2_jump(state);
+    }
+  }
+  if (NULL != Shizu_Types_getTypeByName(Shizu_State2_getState1(state), typesState, (uint8_t const*)"Shizu.NoSuchType", sizeof("Shizu.NoSuchType") - 1)) {
+    Shizu_State2_setStatus(state, 1);
+    Shizu_State2_jump(state);
+  }
+  /* Every type is a sub-type of itself and of the "Object" type but not a true sub-type of itself.
+     Only the "Object" type is a sub-type of the "Object" type. */
+  for (size_t i = 0, n = sizeof(types) / sizeof(Shizu_Type*); i < n; ++i) {
+    if (!Shizu_Types_isSubTypeOf(Shizu_State2_getState1(state), typesState, types[i], types[i])
+     || !Shizu_Types_isSubTypeOf(Shizu_State2_getState1(state), typesState, types[i], types[3])
+     || Shizu_Types_isTrueSubTypeOf(Shizu_State2_getState1(state), typesState, types[i], types[i])
+     || (i != 3) != Shizu_Types_isTrueSubTypeOf(Shizu_State2_getState1(state), typesState, types[i], types[3])
+     || (i != 3) == Shizu_Types_isSubTypeOf(Shizu_State2_getState1(state), typesState, types[3], types[i])) {
+      Shizu_State2_setStatus(state, 1);
+      Shizu_State2_jump(state);
+    }
+  }
+  if (Shizu_Types_isSubTypeOf(Shizu_State2_getState1(state), typesState, types[1], types[2])
+   || Shizu_Types_isSubTypeOf(Shizu_State2_getState1(state), typesState, types[4], Shizu_Integer32_getType(state))) {
+    Shizu_State2_setStatus(state, 1);
+    Shizu_State2_jump(state);
+  }
 }
 
 static void
@@ -0,0 +1,1038 @@
+/*
+  Shizu
+  Copyright (C) 2024 Michael Heilmann. All rights reserved.
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+#include "Shizu/Runtime/Include.h"
+#include "Shizu/Gc/Include.h"
+#include "idlib/process.h"
+
+// EXIT_SUCCESS, EXIT_FAILURE
+#include <stdlib.h>
+// fprintf, stdout, stderr
+#include <stdio.h>
+// strlen
+#include <string.h>
+
+/* Create unreferenced objects. Run the GC. Test the objects are reclaimed. */
+static void
+test1
+  (
+    Shizu_State2* state
+  );
+
+/* Promote a list to the old generation. Store young strings in the list. Run minor collections. Test the strings survive. */
+static void
+test2
+  (
+    Shizu_State2* state
+  );
+
+/* Promote a map and an environment to the old generation. Store young objects in them. Run minor collections. Test the objects survive. */
+static void
+test3
+  (
+    Shizu_State2* state
+  );
+
+/* Perform a collection in small steps. Store new strings in a list between the steps. Test the strings survive. */
+static void
+test4
+  (
+    Shizu_State2* state
+  );
+
+/* Mark a graph of lists with four mark threads. Test the graph survives and the garbage is reclaimed. */
+static void
+test5
+  (
+    Shizu_State2* state
+  );
+
+/* Allocate objects during the sweep phase. Test the allocations sweep lazily and the finalizers of the dead objects are invoked by subsequent steps and runs. */
+static void
+test6
+  (
+    Shizu_State2* state
+  );
+
+/* Allocate objects concurrently on several threads (mostly without taking the lock of the GC). Test the objects of all threads are reclaimed by the next collection. */
+static void
+test7
+  (
+    Shizu_State2* state
+  );
+
+/* Allocate and reclaim objects. Test the statistics of the Gcx types, of the Shizu_Type types, and of the collections. */
+static void
+test8
+  (
+    Shizu_State2* state
+  );
+
+/* Poll the GC with different pacing policies. Test Shizu_Gc_poll runs collections as demanded by the policy. */
+static void
+test9
+  (
+    Shizu_State2* state
+  );
+
+/* Register a root range and hooks. Test the objects referenced by the values of the root range survive and the hooks are notified. */
+static void
+test10
+  (
+    Shizu_State2* state
+  );
+
+/* Store objects in the fields described by a type without a visit callback. Run the GC. Test the objects survive. */
+static void
+test11
+  (
+    Shizu_State2* state
+  );
+
+/* Lock objects and create weak references to them. Test objects have side records if and only if they are locked or weakly referenced and weak references do not retain the objects. */
+static void
+test12
+  (
+    Shizu_State2* state
+  );
+
+/* Lock and unlock many objects. Test the side record table grows and shrinks. */
+static void
+test13
+  (
+    Shizu_State2* state
+  );
+
+/* Promote a list to the old generation. Store a new string in the list while a collection is marking. Complete the collection and run a minor collection. Test the string survives. */
+static void
+test14
+  (
+    Shizu_State2* state
+  );
+
+static void
+assertString
+  (
+    Shizu_State2* state,
+    Shizu_Value const* value,
+    char const* bytes
+  )
+{
+  if (!Shizu_Value_isObject(value)) {
+    Shizu_State2_setStatus(state, Shizu_Status_EnvironmentFailed);
+    Shizu_State2_jump(state);
+  }
+  Shizu_String* string = (Shizu_String*)Shizu_Value_getObject(value);
+  if (Shizu_String_getNumberOfBytes(state, string) != strlen(bytes)) {
+    Shizu_State2_setStatus(state, Shizu_Status_EnvironmentFailed);
+    Shizu_State2_jump(state);
+  }
+  if (memcmp(Shizu_String_getBytes(state, string), bytes, strlen(bytes))) {
+    Shizu_State2_setStatus(state, Shizu_Status_EnvironmentFailed);
+    Shizu_State2_jump(state);
+  }
+}
+
+static void
+test1
+  (
+    Shizu_State2* state
+  )
+{
+  Shizu_Gc_SweepInfo sweepInfo = { .dead = 0, .live = 0 };
+  Shizu_Gc_runMajor(state, Shizu_State2_getGc(state), &sweepInfo);
+  for (size_t i = 0; i < 128; ++i) {
+    Shizu_String_create(state, "x", strlen("x"));
+  }
+  Shizu_Gc_runMinor(state, Shizu_State2_getGc(state), &sweepInfo);
+  if (sweepInfo.dead < 128) {
+    Shizu_State2_setStatus(state, Shizu_Status_EnvironmentFailed);
+    Shizu_State2_jump(state);
+  }
+  for (size_t i = 0; i < 128; ++i) {
+    Shizu_String_create(state, "x", strlen("x"));
+  }
+  Shizu_Gc_runMajor(state, Shizu_State2_getGc(state), &sweepInfo);
+  if (sweepInfo.dead < 128) {
+    Shizu_State2_setStatus(state, Shizu_Status_EnvironmentFailed);
+    Shizu_State2_jump(state);
+  }
+}
+
+static void
+test2
+  (
+    Shizu_State2* state
+  )
+{
+  Shizu_List* list = Shizu_Runtime_Extensions_createList(state);
+  Shizu_Object_lock(Shizu_State2_getState1(state), Shizu_State2_getLocks(state), (Shizu_Object*)list);
+  Shizu_JumpTarget jumpTarget;
+  Shizu_State2_pushJumpTarget(state, &jumpTarget);
+  if (!setjmp(jumpTarget.environment)) {
+    Shizu_Gc_SweepInfo sweepInfo = { .dead = 0, .live = 0 };
+    // Promote the list.
+    Shizu_Gc_runMinor(state, Shizu_State2_getGc(state), &sweepInfo);
+    Shizu_Value value = Shizu_Value_InitializerVoid(Shizu_Void_Void);
+    Shizu_Value_setObject(&value, (Shizu_Object*)Shizu_String_create(state, "a", strlen("a")));
+    Shizu_List_appendValue(state, list, &value);
+    Shizu_Gc_runMinor(state, Shizu_State2_getGc(state), &sweepInfo);
+    Shizu_Value_setObject(&value, (Shizu_Object*)Shizu_String_create(state, "b", strlen("b")));
+    Shizu_List_appendValue(state, list, &value);
+    Shizu_Gc_runMinor(state, Shizu_State2_getGc(state), &sweepInfo);
+    Shizu_Gc_runMajor(state, Shizu_State2_getGc(state), &sweepInfo);
+    if (2 != Shizu_List_getSize(state, list)) {
+      Shizu_State2_setStatus(state, Shizu_Status_EnvironmentFailed);
+      Shizu_State2_jump(state);
+    }
+    value = Shizu_List_getValue(state, list, 0);
+    assertString(state, &value, "a");
+    value = Shizu_List_getValue(state, list, 1);
+    assertString(state, &value, "b");
+    Shizu_State2_popJumpTarget(state);
+  } else {
+    Shizu_State2_popJumpTarget(state);
+    Shizu_Object_unlock(Shizu_State2_getState1(state), Shizu_State2_getLocks(state), (Shizu_Object*)list);
+    Shizu_State2_jump(state);
+  }
+  Shizu_Object_unlock(Shizu_State2_getState1(state), Shizu_State2_getLocks(state), (Shizu_Object*)list);
+}
+
+static void
+test3
+  (
+    Shizu_State2* state
+  )
+{
+  Shizu_Map* map = Shizu_Runtime_Extensions_createMap(state);
+  Shizu_Object_lock(Shizu_State2_getState1(state), Shizu_State2_getLocks(state), (Shizu_Object*)map);
+  Shizu_Environment* environment = Shizu_Runtime_Extensions_createEnvironment(state);
+  Shizu_Object_lock(Shizu_State2_getState1(state), Shizu_State2_getLocks(state), (Shizu_Object*)environment);
+  Shizu_JumpTarget jumpTarget;
+  Shizu_State2_pushJumpTarget(state, &jumpTarget);
+  if (!setjmp(jumpTarget.environment)) {
+    Shizu_Gc_SweepInfo sweepInfo = { .dead = 0, .live = 0 };
+    // Promote the map and the environment.
+    Shizu_Gc_runMinor(state, Shizu_State2_getGc(state), &sweepInfo);
+    Shizu_Value key = Shizu_Value_InitializerVoid(Shizu_Void_Void);
+    Shizu_Value value = Shizu_Value_InitializerVoid(Shizu_Void_Void);
+    Shizu_Value_setObject(&key, (Shizu_Object*)Shizu_String_create(state, "key", strlen("key")));
+    Shizu_Value_setObject(&value, (Shizu_Object*)Shizu_String_create(state, "value", strlen("value")));
+    Shizu_Map_set(state, map, &key, &value);
+    Shizu_Environment_set(state, environment, Shizu_String_create(state, "name", strlen("name")), &value);
+    Shizu_Gc_runMinor(state, Shizu_State2_getGc(state), &sweepInfo);
+    Shizu_Gc_runMinor(state, Shizu_State2_getGc(state), &sweepInfo);
+    Shizu_Value_setObject(&key, (Shizu_Object*)Shizu_String_create(state, "key", strlen("key")));
+    value = Shizu_Map_get(state, map, &key);
+    assertString(state, &value, "value");
+    value = Shizu_Environment_get(state, environment, Shizu_String_create(state, "name", strlen("name")));
+    assertString(state, &value, "value");
+    Shizu_State2_popJumpTarget(state);
+  } else {
+    Shizu_State2_popJumpTarget(state);
+    Shizu_Object_unlock(Shizu_State2_getState1(state), Shizu_State2_getLocks(state), (Shizu_Object*)environment);
+    Shizu_Object_unlock(Shizu_State2_getState1(state), Shizu_State2_getLocks(state), (Shizu_Object*)map);
+    Shizu_State2_jump(state);
+  }
+  Shizu_Object_unlock(Shizu_State2_getState1(state), Shizu_State2_getLocks(state), (Shizu_Object*)environment);
+  Shizu_Object_unlock(Shizu_State2_getState1(state), Shizu_State2_getLocks(state), (Shizu_Object*)map);
+}
+
+static void
+test4
+  (
+    Shizu_State2* state
+  )
+{
+  Shizu_List* list = Shizu_Runtime_Extensions_createList(state);
+  Shizu_Object_lock(Shizu_State2_getState1(state), Shizu_State2_getLocks(state), (Shizu_Object*)list);
+  Shizu_JumpTarget jumpTarget;
+  Shizu_State2_pushJumpTarget(state, &jumpTarget);
+  if (!setjmp(jumpTarget.environment)) {
+    Shizu_Gc_SweepInfo sweepInfo = { .dead = 0, .live = 0 };
+    Shizu_Gc_runMajor(state, Shizu_State2_getGc(state), &sweepInfo);
+    for (size_t i = 0; i < 64; ++i) {
+      Shizu_String_create(state, "x", strlen("x"));
+    }
+    // Begin the collection.
+    Shizu_Gc_step(state, Shizu_State2_getGc(state), 1, &sweepInfo);
+    if (Shizu_Gc_Phase_Mark != sweepInfo.phase) {
+      Shizu_State2_setStatus(state, Shizu_Status_EnvironmentFailed);
+      Shizu_State2_jump(state);
+    }
+    size_t steps = 0;
+    bool swept = false;
+    do {
+      Shizu_Value value = Shizu_Value_InitializerVoid(Shizu_Void_Void);
+      Shizu_Value_setObject(&value, (Shizu_Object*)Shizu_String_create(state, "a", strlen("a")));
+      Shizu_List_appendValue(state, list, &value);
+      // The budget must exceed the number of objects grayed by the write barrier between the steps.
+      Shizu_Gc_step(state, Shizu_State2_getGc(state), 8, &sweepInfo);
+      if (Shizu_Gc_Phase_Sweep == sweepInfo.phase) {
+        swept = true;
+      }
+      steps++;
+    } while (Shizu_Gc_Phase_None != sweepInfo.phase && steps < 1024 * 1024);
+    if (Shizu_Gc_Phase_None != sweepInfo.phase || !swept || sweepInfo.dead < 64) {
+      Shizu_State2_setStatus(state, Shizu_Status_EnvironmentFailed);
+      Shizu_State2_jump(state);
+    }
+    Shizu_Gc_runMajor(state, Shizu_State2_getGc(state), &sweepInfo);
+    if (steps != Shizu_List_getSize(state, list)) {
+      Shizu_State2_setStatus(state, Shizu_Status_EnvironmentFailed);
+      Shizu_State2_jump(state);
+    }
+    for (size_t i = 0; i < steps; ++i) {
+      Shizu_Value value = Shizu_List_getValue(state, list, i);
+      assertString(state, &value, "a");
+    }
+    Shizu_State2_popJumpTarget(state);
+  } else {
+    Shizu_State2_popJumpTarget(state);
+    Shizu_Object_unlock(Shizu_State2_getState1(state), Shizu_State2_getLocks(state), (Shizu_Object*)list);
+    Shizu_State2_jump(state);
+  }
+  Shizu_Object_unlock(Shizu_State2_getState1(state), Shizu_State2_getLocks(state), (Shizu_Object*)list);
+}
+
+static void
+test5
+  (
+    Shizu_State2* state
+  )
+{
+  if (Shizu_Gcx_shutdownMarkThreads() || Shizu_Gcx_startupMarkThreads(4)) {
+    Shizu_State2_setStatus(state, Shizu_Status_EnvironmentFailed);
+    Shizu_State2_jump(state);
+  }
+  Shizu_List* list = Shizu_Runtime_Extensions_createList(state);
+  Shizu_Object_lock(Shizu_State2_getState1(state), Shizu_State2_getLocks(state), (Shizu_Object*)list);
+  Shizu_JumpTarget jumpTarget;
+  Shizu_State2_pushJumpTarget(state, &jumpTarget);
+  if (!setjmp(jumpTarget.environment)) {
+    for (size_t i = 0; i < 64; ++i) {
+      Shizu_Value value = Shizu_Value_InitializerVoid(Shizu_Void_Void);
+      Shizu_List* element = Shizu_Runtime_Extensions_createList(state);
+      Shizu_Value_setObject(&value, (Shizu_Object*)element);
+      Shizu_List_appendValue(state, list, &value);
+      for (size_t j = 0; j < 64; ++j) {
+        Shizu_Value_setObject(&value, (Shizu_Object*)Shizu_String_create(state, "a", strlen("a")));
+        Shizu_List_appendValue(state, element, &value);
+        Shizu_String_create(state, "x", strlen("x"));
+      }
+    }
+    Shizu_Gc_SweepInfo sweepInfo = { .dead = 0, .live = 0 };
+    Shizu_Gc_runMajor(state, Shizu_State2_getGc(state), &sweepInfo);
+    if (sweepInfo.dead < 64 * 64 || sweepInfo.marked < 64 * 64 + 64 + 1) {
+      Shizu_State2_setStatus(state, Shizu_Status_EnvironmentFailed);
+      Shizu_State2_jump(state);
+    }
+    Shizu_Gc_runMajor(state, Shizu_State2_getGc(state), &sweepInfo);
+    for (size_t i = 0; i < 64; ++i) {
+      Shizu_Value value = Shizu_List_getValue(state, list, i);
+      Shizu_List* element = (Shizu_List*)Shizu_Value_getObject(&value);
+      if (64 != Shizu_List_getSize(state, element)) {
+        Shizu_State2_setStatus(state, Shizu_Status_EnvironmentFailed);
+        Shizu_State2_jump(state);
+      }
+      for (size_t j = 0; j < 64; ++j) {
+        value = Shizu_List_getValue(state, element, j);
+        assertString(state, &value, "a");
+      }
+    }
+    Shizu_State2_popJumpTarget(state);
+  } else {
+    Shizu_State2_popJumpTarget(state);
+    Shizu_Object_unlock(Shizu_State2_getState1(state), Shizu_State2_getLocks(state), (Shizu_Object*)list);
+    Shizu_Gcx_shutdownMarkThreads();
+    Shizu_State2_jump(state);
+  }
+  Shizu_Object_unlock(Shizu_State2_getState1(state), Shizu_State2_getLocks(state), (Shizu_Object*)list);
+  Shizu_Gcx_shutdownMarkThreads();
+}
+
+static void
+test6
+  (
+    Shizu_State2* state
+  )
+{
+  Shizu_Gc_SweepInfo sweepInfo = { .dead = 0, .live = 0 };
+  Shizu_Gc_runMajor(state, Shizu_State2_getGc(state), &sweepInfo);
+  for (size_t i = 0; i < 256; ++i) {
+    Shizu_String_create(state, "x", strlen("x"));
+  }
+  // Begin the collection and complete marking.
+  Shizu_Gc_step(state, Shizu_State2_getGc(state), SIZE_MAX, &sweepInfo);
+  Shizu_Gc_step(state, Shizu_State2_getGc(state), SIZE_MAX, &sweepInfo);
+  if (Shizu_Gc_Phase_Sweep != sweepInfo.phase) {
+    Shizu_State2_setStatus(state, Shizu_Status_EnvironmentFailed);
+    Shizu_State2_jump(state);
+  }
+  // Sweep all objects by allocating.
+  for (size_t i = 0; i < 4096; ++i) {
+    Shizu_String_create(state, "y", strlen("y"));
+  }
+  // Nothing is left to sweep.
+  Shizu_Gc_step(state, Shizu_State2_getGc(state), 1, &sweepInfo);
+  if (Shizu_Gc_Phase_None != sweepInfo.phase || sweepInfo.dead < 256 || 1 != sweepInfo.finalized) {
+    Shizu_State2_setStatus(state, Shizu_Status_EnvironmentFailed);
+    Shizu_State2_jump(state);
+  }
+  Shizu_Gc_runMajor(state, Shizu_State2_getGc(state), &sweepInfo);
+  if (sweepInfo.finalized < 255 + 4096) {
+    Shizu_State2_setStatus(state, Shizu_Status_EnvironmentFailed);
+    Shizu_State2_jump(state);
+  }
+}
+
+static void
+test7Visit
+  (
+    void* visitContext,
+    void* object
+  )
+{/*Intentionally empty.*/}
+
+static void
+test7Thread
+  (
+    void* argument
+  )
+{
+  Shizu_Gcx_Type* type = (Shizu_Gcx_Type*)argument;
+  for (size_t i = 0; i < 1024; ++i) {
+    void* object = NULL;
+    // Small objects are allocated from the thread-local allocation buffers, big objects by malloc.
+    size_t size = (i % 16) ? (i % 64) * 8 : 1024;
+    if (Shizu_Gcx_allocate(size, type, &object)) {
+      return;
+    }
+    memset(object, 0, size);
+  }
+}
+
+static void
+test7
+  (
+    Shizu_State2* state
+  )
+{
+  Shizu_Gcx_Type* type = NULL;
+  if (Shizu_Gcx_registerType("Shizu.Test.Gc.Test7", strlen("Shizu.Test.Gc.Test7"), NULL, &test7Visit, NULL, NULL)) {
+    Shizu_State2_setStatus(state, Shizu_Status_EnvironmentFailed);
+    Shizu_State2_jump(state);
+  }
+  if (Shizu_Gcx_acquireType("Shizu.Test.Gc.Test7", strlen("Shizu.Test.Gc.Test7"), &type)) {
+    Shizu_Gcx_unregisterType("Shizu.Test.Gc.Test7", strlen("Shizu.Test.Gc.Test7"));
+    Shizu_State2_setStatus(state, Shizu_Status_EnvironmentFailed);
+    Shizu_State2_jump(state);
+  }
+  idlib_thread threads[4];
+  size_t numberOfThreads = 0;
+  for (; numberOfThreads < 4; ++numberOfThreads) {
+    if (idlib_thread_initialize(&threads[numberOfThreads], &test7Thread, type)) {
+      break;
+    }
+  }
+  for (size_t i = 0; i < numberOfThreads; ++i) {
+    idlib_thread_uninitialize(&threads[i]);
+  }
+  Shizu_Gc_SweepInfo sweepInfo = { .dead = 0, .live = 0 };
+  Shizu_Gc_runMajor(state, Shizu_State2_getGc(state), &sweepInfo);
+  Shizu_Gcx_relinquishType(type);
+  Shizu_Gcx_unregisterType("Shizu.Test.Gc.Test7", strlen("Shizu.Test.Gc.Test7"));
+  if (4 != numberOfThreads || sweepInfo.dead < 4 * 1024) {
+    Shizu_State2_setStatus(state, Shizu_Status_EnvironmentFailed);
+    Shizu_State2_jump(state);
+  }
+}
+
+static void
+fail
+  (
+    Shizu_State2* state
+  )
+{
+  Shizu_State2_setStatus(state, Shizu_Status_EnvironmentFailed);
+  Shizu_State2_jump(state);
+}
+
+static Shizu_Integer32
+getCount
+  (
+    Shizu_State2* state,
+    Shizu_Map* map,
+    char const* name
+  )
+{
+  Shizu_Value key;
+  Shizu_Value_setObject(&key, (Shizu_Object*)Shizu_String_create(state, name, strlen(name)));
+  Shizu_Value value = Shizu_Map_get(state, map, &key);
+  if (!Shizu_Value_isInteger32(&value)) {
+    fail(state);
+  }
+  return Shizu_Value_getInteger32(&value);
+}
+
+static void
+test8
+  (
+    Shizu_State2* state
+  )
+{
+  Shizu_Gc* gc = Shizu_State2_getGc(state);
+  Shizu_Gc_SweepInfo sweepInfo = { .dead = 0, .live = 0 };
+  Shizu_Gc_runMajor(state, gc, &sweepInfo);
+  Shizu_Gc_Statistics statistics;
+  Shizu_Gc_getStatistics(state, gc, &statistics);
+  size_t collections = statistics.collections;
+  // Gcx type: Objects are counted when the next collection begins and when they are swept.
+  Shizu_Gcx_Type* type = NULL;
+  if (Shizu_Gcx_registerType("Shizu.Test.Gc.Test8", strlen("Shizu.Test.Gc.Test8"), NULL, &test7Visit, NULL, NULL)) {
+    fail(state);
+  }
+  if (Shizu_Gcx_acquireType("Shizu.Test.Gc.Test8", strlen("Shizu.Test.Gc.Test8"), &type)) {
+    Shizu_Gcx_unregisterType("Shizu.Test.Gc.Test8", strlen("Shizu.Test.Gc.Test8"));
+    fail(state);
+  }
+  for (size_t i = 0; i < 104; ++i) {
+    void* object = NULL;
+    if (Shizu_Gcx_allocate(i < 100 ? 32 : 1024, type, &object)) {
+      break;
+    }
+  }
+  Shizu_Gc_runMajor(state, gc, &sweepInfo);
+  Shizu_Gcx_TypeStatistics typeStatistics;
+  bool valid = !Shizu_Gcx_getTypeStatistics(type, &typeStatistics)
+            && 104 == typeStatistics.allocatedObjects
+            && 100 * 32 + 4 * 1024 <= typeStatistics.allocatedBytes
+            && 104 == typeStatistics.freedObjects
+            && typeStatistics.allocatedBytes == typeStatistics.freedBytes
+            && 0 == typeStatistics.liveObjects
+            && 0 == typeStatistics.liveBytes;
+  Shizu_Gcx_relinquishType(type);
+  Shizu_Gcx_unregisterType("Shizu.Test.Gc.Test8", strlen("Shizu.Test.Gc.Test8"));
+  if (!valid) {
+    fail(state);
+  }
+  // Shizu_Type: Objects are counted by enumerating the objects and when they are finalized.
+  for (size_t i = 0; i < 64; ++i) {
+    Shizu_String_create(state, "x", strlen("x"));
+  }
+  Shizu_Gc_TypeStatistics stringStatistics;
+  Shizu_Gc_getTypeStatistics(state, gc, Shizu_String_getType(state), &stringStatistics);
+  if (stringStatistics.allocatedObjects < 64 || stringStatistics.liveObjects < stringStatistics.allocatedObjects || stringStatistics.liveBytes < 64 * sizeof(Shizu_Object)) {
+    fail(state);
+  }
+  Shizu_Gc_runMajor(state, gc, &sweepInfo);
+  Shizu_Gc_getTypeStatistics(state, gc, Shizu_String_getType(state), &stringStatistics);
+  if (0 != stringStatistics.allocatedObjects || stringStatistics.freedObjects < 64 || stringStatistics.freedBytes < 64 * sizeof(Shizu_Object)) {
+    fail(state);
+  }
+  Shizu_Gc_getStatistics(state, gc, &statistics);
+  if (collections + 2 != statistics.collections || statistics.totalMarkDuration < statistics.markDuration || statistics.totalSweepDuration < statistics.sweepDuration) {
+    fail(state);
+  }
+  // The statistics are available to scripts.
+  Shizu_Environment* environment = Shizu_Environment_getEnvironment(state, Shizu_State2_getGlobalEnvironment(state), Shizu_String_create(state, "Gc", strlen("Gc")));
+  Shizu_CxxProcedure* procedure = Shizu_Environment_getCxxProcedure(state, environment, Shizu_String_create(state, "getStatistics", strlen("getStatistics")));
+  Shizu_Value returnValue;
+  Shizu_Value argumentValues[1];
+  procedure->f(state, &returnValue, 0, argumentValues);
+  if (!Shizu_Runtime_Extensions_isMap(state, returnValue) || (Shizu_Integer32)statistics.collections != getCount(state, (Shizu_Map*)Shizu_Value_getObject(&returnValue), "collections")) {
+    fail(state);
+  }
+  procedure = Shizu_Environment_getCxxProcedure(state, environment, Shizu_String_create(state, "getTypeStatistics", strlen("getTypeStatistics")));
+  Shizu_Value_setObject(&argumentValues[0], (Shizu_Object*)Shizu_String_create(state, "Shizu.String", strlen("Shizu.String")));
+  procedure->f(state, &returnValue, 1, argumentValues);
+  if (!Shizu_Runtime_Extensions_isMap(state, returnValue) || getCount(state, (Shizu_Map*)Shizu_Value_getObject(&returnValue), "freedObjects") < 64) {
+    fail(state);
+  }
+}
+
+static void
+test9
+  (
+    Shizu_State2* state
+  )
+{
+  Shizu_Gc* gc = Shizu_State2_getGc(state);
+  Shizu_Gc_SweepInfo sweepInfo = { .dead = 0, .live = 0 };
+  Shizu_Gc_Pacing pacing;
+  Shizu_Gc_getPacing(state, gc, &pacing);
+  if (Shizu_Configuration_GcGrowthFactor != pacing.growthFactor) {
+    fail(state);
+  }
+  pacing.growthFactor = 100;
+  pacing.minimumHeapSize = 0;
+  pacing.maximumHeapSize = 0;
+  pacing.minimumInterval = 0;
+  Shizu_Gc_setPacing(state, gc, &pacing);
+  Shizu_Gc_runMajor(state, gc, &sweepInfo);
+  Shizu_Gc_Statistics statistics;
+  Shizu_Gc_getStatistics(state, gc, &statistics);
+  size_t liveBytes = statistics.liveBytes;
+  size_t pacedCollections = statistics.pacedCollections;
+  if (0 == liveBytes || 0 != statistics.allocatedBytes) {
+    fail(state);
+  }
+  // The heap did not grow.
+  if (Shizu_Gc_poll(state, gc, &sweepInfo)) {
+    fail(state);
+  }
+  // The heap doubled.
+  while (statistics.allocatedBytes < liveBytes) {
+    Shizu_String_create(state, "x", strlen("x"));
+    Shizu_Gc_getStatistics(state, gc, &statistics);
+  }
+  if (!Shizu_Gc_poll(state, gc, &sweepInfo) || Shizu_Gc_Phase_None != sweepInfo.phase || 0 == sweepInfo.dead) {
+    fail(state);
+  }
+  Shizu_Gc_getStatistics(state, gc, &statistics);
+  if (pacedCollections + 1 != statistics.pacedCollections || 0 != statistics.allocatedBytes) {
+    fail(state);
+  }
+  // The heap doubled but the minimum interval did not elapse.
+  pacing.minimumInterval = UINT64_MAX / 2;
+  Shizu_Gc_setPacing(state, gc, &pacing);
+  liveBytes = statistics.liveBytes;
+  while (statistics.allocatedBytes < liveBytes) {
+    Shizu_String_create(state, "x", strlen("x"));
+    Shizu_Gc_getStatistics(state, gc, &statistics);
+  }
+  if (Shizu_Gc_poll(state, gc, &sweepInfo)) {
+    fail(state);
+  }
+  // The maximum heap size was reached.
+  pacing.maximumHeapSize = liveBytes + statistics.allocatedBytes;
+  Shizu_Gc_setPacing(state, gc, &pacing);
+  if (!Shizu_Gc_poll(state, gc, &sweepInfo)) {
+    fail(state);
+  }
+  // A collection in progress is completed.
+  pacing.maximumHeapSize = 1;
+  Shizu_Gc_setPacing(state, gc, &pacing);
+  Shizu_Gc_step(state, gc, 1, &sweepInfo);
+  if (Shizu_Gc_Phase_None == sweepInfo.phase || !Shizu_Gc_poll(state, gc, &sweepInfo) || Shizu_Gc_Phase_None != sweepInfo.phase) {
+    fail(state);
+  }
+  // Growth does not trigger collections.
+  pacing.growthFactor = 0;
+  pacing.maximumHeapSize = 0;
+  pacing.minimumInterval = 0;
+  Shizu_Gc_setPacing(state, gc, &pacing);
+  Shizu_Gc_getStatistics(state, gc, &statistics);
+  liveBytes = statistics.liveBytes;
+  while (statistics.allocatedBytes < 4 * liveBytes) {
+    Shizu_String_create(state, "x", strlen("x"));
+    Shizu_Gc_getStatistics(state, gc, &statistics);
+  }
+  if (Shizu_Gc_poll(state, gc, &sweepInfo)) {
+    fail(state);
+  }
+  Shizu_Gc_getStatistics(state, gc, &statistics);
+  if (pacedCollections + 3 != statistics.pacedCollections) {
+    fail(state);
+  }
+}
+
+typedef struct Test10Context {
+  Shizu_Value* values;
+  size_t numberOfValues;
+  size_t capacity;
+  size_t finalized;
+  size_t notified;
+  size_t notifiedFinalize;
+} Test10Context;
+
+static void
+test10ObjectFinalize
+  (
+    Shizu_State1* state,
+    Shizu_Gc* gc,
+    Test10Context* context,
+    Shizu_Object* object
+  )
+{
+  for (size_t i = 0; i < context->capacity; ++i) {
+    if (Shizu_Value_isObject(&context->values[i]) && object == Shizu_Value_getObject(&context->values[i])) {
+      context->finalized++;
+    }
+  }
+}
+
+// An object finalize hook removing itself when notified.
+static void
+test10ObjectFinalizeOnce
+  (
+    Shizu_State1* state,
+    Shizu_Gc* gc,
+    Test10Context* context,
+    Shizu_Object* object
+  )
+{
+  context->notifiedFinalize++;
+  Shizu_Gc_removeObjectFinalizeHook(state, gc, context, (Shizu_Gc_ObjectFinalizeCallbackFunction*)&test10ObjectFinalizeOnce);
+}
+
+// A pre mark hook removing itself when notified.
+static void
+test10PreMark
+  (
+    Shizu_State1* state,
+    Shizu_Gc* gc,
+    Test10Context* context
+  )
+{
+  context->notified++;
+  Shizu_Gc_removePreMarkHook(state, gc, context, (Shizu_Gc_PreMarkCallbackFunction*)&test10PreMark);
+}
+
+static void
+test10
+  (
+    Shizu_State2* state
+  )
+{
+  Shizu_Gc* gc = Shizu_State2_getGc(state);
+  Shizu_Gc_SweepInfo sweepInfo = { .dead = 0, .live = 0 };
+  Shizu_Value values[200];
+  Test10Context context = { .values = values, .numberOfValues = 0, .capacity = 200, .finalized = 0, .notified = 0, .notifiedFinalize = 0 };
+  for (size_t i = 0; i < 200; ++i) {
+    Shizu_Value_setInteger32(&values[i], 0);
+  }
+  Shizu_Gc_addRootRange(Shizu_State2_getState1(state), gc, &context.values, &context.numberOfValues);
+  Shizu_Gc_addObjectFinalizeHook(Shizu_State2_getState1(state), gc, &context, (Shizu_Gc_ObjectFinalizeCallbackFunction*)&test10ObjectFinalize);
+  Shizu_Gc_addPreMarkHook(Shizu_State2_getState1(state), gc, &context, (Shizu_Gc_PreMarkCallbackFunction*)&test10PreMark);
+  // Every third value is not an object.
+  for (size_t i = 0; i < 200; ++i) {
+    if (i % 3) {
+      Shizu_Value_setObject(&values[i], (Shizu_Object*)Shizu_String_create(state, "x", strlen("x")));
+    }
+    context.numberOfValues++;
+  }
+  Shizu_Gc_runMajor(state, gc, &sweepInfo);
+  bool valid = 0 == context.finalized && 1 == context.notified;
+  // The objects referenced by the values beyond the number of values are not retained.
+  // 67 of the values 100, ..., 199 are objects.
+  // The object finalize hook removing itself is notified once.
+  context.numberOfValues = 100;
+  Shizu_Gc_addObjectFinalizeHook(Shizu_State2_getState1(state), gc, &context, (Shizu_Gc_ObjectFinalizeCallbackFunction*)&test10ObjectFinalizeOnce);
+  Shizu_Gc_runMajor(state, gc, &sweepInfo);
+  valid = valid && 67 == context.finalized && 1 == context.notified && 1 == context.notifiedFinalize;
+  Shizu_Gc_removePreMarkHook(Shizu_State2_getState1(state), gc, &context, (Shizu_Gc_PreMarkCallbackFunction*)&test10PreMark);
+  Shizu_Gc_removeRootRange(Shizu_State2_getState1(state), gc, &context.values, &context.numberOfValues);
+  Shizu_Gc_runMajor(state, gc, &sweepInfo);
+  // 133 of the values 0, ..., 199 are objects.
+  valid = valid && 133 == context.finalized;
+  Shizu_Gc_removeObjectFinalizeHook(Shizu_State2_getState1(state), gc, &context, (Shizu_Gc_ObjectFinalizeCallbackFunction*)&test10ObjectFinalize);
+  if (!valid) {
+    fail(state);
+  }
+}
+
+typedef struct Test11 {
+  Shizu_Object _parent;
+  Shizu_String* object;
+  Shizu_Value value;
+  Shizu_String* null;
+} Test11;
+
+static Shizu_ObjectTypeField const Test11_fields[] = {
+  Shizu_ObjectTypeField_Object(Test11, object),
+  Shizu_ObjectTypeField_Value(Test11, value),
+  Shizu_ObjectTypeField_Object(Test11, null),
+};
+
+static Shizu_ObjectTypeDescriptor const Test11_Type = {
+  .postCreateType = (Shizu_PostCreateTypeCallback*)NULL,
+  .preDestroyType = (Shizu_PreDestroyTypeCallback*)NULL,
+  .visitType = NULL,
+  .size = sizeof(Test11),
+  .construct = NULL,
+  .visit = NULL,
+  .finalize = NULL,
+  .fields = Test11_fields,
+  .numberOfFields = sizeof(Test11_fields) / sizeof(Shizu_ObjectTypeField),
+  .dispatchSize = sizeof(Shizu_Object_Dispatch),
+  .dispatchInitialize = NULL,
+  .dispatchUninitialize = NULL,
+};
+
+Shizu_defineObjectType("Shizu.Test.Gc.Test11", Test11, Shizu_Object);
+
+static void
+test11
+  (
+    Shizu_State2* state
+  )
+{
+  Shizu_Gc* gc = Shizu_State2_getGc(state);
+  Shizu_Gc_SweepInfo sweepInfo = { .dead = 0, .live = 0 };
+  Shizu_Value values[3];
+  Test10Context context = { .values = values, .numberOfValues = 1, .capacity = 3, .finalized = 0, .notified = 0, .notifiedFinalize = 0 };
+  Shizu_Type* type = Test11_getType(state);
+  Test11* object = (Test11*)Shizu_Gc_allocateObject(state, sizeof(Test11));
+  object->object = Shizu_String_create(state, "x", strlen("x"));
+  Shizu_Value_setObject(&object->value, (Shizu_Object*)Shizu_String_create(state, "y", strlen("y")));
+  object->null = NULL;
+  ((Shizu_Object*)object)->type = type;
+  Shizu_Value_setObject(&values[0], (Shizu_Object*)object);
+  Shizu_Value_setObject(&values[1], (Shizu_Object*)object->object);
+  values[2] = object->value;
+  Shizu_Gc_addRootRange(Shizu_State2_getState1(state), gc, &context.values, &context.numberOfValues);
+  Shizu_Gc_addObjectFinalizeHook(Shizu_State2_getState1(state), gc, &context, (Shizu_Gc_ObjectFinalizeCallbackFunction*)&test10ObjectFinalize);
+  Shizu_Gc_runMajor(state, gc, &sweepInfo);
+  bool valid = 0 == context.finalized;
+  Shizu_Gc_removeRootRange(Shizu_State2_getState1(state), gc, &context.values, &context.numberOfValues);
+  Shizu_Gc_runMajor(state, gc, &sweepInfo);
+  valid = valid && 3 == context.finalized;
+  Shizu_Gc_removeObjectFinalizeHook(Shizu_State2_getState1(state), gc, &context, (Shizu_Gc_ObjectFinalizeCallbackFunction*)&test10ObjectFinalize);
+  if (!valid) {
+    fail(state);
+  }
+}
+
+static void
+test12
+  (
+    Shizu_State2* state
+  )
+{
+  Shizu_Gc* gc = Shizu_State2_getGc(state);
+  Shizu_Gc_SweepInfo sweepInfo = { .dead = 0, .live = 0 };
+  Shizu_Value values[4];
+  Test10Context context = { .values = values, .numberOfValues = 1, .capacity = 4, .finalized = 0, .notified = 0, .notifiedFinalize = 0 };
+  Shizu_String* x = Shizu_String_create(state, "x", strlen("x"));
+  Shizu_String* y = Shizu_String_create(state, "y", strlen("y"));
+  Shizu_Value_setObject(&values[0], (Shizu_Object*)x);
+  Shizu_Value_setObject(&values[1], (Shizu_Object*)y);
+  Shizu_Gc_addRootRange(Shizu_State2_getState1(state), gc, &context.values, &context.numberOfValues);
+  Shizu_Gc_addObjectFinalizeHook(Shizu_State2_getState1(state), gc, &context, (Shizu_Gc_ObjectFinalizeCallbackFunction*)&test10ObjectFinalize);
+  bool valid = !Shizu_Gcx_getRecordFlag(x) && !Shizu_Gcx_getRecordFlag(y);
+  Shizu_WeakReference* wx = Shizu_Runtime_Extensions_createWeakReference(state, (Shizu_Object*)x);
+  Shizu_WeakReference* wy = Shizu_Runtime_Extensions_createWeakReference(state, (Shizu_Object*)y);
+  Shizu_Value_setObject(&values[2], (Shizu_Object*)wx);
+  Shizu_Value_setObject(&values[3], (Shizu_Object*)wy);
+  Shizu_Object_lock(Shizu_State2_getState1(state), Shizu_State2_getLocks(state), (Shizu_Object*)wx);
+  Shizu_Object_lock(Shizu_State2_getState1(state), Shizu_State2_getLocks(state), (Shizu_Object*)wx);
+  valid = valid && Shizu_Gcx_getRecordFlag(x) && Shizu_Gcx_getRecordFlag(y) && Shizu_Gcx_getRecordFlag(wx) && !Shizu_Gcx_getRecordFlag(wy);
+  // y and wy are not retained. x is retained by the root range, wx is retained by its locks.
+  Shizu_Gc_runMajor(state, gc, &sweepInfo);
+  valid = valid && 2 == context.finalized && Shizu_Gcx_getRecordFlag(x);
+  Shizu_Object_unlock(Shizu_State2_getState1(state), Shizu_State2_getLocks(state), (Shizu_Object*)wx);
+  valid = valid && Shizu_Gcx_getRecordFlag(wx);
+  Shizu_Object_unlock(Shizu_State2_getState1(state), Shizu_State2_getLocks(state), (Shizu_Object*)wx);
+  valid = valid && !Shizu_Gcx_getRecordFlag(wx);
+  // wx is not retained. Its finalization removes the side record of x.
+  Shizu_Gc_runMajor(state, gc, &sweepInfo);
+  valid = valid && 3 == context.finalized && !Shizu_Gcx_getRecordFlag(x);
+  Shizu_Gc_removeRootRange(Shizu_State2_getState1(state), gc, &context.values, &context.numberOfValues);
+  Shizu_Gc_runMajor(state, gc, &sweepInfo);
+  valid = valid && 4 == context.finalized;
+  Shizu_Gc_removeObjectFinalizeHook(Shizu_State2_getState1(state), gc, &context, (Shizu_Gc_ObjectFinalizeCallbackFunction*)&test10ObjectFinalize);
+  if (!valid) {
+    fail(state);
+  }
+}
+
+static void
+test13
+  (
+    Shizu_State2* state
+  )
+{
+  Shizu_Gc* gc = Shizu_State2_getGc(state);
+  Shizu_Gc_SweepInfo sweepInfo = { .dead = 0, .live = 0 };
+  Shizu_Value values[1000];
+  Test10Context context = { .values = values, .numberOfValues = 0, .capacity = 1000, .finalized = 0, .notified = 0, .notifiedFinalize = 0 };
+  Shizu_Gc_addObjectFinalizeHook(Shizu_State2_getState1(state), gc, &context, (Shizu_Gc_ObjectFinalizeCallbackFunction*)&test10ObjectFinalize);
+  bool valid = true;
+  for (size_t j = 0; j < 2; ++j) {
+    for (size_t i = 0; i < 1000; ++i) {
+      Shizu_Object* object = (Shizu_Object*)Shizu_String_create(state, "x", strlen("x"));
+      Shizu_Value_setObject(&values[i], object);
+      Shizu_Object_lock(Shizu_State2_getState1(state), Shizu_State2_getLocks(state), object);
+    }
+    Shizu_Gc_runMajor(state, gc, &sweepInfo);
+    valid = valid && 0 == context.finalized;
+    // Unlock the objects with even indices first.
+    for (size_t i = 0; i < 1000; i += 2) {
+      Shizu_Object_unlock(Shizu_State2_getState1(state), Shizu_State2_getLocks(state), Shizu_Value_getObject(&values[i]));
+    }
+    Shizu_Gc_runMajor(state, gc, &sweepInfo);
+    valid = valid && 500 == context.finalized;
+    for (size_t i = 1; i < 1000; i += 2) {
+      valid = valid && Shizu_Gcx_getRecordFlag(Shizu_Value_getObject(&values[i]));
+      Shizu_Object_unlock(Shizu_State2_getState1(state), Shizu_State2_getLocks(state), Shizu_Value_getObject(&values[i]));
+    }
+    Shizu_Gc_runMajor(state, gc, &sweepInfo);
+    valid = valid && 1000 == context.finalized;
+    context.finalized = 0;
+  }
+  Shizu_Gc_removeObjectFinalizeHook(Shizu_State2_getState1(state), gc, &context, (Shizu_Gc_ObjectFinalizeCallbackFunction*)&test10ObjectFinalize);
+  if (!valid) {
+    fail(state);
+  }
+}
+
+static void
+test14
+  (
+    Shizu_State2* state
+  )
+{
+  Shizu_List* list = Shizu_Runtime_Extensions_createList(state);
+  Shizu_Object_lock(Shizu_State2_getState1(state), Shizu_State2_getLocks(state), (Shizu_Object*)list);
+  Shizu_JumpTarget jumpTarget;
+  Shizu_State2_pushJumpTarget(state, &jumpTarget);
+  if (!setjmp(jumpTarget.environment)) {
+    Shizu_Gc_SweepInfo sweepInfo = { .dead = 0, .live = 0 };
+    // Promote the list.
+    Shizu_Gc_runMinor(state, Shizu_State2_getGc(state), &sweepInfo);
+    // Begin the collection.
+    Shizu_Gc_step(state, Shizu_State2_getGc(state), 1, &sweepInfo);
+    if (Shizu_Gc_Phase_Mark != sweepInfo.phase) {
+      Shizu_State2_setStatus(state, Shizu_Status_EnvironmentFailed);
+      Shizu_State2_jump(state);
+    }
+    // The string is allocated after the collection began: It is neither swept nor promoted by the collection.
+    Shizu_Value value = Shizu_Value_InitializerVoid(Shizu_Void_Void);
+    Shizu_Value_setObject(&value, (Shizu_Object*)Shizu_String_create(state, "a", strlen("a")));
+    Shizu_List_appendValue(state, list, &value);
+    size_t steps = 0;
+    do {
+      Shizu_Gc_step(state, Shizu_State2_getGc(state), 8, &sweepInfo);
+      steps++;
+    } while (Shizu_Gc_Phase_None != sweepInfo.phase && steps < 1024 * 1024);
+    if (Shizu_Gc_Phase_None != sweepInfo.phase) {
+      Shizu_State2_setStatus(state, Shizu_Status_EnvironmentFailed);
+      Shizu_State2_jump(state);
+    }
+    // The list is the only object referencing the string.
+    Shizu_Gc_runMinor(state, Shizu_State2_getGc(state), &sweepInfo);
+    if (0 != sweepInfo.dead) {
+      Shizu_State2_setStatus(state, Shizu_Status_EnvironmentFailed);
+      Shizu_State2_jump(state);
+    }
+    // Reuse the memory of dead objects (if any).
+    for (size_t i = 0; i < 64; ++i) {
+      Shizu_String_create(state, "x", strlen("x"));
+    }
+    Shizu_Gc_runMinor(state, Shizu_State2_getGc(state), &sweepInfo);
+    if (1 != Shizu_List_getSize(state, list)) {
+      Shizu_State2_setStatus(state, Shizu_Status_EnvironmentFailed);
+      Shizu_State2_jump(state);
+    }
+    value = Shizu_List_getValue(state, list, 0);
+    assertString(state, &value, "a");
+    Shizu_State2_popJumpTarget(state);
+  } else {
+    Shizu_State2_popJumpTarget(state);
+    Shizu_Object_unlock(Shizu_State2_getState1(state), Shizu_State2_getLocks(state), (Shizu_Object*)list);
+    Shizu_State2_jump(state);
+  }
+  Shizu_Object_unlock(Shizu_State2_getState1(state), Shizu_State2_getLocks(state), (Shizu_Object*)list);
+}
+
+static int
+safeExecute
+  (
+    void (*test)(Shizu_State2* state)
+  )
+{
+  if (!test) {
+    return 1;
+  }
+  Shizu_State2* state = NULL;
+  if (Shizu_State2_acquire(&state)) {
+    return 1;
+  }
+  Shizu_JumpTarget jumpTarget;
+  Shizu_State2_pushJumpTarget(state, &jumpTarget);
+  if (!setjmp(jumpTarget.environment)) {
+    Shizu_State2_ensureModulesLoaded(state);
+    (*test)(state);
+    Shizu_State2_popJumpTarget(state);
+  } else {
+    Shizu_State2_popJumpTarget(state);
+    Shizu_State2_relinquish(state);
+    state = NULL;
+    return 1;
+  }
+  Shizu_State2_relinquish(state);
+  state = NULL;
+  return 0;
+}
+
+int
+main
+  (
+    int argc,
+    char** argv
+  )
+{
+  bool failed = false;
+  if (safeExecute(&test1)) {
+    failed = true;
+  }
+  if (safeExecute(&test2)) {
+    failed = true;
+  }
+  if (safeExecute(&test3)) {
+    failed = true;
+  }
+  if (safeExecute(&test4)) {
+    failed = true;
+  }
+  if (safeExecute(&test5)) {
+    failed = true;
+  }
+  if (safeExecute(&test6)) {
+    failed = true;
+  }
+  if (safeExecute(&test7)) {
+    failed = true;
+  }
+  if (safeExecute(&test8)) {
+    failed = true;
+  }
+  if (safeExecute(&test9)) {
+    failed = true;
+  }
+  if (safeExecute(&test10)) {
+    failed = true;
+  }
+  if (safeExecute(&test11)) {
+    failed = true;
+  }
+  if (safeExecute(&test12)) {
+    failed = true;
+  }
+  if (safeExecute(&test13)) {
+    failed = true;
+  }
+  if (safeExecute(&test14)) {
+    failed = true;
+  }
+  return failed ? EXIT_FAILURE : EXIT_SUCCESS;
+}
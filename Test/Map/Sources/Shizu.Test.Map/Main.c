@@ -0,0 +1,298 @@
+/*
+  Shizu
+  Copyright (C) 2024 Michael Heilmann. All rights reserved.
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+#include "Shizu/Runtime/Include.h"
+
+// EXIT_SUCCESS, EXIT_FAILURE
+#include <stdlib.h>
+// fprintf, stdout, stderr
+#include <stdio.h>
+// strlen
+#include <string.h>
+
+#define NumberOfKeys (1 << 16)
+
+static void
+check
+  (
+    Shizu_State2* state,
+    bool condition
+  )
+{
+  if (!condition) {
+    Shizu_State2_setStatus(state, Shizu_Status_RuntimeTestFailed);
+    Shizu_State2_jump(state);
+  }
+}
+
+static Shizu_Integer32
+getInteger32
+  (
+    Shizu_State2* state,
+    Shizu_Map* map,
+    Shizu_Integer32 k
+  )
+{
+  Shizu_Value key = Shizu_Value_InitializerInteger32(k);
+  Shizu_Value value = Shizu_Map_get(state, map, &key);
+  if (Shizu_Value_isVoid(&value)) {
+    return -1;
+  }
+  check(state, Shizu_Value_isInteger32(&value));
+  return Shizu_Value_getInteger32(&value);
+}
+
+static void
+setInteger32
+  (
+    Shizu_State2* state,
+    Shizu_Map* map,
+    Shizu_Integer32 k,
+    Shizu_Integer32 v
+  )
+{
+  Shizu_Value key = Shizu_Value_InitializerInteger32(k);
+  Shizu_Value value = Shizu_Value_InitializerInteger32(v);
+  Shizu_Map_set(state, map, &key, &value);
+}
+
+/* Test set, get, remove, reserve, shrink to fit, iterate, and clear. */
+static void
+test1Body
+  (
+    Shizu_State2* state,
+    Shizu_Map* map
+  )
+{
+  Shizu_Integer32 const n = 10000;
+  // Insert.
+  for (Shizu_Integer32 i = 0; i < n; ++i) {
+    setInteger32(state, map, i, 2 * i);
+  }
+  check(state, n == Shizu_Map_getSize(state, map));
+  for (Shizu_Integer32 i = 0; i < n; ++i) {
+    check(state, 2 * i == getInteger32(state, map, i));
+    check(state, -1 == getInteger32(state, map, n + i));
+  }
+  // Overwrite.
+  for (Shizu_Integer32 i = 0; i < n; i += 2) {
+    setInteger32(state, map, i, 3 * i);
+  }
+  check(state, n == Shizu_Map_getSize(state, map));
+  // Remove.
+  for (Shizu_Integer32 i = 1; i < n; i += 2) {
+    Shizu_Value key = Shizu_Value_InitializerInteger32(i);
+    Shizu_Map_remove(state, map, &key);
+  }
+  check(state, n / 2 == Shizu_Map_getSize(state, map));
+  for (Shizu_Integer32 i = 0; i < n; ++i) {
+    check(state, (i % 2 ? -1 : 3 * i) == getInteger32(state, map, i));
+  }
+  // Setting a Void value removes the pair.
+  Shizu_Value key = Shizu_Value_InitializerInteger32(0);
+  Shizu_Value value = Shizu_Value_InitializerVoid(Shizu_Void_Void);
+  Shizu_Map_set(state, map, &key, &value);
+  check(state, n / 2 - 1 == Shizu_Map_getSize(state, map));
+  check(state, -1 == getInteger32(state, map, 0));
+  // Iterate.
+  Shizu_Integer32 iterator = 0, count = 0;
+  int64_t sum = 0;
+  while (Shizu_Map_iterate(state, map, &iterator, &key, &value)) {
+    check(state, 3 * Shizu_Value_getInteger32(&key) == Shizu_Value_getInteger32(&value));
+    sum += Shizu_Value_getInteger32(&key);
+    count++;
+  }
+  check(state, Shizu_Map_getSize(state, map) == count);
+  check(state, (int64_t)(n / 2 - 1) * (int64_t)(n / 2) == sum);
+  // Shrink to fit and reserve.
+  Shizu_Map_shrinkToFit(state, map);
+  Shizu_Map_reserve(state, map, 4 * n);
+  for (Shizu_Integer32 i = 0; i < n; ++i) {
+    check(state, (i % 2 || 0 == i ? -1 : 3 * i) == getInteger32(state, map, i));
+  }
+  Shizu_JumpTarget jumpTarget;
+  Shizu_State2_pushJumpTarget(state, &jumpTarget);
+  if (!setjmp(jumpTarget.environment)) {
+    Shizu_Map_reserve(state, map, -1);
+    Shizu_State2_popJumpTarget(state);
+    check(state, false);
+  } else {
+    Shizu_State2_popJumpTarget(state);
+    check(state, Shizu_Status_ArgumentOutOfRange == Shizu_State2_getStatus(state));
+    Shizu_State2_setStatus(state, Shizu_Status_NoError);
+  }
+  // String keys are compared by their contents.
+  Shizu_Value_setObject(&key, (Shizu_Object*)Shizu_String_create(state, "key", strlen("key")));
+  Shizu_Value_setInteger32(&value, 7);
+  Shizu_Map_set(state, map, &key, &value);
+  Shizu_Value_setObject(&key, (Shizu_Object*)Shizu_String_create(state, "key", strlen("key")));
+  value = Shizu_Map_get(state, map, &key);
+  check(state, Shizu_Value_isInteger32(&value) && 7 == Shizu_Value_getInteger32(&value));
+  // Clear.
+  Shizu_Map_clear(state, map);
+  check(state, 0 == Shizu_Map_getSize(state, map));
+  check(state, -1 == getInteger32(state, map, 2));
+  value = Shizu_Map_get(state, map, &key);
+  check(state, Shizu_Value_isVoid(&value));
+}
+
+static void
+test1
+  (
+    Shizu_State2* state
+  )
+{
+  Shizu_Map* map = Shizu_Runtime_Extensions_createMap(state);
+  Shizu_Object_lock(Shizu_State2_getState1(state), Shizu_State2_getLocks(state), (Shizu_Object*)map);
+  Shizu_JumpTarget jumpTarget;
+  Shizu_State2_pushJumpTarget(state, &jumpTarget);
+  if (!setjmp(jumpTarget.environment)) {
+    test1Body(state, map);
+    Shizu_State2_popJumpTarget(state);
+  } else {
+    Shizu_State2_popJumpTarget(state);
+    Shizu_Object_unlock(Shizu_State2_getState1(state), Shizu_State2_getLocks(state), (Shizu_Object*)map);
+    Shizu_State2_jump(state);
+  }
+  Shizu_Object_unlock(Shizu_State2_getState1(state), Shizu_State2_getLocks(state), (Shizu_Object*)map);
+}
+
+// The i-th key of test2.
+// The keys are pseudo-random (the finalizer of MurmurHash3 is a bijection such that distinct indices yield distinct keys).
+static inline Shizu_Integer32
+getKey
+  (
+    Shizu_Integer32 i
+  )
+{
+  uint32_t x = (uint32_t)i;
+  x ^= x >> 16;
+  x *= UINT32_C(0x85EBCA6B);
+  x ^= x >> 13;
+  x *= UINT32_C(0xC2B2AE35);
+  x ^= x >> 16;
+  return (Shizu_Integer32)x;
+}
+
+// The i-th index of a permutation of [0,NumberOfKeys).
+// Lookups visit the keys in this order rather than in the order of their insertion.
+static inline Shizu_Integer32
+permute
+  (
+    Shizu_Integer32 i
+  )
+{
+  return (Shizu_Integer32)(((uint32_t)i * UINT32_C(40503)) & (NumberOfKeys - 1));
+}
+
+/* Set many pseudo-random keys. Test the keys are found in an order different from their insertion and absent keys are not found. */
+static void
+test2Body
+  (
+    Shizu_State2* state,
+    Shizu_Map* map
+  )
+{
+  Shizu_Value key, value;
+  for (Shizu_Integer32 i = 0; i < NumberOfKeys; ++i) {
+    Shizu_Value_setInteger32(&key, getKey(i));
+    Shizu_Value_setInteger32(&value, i);
+    Shizu_Map_set(state, map, &key, &value);
+  }
+  check(state, NumberOfKeys == Shizu_Map_getSize(state, map));
+  for (Shizu_Integer32 i = 0; i < NumberOfKeys; ++i) {
+    Shizu_Integer32 j = permute(i);
+    check(state, j == getInteger32(state, map, getKey(j)));
+  }
+  for (Shizu_Integer32 i = 0; i < NumberOfKeys; ++i) {
+    Shizu_Value_setInteger32(&key, getKey(NumberOfKeys + permute(i)));
+    value = Shizu_Map_get(state, map, &key);
+    check(state, Shizu_Value_isVoid(&value));
+  }
+}
+
+static void
+test2
+  (
+    Shizu_State2* state
+  )
+{
+  Shizu_Map* map = Shizu_Runtime_Extensions_createMap(state);
+  Shizu_Object_lock(Shizu_State2_getState1(state), Shizu_State2_getLocks(state), (Shizu_Object*)map);
+  Shizu_JumpTarget jumpTarget;
+  Shizu_State2_pushJumpTarget(state, &jumpTarget);
+  if (!setjmp(jumpTarget.environment)) {
+    test2Body(state, map);
+    Shizu_State2_popJumpTarget(state);
+  } else {
+    Shizu_State2_popJumpTarget(state);
+    Shizu_Object_unlock(Shizu_State2_getState1(state), Shizu_State2_getLocks(state), (Shizu_Object*)map);
+    Shizu_State2_jump(state);
+  }
+  Shizu_Object_unlock(Shizu_State2_getState1(state), Shizu_State2_getLocks(state), (Shizu_Object*)map);
+}
+
+static int
+safeExecute
+  (
+    void (*test)(Shizu_State2* state)
+  )
+{
+  if (!test) {
+    return 1;
+  }
+  Shizu_State2* state = NULL;
+  if (Shizu_State2_acquire(&state)) {
+    return 1;
+  }
+  Shizu_JumpTarget jumpTarget;
+  Shizu_State2_pushJumpTarget(state, &jumpTarget);
+  if (!setjmp(jumpTarget.environment)) {
+    Shizu_State2_ensureModulesLoaded(state);
+    (*test)(state);
+    Shizu_State2_popJumpTarget(state);
+  } else {
+    Shizu_State2_popJumpTarget(state);
+    Shizu_State2_relinquish(state);
+    state = NULL;
+    return 1;
+  }
+  Shizu_State2_relinquish(state);
+  state = NULL;
+  return 0;
+}
+
+int
+main
+  (
+    int argc,
+    char** argv
+  )
+{
+  bool failed = false;
+  if (safeExecute(&test1)) {
+    failed = true;
+  }
+  if (safeExecute(&test2)) {
+    failed = true;
+  }
+  return failed ? EXIT_FAILURE : EXIT_SUCCESS;
+}
@@ -0,0 +1,369 @@
+/*
+  Shizu
+  Copyright (C) 2024 Michael Heilmann. All rights reserved.
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+#include "Shizu/Runtime/Include.h"
+
+// EXIT_SUCCESS, EXIT_FAILURE
+#include <stdlib.h>
+// snprintf
+#include <stdio.h>
+// memcmp, strlen
+#include <string.h>
+
+#define NumberOfStrings (4096)
+
+#define NumberOfParts (1024)
+
+static void
+check
+  (
+    Shizu_State2* state,
+    bool condition
+  )
+{
+  if (!condition) {
+    Shizu_State2_setStatus(state, Shizu_Status_RuntimeTestFailed);
+    Shizu_State2_jump(state);
+  }
+}
+
+static Shizu_String*
+createName
+  (
+    Shizu_State2* state,
+    size_t i
+  )
+{
+  char buffer[64];
+  int n = snprintf(buffer, sizeof(buffer), "Shizu.Test.String.name%zu", i);
+  return Shizu_String_createInterned(state, buffer, (size_t)n);
+}
+
+static void
+checkName
+  (
+    Shizu_State2* state,
+    Shizu_String* string,
+    size_t i
+  )
+{
+  char buffer[64];
+  int n = snprintf(buffer, sizeof(buffer), "Shizu.Test.String.name%zu", i);
+  check(state, (size_t)n == Shizu_String_getNumberOfBytes(state, string));
+  check(state, !memcmp(buffer, Shizu_String_getBytes(state, string), (size_t)n));
+}
+
+/* Interned strings are canonical. */
+static void
+test1
+  (
+    Shizu_State2* state
+  )
+{
+  Shizu_String* a = Shizu_String_createInterned(state, "a", strlen("a"));
+  Shizu_String* b = Shizu_String_createInterned(state, "b", strlen("b"));
+  check(state, Shizu_String_isInterned(state, a));
+  check(state, a == Shizu_String_createInterned(state, "a", strlen("a")));
+  check(state, a != b);
+  Shizu_String* c = Shizu_String_create(state, "a", strlen("a"));
+  check(state, !Shizu_String_isInterned(state, c));
+  Shizu_Value value;
+  Shizu_Value_setObject(&value, (Shizu_Object*)c);
+  check(state, Shizu_Object_isEqualTo(state, (Shizu_Object*)a, &value));
+  Shizu_Value_setObject(&value, (Shizu_Object*)b);
+  check(state, !Shizu_Object_isEqualTo(state, (Shizu_Object*)a, &value));
+  check(state, a == Shizu_String_intern(state, c));
+  check(state, !Shizu_String_isInterned(state, c));
+  Shizu_String* d = Shizu_String_concatenate(state, a, b);
+  check(state, d == Shizu_String_intern(state, d));
+  check(state, Shizu_String_isInterned(state, d));
+  check(state, d == Shizu_String_createInterned(state, "ab", strlen("ab")));
+}
+
+/* The intern table does not keep its strings alive. */
+static void
+test2Body
+  (
+    Shizu_State2* state,
+    Shizu_List* list
+  )
+{
+  for (size_t i = 0; i < NumberOfStrings; ++i) {
+    Shizu_String* string = createName(state, i);
+    if (0 == i % 2) {
+      Shizu_List_appendObject(state, list, (Shizu_Object*)string);
+    }
+  }
+  Shizu_Gc_SweepInfo sweepInfo = { .dead = 0, .live = 0 };
+  Shizu_Gc_runMajor(state, Shizu_State2_getGc(state), &sweepInfo);
+  check(state, sweepInfo.dead >= NumberOfStrings / 2);
+  for (size_t i = 0; i < NumberOfStrings; ++i) {
+    Shizu_String* string = createName(state, i);
+    checkName(state, string, i);
+    if (0 == i % 2) {
+      Shizu_Value value = Shizu_List_getValue(state, list, (Shizu_Integer32)(i / 2));
+      check(state, (Shizu_Object*)string == Shizu_Value_getObject(&value));
+    }
+  }
+}
+
+/* Strings handed out by the intern table while a collection is marking are not reclaimed by that collection. */
+static void
+test3Body
+  (
+    Shizu_State2* state,
+    Shizu_List* list
+  )
+{
+  Shizu_Gc_SweepInfo sweepInfo = { .dead = 0, .live = 0 };
+  Shizu_Gc_runMajor(state, Shizu_State2_getGc(state), &sweepInfo);
+  for (size_t i = 0; i < NumberOfStrings; ++i) {
+    createName(state, i);
+  }
+  // Begin the collection.
+  Shizu_Gc_step(state, Shizu_State2_getGc(state), 1, &sweepInfo);
+  check(state, Shizu_Gc_Phase_Mark == sweepInfo.phase);
+  size_t steps = 0;
+  do {
+    Shizu_List_appendObject(state, list, (Shizu_Object*)createName(state, steps % NumberOfStrings));
+    Shizu_Gc_step(state, Shizu_State2_getGc(state), 8, &sweepInfo);
+    steps++;
+  } while (Shizu_Gc_Phase_None != sweepInfo.phase && steps < 1024 * 1024);
+  check(state, Shizu_Gc_Phase_None == sweepInfo.phase);
+  Shizu_Gc_runMajor(state, Shizu_State2_getGc(state), &sweepInfo);
+  for (size_t i = 0; i < steps; ++i) {
+    Shizu_Value value = Shizu_List_getValue(state, list, (Shizu_Integer32)i);
+    Shizu_String* string = (Shizu_String*)Shizu_Value_getObject(&value);
+    checkName(state, string, i % NumberOfStrings);
+    check(state, Shizu_String_isInterned(state, string));
+    check(state, string == createName(state, i % NumberOfStrings));
+  }
+}
+
+/* Strings of any length, including short strings stored in their objects. */
+static void
+test4
+  (
+    Shizu_State2* state
+  )
+{
+  char buffer[64];
+  for (size_t i = 0; i < sizeof(buffer); ++i) {
+    buffer[i] = (char)('a' + i % 26);
+  }
+  for (size_t i = 0; i <= sizeof(buffer); ++i) {
+    Shizu_String* string = Shizu_String_create(state, buffer, i);
+    check(state, i == Shizu_String_getNumberOfBytes(state, string));
+    check(state, !memcmp(buffer, Shizu_String_getBytes(state, string), i));
+    for (size_t j = 0; j <= i; ++j) {
+      Shizu_String* prefix = Shizu_String_create(state, buffer, j);
+      Shizu_String* suffix = Shizu_String_create(state, buffer + j, i - j);
+      Shizu_String* concatenation = Shizu_String_concatenate(state, prefix, suffix);
+      check(state, i == Shizu_String_getNumberOfBytes(state, concatenation));
+      check(state, !memcmp(buffer, Shizu_String_getBytes(state, concatenation), i));
+      Shizu_Value value;
+      Shizu_Value_setObject(&value, (Shizu_Object*)concatenation);
+      check(state, Shizu_Object_getHashValue(state, (Shizu_Object*)string) == Shizu_Object_getHashValue(state, (Shizu_Object*)concatenation));
+      check(state, Shizu_Object_isEqualTo(state, (Shizu_Object*)string, &value));
+    }
+  }
+}
+
+/* Long chains of concatenations (represented as ropes if ropes are enabled) survive collections before their Bytes are accessed. */
+static void
+test5Body
+  (
+    Shizu_State2* state,
+    Shizu_List* list
+  )
+{
+  static char const Part[] = "0123456789";
+  static char expected[NumberOfParts * (sizeof(Part) - 1)];
+  for (size_t i = 0; i < NumberOfParts; ++i) {
+    memcpy(expected + i * (sizeof(Part) - 1), Part, sizeof(Part) - 1);
+  }
+  Shizu_String* part = Shizu_String_create(state, Part, sizeof(Part) - 1);
+  Shizu_String* appended = Shizu_String_create(state, "", 0);
+  Shizu_String* prepended = Shizu_String_create(state, "", 0);
+  for (size_t i = 0; i < NumberOfParts; ++i) {
+    appended = Shizu_String_concatenate(state, appended, part);
+    prepended = Shizu_String_concatenate(state, Shizu_String_create(state, Part, sizeof(Part) - 1), prepended);
+  }
+  Shizu_List_appendObject(state, list, (Shizu_Object*)appended);
+  Shizu_List_appendObject(state, list, (Shizu_Object*)prepended);
+  Shizu_Gc_SweepInfo sweepInfo = { .dead = 0, .live = 0 };
+  Shizu_Gc_runMajor(state, Shizu_State2_getGc(state), &sweepInfo);
+  Shizu_String* string = Shizu_String_create(state, expected, sizeof(expected));
+  Shizu_String* strings[] = { appended, prepended, Shizu_String_concatenate(state, appended, prepended) };
+  for (size_t i = 0; i < 2; ++i) {
+    check(state, sizeof(expected) == Shizu_String_getNumberOfBytes(state, strings[i]));
+    check(state, Shizu_Object_getHashValue(state, (Shizu_Object*)string) == Shizu_Object_getHashValue(state, (Shizu_Object*)strings[i]));
+    Shizu_Value value;
+    Shizu_Value_setObject(&value, (Shizu_Object*)strings[i]);
+    check(state, Shizu_Object_isEqualTo(state, (Shizu_Object*)string, &value));
+    check(state, !memcmp(expected, Shizu_String_getBytes(state, strings[i]), sizeof(expected)));
+  }
+  check(state, 2 * sizeof(expected) == Shizu_String_getNumberOfBytes(state, strings[2]));
+  check(state, !memcmp(expected, Shizu_String_getBytes(state, strings[2]), sizeof(expected)));
+  check(state, !memcmp(expected, Shizu_String_getBytes(state, strings[2]) + sizeof(expected), sizeof(expected)));
+  check(state, Shizu_String_startsWith(state, strings[2], appended));
+  check(state, Shizu_String_endsWith(state, strings[2], prepended));
+}
+
+/* A string builder creates the string of the Bytes appended to it. */
+static void
+test6
+  (
+    Shizu_State2* state
+  )
+{
+  static char const Part[] = "0123456789";
+  static char expected[NumberOfParts * (sizeof(Part) - 1)];
+  for (size_t i = 0; i < NumberOfParts; ++i) {
+    memcpy(expected + i * (sizeof(Part) - 1), Part, sizeof(Part) - 1);
+  }
+  Shizu_StringBuilder* builder = Shizu_StringBuilder_create(state);
+  check(state, 0 == Shizu_StringBuilder_getNumberOfBytes(state, builder));
+  Shizu_String* part = Shizu_String_create(state, Part, sizeof(Part) - 1);
+  for (size_t i = 0; i < NumberOfParts; ++i) {
+    if (i % 2) {
+      Shizu_StringBuilder_appendString(state, builder, part);
+    } else {
+      Shizu_StringBuilder_appendBytes(state, builder, Part, sizeof(Part) - 1);
+    }
+  }
+  check(state, sizeof(expected) == Shizu_StringBuilder_getNumberOfBytes(state, builder));
+  Shizu_String* string = Shizu_StringBuilder_toString(state, builder);
+  check(state, sizeof(expected) == Shizu_String_getNumberOfBytes(state, string));
+  check(state, !memcmp(expected, Shizu_String_getBytes(state, string), sizeof(expected)));
+  Shizu_Value value;
+  Shizu_Value_setObject(&value, (Shizu_Object*)string);
+  check(state, Shizu_Object_isEqualTo(state, (Shizu_Object*)Shizu_String_create(state, expected, sizeof(expected)), &value));
+  Shizu_StringBuilder_clear(state, builder);
+  check(state, 0 == Shizu_StringBuilder_getNumberOfBytes(state, builder));
+  string = Shizu_StringBuilder_toString(state, builder);
+  check(state, 0 == Shizu_String_getNumberOfBytes(state, string));
+  Shizu_StringBuilder_appendString(state, builder, part);
+  Shizu_Value_setObject(&value, (Shizu_Object*)Shizu_StringBuilder_toString(state, builder));
+  check(state, Shizu_Object_isEqualTo(state, (Shizu_Object*)part, &value));
+}
+
+static void
+withList
+  (
+    Shizu_State2* state,
+    void (*body)(Shizu_State2* state, Shizu_List* list)
+  )
+{
+  Shizu_List* list = Shizu_Runtime_Extensions_createList(state);
+  Shizu_Object_lock(Shizu_State2_getState1(state), Shizu_State2_getLocks(state), (Shizu_Object*)list);
+  Shizu_JumpTarget jumpTarget;
+  Shizu_State2_pushJumpTarget(state, &jumpTarget);
+  if (!setjmp(jumpTarget.environment)) {
+    body(state, list);
+    Shizu_State2_popJumpTarget(state);
+  } else {
+    Shizu_State2_popJumpTarget(state);
+    Shizu_Object_unlock(Shizu_State2_getState1(state), Shizu_State2_getLocks(state), (Shizu_Object*)list);
+    Shizu_State2_jump(state);
+  }
+  Shizu_Object_unlock(Shizu_State2_getState1(state), Shizu_State2_getLocks(state), (Shizu_Object*)list);
+}
+
+static void
+test2
+  (
+    Shizu_State2* state
+  )
+{ withList(state, &test2Body); }
+
+static void
+test3
+  (
+    Shizu_State2* state
+  )
+{ withList(state, &test3Body); }
+
+static void
+test5
+  (
+    Shizu_State2* state
+  )
+{ withList(state, &test5Body); }
+
+static int
+safeExecute
+  (
+    void (*test)(Shizu_State2* state)
+  )
+{
+  if (!test) {
+    return 1;
+  }
+  Shizu_State2* state = NULL;
+  if (Shizu_State2_acquire(&state)) {
+    return 1;
+  }
+  Shizu_JumpTarget jumpTarget;
+  Shizu_State2_pushJumpTarget(state, &jumpTarget);
+  if (!setjmp(jumpTarget.environment)) {
+    Shizu_State2_ensureModulesLoaded(state);
+    (*test)(state);
+    Shizu_State2_popJumpTarget(state);
+  } else {
+    Shizu_State2_popJumpTarget(state);
+    Shizu_State2_relinquish(state);
+    state = NULL;
+    return 1;
+  }
+  Shizu_State2_relinquish(state);
+  state = NULL;
+  return 0;
+}
+
+int
+main
+  (
+    int argc,
+    char** argv
+  )
+{
+  bool failed = false;
+  if (safeExecute(&test1)) {
+    failed = true;
+  }
+  if (safeExecute(&test2)) {
+    failed = true;
+  }
+  if (safeExecute(&test3)) {
+    failed = true;
+  }
+  if (safeExecute(&test4)) {
+    failed = true;
+  }
+  if (safeExecute(&test5)) {
+    failed = true;
+  }
+  if (safeExecute(&test6)) {
+    failed = true;
+  }
+  return failed ? EXIT_FAILURE : EXIT_SUCCESS;
+}
@@ -0,0 +1,268 @@
+/*
+  Shizu
+  Copyright (C) 2024 Michael Heilmann. All rights reserved.
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+
+#include "Shizu/Runtime/Include.h"
+
+// EXIT_SUCCESS, EXIT_FAILURE
+#include <stdlib.h>
+// fprintf, stdout, stderr
+#include <stdio.h>
+// strlen
+#include <string.h>
+// isnan, signbit
+#include <math.h>
+
+/* Set values of each tag with the Shizu_Value_set* accessors. Test the Shizu_Value_get* and Shizu_Value_is* accessors. */
+static void
+test1
+  (
+    Shizu_State2* state
+  );
+
+/* Initialize values of each tag with the Shizu_Value_Initializer* macros. Test the Shizu_Value_get* and Shizu_Value_is* accessors. */
+static void
+test2
+  (
+    Shizu_State2* state
+  );
+
+static void
+check
+  (
+    Shizu_State2* state,
+    bool condition
+  )
+{
+  if (!condition) {
+    Shizu_State2_setStatus(state, Shizu_Status_RuntimeTestFailed);
+    Shizu_State2_jump(state);
+  }
+}
+
+// Check the tag of a value is the specified tag and the Shizu_Value_is* accessors agree with that tag.
+static void
+checkTag
+  (
+    Shizu_State2* state,
+    Shizu_Value const* value,
+    uint8_t tag
+  )
+{
+  check(state, tag == Shizu_Value_getTag(value));
+  check(state, (Shizu_Value_Tag_Boolean == tag) == Shizu_Value_isBoolean(value));
+  check(state, (Shizu_Value_Tag_CxxFunction == tag) == Shizu_Value_isCxxFunction(value));
+  check(state, (Shizu_Value_Tag_Float32 == tag) == Shizu_Value_isFloat32(value));
+#if 1 == Shizu_Configuration_WithFloat64
+  check(state, (Shizu_Value_Tag_Float64 == tag) == Shizu_Value_isFloat64(value));
+#endif
+  check(state, (Shizu_Value_Tag_Integer32 == tag) == Shizu_Value_isInteger32(value));
+#if 1 == Shizu_Configuration_WithInteger64
+  check(state, (Shizu_Value_Tag_Integer64 == tag) == Shizu_Value_isInteger64(value));
+#endif
+  check(state, (Shizu_Value_Tag_Object == tag) == Shizu_Value_isObject(value));
+  check(state, (Shizu_Value_Tag_Type == tag) == Shizu_Value_isType(value));
+  check(state, (Shizu_Value_Tag_Void == tag) == Shizu_Value_isVoid(value));
+}
+
+static void
+cxxFunction
+  (
+    Shizu_State2* state,
+    Shizu_Value* returnValue,
+    Shizu_Integer32 numberOfArgumentValues,
+    Shizu_Value* argumentValues
+  )
+{ Shizu_Value_setVoid(returnValue, Shizu_Void_Void); }
+
+static void
+test1
+  (
+    Shizu_State2* state
+  )
+{
+  Shizu_Value value = Shizu_Value_InitializerVoid(Shizu_Void_Void);
+
+  Shizu_Value_setBoolean(&value, Shizu_Boolean_True);
+  checkTag(state, &value, Shizu_Value_Tag_Boolean);
+  check(state, Shizu_Boolean_True == Shizu_Value_getBoolean(&value));
+  Shizu_Value_setBoolean(&value, Shizu_Boolean_False);
+  checkTag(state, &value, Shizu_Value_Tag_Boolean);
+  check(state, Shizu_Boolean_False == Shizu_Value_getBoolean(&value));
+
+  Shizu_Value_setCxxFunction(&value, &cxxFunction);
+  checkTag(state, &value, Shizu_Value_Tag_CxxFunction);
+  check(state, &cxxFunction == Shizu_Value_getCxxFunction(&value));
+
+  Shizu_Float32 const float32Values[] = { 0.f, 1.5f, Shizu_Float32_Minimum, Shizu_Float32_Maximum, Shizu_Float32_Infinity, -Shizu_Float32_Infinity };
+  for (size_t i = 0, n = sizeof(float32Values) / sizeof(Shizu_Float32); i < n; ++i) {
+    Shizu_Value_setFloat32(&value, float32Values[i]);
+    checkTag(state, &value, Shizu_Value_Tag_Float32);
+    check(state, float32Values[i] == Shizu_Value_getFloat32(&value));
+  }
+  Shizu_Value_setFloat32(&value, -0.f);
+  checkTag(state, &value, Shizu_Value_Tag_Float32);
+  check(state, 0.f == Shizu_Value_getFloat32(&value) && signbit(Shizu_Value_getFloat32(&value)));
+  Shizu_Value_setFloat32(&value, (Shizu_Float32)NAN);
+  checkTag(state, &value, Shizu_Value_Tag_Float32);
+  check(state, isnan(Shizu_Value_getFloat32(&value)));
+
+#if 1 == Shizu_Configuration_WithFloat64
+  Shizu_Float64 const float64Values[] = { 0., 1.5, Shizu_Float64_Minimum, Shizu_Float64_Maximum, Shizu_Float64_Infinity, -Shizu_Float64_Infinity };
+  for (size_t i = 0, n = sizeof(float64Values) / sizeof(Shizu_Float64); i < n; ++i) {
+    Shizu_Value_setFloat64(&value, float64Values[i]);
+    checkTag(state, &value, Shizu_Value_Tag_Float64);
+    check(state, float64Values[i] == Shizu_Value_getFloat64(&value));
+  }
+  Shizu_Value_setFloat64(&value, -0.);
+  checkTag(state, &value, Shizu_Value_Tag_Float64);
+  check(state, 0. == Shizu_Value_getFloat64(&value) && signbit(Shizu_Value_getFloat64(&value)));
+  Shizu_Value_setFloat64(&value, (Shizu_Float64)NAN);
+  checkTag(state, &value, Shizu_Value_Tag_Float64);
+  check(state, isnan(Shizu_Value_getFloat64(&value)));
+#endif
+
+  Shizu_Integer32 const integer32Values[] = { 0, 1, -1, Shizu_Integer32_Minimum, Shizu_Integer32_Maximum };
+  for (size_t i = 0, n = sizeof(integer32Values) / sizeof(Shizu_Integer32); i < n; ++i) {
+    Shizu_Value_setInteger32(&value, integer32Values[i]);
+    checkTag(state, &value, Shizu_Value_Tag_Integer32);
+    check(state, integer32Values[i] == Shizu_Value_getInteger32(&value));
+  }
+
+#if 1 == Shizu_Configuration_WithInteger64
+  Shizu_Integer64 const integer64Values[] = { 0, 1, -1, Shizu_Integer64_Minimum, Shizu_Integer64_Maximum };
+  for (size_t i = 0, n = sizeof(integer64Values) / sizeof(Shizu_Integer64); i < n; ++i) {
+    Shizu_Value_setInteger64(&value, integer64Values[i]);
+    checkTag(state, &value, Shizu_Value_Tag_Integer64);
+    check(state, integer64Values[i] == Shizu_Value_getInteger64(&value));
+  }
+#endif
+
+  Shizu_Object* object = (Shizu_Object*)Shizu_String_create(state, "x", strlen("x"));
+  Shizu_Value_setObject(&value, object);
+  checkTag(state, &value, Shizu_Value_Tag_Object);
+  check(state, object == Shizu_Value_getObject(&value));
+
+  Shizu_Type* type = Shizu_String_getType(state);
+  Shizu_Value_setType(&value, type);
+  checkTag(state, &value, Shizu_Value_Tag_Type);
+  check(state, type == Shizu_Value_getType(&value));
+
+  Shizu_Value_setVoid(&value, Shizu_Void_Void);
+  checkTag(state, &value, Shizu_Value_Tag_Void);
+  check(state, Shizu_Void_Void == Shizu_Value_getVoid(&value));
+}
+
+static void
+test2
+  (
+    Shizu_State2* state
+  )
+{
+  Shizu_Value booleanValue = Shizu_Value_InitializerBoolean(Shizu_Boolean_True);
+  checkTag(state, &booleanValue, Shizu_Value_Tag_Boolean);
+  check(state, Shizu_Boolean_True == Shizu_Value_getBoolean(&booleanValue));
+
+  Shizu_Value cxxFunctionValue = Shizu_Value_InitializerCxxFunction(&cxxFunction);
+  checkTag(state, &cxxFunctionValue, Shizu_Value_Tag_CxxFunction);
+  check(state, &cxxFunction == Shizu_Value_getCxxFunction(&cxxFunctionValue));
+
+  Shizu_Value float32Value = Shizu_Value_InitializerFloat32(-1.5f);
+  checkTag(state, &float32Value, Shizu_Value_Tag_Float32);
+  check(state, -1.5f == Shizu_Value_getFloat32(&float32Value));
+
+#if 1 == Shizu_Configuration_WithFloat64
+  Shizu_Value float64Value = Shizu_Value_InitializerFloat64(-1.5);
+  checkTag(state, &float64Value, Shizu_Value_Tag_Float64);
+  check(state, -1.5 == Shizu_Value_getFloat64(&float64Value));
+#endif
+
+  Shizu_Value integer32Value = Shizu_Value_InitializerInteger32(Shizu_Integer32_Minimum);
+  checkTag(state, &integer32Value, Shizu_Value_Tag_Integer32);
+  check(state, Shizu_Integer32_Minimum == Shizu_Value_getInteger32(&integer32Value));
+
+#if 1 == Shizu_Configuration_WithInteger64
+  Shizu_Value integer64Value = Shizu_Value_InitializerInteger64(Shizu_Integer64_Minimum);
+  checkTag(state, &integer64Value, Shizu_Value_Tag_Integer64);
+  check(state, Shizu_Integer64_Minimum == Shizu_Value_getInteger64(&integer64Value));
+#endif
+
+  Shizu_Object* object = (Shizu_Object*)Shizu_String_create(state, "x", strlen("x"));
+  Shizu_Value objectValue = Shizu_Value_InitializerObject(object);
+  checkTag(state, &objectValue, Shizu_Value_Tag_Object);
+  check(state, object == Shizu_Value_getObject(&objectValue));
+
+  Shizu_Type* type = Shizu_String_getType(state);
+  Shizu_Value typeValue = Shizu_Value_InitializerType(type);
+  checkTag(state, &typeValue, Shizu_Value_Tag_Type);
+  check(state, type == Shizu_Value_getType(&typeValue));
+
+  Shizu_Value voidValue = Shizu_Value_InitializerVoid(Shizu_Void_Void);
+  checkTag(state, &voidValue, Shizu_Value_Tag_Void);
+  check(state, Shizu_Void_Void == Shizu_Value_getVoid(&voidValue));
+}
+
+static int
+safeExecute
+  (
+    void (*test)(Shizu_State2* state)
+  )
+{
+  if (!test) {
+    return 1;
+  }
+  Shizu_State2* state = NULL;
+  if (Shizu_State2_acquire(&state)) {
+    return 1;
+  }
+  Shizu_JumpTarget jumpTarget;
+  Shizu_State2_pushJumpTarget(state, &jumpTarget);
+  if (!setjmp(jumpTarget.environment)) {
+    Shizu_State2_ensureModulesLoaded(state);
+    (*test)(state);
+    Shizu_State2_popJumpTarget(state);
+  } else {
+    Shizu_State2_popJumpTarget(state);
+    Shizu_State2_relinquish(state);
+    state = NULL;
+    return 1;
+  }
+  Shizu_State2_relinquish(state);
+  state = NULL;
+  return 0;
+}
+
+int
+main
+  (
+    int argc,
+    char** argv
+  )
+{
+  bool failed = false;
+  if (safeExecute(&test1)) {
+    failed = true;
+  }
+  if (safeExecute(&test2)) {
+    failed = true;
+  }
+  return failed ? EXIT_FAILURE : EXIT_SUCCESS;
+}